@@ -4413,6 +4413,9 @@ endif
 	cp src/vm/ejsByteGoto.h $(BIT_VAPP_PREFIX)/inc/ejsByteGoto.h
 	rm -f "$(BIT_INC_PREFIX)/ejs/ejsByteGoto.h"
 	ln -s "$(BIT_VAPP_PREFIX)/inc/ejsByteGoto.h" "$(BIT_INC_PREFIX)/ejs/ejsByteGoto.h"
+	cp src/vm/ejsByteFused.h $(BIT_VAPP_PREFIX)/inc/ejsByteFused.h
+	rm -f "$(BIT_INC_PREFIX)/ejs/ejsByteFused.h"
+	ln -s "$(BIT_VAPP_PREFIX)/inc/ejsByteFused.h" "$(BIT_INC_PREFIX)/ejs/ejsByteFused.h"
 	cp src/slots/ejs.cache.local.slots.h $(BIT_VAPP_PREFIX)/inc/ejs.cache.local.slots.h
 	rm -f "$(BIT_INC_PREFIX)/ejs/ejs.cache.local.slots.h"
 	ln -s "$(BIT_VAPP_PREFIX)/inc/ejs.cache.local.slots.h" "$(BIT_INC_PREFIX)/ejs/ejs.cache.local.slots.h"
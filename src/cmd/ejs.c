@@ -50,7 +50,8 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
     Ejs             *ejs;
     cchar           *cmd, *className, *method, *homeDir;
     char            *argp, *searchPath, *modules, *name, *tok, *extraFiles;
-    int             nextArg, err, ecFlags, stats, merge, bind, noout, debug, optimizeLevel, warnLevel, strict, i, next;
+    int             nextArg, err, ecFlags, stats, merge, bind, noout, debug, optimizeLevel, warnLevel, strict, quicken,
+                    jit, map, lazy, i, next;
 
     /*  
         Initialize Multithreaded Portable Runtime (MPR)
@@ -77,6 +78,10 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
     warnLevel = 1;
     optimizeLevel = 9;
     strict = 0;
+    quicken = 1;
+    jit = 1;
+    map = 0;
+    lazy = 0;
     app->files = mprCreateList(-1, 0);
     app->iterations = 1;
     argc = mpr->argc;
@@ -167,6 +172,9 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
                 app->iterations = atoi(argv[++nextArg]);
             }
 
+        } else if (smatch(argp, "--lazy")) {
+            lazy = 1;
+
         } else if (smatch(argp, "--log")) {
             if (nextArg >= argc) {
                 err++;
@@ -175,6 +183,9 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
                 mprSetCmdlineLogging(1);
             }
 
+        } else if (smatch(argp, "--map")) {
+            map = 1;
+
         } else if (smatch(argp, "--method")) {
             if (nextArg >= argc) {
                 err++;
@@ -192,6 +203,12 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
         } else if (smatch(argp, "--nodebug")) {
             debug = 0;
 
+        } else if (smatch(argp, "--nojit")) {
+            jit = 0;
+
+        } else if (smatch(argp, "--noquicken")) {
+            quicken = 0;
+
         } else if (smatch(argp, "--optimize")) {
             if (nextArg >= argc) {
                 err++;
@@ -272,14 +289,18 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
             "  --debug                  # Use symbolic debugging information (default)\n"
             "  --debugger               # Disable timeouts to make using a debugger easier\n"
             "  --files \"files..\"        # Extra source to compile\n"
+            "  --lazy                   # Load function bodies from module files when first called\n"
             "  --log logSpec            # Internal compiler diagnostics logging\n"
+            "  --map                    # Map module files and share their code between interpreters\n"
             "  --method methodName      # Name of method to run. Defaults to main\n"
             "  --nodebug                # Omit symbolic debugging information\n"
+            "  --nojit                  # Disable native code compilation of hot functions\n"
+            "  --noquicken              # Disable runtime op code specialization of hot functions\n"
             "  --optimize level         # Set the optimization level (0-9 default is 9)\n"
             "  --require 'module,...'   # Required list of modules to pre-load\n"
             "  --search ejsPath         # Module search path\n"
             "  --standard               # Default compilation mode to standard (default)\n"
-            "  --stats                  # Print memory stats on exit\n"
+            "  --stats                  # Print memory, cache, intern and op code stats on exit\n"
             "  --strict                 # Default compilation mode to strict\n"
             "  --verbose | -v           # Same as --log stderr:2 \n"
             "  --version                # Emit the compiler version information\n"
@@ -291,9 +312,31 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
         return MPR_ERR_MEMORY;
     }
     app->ejs = ejs;
+    if (!quicken) {
+        ejs->service->quicken = 0;
+    }
+    if (!jit) {
+        ejs->service->jit = 0;
+    }
+    if (map) {
+        ejs->service->mapModules = 1;
+    }
+    if (lazy) {
+        ejs->service->lazyCode = 1;
+    }
     if (ejsLoadModules(ejs, searchPath, app->modules) < 0) {
         return MPR_ERR_CANT_READ;
     }
+    if ((name = getenv("EJS_WORKER")) != 0 && *name) {
+        /*
+            Running as an isolated worker process. Don't let child processes inherit the worker connection.
+         */
+        name = sclone(name);
+        mprSetEnv("EJS_WORKER", "");
+        if (ejsAttachWorker(ejs, name) < 0) {
+            return MPR_ERR_CANT_INITIALIZE;
+        }
+    }
     ecFlags = 0;
     ecFlags |= (merge) ? EC_FLAGS_MERGE: 0;
     ecFlags |= (bind) ? EC_FLAGS_BIND: 0;
@@ -346,6 +389,13 @@ MAIN(ejsMain, int argc, char **argv, char **envp)
         mprSetLogLevel(1);
         mprPrintMem("Memory Usage", 1);
 #endif
+        mprPrintf("Property cache: %,Ld hits, %,Ld misses\n", ejs->cacheHits, ejs->cacheMisses);
+        ejsShowInternStats(ejs);
+        if (ejs->service->mapModules) {
+            mprPrintf("Mapped module files: %d\n", mprGetHashLength(ejs->service->moduleMaps));
+        }
+        mprPrintf("Function bodies: %d loaded of %d deferred\n", ejs->service->loadedCode, ejs->service->deferredCode);
+        ejsShowOpFrequency(ejs);
     }
     if (!err) {
         err = mpr->exitStatus;
@@ -25,10 +25,10 @@ MAIN(ejsmodMain, int argc, char **argv, char **envp)
     EjsMod          *mp;
     Ejs             *ejs;
     MprList         *requiredModules;
-    char            *argp, *searchPath, *output, *modules, *name, *tok;
-    int             nextArg, err, flags;
+    char            *argp, *searchPath, *output, *modules, *name, *tok, *report;
+    int             nextArg, err, flags, analyze;
 
-    err = 0;
+    err = analyze = 0;
     output = searchPath = 0;
     requiredModules = 0;
     
@@ -79,6 +79,9 @@ MAIN(ejsmodMain, int argc, char **argv, char **envp)
             mp->exitOnError++;
             mp->warnOnError++;
             
+        } else if (strcmp(argp, "--heap") == 0) {
+            analyze = 1;
+
         } else if (strcmp(argp, "--html") == 0) {
             if (nextArg >= argc) {
                 err++;
@@ -152,7 +155,7 @@ MAIN(ejsmodMain, int argc, char **argv, char **envp)
             break;
         }
     }
-    if (argc == nextArg) {
+    if (argc == nextArg || (analyze && argc - nextArg > 2)) {
         err++;
     }
     if (mp->genSlots == 0 && mp->listing == 0 && mp->html == 0 && mp->xml == 0 && mp->depends == 0) {
@@ -167,10 +170,12 @@ MAIN(ejsmodMain, int argc, char **argv, char **envp)
                 ejsmod file.mod                              # Defaults to --listing
                 ejsmod --listing embedthis.mod 
                 ejsmod --out slots.h embedthis.mod 
+                ejsmod --heap app.snapshot baseline.snapshot
          */
         mprEprintf("Usage: %s [options] modules ...\n"
             "  Ejscript module manager options:\n"
             "  --cslots              # Generate a C slot definitions file\n"
+            "  --heap                # Analyze a heap snapshot with an optional baseline\n"
             "  --html dir            # Generate HTML documentation to the specified directory\n"
             "  --listing             # Create assembler listing files (default)\n"
             "  --out file            # Output file for all C slots (implies --cslots)\n"
@@ -181,6 +186,22 @@ MAIN(ejsmodMain, int argc, char **argv, char **envp)
         return -1;
     }
 
+    if (analyze) {
+        /*
+            Analyze heap snapshots written by Memory.snapshot() instead of modules
+         */
+        report = ejsAnalyzeMemSnapshot(argv[nextArg], (nextArg + 1 < argc) ? argv[nextArg + 1] : 0);
+        if (report == 0) {
+            mprError("Cannot analyze heap snapshot %s", argv[nextArg]);
+            err = -1;
+        } else {
+            mprPrintf("%s", report);
+        }
+        mprRemoveRoot(mp);
+        mprDestroy(MPR_EXIT_DEFAULT);
+        return err;
+    }
+
     /*
         Need an interpreter to load modules
      */
@@ -95,6 +95,8 @@ static int      getCodeLength(EcCompiler *cp, EcCodeGen *code);
 static EcNode   *getNextNode(EcCompiler *cp, EcNode *np, int *next);
 static EcNode   *getPrevNode(EcCompiler *cp, EcNode *np, int *next);
 static int      getStackCount(EcCompiler *cp);
+static int      isChainedAdd(EcNode *np);
+static int      isNumberNode(EcCompiler *cp, EcNode *np);
 static int      mapToken(EcCompiler *cp, int tokenId);
 static MprFile  *openModuleFile(EcCompiler *cp, cchar *filename);
 static void     orderModule(EcCompiler *cp, MprList *list, EjsModule *mp);
@@ -332,6 +334,7 @@ static void genAssignOp(EcCompiler *cp, EcNode *np)
 static void genBinaryOp(EcCompiler *cp, EcNode *np)
 {
     EcState     *state;
+    int         opcode;
 
     ENTER(cp);
 
@@ -353,7 +356,15 @@ static void genBinaryOp(EcCompiler *cp, EcNode *np)
         if (np->right) {
             processNode(cp, np->right);
         }
-        ecEncodeOpcode(cp, mapToken(cp, np->tokenId));
+        opcode = mapToken(cp, np->tokenId);
+        if (isNumberNode(cp, np->left) && isNumberNode(cp, np->right) && ejsGetNumberOpcode(opcode)) {
+            opcode = ejsGetNumberOpcode(opcode);
+
+        } else if (opcode == EJS_OP_ADD && cp->optimizeLevel > 0 && isChainedAdd(np)) {
+            /* The result is only used by the enclosing add, so string results can be built in place */
+            opcode = EJS_OP_ADD_CHAIN;
+        }
+        ecEncodeOpcode(cp, opcode);
         popStack(cp, 2);
         pushStack(cp, 1);
         break;
@@ -2647,7 +2658,7 @@ static void genPostfixOp(EcCompiler *cp, EcNode *np)
      */
     processNode(cp, np->left);
     ecEncodeOpcode(cp, EJS_OP_DUP);
-    ecEncodeOpcode(cp, EJS_OP_INC);
+    ecEncodeOpcode(cp, isNumberNode(cp, np->left) ? EJS_OP_INC_NUM : EJS_OP_INC);
     ecEncodeByte(cp, (np->tokenId == T_PLUS_PLUS) ? 1 : -1);
     genLeftHandSide(cp, np->left);
     pushStack(cp, 1);
@@ -3170,7 +3181,7 @@ static void genUnaryOp(EcCompiler *cp, EcNode *np)
 
     case T_PLUS_PLUS:
         processNode(cp, np->left);
-        ecEncodeOpcode(cp, EJS_OP_INC);
+        ecEncodeOpcode(cp, isNumberNode(cp, np->left) ? EJS_OP_INC_NUM : EJS_OP_INC);
         ecEncodeByte(cp, 1);
         ecEncodeOpcode(cp, EJS_OP_DUP);
         pushStack(cp, 1);
@@ -3184,7 +3195,7 @@ static void genUnaryOp(EcCompiler *cp, EcNode *np)
 
     case T_MINUS_MINUS:
         processNode(cp, np->left);
-        ecEncodeOpcode(cp, EJS_OP_INC);
+        ecEncodeOpcode(cp, isNumberNode(cp, np->left) ? EJS_OP_INC_NUM : EJS_OP_INC);
         ecEncodeByte(cp, -1);
         ecEncodeOpcode(cp, EJS_OP_DUP);
         pushStack(cp, 1);
@@ -3485,6 +3496,10 @@ static MprFile *openModuleFile(EcCompiler *cp, cchar *filename)
         return 0;
     }
     filename = mprJoinPath(cp->outputDir, filename);
+    /*
+        Remove any prior module file rather than truncating it. Interpreters may have the prior file mapped.
+     */
+    mprDeletePath(filename);
     if ((cp->file = mprOpenFile(filename,  O_CREAT | O_WRONLY | O_TRUNC | O_BINARY, 0664)) == 0) {
         genError(cp, 0, "Cannot create module file \"%s\"", filename);
         return 0;
@@ -3593,6 +3608,14 @@ static void copyCodeBuffer(EcCompiler *cp, EcCodeGen *dest, EcCodeGen *src)
         assert(0);
         return;
     }
+    /*
+        Op codes may be fused with the instructions at the end of src
+     */
+    dest->numRecent = src->numRecent;
+    for (i = 0; i < src->numRecent; i++) {
+        dest->recent[i] = src->recent[i];
+        dest->recent[i].offset += baseOffset;
+    }
     /*
         Copy and fix the jump offset of jump patch records. jump->offset starts out being relative to the current code src.
         We add the original length of dest to make it absolute to the new dest buffer.
@@ -3743,6 +3766,59 @@ static EcNode *getPrevNode(EcCompiler *cp, EcNode *np, int *next)
 }
 
 
+/*
+    Test if an expression is statically known to yield a Number. This is a hint only. The Number opcodes verify their
+    operands at runtime.
+ */
+static int isNumberNode(EcCompiler *cp, EcNode *np)
+{
+    Ejs     *ejs;
+
+    ejs = cp->ejs;
+    if (np == 0) {
+        return 0;
+    }
+    switch (np->kind) {
+    case N_LITERAL:
+        return np->literal.var && TYPE(np->literal.var) == EST(Number);
+
+    case N_QNAME:
+        return np->lookup.trait && np->lookup.trait->type == EST(Number);
+
+    case N_DOT:
+        return np->right && np->right->kind == N_QNAME && isNumberNode(cp, np->right);
+
+    case N_BINARY_OP:
+        switch (np->tokenId) {
+        case T_PLUS: case T_MINUS: case T_MUL: case T_DIV: case T_MOD:
+            return isNumberNode(cp, np->left) && isNumberNode(cp, np->right);
+        }
+        return 0;
+
+    case N_POSTFIX_OP:
+    case N_UNARY_OP:
+        switch (np->tokenId) {
+        case T_PLUS_PLUS: case T_MINUS_MINUS: case T_MINUS:
+            return isNumberNode(cp, np->left);
+        }
+        return 0;
+    }
+    return 0;
+}
+
+
+/*
+    Test if the node is the left operand of an addition: (np) + right
+ */
+static int isChainedAdd(EcNode *np)
+{
+    EcNode  *parent;
+
+    parent = np->parent;
+    return parent && parent->kind == N_BINARY_OP && parent->tokenId == T_PLUS && parent->left == np;
+}
+
+
 /*
     Map a lexical token to an op code
  */
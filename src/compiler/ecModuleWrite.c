@@ -392,7 +392,10 @@ static void createFunctionSection(EcCompiler *cp, EjsPot *block, int slotNum, Ej
     activation = fun->activation;
     numProp = (activation) ? activation->numProp: 0;
     code = fun->body.code;
-    
+    if (code && code->byteCode == 0 && code->codeLen > 0 && ejsLoadFunctionCode(ejs, fun) < 0) {
+        cp->fatalError = 1;
+        return;
+    }
     if (block && slotNum >= 0) {
         qname = ejsGetPropertyName(ejs, block, slotNum);
         createDocSection(cp, "fun", block, slotNum);
@@ -862,13 +865,130 @@ static int reserveRoom(EcCompiler *cp, int room)
 
 
 /*
-    Encode an Ejscript instruction operation code
+    Restore the op code of a fused sequence that starts at recent[index] and uncover the rest of the sequence
+ */
+static void unfuseOpcodes(EcCodeGen *cg, int index)
+{
+    EcOpcode    *op;
+    int         i;
+
+    op = &cg->recent[index];
+    mprGetBufStart(cg->buf)[op->offset] = (char) op->opcode;
+    for (i = index + 1; i < index + op->fused && i < cg->numRecent; i++) {
+        cg->recent[i].covered = 0;
+    }
+    op->fused = 0;
+}
+
+
+/*
+    Return the fused op code for the recent instructions from "first" up to "last" followed by "code" if not -1
+ */
+static int matchOpcodes(EcCodeGen *cg, int first, int last, int code)
+{
+    int     opcodes[EJS_FUSED_MAX], count, i;
+
+    count = 0;
+    for (i = first; i < last; i++) {
+        opcodes[count++] = cg->recent[i].opcode;
+    }
+    if (code >= 0) {
+        opcodes[count++] = code;
+    }
+    return (count < 2) ? 0 : ejsGetFusedOpcode(opcodes, count);
+}
+
+
+/*
+    Rewrite the op code at recent[first] to the fused op code for a sequence of "count" instructions
+ */
+static void fuseOpcodes(EcCodeGen *cg, int first, int count, int fused)
+{
+    EcOpcode    *op;
+    int         i;
+
+    for (i = first + 1; i < first + count && i < cg->numRecent; i++) {
+        op = &cg->recent[i];
+        if (op->fused) {
+            unfuseOpcodes(cg, i);
+        }
+        op->covered = 1;
+    }
+    op = &cg->recent[first];
+    mprGetBufStart(cg->buf)[op->offset] = (char) fused;
+    op->fused = count;
+    op->covered = 0;
+}
+
+
+/*
+    Fuse the longest sequence of recent instructions that ends with this op code. Return true if the op code was
+    fused. A sequence may start inside a prior fused sequence only if it is longer. The prior sequence is then cut
+    short and fused again if possible. The fused op code replaces the first op code and the other instructions remain
+    in the code, so instruction lengths and jump targets are unchanged. A jump into the sequence runs the remaining
+    instructions normally.
+ */
+static int fuseRecentOpcodes(EcCodeGen *cg, int code)
+{
+    int     count, start, owner, fused, refused;
+
+    for (count = min(cg->numRecent, EJS_FUSED_MAX - 1); count > 0; count--) {
+        start = cg->numRecent - count;
+        owner = -1;
+        if (cg->recent[start].covered) {
+            for (owner = start - 1; owner >= 0 && cg->recent[owner].fused == 0; owner--) ;
+            if (owner < 0 || cg->recent[owner].fused > count) {
+                continue;
+            }
+        }
+        if ((fused = matchOpcodes(cg, start, cg->numRecent, code)) == 0) {
+            continue;
+        }
+        if (owner >= 0) {
+            unfuseOpcodes(cg, owner);
+            if ((refused = matchOpcodes(cg, owner, start, -1)) != 0) {
+                fuseOpcodes(cg, owner, start - owner, refused);
+            }
+        }
+        fuseOpcodes(cg, start, count + 1, fused);
+        return 1;
+    }
+    return 0;
+}
+
+
+/*
+    Encode an Ejscript instruction operation code. When optimizing, sequences of recently encoded instructions ending
+    with this op code are fused into one op code from the EJS_FUSED_OPCODES table that genbyte generates from the
+    op code sequence profile in src/test/bench/opcodes.profile. Loop and if conditions compile to a comparison followed
+    by BranchFalse.8, so only CompareLt and CompareGt are fused with their operand loads and the branch. They are the
+    comparisons of the profiled loop conditions. The other comparisons are too rare in the profile to earn an op code.
+    See EJS_FUSIBLE_OPCODES for the op codes that may be fused.
  */
 PUBLIC void ecEncodeOpcode(EcCompiler *cp, int code)
 {
+    EcCodeGen   *cg;
+    EcOpcode    *op;
+    int         offset, covered;
+
     assert(code < 240);
     assert(cp);
 
+    cg = cp->state->code;
+    offset = (int) mprGetBufLength(cg->buf);
+    if (cg->numRecent > 0 && cg->recent[cg->numRecent - 1].offset >= offset) {
+        cg->numRecent = 0;
+    }
+    covered = (cp->optimizeLevel > 0) ? fuseRecentOpcodes(cg, code) : 0;
+    if (cg->numRecent == EC_RECENT_OPCODES) {
+        memmove(cg->recent, &cg->recent[1], (EC_RECENT_OPCODES - 1) * sizeof(EcOpcode));
+        cg->numRecent--;
+    }
+    op = &cg->recent[cg->numRecent++];
+    op->offset = offset;
+    op->opcode = code;
+    op->fused = 0;
+    op->covered = covered;
     cp->lastOpcode = code;
     ecEncodeByte(cp, code);
 }
@@ -10050,6 +10050,9 @@ static void manageNode(EcNode *node, int flags)
         case N_ASSIGN_OP:
             break;
 
+        case N_ATTRIBUTES:
+            break;
+
         case N_BINARY_OP:
             break;
 
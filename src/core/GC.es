@@ -21,6 +21,15 @@ module ejs {
         native static function get enabled(): Boolean
         native static function set enabled(on: Boolean): Void
 
+        /**
+            Percentage the heap may grow by, relative to the memory that survived the last collection, before growing 
+            the heap will trigger the garbage collector. Larger values collect short-lived objects in bigger batches 
+            and mark long-lived objects less often, at the cost of a larger heap. Set to zero to collect whenever the 
+            heap must grow. Defaults to 100 or to the MPR_GC_GROWTH environment variable if defined.
+         */
+        native static function get growth(): Number
+        native static function set growth(percent: Number): Void
+
         /**
             The quota of work to perform before the GC will be invoked. Set to the number of work units that will 
             trigger the GC to run. This roughly corresponds to the number of allocated objects.
@@ -28,6 +37,34 @@ module ejs {
         native static function get newQuota(): Number
         native static function set newQuota(quota: Number): Void
 
+        /**
+            Size in bytes of the nursery for young objects. New objects are allocated from the nursery and a minor 
+            collection that only marks the objects reachable from the roots and from memory written since the last 
+            collection is run when the nursery is full. Surviving objects become old and are only collected by 
+            full collections. Set to zero to use full collections only. Reads as zero if the O/S cannot track 
+            writes to the heap. Defaults to 4MB or to the MPR_NURSERY environment variable if defined.
+         */
+        native static function get nursery(): Number
+        native static function set nursery(size: Number): Void
+
+        /**
+            Target maximum time in milliseconds that the garbage collector may pause other threads. The collector marks
+            memory and runs destructors while threads are paused and then frees memory while within the target. Any 
+            remaining memory is freed in the background after threads resume. Marking is not limited by the target.
+            Set to zero to free all memory before resuming. Defaults to 10 or to the MPR_GC_PAUSE environment 
+            variable if defined.
+         */
+        native static function get pauseTarget(): Number
+        native static function set pauseTarget(msec: Number): Void
+
+        /**
+            Garbage collector pause statistics. Returns an object with the number of collections ("count"), the 
+            last and longest pauses ("last", "max"), the median and 99th percentile pauses ("p50", "p99") and a 
+            pause histogram ("histogram"). Element N of the histogram is the number of pauses shorter than 2^N 
+            microseconds. Percentiles are taken from the histogram and are not exact. Times are in microseconds.
+         */
+        native static function get pauses(): Object
+
         /**
             Run the garbage collector and reclaim memory allocated to objects and properties that are no longer reachable. 
             When objects and properties are freed, any registered native destructors will be called. The run function will 
@@ -39,6 +76,53 @@ module ejs {
          */
         native static function run(deep: Boolean = false): void
 
+        /**
+            Garbage collector and allocation statistics. These are maintained at all times and are cheap to read, so 
+            they are suitable for monitoring production applications. Sizes are in bytes and times in microseconds.
+            @return An object with the following properties:
+            @option allocated Total bytes allocated.
+            @option collections Number of collections.
+            @option committed Heap bytes backed by physical memory when the last collection completed. Pages of large 
+                free spans are returned to the O/S and are not committed until reused. Compare with "used".
+            @option deferredSweeps Number of collections that freed memory after resuming other threads.
+            @option fragmentation Percentage of free heap memory outside the largest free block.
+            @option free Bytes in the heap free for reuse.
+            @option freed Total bytes freed by the collector.
+            @option heap Bytes currently allocated to the heap.
+            @option hugePages True if heap regions are backed by transparent huge pages. Set the MPR_HUGE_PAGES 
+                environment variable to 1 to enable.
+            @option history Array of the most recent collections, oldest first. Each element has the properties
+                "allocated" (bytes allocated since the prior collection), "freed" (bytes freed), "freedBlocks", "heap" 
+                (heap size after collecting), "live" (bytes in use after collecting), "mark" (marking time), 
+                "pause" (time other threads were paused), "sweep" (sweeping time while paused), "minor" (true for 
+                minor collections) and "promoted" (bytes of young objects that survived a minor collection).
+            @option largestFree Size of the largest free block.
+            @option live Bytes in use after the last collection.
+            @option maxPause Longest pause.
+            @option minorCollections Number of minor collections. See $nursery.
+            @option newCount Allocation work since the last collection. See $newQuota.
+            @option newQuota The $newQuota work quota.
+            @option nursery The $nursery size.
+            @option partitionCollections Number of collections of a single interpreter's heap partition. These pause 
+                only the threads of the interpreter. Set the EJS_PARTITIONS environment variable to "1" to create 
+                interpreters after the first in their own heap partition.
+            @option partitionPauseTime Total time threads have been paused for partition collections.
+            @option partitions Number of heap partitions.
+            @option pauseTime Total time other threads have been paused for collection.
+            @option promoted Total bytes of young objects that survived minor collections.
+            @option releases Number of free spans returned to the O/S.
+            @option used Bytes of the heap allocated to blocks in use or awaiting collection.
+         */
+        native static function get stats(): Object
+
+        /**
+            Number of threads used to mark memory during garbage collection. When set to more than one, helper threads 
+            mark in parallel with the collector to shorten the time other threads are paused. Set to zero to use one 
+            thread per CPU. Defaults to one or to the MPR_GC_THREADS environment variable if defined.
+         */
+        native static function get threads(): Number
+        native static function set threads(count: Number): Void
+
         /**
             Verify memory. In debug builds, this call verifies all memory blocks by checking a per-block signature.
             This is very slow, so call sparingly. In release builds, this call does nothing.
@@ -22,6 +22,33 @@ module ejs {
          */
         native static function get allocated(): Number
 
+        /**
+            Memory allocator statistics. Threads allocate small blocks from per-thread caches and only lock the shared
+            heap to refill their caches. These statistics measure how often threads contend for the heap.
+            @return An object with the following properties:
+            @option cacheFlushes Number of thread caches returned to the heap when their threads exited.
+            @option cacheHits Number of allocations served from thread caches or nursery chunks without locking the heap.
+            @option cacheRefills Number of times a thread cache was refilled or a nursery chunk taken from the heap.
+            @option cached Bytes currently held in thread caches.
+            @option caches Number of thread caches.
+            @option heapLockWaits Number of heap lock acquisitions that had to wait for another thread.
+            @option heapLocks Number of heap lock acquisitions.
+         */
+        native static function get allocator(): Object
+
+        /**
+            Analyze a heap snapshot written by $snapshot. The report lists each type of memory block with the bytes 
+            retained, the bytes used and the number of blocks. A block retains the memory that would be freed if the 
+            block were no longer referenced. The blocks that retain the most memory are listed last. If a baseline 
+            snapshot is given, the report instead lists the growth for each type since the baseline.
+            The ejsmod command will also analyze snapshots with "ejsmod --heap snapshot [baseline]".
+            @param snapshot Snapshot file to analyze
+            @param baseline Optional earlier snapshot to compare with
+            @return A string containing the report
+            @throws IOError if a snapshot cannot be read
+         */
+        native static function analyze(snapshot: Path, baseline: Path = null): String
+
         //  TODO -- should use observers not callbacks
         /**
             Memory redline callback. When the memory redline limit is exceeded, the callback will be invoked. 
@@ -34,6 +61,15 @@ module ejs {
         native static function get callback(): Void
         native static function set callback(fn: Function): Void
 
+        /**
+            Function body statistics for all interpreters. With "ejs --lazy", function byte code is not read from module
+            files until each function is first called. Functions that are never called never load their byte code.
+            @return An object with the following properties:
+            @option deferred Number of functions loaded without their byte code.
+            @option loaded Number of deferred functions that have since loaded their byte code.
+         */
+        native static function get functions(): Object
+
 
         /**
             Maximum amount of heap memory the application may use in bytes. This defines the upper limit for heap memory 
@@ -50,6 +86,40 @@ module ejs {
          */
         native static function set maximum(value: Number): Void
 
+        /**
+            Count the live objects of each type. This walks the entire heap and locks it while walking, so it should 
+            be called sparingly. Only types defined in the global scope of this interpreter are counted. Objects that 
+            are no longer reachable, but have not yet been freed by the garbage collector, may be included.
+            @return An object with a property for each type name. The property value is an object with "count" and 
+                "bytes" properties giving the number of objects and the bytes they occupy. Bytes do not include 
+                memory referenced by the objects.
+         */
+        native static function objects(): Object
+
+        /**
+            Report sampled allocations. Allocations are sampled while $profiling is set. The report has one line per
+            allocation site in the folded stack format used by flame graph tools. Each line lists the script functions 
+            on the stack, outermost first, separated by semicolons and followed by the type of object allocated in 
+            brackets, or the native function that allocated the memory. The line ends with the estimated bytes 
+            allocated at the site. Lines are ordered by decreasing bytes.
+            @param reset If true, discard the samples after reporting.
+            @return A string with the folded stack report. Returns an empty string if no samples have been taken.
+         */
+        native static function profile(reset: Boolean = false): String
+
+        /**
+            Allocation profiling sample interval in bytes. While non-zero, the script stack is recorded once for every 
+            interval bytes allocated by this interpreter's thread. Set to zero to stop sampling. Only one interpreter 
+            may profile allocations at a time. Smaller intervals give more accurate profiles at a higher cost.
+         */
+        native static function get profiling(): Number
+
+        /**
+            @duplicate Memory.profiling
+            @param interval Sample interval in bytes. Set to zero to stop profiling.
+         */
+        native static function set profiling(interval: Number): Void
+
         /**
             Memory redline value in bytes. When the memory redline limit is exceeded, the redline $callback will be invoked. 
             If no callback is defined, a MemoryError exception is thrown. The redline limit enables the application detect 
@@ -72,6 +142,16 @@ module ejs {
          */
         native static function get resident(): Number
 
+        /**
+            Write a snapshot of the reachable heap to a file. The snapshot records every memory block reachable from 
+            the garbage collector roots, its size, its type and its references to other blocks. Objects are 
+            labeled by type name and other blocks by the name of their native manager function. All threads are 
+            paused while the snapshot is written. Use $analyze to report on the snapshot.
+            @param path Snapshot filename
+            @throws IOError if the snapshot cannot be written
+         */
+        native static function snapshot(path: Path): Void
+
         /**
             System RAM. This is the total amount of RAM installed in the system in bytes.
          */
@@ -52,6 +52,10 @@ module ejs {
             @params options Options hash
             @options search Search path
             @options name Name of the Worker instance.
+            @options isolate If true, run the script in a separate process with its own heap and garbage collector. 
+                Collections in the worker then never pause the calling interpreter, and vice versa. Messages are
+                copied between the processes as JSON. An isolated worker requires a script and cannot be used with
+                clone(), eval(), load(), preeval() or preload().
             @spec WebWorker and ejs
          */
         native function Worker(script: Path? = null, options: Object? = null)
@@ -799,7 +799,7 @@ static bool compareArrayElement(Ejs *ejs, EjsObj *v1, EjsObj *v2)
         return ((EjsNumber*) v1)->value == ((EjsNumber*) v2)->value;
     }
     if (ejsIs(ejs, v1, String)) {
-        return (EjsString*) v1 == (EjsString*) v2;
+        return ejsMatchString((EjsString*) v1, (EjsString*) v2);
     }
     if (ejsIs(ejs, v1, Path)) {
         return smatch(((EjsPath*) v1)->value, ((EjsPath*) v2)->value);
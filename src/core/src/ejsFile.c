@@ -581,7 +581,7 @@ static EjsString *readFileString(Ejs *ejs, EjsFile *fp, int argc, EjsObj **argv)
         ejsThrowIOError(ejs, "Cannot read from file: %s", fp->path);
         return 0;
     }
-    return ejsInternString(result);
+    return result;
 }
 
 
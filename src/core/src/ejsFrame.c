@@ -15,6 +15,11 @@ static void manageFrame(EjsFrame *frame, int flags)
     assert(frame);
     if (frame) {
         if (flags & MPR_MANAGE_MARK) {
+            if (frame->pooled) {
+                /* Free frames only link to the next free frame. Their slots are stale */
+                mprMark(frame->caller);
+                return;
+            }
             ejsManageFunction((EjsFunction*) frame, flags);
             mprMark(frame->orig);
             mprMark(frame->caller);
@@ -24,19 +29,48 @@ static void manageFrame(EjsFrame *frame, int flags)
 }
 
 
+/*
+    Return the pool size class for a frame with the given number of slots. Returns -1 if too big to pool.
+ */
+static int frameClass(int size)
+{
+    int     fclass, capacity;
+
+    for (fclass = 0, capacity = EJS_MIN_FRAME_SLOTS; fclass < EJS_FRAME_CLASSES; fclass++, capacity <<= 1) {
+        if (size <= capacity) {
+            return fclass;
+        }
+    }
+    return -1;
+}
+
+
+/*
+    Allocate a frame with room for numProp slots. Reuse a free frame of the same size class if one is available.
+ */
 static EjsFrame *allocFrame(Ejs *ejs, int numProp)
 {
     EjsObj      *obj;
+    EjsFrame    *frame;
     ssize       size;
+    int         fclass;
 
     assert(ejs);
 
-    size = sizeof(EjsFrame) + sizeof(EjsProperties) + numProp * sizeof(EjsSlot);
-    if ((obj = mprAllocBlock(size, MPR_ALLOC_MANAGER | MPR_ALLOC_ZERO)) == 0) {
-        ejsThrowMemoryError(ejs);
-        return 0;
+    if ((fclass = frameClass(numProp)) >= 0 && (frame = ejs->frames[fclass]) != 0) {
+        assert(frame->pooled);
+        ejs->frames[fclass] = frame->caller;
+        ejs->numFrames[fclass]--;
+        obj = (EjsObj*) frame;
+        memset(obj, 0, sizeof(EjsFrame) + sizeof(EjsProperties));
+    } else {
+        size = sizeof(EjsFrame) + sizeof(EjsProperties) + numProp * sizeof(EjsSlot);
+        if ((obj = mprAllocBlock(size, MPR_ALLOC_MANAGER | MPR_ALLOC_ZERO)) == 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+        mprSetManager(obj, (MprManager) manageFrame);
     }
-    mprSetManager(obj, (MprManager) manageFrame);
     SET_TYPE(obj, ESV(Frame));
     ejsSetMemRef(obj);
     return (EjsFrame*) obj;
@@ -69,13 +103,20 @@ PUBLIC EjsFrame *ejsCreateFrame(Ejs *ejs, EjsFunction *fun, EjsObj *thisObj, int
 {
     EjsFrame    *frame;
     EjsPot      *obj, *activation;
-    int         numProp, size, i;
+    int         numProp, size, fclass, i;
 
+    if (fun->body.code->byteCode == 0 && ejsLoadFunctionCode(ejs, fun) < 0) {
+        return 0;
+    }
     activation = fun->activation;
     numProp = (activation) ? activation->numProp : 0;
     size = max(numProp, EJS_MIN_FRAME_SLOTS);
-
-    frame = allocFrame(ejs, size);
+    if ((fclass = frameClass(size)) >= 0) {
+        size = EJS_MIN_FRAME_SLOTS << fclass;
+    }
+    if ((frame = allocFrame(ejs, size)) == 0) {
+        return 0;
+    }
     obj = (EjsPot*) frame;
     obj->properties = (EjsProperties*) &(((char*) obj)[sizeof(EjsFrame)]);
     obj->properties->size = size;
@@ -139,6 +180,35 @@ PUBLIC EjsFrame *ejsCreateFrame(Ejs *ejs, EjsFunction *fun, EjsObj *thisObj, int
 }
 
 
+/*
+    Release a frame when its function returns. The frame is retained on a free list for reuse by the next call unless it
+    has been captured by a closure or scope, or its properties have been reallocated.
+ */
+PUBLIC void ejsFreeFrame(Ejs *ejs, EjsFrame *frame)
+{
+    EjsPot      *obj;
+    int         fclass;
+
+    if (frame == 0 || frame->captured || frame->pooled) {
+        return;
+    }
+    obj = (EjsPot*) frame;
+    if (obj->properties != (EjsProperties*) &(((char*) obj)[sizeof(EjsFrame)])) {
+        return;
+    }
+    if ((fclass = frameClass(obj->properties->size)) < 0 || ejs->numFrames[fclass] >= EJS_FRAME_POOL_MAX) {
+        return;
+    }
+    if ((EJS_MIN_FRAME_SLOTS << fclass) != obj->properties->size) {
+        return;
+    }
+    frame->pooled = 1;
+    frame->caller = ejs->frames[fclass];
+    ejs->frames[fclass] = frame;
+    ejs->numFrames[fclass]++;
+}
+
+
 PUBLIC void ejsCreateFrameType(Ejs *ejs)
 {
     EjsType     *type;
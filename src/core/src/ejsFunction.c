@@ -369,6 +369,12 @@ static void manageCode(EjsCode *code, int flags)
         assert(code->debug == 0 || code->debug->magic == EJS_DEBUG_MAGIC);        
         mprMark(code->module);
         mprMark(code->debug);
+        mprMark(code->cache);
+        mprMark(code->jit);
+        if (code->codeOffset && code->module && !code->module->map) {
+            /* Byte code loaded on first call is allocated separately. Mapped modules use the code in place */
+            mprMark(code->byteCode);
+        }
         if (code->handlers) {
             mprMark(code->handlers);
             for (i = 0; i < code->numHandlers; i++) {
@@ -383,15 +389,21 @@ static void manageCode(EjsCode *code, int flags)
 PUBLIC EjsCode *ejsCreateCode(Ejs *ejs, EjsFunction *fun, EjsModule *module, cuchar *byteCode, ssize len, 
     EjsDebug *debug)
 {
-    EjsCode     *code;
+    EjsCode         *code;
+    EjsModuleMap    *map;
+    int             inplace;
 
     assert(fun);
     assert(module);
-    assert(byteCode);
     assert(len >= 0);
     assert(debug == 0 || debug->magic == EJS_DEBUG_MAGIC);
 
-    if ((code = mprAllocBlock(sizeof(EjsCode) + len, MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
+    /*
+        Deferred byte code (null) is loaded by ejsLoadFunctionCode when the function is first called
+     */
+    map = module->map;
+    inplace = byteCode == 0 || (map && byteCode >= map->data && &byteCode[len] <= &map->data[map->size]);
+    if ((code = mprAllocBlock(sizeof(EjsCode) + (inplace ? 0 : len), MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
         return NULL;
     }
     mprSetManager(code, (MprManager) manageCode);
@@ -399,7 +411,13 @@ PUBLIC EjsCode *ejsCreateCode(Ejs *ejs, EjsFunction *fun, EjsModule *module, cuc
     code->module = module;
     code->debug = debug;
     code->magic = EJS_CODE_MAGIC;
-    memcpy(code->byteCode, byteCode, len);
+    if (inplace) {
+        /* Use the code in place. The module keeps the mapping */
+        code->byteCode = (uchar*) byteCode;
+    } else {
+        code->byteCode = (uchar*) &code[1];
+        memcpy(code->byteCode, byteCode, len);
+    }
     return code;
 }
 
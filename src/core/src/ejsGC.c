@@ -29,6 +29,63 @@ static EjsObj *gc_set_enabled(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv
 }
 
 
+/*
+    native static function get pauseTarget(): Number
+ */
+static EjsNumber *gc_pauseTarget(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, mprGetMpr()->heap->pauseTarget);
+}
+
+
+/*
+    native static function set pauseTarget(msec: Number): Void
+ */
+static EjsObj *gc_set_pauseTarget(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    int     msec;
+
+    assert(argc == 1 && ejsIs(ejs, argv[0], Number));
+    msec = ejsGetInt(ejs, argv[0]);
+
+    if (msec < 0) {
+        ejsThrowArgError(ejs, "Bad pause target. Must be >= 0");
+        return 0;
+    }
+    mprSetGCPauseTarget(msec);
+    return 0;
+}
+
+
+/*
+    native static function get pauses(): Object
+ */
+static EjsObj *gc_pauses(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    MprMemStats     *stats;
+    EjsArray        *histogram;
+    EjsPot          *result;
+    int             i, last;
+
+    stats = mprGetMemStats();
+    for (last = MPR_GC_PAUSE_BUCKETS - 1; last > 0 && stats->pauses[last] == 0; last--) ;
+    if ((histogram = ejsCreateArray(ejs, last + 1)) == 0) {
+        return 0;
+    }
+    for (i = 0; i <= last; i++) {
+        ejsSetProperty(ejs, histogram, i, ejsCreateNumber(ejs, (MprNumber) stats->pauses[i]));
+    }
+    result = ejsCreatePot(ejs, ESV(Object), 0);
+    ejsSetPropertyByName(ejs, result, EN("count"), ejsCreateNumber(ejs, (MprNumber) stats->collections));
+    ejsSetPropertyByName(ejs, result, EN("last"), ejsCreateNumber(ejs, (MprNumber) stats->lastPause));
+    ejsSetPropertyByName(ejs, result, EN("max"), ejsCreateNumber(ejs, (MprNumber) stats->maxPause));
+    ejsSetPropertyByName(ejs, result, EN("p50"), ejsCreateNumber(ejs, (MprNumber) mprGetGCPause(50)));
+    ejsSetPropertyByName(ejs, result, EN("p99"), ejsCreateNumber(ejs, (MprNumber) mprGetGCPause(99)));
+    ejsSetPropertyByName(ejs, result, EN("histogram"), histogram);
+    return (EjsObj*) result;
+}
+
+
 /*
     run(deep: Boolean = false)
     TODO -- change args to be a string "check", "all"
@@ -47,6 +104,34 @@ static EjsObj *gc_run(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
 }
 
 
+/*
+    native static function get growth(): Number
+ */
+static EjsNumber *gc_growth(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, mprGetMpr()->heap->gcGrowth);
+}
+
+
+/*
+    native static function set growth(percent: Number): Void
+ */
+static EjsObj *gc_set_growth(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    int     percent;
+
+    assert(argc == 1 && ejsIs(ejs, argv[0], Number));
+    percent = ejsGetInt(ejs, argv[0]);
+
+    if (percent < 0 || percent > MPR_GC_MAX_GROWTH) {
+        ejsThrowArgError(ejs, "Bad growth percentage. Must be between 0 and %d", MPR_GC_MAX_GROWTH);
+        return 0;
+    }
+    mprSetGCGrowth(percent);
+    return 0;
+}
+
+
 /*
     native static function get newQuota(): Number
  */
@@ -75,6 +160,126 @@ static EjsObj *gc_set_newQuota(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **arg
 }
 
 
+/*
+    native static function get nursery(): Number
+ */
+static EjsNumber *gc_nursery(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, (MprNumber) mprGetMpr()->heap->stats.nursery);
+}
+
+
+/*
+    native static function set nursery(size: Number): Void
+ */
+static EjsObj *gc_set_nursery(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    ssize   size;
+
+    assert(argc == 1 && ejsIs(ejs, argv[0], Number));
+    size = (ssize) ejsGetNumber(ejs, argv[0]);
+
+    if (size < 0) {
+        ejsThrowArgError(ejs, "Bad nursery size. Must be >= 0");
+        return 0;
+    }
+    mprSetNurserySize(size);
+    return 0;
+}
+
+
+/*
+    native static function get stats(): Object
+ */
+static EjsObj *gc_stats(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    MprMemStats     *stats;
+    MprHeap         *heap;
+    MprGCRecord     *rp;
+    EjsArray        *history;
+    EjsObj          *obj, *record;
+    uint64          first, n;
+
+    heap = mprGetMpr()->heap;
+    stats = mprGetMemStats();
+    first = (stats->collections > MPR_GC_HISTORY) ? (stats->collections - MPR_GC_HISTORY) : 0;
+    if ((history = ejsCreateArray(ejs, 0)) == 0) {
+        return 0;
+    }
+    for (n = first; n < stats->collections; n++) {
+        rp = &stats->history[n % MPR_GC_HISTORY];
+        record = ejsCreateEmptyPot(ejs);
+        ejsSetPropertyByName(ejs, record, EN("allocated"), ejsCreateNumber(ejs, (MprNumber) rp->allocated));
+        ejsSetPropertyByName(ejs, record, EN("freed"), ejsCreateNumber(ejs, (MprNumber) rp->freed));
+        ejsSetPropertyByName(ejs, record, EN("freedBlocks"), ejsCreateNumber(ejs, (MprNumber) rp->freedBlocks));
+        ejsSetPropertyByName(ejs, record, EN("heap"), ejsCreateNumber(ejs, (MprNumber) rp->heap));
+        ejsSetPropertyByName(ejs, record, EN("live"), ejsCreateNumber(ejs, (MprNumber) rp->live));
+        ejsSetPropertyByName(ejs, record, EN("mark"), ejsCreateNumber(ejs, (MprNumber) rp->markTime));
+        ejsSetPropertyByName(ejs, record, EN("minor"), ejsCreateBoolean(ejs, rp->minor));
+        ejsSetPropertyByName(ejs, record, EN("pause"), ejsCreateNumber(ejs, (MprNumber) rp->pause));
+        ejsSetPropertyByName(ejs, record, EN("promoted"), ejsCreateNumber(ejs, (MprNumber) rp->promoted));
+        ejsSetPropertyByName(ejs, record, EN("sweep"), ejsCreateNumber(ejs, (MprNumber) rp->sweepTime));
+        ejsSetProperty(ejs, history, (int) (n - first), record);
+    }
+    obj = ejsCreateEmptyPot(ejs);
+    ejsSetPropertyByName(ejs, obj, EN("allocated"), ejsCreateNumber(ejs, (MprNumber) stats->totalAllocated));
+    ejsSetPropertyByName(ejs, obj, EN("collections"), ejsCreateNumber(ejs, (MprNumber) stats->collections));
+    ejsSetPropertyByName(ejs, obj, EN("committed"), ejsCreateNumber(ejs, (MprNumber) stats->bytesCommitted));
+    ejsSetPropertyByName(ejs, obj, EN("deferredSweeps"), ejsCreateNumber(ejs, (MprNumber) stats->deferredSweeps));
+    ejsSetPropertyByName(ejs, obj, EN("fragmentation"), ejsCreateNumber(ejs, (MprNumber) (stats->bytesFree ? 
+        (100 - (MprNumber) stats->largestFree * 100 / stats->bytesFree) : 0)));
+    ejsSetPropertyByName(ejs, obj, EN("free"), ejsCreateNumber(ejs, (MprNumber) stats->bytesFree));
+    ejsSetPropertyByName(ejs, obj, EN("freed"), ejsCreateNumber(ejs, (MprNumber) stats->totalFreed));
+    ejsSetPropertyByName(ejs, obj, EN("heap"), ejsCreateNumber(ejs, (MprNumber) stats->bytesAllocated));
+    ejsSetPropertyByName(ejs, obj, EN("history"), history);
+    ejsSetPropertyByName(ejs, obj, EN("hugePages"), ejsCreateBoolean(ejs, stats->hugePages));
+    ejsSetPropertyByName(ejs, obj, EN("largestFree"), ejsCreateNumber(ejs, (MprNumber) stats->largestFree));
+    ejsSetPropertyByName(ejs, obj, EN("live"), ejsCreateNumber(ejs, (MprNumber) stats->liveBytes));
+    ejsSetPropertyByName(ejs, obj, EN("maxPause"), ejsCreateNumber(ejs, (MprNumber) stats->maxPause));
+    ejsSetPropertyByName(ejs, obj, EN("minorCollections"), ejsCreateNumber(ejs, (MprNumber) stats->minorCollections));
+    ejsSetPropertyByName(ejs, obj, EN("newCount"), ejsCreateNumber(ejs, (MprNumber) heap->newCount));
+    ejsSetPropertyByName(ejs, obj, EN("newQuota"), ejsCreateNumber(ejs, (MprNumber) heap->newQuota));
+    ejsSetPropertyByName(ejs, obj, EN("nursery"), ejsCreateNumber(ejs, (MprNumber) stats->nursery));
+    ejsSetPropertyByName(ejs, obj, EN("partitionCollections"), 
+        ejsCreateNumber(ejs, (MprNumber) stats->partitionCollections));
+    ejsSetPropertyByName(ejs, obj, EN("partitionPauseTime"), ejsCreateNumber(ejs, (MprNumber) stats->partitionPauseTime));
+    ejsSetPropertyByName(ejs, obj, EN("partitions"), ejsCreateNumber(ejs, (MprNumber) stats->partitions));
+    ejsSetPropertyByName(ejs, obj, EN("pauseTime"), ejsCreateNumber(ejs, (MprNumber) stats->pauseTime));
+    ejsSetPropertyByName(ejs, obj, EN("promoted"), ejsCreateNumber(ejs, (MprNumber) stats->promoted));
+    ejsSetPropertyByName(ejs, obj, EN("releases"), ejsCreateNumber(ejs, (MprNumber) stats->releases));
+    ejsSetPropertyByName(ejs, obj, EN("used"), ejsCreateNumber(ejs, (MprNumber) (stats->bytesAllocated - stats->bytesFree)));
+    return obj;
+}
+
+
+/*
+    native static function get threads(): Number
+ */
+static EjsNumber *gc_threads(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, mprGetMpr()->heap->gcThreads);
+}
+
+
+/*
+    native static function set threads(count: Number): Void
+ */
+static EjsObj *gc_set_threads(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    int     count;
+
+    assert(argc == 1 && ejsIs(ejs, argv[0], Number));
+    count = ejsGetInt(ejs, argv[0]);
+
+    if (count < 0 || count > MPR_GC_MAX_THREADS) {
+        ejsThrowArgError(ejs, "Bad thread count. Must be between 0 and %d", MPR_GC_MAX_THREADS);
+        return 0;
+    }
+    mprSetGCThreads(count);
+    return 0;
+}
+
+
 /*
     verify(): Void
  */
@@ -93,8 +298,14 @@ PUBLIC void ejsConfigureGCType(Ejs *ejs)
         return;
     }
     ejsBindAccess(ejs, type, ES_GC_enabled, gc_enabled, gc_set_enabled);
+    ejsBindAccess(ejs, type, ES_GC_growth, gc_growth, gc_set_growth);
     ejsBindAccess(ejs, type, ES_GC_newQuota, gc_newQuota, gc_set_newQuota);
+    ejsBindAccess(ejs, type, ES_GC_nursery, gc_nursery, gc_set_nursery);
+    ejsBindAccess(ejs, type, ES_GC_pauseTarget, gc_pauseTarget, gc_set_pauseTarget);
+    ejsBindAccess(ejs, type, ES_GC_pauses, gc_pauses, 0);
     ejsBindMethod(ejs, type, ES_GC_run, gc_run);
+    ejsBindMethod(ejs, type, ES_GC_stats, gc_stats);
+    ejsBindAccess(ejs, type, ES_GC_threads, gc_threads, gc_set_threads);
     ejsBindMethod(ejs, type, ES_GC_verify, gc_verify);
 }
 
@@ -7,6 +7,92 @@
 
 #include    "ejs.h"
 
+/************************************ Locals **********************************/
+
+typedef struct ObjectCount {
+    EjsType     *type;
+    cchar       *name;
+    MprNumber   count;
+    MprNumber   bytes;
+} ObjectCount;
+
+typedef struct ObjectCounts {
+    ObjectCount *counts;
+    int         length;
+} ObjectCounts;
+
+/*
+    Maximum script frames recorded for an allocation sample
+ */
+#define EJS_PROFILE_DEPTH   64
+
+typedef struct AllocFrame {
+    EjsFunction     *fun;
+    uchar           *pc;
+} AllocFrame;
+
+/*
+    Allocation site. Samples with the same script stack and leaf are merged.
+ */
+typedef struct AllocSite {
+    MprNumber       count;              /* Samples at this site */
+    MprNumber       bytes;              /* Bytes allocated represented by the samples */
+    EjsType         *type;              /* Type of the sampled object */
+    cvoid           *caller;            /* Native caller of the allocator if not an object */
+    int             depth;              /* Count of frames */
+    AllocFrame      frames[ARRAY_FLEX]; /* Script frames, outermost first */
+} AllocSite;
+
+typedef struct EjsAllocProfile {
+    MprHash         *sites;             /* Allocation sites by stack */
+    AllocSite       *pending;           /* Sample awaiting the type of its object */
+    MprOsThread     thread;             /* Thread being sampled */
+    ssize           interval;           /* Bytes between samples */
+} EjsAllocProfile;
+
+/*
+    Line of the folded stack report
+ */
+typedef struct AllocLine {
+    char            *stack;
+    MprNumber       bytes;
+} AllocLine;
+
+/*
+    Heap snapshot graph read from a snapshot file. Node zero is the root set.
+ */
+typedef struct HeapGraph {
+    int             nodeCount;
+    int             edgeCount;
+    int             labelCount;
+    int             reachable;          /* Count of nodes reachable from the root set */
+    MprNumber       bytes;              /* Total size of all nodes */
+    MprNumber       *sizes;             /* Node sizes */
+    MprNumber       *retained;          /* Bytes retained by each node */
+    int             *labels;            /* Node labels */
+    int             *starts;            /* Index of the first edge of each node */
+    int             *edges;             /* Edges as node indexes */
+    int             *idom;              /* Immediate dominator of each node */
+    char            **names;            /* Label names */
+} HeapGraph;
+
+typedef struct HeapLabel {
+    cchar           *name;
+    MprNumber       count;
+    MprNumber       bytes;
+    MprNumber       retained;
+    MprNumber       priorCount;         /* Baseline totals when comparing snapshots */
+    MprNumber       priorBytes;
+    MprNumber       priorRetained;
+} HeapLabel;
+
+/*
+    Number of blocks reported as retaining the most memory
+ */
+#define EJS_SNAPSHOT_TOP    10
+
+static EjsAllocProfile *createAllocProfile(Ejs *ejs);
+
 /*********************************** Methods *********************************/
 /*
     native static function get allocated(): Number
@@ -20,6 +106,43 @@ static EjsNumber *getAllocatedMemory(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj
 }
 
 
+/*
+    native static function get allocator(): Object
+ */
+static EjsObj *getAllocatorStats(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    MprMemStats     *mem;
+    EjsObj          *obj;
+
+    mem = mprGetMemStats(ejs);
+    obj = ejsCreateEmptyPot(ejs);
+    ejsSetPropertyByName(ejs, obj, EN("cacheFlushes"), ejsCreateNumber(ejs, (MprNumber) mem->cacheFlushes));
+    ejsSetPropertyByName(ejs, obj, EN("cacheHits"), ejsCreateNumber(ejs, (MprNumber) mem->cacheHits));
+    ejsSetPropertyByName(ejs, obj, EN("cacheRefills"), ejsCreateNumber(ejs, (MprNumber) mem->cacheRefills));
+    ejsSetPropertyByName(ejs, obj, EN("cached"), ejsCreateNumber(ejs, (MprNumber) mem->bytesCached));
+    ejsSetPropertyByName(ejs, obj, EN("caches"), ejsCreateNumber(ejs, (MprNumber) mem->caches));
+    ejsSetPropertyByName(ejs, obj, EN("heapLockWaits"), ejsCreateNumber(ejs, (MprNumber) mem->heapLockWaits));
+    ejsSetPropertyByName(ejs, obj, EN("heapLocks"), ejsCreateNumber(ejs, (MprNumber) mem->heapLocks));
+    return obj;
+}
+
+
+/*
+    native static function get functions(): Object
+ */
+static EjsObj *getFunctionStats(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    EjsService      *sp;
+    EjsObj          *obj;
+
+    sp = ejs->service;
+    obj = ejsCreateEmptyPot(ejs);
+    ejsSetPropertyByName(ejs, obj, EN("deferred"), ejsCreateNumber(ejs, (MprNumber) sp->deferredCode));
+    ejsSetPropertyByName(ejs, obj, EN("loaded"), ejsCreateNumber(ejs, (MprNumber) sp->loadedCode));
+    return obj;
+}
+
+
 #if FUTURE
 /*
     native static function callback(fn: Function): Void
@@ -65,6 +188,791 @@ static EjsObj *setMaxMemory(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
 }
 
 
+static int compareObjectCount(cvoid *a, cvoid *b)
+{
+    EjsType     *ta, *tb;
+
+    ta = ((ObjectCount*) a)->type;
+    tb = ((ObjectCount*) b)->type;
+    return (ta < tb) ? -1 : ((ta > tb) ? 1 : 0);
+}
+
+
+/*
+    Heap walker. Called with the heap locked so must not allocate. The first word of a block is only taken as a type 
+    if it matches a known type and the block uses the type's manager.
+ */
+static void countObject(void *ptr, ssize size, MprManager manager, void *data)
+{
+    ObjectCounts    *oc;
+    ObjectCount     key, *cp;
+
+    if (manager == 0) {
+        return;
+    }
+    oc = data;
+    key.type = TYPE(ptr);
+    if ((cp = bsearch(&key, oc->counts, oc->length, sizeof(ObjectCount), compareObjectCount)) != 0 && 
+            cp->type->manager == manager) {
+        cp->count++;
+        cp->bytes += size;
+    }
+}
+
+
+/*
+    Get the global types sorted by address
+ */
+static int getObjectTypes(Ejs *ejs, ObjectCounts *oc)
+{
+    EjsType     *type;
+    int         i, count;
+
+    count = ejsGetLength(ejs, ejs->global);
+    if ((oc->counts = mprAllocZeroed(count * sizeof(ObjectCount))) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    for (oc->length = i = 0; i < count; i++) {
+        type = ejsGetProperty(ejs, ejs->global, i);
+        if (ejsIsType(ejs, type) && type->manager) {
+            oc->counts[oc->length++].type = type;
+        }
+    }
+    qsort(oc->counts, oc->length, sizeof(ObjectCount), compareObjectCount);
+    return 0;
+}
+
+
+/*
+    native static function objects(): Object
+ */
+static EjsObj *getObjectCounts(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    ObjectCounts    oc;
+    ObjectCount     *cp;
+    EjsObj          *result, *entry;
+    EjsName         qname;
+    int             i;
+
+    if (getObjectTypes(ejs, &oc) < 0) {
+        return 0;
+    }
+    mprWalkMem(countObject, &oc);
+
+    result = ejsCreateEmptyPot(ejs);
+    for (i = 0; i < oc.length; i++) {
+        cp = &oc.counts[i];
+        if (cp->count == 0) {
+            continue;
+        }
+        qname = WEN(cp->type->qname.name->value);
+        if ((entry = ejsGetPropertyByName(ejs, result, qname)) != 0) {
+            /* Same type name in different namespaces */
+            cp->count += ejsGetNumber(ejs, ejsGetPropertyByName(ejs, entry, EN("count")));
+            cp->bytes += ejsGetNumber(ejs, ejsGetPropertyByName(ejs, entry, EN("bytes")));
+        } else {
+            entry = ejsCreateEmptyPot(ejs);
+            ejsSetPropertyByName(ejs, result, qname, entry);
+        }
+        ejsSetPropertyByName(ejs, entry, EN("bytes"), ejsCreateNumber(ejs, cp->bytes));
+        ejsSetPropertyByName(ejs, entry, EN("count"), ejsCreateNumber(ejs, cp->count));
+    }
+    return result;
+}
+
+
+static void manageAllocSite(AllocSite *site, int flags)
+{
+    int     i;
+
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(site->type);
+        for (i = 0; i < site->depth; i++) {
+            mprMark(site->frames[i].fun);
+        }
+    }
+}
+
+
+static void manageAllocProfile(EjsAllocProfile *profile, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(profile->sites);
+        mprMark(profile->pending);
+    }
+}
+
+
+static void manageAllocLine(AllocLine *line, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(line->stack);
+    }
+}
+
+
+static EjsAllocProfile *createAllocProfile(Ejs *ejs)
+{
+    EjsAllocProfile     *profile;
+
+    if ((profile = mprAllocObj(EjsAllocProfile, manageAllocProfile)) == 0) {
+        return 0;
+    }
+    if ((profile->sites = mprCreateHash(0, 0)) == 0) {
+        return 0;
+    }
+    return profile;
+}
+
+
+/*
+    MPR allocation sampler. Record the script stack of the interpreter profiling allocations. The sample is committed
+    once the type of the allocated object is known. Allocations here are not themselves sampled.
+ */
+static void sampleAllocation(void *ptr, ssize size, ssize weight, cvoid *caller)
+{
+    EjsService      *sp;
+    EjsAllocProfile *profile;
+    EjsState        *state;
+    EjsFrame        *fp;
+    AllocSite       *site;
+    Ejs             *ejs;
+    int             depth;
+
+    if ((sp = MPR->ejsService) == 0 || (ejs = sp->profiler) == 0 || (profile = ejs->allocProfile) == 0) {
+        return;
+    }
+    if (profile->thread != mprGetCurrentOsThread()) {
+        return;
+    }
+    if (profile->pending) {
+        ejsCommitAllocSample(ejs, NULL);
+    }
+    depth = 0;
+    for (state = ejs->state; state && depth < EJS_PROFILE_DEPTH; state = state->prev) {
+        for (fp = state->fp; fp && fp->orig && depth < EJS_PROFILE_DEPTH; fp = fp->caller) {
+            depth++;
+        }
+    }
+    if ((site = mprAllocBlock(sizeof(AllocSite) + depth * sizeof(AllocFrame), MPR_ALLOC_MANAGER | MPR_ALLOC_ZERO)) == 0) {
+        return;
+    }
+    mprSetManager(site, (MprManager) manageAllocSite);
+    site->count = 1;
+    site->bytes = (MprNumber) weight;
+    site->caller = caller;
+    site->depth = depth;
+    for (state = ejs->state; state && depth > 0; state = state->prev) {
+        for (fp = state->fp; fp && fp->orig && depth > 0; fp = fp->caller) {
+            depth--;
+            site->frames[depth].fun = fp->orig;
+            site->frames[depth].pc = fp->pc;
+        }
+    }
+    profile->pending = site;
+    ejs->allocSample = ptr;
+}
+
+
+/*
+    Commit the pending allocation sample. The type is NULL if the sampled block was not an object and the sample is 
+    then attributed to the native allocator caller.
+ */
+PUBLIC void ejsCommitAllocSample(Ejs *ejs, EjsType *type)
+{
+    EjsAllocProfile *profile;
+    AllocSite       *site, *prior;
+    char            key[(EJS_PROFILE_DEPTH * 2 + 1) * 20], *cp;
+    int             i;
+
+    ejs->allocSample = 0;
+    if ((profile = ejs->allocProfile) == 0 || (site = profile->pending) == 0) {
+        return;
+    }
+    profile->pending = 0;
+    site->type = type;
+
+    /*
+        The key is built on the stack. Allocating here could trigger further samples
+     */
+    cp = key;
+    for (i = 0; i < site->depth; i++) {
+        fmt(cp, &key[sizeof(key)] - cp, "%p:%p;", site->frames[i].fun, site->frames[i].pc);
+        cp += slen(cp);
+    }
+    fmt(cp, &key[sizeof(key)] - cp, "%p", type ? (cvoid*) type : site->caller);
+    if ((prior = mprLookupKey(profile->sites, key)) != 0) {
+        prior->count += site->count;
+        prior->bytes += site->bytes;
+    } else {
+        mprAddKey(profile->sites, key, site);
+    }
+}
+
+
+/*
+    Format a site as a folded stack: "outer (file:line);inner (file:line);leaf"
+ */
+static char *formatAllocSite(Ejs *ejs, AllocSite *site)
+{
+    MprBuf      *buf;
+    AllocFrame  *frame;
+    cchar       *name;
+    char        *path;
+    int         i, line;
+
+    buf = mprCreateBuf(0, 0);
+    for (i = 0; i < site->depth; i++) {
+        frame = &site->frames[i];
+        mprPutStringToBuf(buf, ejsToMulti(ejs, frame->fun->name));
+        if (ejsGetDebugInfo(ejs, frame->fun, frame->pc, &path, &line, NULL) >= 0) {
+            mprPutToBuf(buf, " (%s:%d)", mprGetPathBase(path), line);
+        }
+        mprPutCharToBuf(buf, ';');
+    }
+    if (site->type) {
+        mprPutToBuf(buf, "[%s]", ejsToMulti(ejs, site->type->qname.name));
+    } else if ((name = mprGetNativeSymbol(site->caller)) != 0) {
+        mprPutStringToBuf(buf, name);
+    } else {
+        mprPutStringToBuf(buf, "[native]");
+    }
+    mprAddNullToBuf(buf);
+    return mprGetBufStart(buf);
+}
+
+
+static int compareAllocLine(cvoid *a, cvoid *b, void *ctx)
+{
+    MprNumber   ba, bb;
+
+    ba = (*(AllocLine**) a)->bytes;
+    bb = (*(AllocLine**) b)->bytes;
+    return (ba < bb) ? 1 : ((ba > bb) ? -1 : 0);
+}
+
+
+/*
+    native static function profile(reset: Boolean = false): String
+ */
+static EjsString *getAllocProfile(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    EjsAllocProfile *profile;
+    MprHash         *lines;
+    MprList         *list;
+    MprKey          *kp;
+    MprBuf          *buf;
+    AllocSite       *site;
+    AllocLine       *line;
+    char            *stack;
+    int             next;
+
+    if ((profile = ejs->allocProfile) == 0) {
+        return ESV(empty);
+    }
+    if (profile->pending) {
+        ejsCommitAllocSample(ejs, NULL);
+    }
+    /*
+        Sites differing only in program counters or native call addresses within the same line and function are merged
+     */
+    lines = mprCreateHash(0, 0);
+    list = mprCreateList(0, 0);
+    for (ITERATE_KEY_DATA(profile->sites, kp, site)) {
+        stack = formatAllocSite(ejs, site);
+        if ((line = mprLookupKey(lines, stack)) == 0) {
+            line = mprAllocObj(AllocLine, manageAllocLine);
+            line->stack = stack;
+            mprAddKey(lines, stack, line);
+            mprAddItem(list, line);
+        }
+        line->bytes += site->bytes;
+    }
+    mprSortList(list, compareAllocLine, 0);
+    buf = mprCreateBuf(0, 0);
+    for (ITERATE_ITEMS(list, line, next)) {
+        mprPutToBuf(buf, "%s %Ld\n", line->stack, (int64) line->bytes);
+    }
+    if (argc > 0 && argv[0] == ESV(true)) {
+        profile->sites = mprCreateHash(0, 0);
+    }
+    return ejsCreateStringFromBytes(ejs, mprGetBufStart(buf), mprGetBufLength(buf));
+}
+
+
+/*
+    native static function get profiling(): Number
+ */
+static EjsNumber *getProfiling(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    if (ejs->service->profiler != ejs) {
+        return ESV(zero);
+    }
+    return ejsCreateNumber(ejs, (MprNumber) ejs->allocProfile->interval);
+}
+
+
+/*
+    native static function set profiling(interval: Number): Void
+ */
+static EjsObj *setProfiling(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    EjsService      *sp;
+    ssize           interval;
+
+    sp = ejs->service;
+    interval = (ssize) ejsGetNumber(ejs, argv[0]);
+    if (interval < 0) {
+        ejsThrowArgError(ejs, "Bad profiling interval");
+        return 0;
+    }
+    if (sp->profiler && sp->profiler != ejs) {
+        ejsThrowStateError(ejs, "Another interpreter is profiling allocations");
+        return 0;
+    }
+    if (interval == 0) {
+        if (sp->profiler == ejs) {
+            mprSetAllocSampler(NULL, 0);
+            sp->profiler = 0;
+            ejsCommitAllocSample(ejs, NULL);
+        }
+        return 0;
+    }
+    if (ejs->allocProfile == 0 && (ejs->allocProfile = createAllocProfile(ejs)) == 0) {
+        return 0;
+    }
+    ejs->allocProfile->thread = mprGetCurrentOsThread();
+    ejs->allocProfile->interval = interval;
+    sp->profiler = ejs;
+    mprSetAllocSampler(sampleAllocation, interval);
+    return 0;
+}
+
+
+/*
+    Heap snapshot labeler. Called by the marker thread while the interpreter is paused. Blocks that are objects of 
+    a known type are labeled by the type name.
+ */
+static cchar *labelObject(void *ptr, MprManager manager, void *data)
+{
+    ObjectCounts    *oc;
+    ObjectCount     key, *cp;
+
+    if (manager == 0) {
+        return 0;
+    }
+    oc = data;
+    key.type = TYPE(ptr);
+    if ((cp = bsearch(&key, oc->counts, oc->length, sizeof(ObjectCount), compareObjectCount)) != 0 && 
+            cp->type->manager == manager) {
+        return cp->name;
+    }
+    return 0;
+}
+
+
+/*
+    native static function snapshot(path: Path): Void
+ */
+static EjsObj *writeSnapshot(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    ObjectCounts    oc;
+    MprList         *names;
+    EjsPath         *path;
+    int             i, rc;
+
+    path = (EjsPath*) argv[0];
+    if (getObjectTypes(ejs, &oc) < 0 || (names = mprCreateList(oc.length, 0)) == 0) {
+        return 0;
+    }
+    for (i = 0; i < oc.length; i++) {
+        oc.counts[i].name = ejsToMulti(ejs, oc.counts[i].type->qname.name);
+        mprAddItem(names, oc.counts[i].name);
+    }
+    /* The snapshot is written during a collection. The path is held by the caller's frame */
+    mprHold(oc.counts);
+    mprHold(names);
+    rc = mprWriteMemSnapshot(path->value, labelObject, &oc);
+    mprRelease(names);
+    mprRelease(oc.counts);
+    if (rc < 0) {
+        ejsThrowIOError(ejs, "Cannot write heap snapshot %s", path->value);
+    }
+    return 0;
+}
+
+
+/*
+    Read a heap snapshot written by mprWriteMemSnapshot. Labels with the same name are merged.
+ */
+static int readHeapGraph(cchar *path, HeapGraph *g)
+{
+    MprHash     *index;
+    char        *data, *cp, *end, *name;
+    int         *labels, version, fileLabels, node, label, count, edge, i;
+
+    memset(g, 0, sizeof(HeapGraph));
+    if (!mprPathExists(path, R_OK) || (data = mprReadPathContents(path, NULL)) == 0) {
+        return MPR_ERR_CANT_READ;
+    }
+    if (!sstarts(data, "mpr-snapshot ")) {
+        return MPR_ERR_BAD_FORMAT;
+    }
+    cp = &data[13];
+    version = (int) strtol(cp, &cp, 10);
+    g->nodeCount = (int) strtol(cp, &cp, 10);
+    g->edgeCount = (int) strtol(cp, &cp, 10);
+    fileLabels = (int) strtol(cp, &cp, 10);
+    if (version != 1 || g->nodeCount <= 0 || g->edgeCount < 0 || fileLabels <= 0) {
+        return MPR_ERR_BAD_FORMAT;
+    }
+    g->sizes = mprAlloc(g->nodeCount * sizeof(MprNumber));
+    g->labels = mprAlloc(g->nodeCount * sizeof(int));
+    g->starts = mprAlloc((g->nodeCount + 1) * sizeof(int));
+    g->edges = mprAlloc((g->edgeCount + 1) * sizeof(int));
+    g->names = mprAlloc(fileLabels * sizeof(char*));
+    labels = mprAlloc(fileLabels * sizeof(int));
+    index = mprCreateHash(0, MPR_HASH_STATIC_VALUES);
+    if (!g->sizes || !g->labels || !g->starts || !g->edges || !g->names || !labels || !index) {
+        return MPR_ERR_MEMORY;
+    }
+    for (i = 0; i < fileLabels; i++) {
+        if ((cp = strchr(cp, '\n')) == 0 || !sstarts(++cp, "L ") || (end = strchr(cp, '\n')) == 0) {
+            return MPR_ERR_BAD_FORMAT;
+        }
+        name = snclone(&cp[2], end - cp - 2);
+        cp = end;
+        if ((label = PTOI(mprLookupKey(index, name))) == 0) {
+            g->names[g->labelCount++] = name;
+            label = g->labelCount;
+            mprAddKey(index, name, ITOP(label));
+        }
+        labels[i] = label - 1;
+    }
+    for (node = edge = 0; node < g->nodeCount; node++) {
+        if ((cp = strchr(cp, '\n')) == 0 || !sstarts(++cp, "N ")) {
+            return MPR_ERR_BAD_FORMAT;
+        }
+        g->sizes[node] = (MprNumber) strtol(&cp[2], &cp, 10);
+        label = (int) strtol(cp, &cp, 10);
+        count = (int) strtol(cp, &cp, 10);
+        if (label < 0 || label >= fileLabels || count < 0 || count > g->edgeCount - edge) {
+            return MPR_ERR_BAD_FORMAT;
+        }
+        g->labels[node] = labels[label];
+        g->bytes += g->sizes[node];
+        g->starts[node] = edge;
+        for (i = 0; i < count; i++) {
+            if ((g->edges[edge++] = (int) strtol(cp, &cp, 10)) < 0 || g->edges[edge - 1] >= g->nodeCount) {
+                return MPR_ERR_BAD_FORMAT;
+            }
+        }
+    }
+    g->starts[node] = edge;
+    return 0;
+}
+
+
+static int intersectDominators(int *idom, int *rank, int a, int b)
+{
+    while (a != b) {
+        while (rank[a] < rank[b]) {
+            a = idom[a];
+        }
+        while (rank[b] < rank[a]) {
+            b = idom[b];
+        }
+    }
+    return a;
+}
+
+
+/*
+    Compute the immediate dominator and retained size of each block. Uses the iterative algorithm of Cooper, Harvey 
+    and Kennedy over a depth first post order from the root set (node zero).
+ */
+static int computeDominators(HeapGraph *g)
+{
+    int     *order, *rank, *stack, *cursor, *pstart, *preds, *idom;
+    int     count, top, node, next, pred, dom, changed, i, k;
+
+    order = mprAlloc(g->nodeCount * sizeof(int));
+    rank = mprAlloc(g->nodeCount * sizeof(int));
+    stack = mprAlloc(g->nodeCount * sizeof(int));
+    cursor = mprAlloc(g->nodeCount * sizeof(int));
+    pstart = mprAllocZeroed((g->nodeCount + 1) * sizeof(int));
+    preds = mprAlloc((g->edgeCount + 1) * sizeof(int));
+    idom = g->idom = mprAlloc(g->nodeCount * sizeof(int));
+    g->retained = mprAlloc(g->nodeCount * sizeof(MprNumber));
+    if (!order || !rank || !stack || !cursor || !pstart || !preds || !idom || !g->retained) {
+        return MPR_ERR_MEMORY;
+    }
+    for (i = 0; i < g->nodeCount; i++) {
+        rank[i] = -1;
+        idom[i] = -1;
+    }
+    /*
+        Depth first post order
+     */
+    count = 0;
+    top = 0;
+    stack[top] = 0;
+    cursor[top] = g->starts[0];
+    rank[0] = 0;
+    while (top >= 0) {
+        node = stack[top];
+        if (cursor[top] < g->starts[node + 1]) {
+            next = g->edges[cursor[top]++];
+            if (rank[next] < 0) {
+                rank[next] = 0;
+                stack[++top] = next;
+                cursor[top] = g->starts[next];
+            }
+        } else {
+            rank[node] = count;
+            order[count++] = node;
+            top--;
+        }
+    }
+    /*
+        Predecessors of reachable blocks
+     */
+    for (node = 0; node < g->nodeCount; node++) {
+        for (i = g->starts[node]; i < g->starts[node + 1]; i++) {
+            pstart[g->edges[i] + 1]++;
+        }
+    }
+    for (node = 0; node < g->nodeCount; node++) {
+        pstart[node + 1] += pstart[node];
+    }
+    memcpy(cursor, pstart, g->nodeCount * sizeof(int));
+    for (node = 0; node < g->nodeCount; node++) {
+        for (i = g->starts[node]; i < g->starts[node + 1]; i++) {
+            preds[cursor[g->edges[i]]++] = node;
+        }
+    }
+    idom[0] = 0;
+    do {
+        changed = 0;
+        for (k = count - 2; k >= 0; k--) {
+            node = order[k];
+            dom = -1;
+            for (i = pstart[node]; i < pstart[node + 1]; i++) {
+                pred = preds[i];
+                if (idom[pred] >= 0) {
+                    dom = (dom < 0) ? pred : intersectDominators(idom, rank, pred, dom);
+                }
+            }
+            if (dom >= 0 && idom[node] != dom) {
+                idom[node] = dom;
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    /*
+        A block retains its own size and the sizes of the blocks it dominates. Post order visits them first.
+     */
+    for (node = 0; node < g->nodeCount; node++) {
+        g->retained[node] = g->sizes[node];
+    }
+    for (k = 0; k < count - 1; k++) {
+        node = order[k];
+        g->retained[idom[node]] += g->retained[node];
+    }
+    g->reachable = count;
+    return 0;
+}
+
+
+/*
+    Total the blocks of each label. A label retains the blocks dominated by its outermost blocks so that nested blocks 
+    with the same label are not counted twice.
+ */
+static HeapLabel *computeLabels(HeapGraph *g)
+{
+    HeapLabel   *labels;
+    int         *cstart, *children, *stack, *cursor, *active;
+    int         node, top, child, label, i;
+
+    labels = mprAllocZeroed(g->labelCount * sizeof(HeapLabel));
+    cstart = mprAllocZeroed((g->nodeCount + 1) * sizeof(int));
+    children = mprAlloc(g->nodeCount * sizeof(int));
+    stack = mprAlloc(g->nodeCount * sizeof(int));
+    cursor = mprAlloc(g->nodeCount * sizeof(int));
+    active = mprAllocZeroed(g->labelCount * sizeof(int));
+    if (!labels || !cstart || !children || !stack || !cursor || !active) {
+        return 0;
+    }
+    for (i = 0; i < g->labelCount; i++) {
+        labels[i].name = g->names[i];
+    }
+    for (node = 1; node < g->nodeCount; node++) {
+        if (g->idom[node] >= 0) {
+            label = g->labels[node];
+            labels[label].count++;
+            labels[label].bytes += g->sizes[node];
+            cstart[g->idom[node] + 1]++;
+        }
+    }
+    for (node = 0; node < g->nodeCount; node++) {
+        cstart[node + 1] += cstart[node];
+    }
+    memcpy(cursor, cstart, g->nodeCount * sizeof(int));
+    for (node = 1; node < g->nodeCount; node++) {
+        if (g->idom[node] >= 0) {
+            children[cursor[g->idom[node]]++] = node;
+        }
+    }
+    top = 0;
+    stack[top] = 0;
+    cursor[top] = cstart[0];
+    while (top >= 0) {
+        node = stack[top];
+        if (cursor[top] < cstart[node + 1]) {
+            child = children[cursor[top]++];
+            label = g->labels[child];
+            if (active[label]++ == 0) {
+                labels[label].retained += g->retained[child];
+            }
+            stack[++top] = child;
+            cursor[top] = cstart[child];
+        } else {
+            if (node) {
+                active[g->labels[node]]--;
+            }
+            top--;
+        }
+    }
+    return labels;
+}
+
+
+static int compareHeapLabel(cvoid *a, cvoid *b)
+{
+    MprNumber   ra, rb;
+
+    ra = ((HeapLabel*) a)->retained - ((HeapLabel*) a)->priorRetained;
+    rb = ((HeapLabel*) b)->retained - ((HeapLabel*) b)->priorRetained;
+    return (ra < rb) ? 1 : ((ra > rb) ? -1 : 0);
+}
+
+
+static void reportLargest(MprBuf *buf, HeapGraph *g)
+{
+    int     top[EJS_SNAPSHOT_TOP], count, node, i, j;
+
+    count = 0;
+    for (node = 1; node < g->nodeCount; node++) {
+        if (g->idom[node] < 0) {
+            continue;
+        }
+        for (i = count; i > 0 && g->retained[top[i - 1]] < g->retained[node]; i--) ;
+        if (i < EJS_SNAPSHOT_TOP) {
+            for (j = min(count, EJS_SNAPSHOT_TOP - 1); j > i; j--) {
+                top[j] = top[j - 1];
+            }
+            top[i] = node;
+            count = min(count + 1, EJS_SNAPSHOT_TOP);
+        }
+    }
+    mprPutToBuf(buf, "\nLargest retained blocks\n%12s %12s  %s\n", "Retained", "Bytes", "Label");
+    for (i = 0; i < count; i++) {
+        node = top[i];
+        mprPutToBuf(buf, "%12Ld %12Ld  %s\n", (int64) g->retained[node], (int64) g->sizes[node], 
+            g->names[g->labels[node]]);
+    }
+}
+
+
+/*
+    Analyze a heap snapshot. Reports the blocks, bytes and retained bytes for each label, and the blocks that retain 
+    the most memory. If a baseline snapshot is given, the growth of each label since the baseline is reported instead.
+ */
+PUBLIC char *ejsAnalyzeMemSnapshot(cchar *path, cchar *baseline)
+{
+    HeapGraph   graph, prior;
+    HeapLabel   *labels, *priorLabels, *lp, *all;
+    MprHash     *index;
+    MprBuf      *buf;
+    int         count, i;
+
+    if (readHeapGraph(path, &graph) < 0 || computeDominators(&graph) < 0 || (labels = computeLabels(&graph)) == 0) {
+        return 0;
+    }
+    buf = mprCreateBuf(0, 0);
+    mprPutToBuf(buf, "Snapshot %s: %d blocks, %Ld bytes, %d references\n", path, graph.reachable - 1, 
+        (int64) graph.bytes, graph.edgeCount);
+    if (baseline) {
+        if (readHeapGraph(baseline, &prior) < 0 || computeDominators(&prior) < 0 || 
+                (priorLabels = computeLabels(&prior)) == 0) {
+            return 0;
+        }
+        mprPutToBuf(buf, "Baseline %s: %d blocks, %Ld bytes, %d references\n", baseline, prior.reachable - 1, 
+            (int64) prior.bytes, prior.edgeCount);
+        all = mprAllocZeroed((graph.labelCount + prior.labelCount) * sizeof(HeapLabel));
+        index = mprCreateHash(0, MPR_HASH_STATIC_VALUES);
+        for (i = 0; i < graph.labelCount; i++) {
+            all[i] = labels[i];
+            mprAddKey(index, labels[i].name, &all[i]);
+        }
+        count = graph.labelCount;
+        for (i = 0; i < prior.labelCount; i++) {
+            if ((lp = mprLookupKey(index, priorLabels[i].name)) == 0) {
+                lp = &all[count++];
+                lp->name = priorLabels[i].name;
+            }
+            lp->priorCount = priorLabels[i].count;
+            lp->priorBytes = priorLabels[i].bytes;
+            lp->priorRetained = priorLabels[i].retained;
+        }
+        qsort(all, count, sizeof(HeapLabel), compareHeapLabel);
+        mprPutToBuf(buf, "\nGrowth since baseline\n%12s %12s %12s %12s %10s %10s  %s\n", "Retained", "+/-", "Bytes", 
+            "+/-", "Count", "+/-", "Label");
+        for (i = 0; i < count; i++) {
+            lp = &all[i];
+            if (lp->count == lp->priorCount && lp->bytes == lp->priorBytes && lp->retained == lp->priorRetained) {
+                continue;
+            }
+            mprPutToBuf(buf, "%12Ld %+12Ld %12Ld %+12Ld %10Ld %+10Ld  %s\n", (int64) lp->retained, 
+                (int64) (lp->retained - lp->priorRetained), (int64) lp->bytes, (int64) (lp->bytes - lp->priorBytes), 
+                (int64) lp->count, (int64) (lp->count - lp->priorCount), lp->name);
+        }
+    } else {
+        qsort(labels, graph.labelCount, sizeof(HeapLabel), compareHeapLabel);
+        mprPutToBuf(buf, "\n%12s %12s %10s  %s\n", "Retained", "Bytes", "Count", "Label");
+        for (i = 0; i < graph.labelCount; i++) {
+            lp = &labels[i];
+            if (lp->count > 0) {
+                mprPutToBuf(buf, "%12Ld %12Ld %10Ld  %s\n", (int64) lp->retained, (int64) lp->bytes, 
+                    (int64) lp->count, lp->name);
+            }
+        }
+    }
+    reportLargest(buf, &graph);
+    mprAddNullToBuf(buf);
+    return mprGetBufStart(buf);
+}
+
+
+/*
+    native static function analyze(snapshot: Path, baseline: Path = null): String
+ */
+static EjsString *analyzeSnapshot(Ejs *ejs, EjsObj *thisObj, int argc, EjsObj **argv)
+{
+    EjsPath     *path, *baseline;
+    char        *report;
+
+    path = (EjsPath*) argv[0];
+    baseline = (argc > 1 && ejsIs(ejs, argv[1], Path)) ? (EjsPath*) argv[1] : 0;
+    if ((report = ejsAnalyzeMemSnapshot(path->value, baseline ? baseline->value : 0)) == 0) {
+        ejsThrowIOError(ejs, "Cannot analyze heap snapshot %s", path->value);
+        return 0;
+    }
+    return ejsCreateStringFromAsc(ejs, report);
+}
+
+
 /*
     native static function get redline(): Number
  */
@@ -141,9 +1049,16 @@ PUBLIC void ejsConfigureMemoryType(Ejs *ejs)
         return;
     }
     ejsBindMethod(ejs, type, ES_Memory_allocated, getAllocatedMemory);
+    ejsBindMethod(ejs, type, ES_Memory_analyze, analyzeSnapshot);
+    ejsBindMethod(ejs, type, ES_Memory_allocator, getAllocatorStats);
+    ejsBindMethod(ejs, type, ES_Memory_functions, getFunctionStats);
     ejsBindAccess(ejs, type, ES_Memory_maximum, getMaxMemory, setMaxMemory);
+    ejsBindMethod(ejs, type, ES_Memory_objects, getObjectCounts);
+    ejsBindMethod(ejs, type, ES_Memory_profile, getAllocProfile);
+    ejsBindAccess(ejs, type, ES_Memory_profiling, getProfiling, setProfiling);
     ejsBindAccess(ejs, type, ES_Memory_redline, getRedline, setRedline);
     ejsBindMethod(ejs, type, ES_Memory_resident, getResident);
+    ejsBindMethod(ejs, type, ES_Memory_snapshot, writeSnapshot);
     ejsBindMethod(ejs, type, ES_Memory_system, getSystemRam);
     ejsBindMethod(ejs, type, ES_Memory_stats, printStats);
 
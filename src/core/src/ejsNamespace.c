@@ -116,7 +116,8 @@ PUBLIC EjsNamespace *ejsCreateNamespace(Ejs *ejs, EjsString *name)
     if ((np = ejsCreateObj(ejs, ESV(Namespace), 0)) == 0) {
         return 0;
     }
-    np->value = name;
+    /* Namespaces are compared by reference */
+    np->value = ejsInternString(name);
     mprSetName(np, "namespace");
     return np;
 }
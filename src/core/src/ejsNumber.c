@@ -586,12 +586,14 @@ static char *ntoa(double value, int ndigits, int mode, int flags)
 
 /*********************************** Factory **********************************/
 /*
-    Create an initialized number
+    Create an initialized number. Small integers are shared from a service wide cache as numbers are immutable.
+    Threads racing to fill a cache entry may each create a number, but either result is valid.
  */
 
 PUBLIC EjsNumber *ejsCreateNumber(Ejs *ejs, MprNumber value)
 {
-    EjsNumber   *vp;
+    EjsNumber   *vp, **cache;
+    int         index;
 
     if (value == 0) {
         return ESV(zero);
@@ -600,6 +602,16 @@ PUBLIC EjsNumber *ejsCreateNumber(Ejs *ejs, MprNumber value)
     } else if (value == -1) {
         return ESV(minusOne);
     }
+    if (value >= EJS_NUMBER_CACHE_MIN && value < EJS_NUMBER_CACHE_MAX && (index = (int) value) == value) {
+        cache = &ejs->service->numbers[index - EJS_NUMBER_CACHE_MIN];
+        if ((vp = *cache) == 0) {
+            if ((vp = ejsCreateObj(ejs, ESV(Number), 0)) != 0) {
+                vp->value = value;
+                *cache = vp;
+            }
+        }
+        return vp;
+    }
     if ((vp = ejsCreateObj(ejs, ESV(Number), 0)) != 0) {
         vp->value = value;
     }
@@ -77,11 +77,13 @@ static EjsObj *obj_set_prototype(Ejs *ejs, EjsObj *obj, int argc, EjsObj **argv)
     prototype = (EjsPot*) argv[0];
     if (ejsIsType(ejs, obj)) {
         ((EjsType*) obj)->prototype = prototype;
+        ejs->service->cacheEpoch++;
     } else {
         if (ejsIsFunction(ejs, obj)) {
             fun = (EjsFunction*) obj;
             if (ejsIsType(ejs, fun->archetype)) {
                 fun->archetype->prototype = prototype;
+                ejs->service->cacheEpoch++;
             } else {
                 ejsCreateArchetype(ejs, fun, prototype);
             }
@@ -654,7 +656,7 @@ static EjsObj *obj_seal(Ejs *ejs, EjsObj *unused, int argc, EjsObj **argv)
     numProp = ejsGetLength(ejs, obj);
     for (slotNum = 0; slotNum < numProp; slotNum++) {
         if ((trait = ejsGetPropertyTraits(ejs, obj, slotNum)) != 0) {
-            trait->attributes |= EJS_TRAIT_FIXED;
+            ejsSetPropertyTraits(ejs, obj, slotNum, NULL, trait->attributes | EJS_TRAIT_FIXED);
         }
     }
     SET_DYNAMIC(obj, 0);
@@ -692,6 +694,10 @@ static EjsObj *obj_sortProperties(Ejs *ejs, EjsObj *unused, int argc, EjsObj **a
 #if FUTURE && KEEP
     asc = (argc >= 2 && argv[1] == ESV(true));
 #endif
+    if (ejsMakeDictionary(ejs, obj) < 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
     qsort(obj->properties->slots, obj->numProp, sizeof(EjsSlot), sortSlots);
     ejsIndexProperties(ejs, obj);
     return 0;
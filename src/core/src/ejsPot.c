@@ -15,11 +15,37 @@
 #define CMP_QNAME(a,b) ((a)->name == (b)->name && (a)->space == (b)->space)
 #define CMP_NAME(a,b) ((a)->name == (b)->name)
 
+/*
+    Shaped objects store an EjsValues block in place of the properties
+ */
+#define VALUES(obj) ((EjsValues*) (obj)->properties)
+
+/*
+    Plain dynamic objects that use the standard property helpers can share shapes
+ */
+#define SHAPED_TYPE(type) (!(type)->hasInstanceVars && !(type)->virtualSlots && \
+    (type)->instanceSize == sizeof(EjsPot) && \
+    (type)->helpers.getProperty == (EjsGetPropertyHelper) getPotProperty && \
+    (type)->helpers.lookupProperty == (EjsLookupPropertyHelper) ejsLookupPotProperty && \
+    (type)->helpers.setPropertyName == (EjsSetPropertyNameHelper) setPotPropertyName)
+
 /****************************** Forward Declarations **************************/
 
+static int  addShapedProperty(Ejs *ejs, EjsPot *obj, EjsName qname);
+static EjsAny *cloneValue(Ejs *ejs, EjsPot *src, int slotNum, EjsAny *vp, bool deep);
+static EjsShape *findShape(Ejs *ejs, EjsShape *shape, EjsName qname, EjsType *propType, int attributes);
 static int  growSlots(Ejs *ejs, EjsPot *obj, int size);
+static int  growValues(Ejs *ejs, EjsPot *obj, int count);
+static bool hasDuplicateName(EjsPot *obj, int slotNum, EjsName qname);
 static int  hashProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname);
+static void manageShape(EjsShape *shape, int flags);
 static void removeHashEntry(Ejs *ejs, EjsPot *obj, EjsName qname);
+static int  setShapedTraits(Ejs *ejs, EjsPot *obj, int slotNum, EjsType *type, int attributes);
+
+/*
+    Inline property caches in the VM depend on the shape of types and prototypes. Invalidate all caches if these change.
+ */
+#define CHECK_SHAPE(ejs, obj) if ((obj)->isPrototype || (obj)->isType) { (ejs)->service->cacheEpoch++; } else
 
 /************************************* Code ***********************************/
 
@@ -33,8 +59,8 @@ PUBLIC EjsAny *ejsClonePot(Ejs *ejs, EjsAny *obj, bool deep)
 {
     EjsPot      *dest, *src;
     EjsSlot     *dp, *sp;
+    EjsValues   *values;
     EjsType     *type;
-    EjsObj      *vp;
     int         numProp, i;
 
     if (!ejsIsPot(ejs, obj)) {
@@ -44,7 +70,7 @@ PUBLIC EjsAny *ejsClonePot(Ejs *ejs, EjsAny *obj, bool deep)
     src = (EjsPot*) obj;
     type = TYPE(src);
     numProp = src->numProp;
-    if ((dest = ejsCreatePot(ejs, type, numProp)) == 0) {
+    if ((dest = ejsCreatePot(ejs, type, src->shaped ? 0 : numProp)) == 0) {
         return 0;
     }
     dest->obj = src->obj;
@@ -55,39 +81,64 @@ PUBLIC EjsAny *ejsClonePot(Ejs *ejs, EjsAny *obj, bool deep)
     dest->isType = src->isType;
     dest->numProp = numProp;
     dest->shortScope = src->shortScope;
-    
-    dp = dest->properties->slots;
-    sp = src->properties->slots;
+    dest->dupNames = src->dupNames;
 
-    /*
-        NOTE: Object pots do not inherit prototype properties, whereas class instances do.
-     */
-    for (i = 0; i < numProp; i++, sp++, dp++) {
-        *dp = *sp;
-        dp->hashChain = -1;
-        vp = sp->value.ref;
-        if (deep && vp) {
-            if (ejsIsFunction(ejs, vp) && !ejsIsType(ejs, vp)) {
-                ;
-            } else if ((ejsIsType(ejs, vp) && ((EjsType*) vp)->mutable) || 
-                      (!ejsIsType(ejs, vp) && TYPE(vp)->mutableInstances)) {
-#if BIT_MEMORY_DEBUG
-                EjsName qname = ejsGetPropertyName(ejs, src, i);
-                mprSetName(dp->value.ref, qname.name->value);
-                // mprTrace(0, "CLONE %N", qname);
-#endif
-                dp->value.ref = ejsClone(ejs, vp, deep);
+    if (src->shaped) {
+        /*
+            The clone shares the shape of the source. Only the values are copied.
+         */
+        assert(dest->shaped);
+        if (numProp > 0) {
+            if (growValues(ejs, dest, numProp) < 0) {
+                return 0;
+            }
+            values = VALUES(dest);
+            memcpy(values->values, VALUES(src)->values, numProp * sizeof(EjsAny*));
+            values->shape = VALUES(src)->shape;
+            for (i = 0; i < numProp; i++) {
+                values->values[i] = cloneValue(ejs, src, i, values->values[i], deep);
             }
         }
-    }
-    if (dest->numProp > EJS_HASH_MIN_PROP) {
-        ejsIndexProperties(ejs, dest);
+    } else {
+        dp = dest->properties->slots;
+        sp = src->properties->slots;
+
+        /*
+            NOTE: Object pots do not inherit prototype properties, whereas class instances do.
+         */
+        for (i = 0; i < numProp; i++, sp++, dp++) {
+            *dp = *sp;
+            dp->hashChain = -1;
+            dp->value.ref = cloneValue(ejs, src, i, sp->value.ref, deep);
+        }
+        if (dest->numProp > EJS_HASH_MIN_PROP) {
+            ejsIndexProperties(ejs, dest);
+        }
     }
     mprCopyName(dest, src);
     return dest;
 }
 
 
+static EjsAny *cloneValue(Ejs *ejs, EjsPot *src, int slotNum, EjsAny *vp, bool deep)
+{
+    if (deep && vp) {
+        if (ejsIsFunction(ejs, vp) && !ejsIsType(ejs, vp)) {
+            ;
+        } else if ((ejsIsType(ejs, vp) && ((EjsType*) vp)->mutable) || 
+                  (!ejsIsType(ejs, vp) && TYPE(vp)->mutableInstances)) {
+#if BIT_MEMORY_DEBUG
+            EjsName qname = ejsGetPropertyName(ejs, src, slotNum);
+            mprSetName(vp, qname.name->value);
+            // mprTrace(0, "CLONE %N", qname);
+#endif
+            return ejsClone(ejs, vp, deep);
+        }
+    }
+    return vp;
+}
+
+
 /*
     Fix trait type references to point to mutable types in the current interpreter. Only needed after cloning global.
  */
@@ -102,19 +153,35 @@ PUBLIC void ejsFixTraits(Ejs *ejs, EjsPot *obj)
     }
     SET_VISITED(obj, 1);
     numProp = obj->numProp;
-    sp = obj->properties->slots;
-    
-    for (i = 0; i < numProp; i++, sp++) {
-        if (sp->trait.type && sp->trait.type->mutable) {
-            assert(sp->trait.type->qname.name);
-            if ((type = ejsGetPropertyByName(ejs, ejs->global, sp->trait.type->qname)) != 0) {
-                sp->trait.type = type;
-            } else {
-                assert(0);
+
+    if (obj->shaped && numProp > 0) {
+        /* Shapes are shared. Give the object its own traits if any must be fixed */
+        for (i = 0, sp = ejsGetShape(obj)->layout->properties->slots; i < numProp; i++, sp++) {
+            if (sp->trait.type && sp->trait.type->mutable) {
+                ejsMakeDictionary(ejs, obj);
+                break;
             }
         }
-        if (ejsIsPot(ejs, sp->value.ref)) {
-            ejsFixTraits(ejs, sp->value.ref);
+    }
+    if (obj->shaped) {
+        for (i = 0; i < numProp; i++) {
+            if (ejsIsPot(ejs, VALUES(obj)->values[i])) {
+                ejsFixTraits(ejs, VALUES(obj)->values[i]);
+            }
+        }
+    } else {
+        for (i = 0, sp = obj->properties->slots; i < numProp; i++, sp++) {
+            if (sp->trait.type && sp->trait.type->mutable) {
+                assert(sp->trait.type->qname.name);
+                if ((type = ejsGetPropertyByName(ejs, ejs->global, sp->trait.type->qname)) != 0) {
+                    sp->trait.type = type;
+                } else {
+                    assert(0);
+                }
+            }
+            if (ejsIsPot(ejs, sp->value.ref)) {
+                ejsFixTraits(ejs, sp->value.ref);
+            }
         }
     }
     SET_VISITED(obj, 0);
@@ -183,6 +250,10 @@ static int definePotProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname,
     assert(priorSlot < 0 || priorSlot == slotNum);
 
     if (slotNum >= obj->numProp && !DYNAMIC(obj)) {
+        if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+            ejsThrowMemoryError(ejs);
+            return EJS_ERR;
+        }
         if (obj->properties == 0 || slotNum >= obj->properties->size) {
             if (growSlots(ejs, obj, slotNum + 1) < 0) {
                 ejsThrowMemoryError(ejs);
@@ -241,10 +312,15 @@ static int deletePotProperty(Ejs *ejs, EjsPot *obj, int slotNum)
         ejsThrowReferenceError(ejs, "Invalid property slot to delete");
         return EJS_ERR;
     }
+    if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+        ejsThrowMemoryError(ejs);
+        return EJS_ERR;
+    }
     qname = ejsGetPotPropertyName(ejs, obj, slotNum);
     if (qname.name) {
         removeHashEntry(ejs, obj, qname);
     }
+    CHECK_SHAPE(ejs, obj);
     sp = &obj->properties->slots[slotNum];
     sp->value.ref = ESV(undefined);
     sp->trait.type = 0;
@@ -278,6 +354,9 @@ static EjsPot *getPotProperty(Ejs *ejs, EjsPot *obj, int slotNum)
         ejsThrowReferenceError(ejs, "Property at slot \"%d\" is not found", slotNum);
         return 0;
     }
+    if (obj->shaped) {
+        return VALUES(obj)->values[slotNum];
+    }
     return obj->properties->slots[slotNum].value.ref;
 }
 
@@ -304,6 +383,9 @@ PUBLIC EjsName ejsGetPotPropertyName(Ejs *ejs, EjsPot *obj, int slotNum)
         qname.space = 0;
         return qname;
     }
+    if (obj->shaped) {
+        return ejsGetShape(obj)->layout->properties->slots[slotNum].qname;
+    }
     return obj->properties->slots[slotNum].qname;
 }
 
@@ -324,6 +406,13 @@ PUBLIC int ejsLookupPotProperty(struct Ejs *ejs, EjsPot *obj, EjsName qname)
     assert(qname.name);
     assert(ejsIsPot(ejs, obj));
 
+    if (obj->shaped) {
+        /* The shape layout has the same names in the same slots */
+        if (obj->properties == 0) {
+            return -1;
+        }
+        obj = ejsGetShape(obj)->layout;
+    }
     if ((props = obj->properties) == 0 || obj->numProp == 0) {
         return -1;
     }
@@ -360,7 +449,7 @@ PUBLIC int ejsLookupPotProperty(struct Ejs *ejs, EjsPot *obj, EjsName qname)
          */
         assert(props->hash);
         assert(props->hash->size > 0);
-        index = whash(qname.name->value, qname.name->length) % props->hash->size;
+        index = ejsGetStringHash(qname.name) % props->hash->size;
         if (qname.space) {
             assert(hash->buckets);
             assert(index < hash->size);
@@ -412,6 +501,10 @@ PUBLIC int ejsCheckSlot(Ejs *ejs, EjsPot *obj, int slotNum)
             }
             return EJS_ERR;
         }
+        if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+            ejsThrowMemoryError(ejs);
+            return EJS_ERR;
+        }
         if (slotNum < 0) {
             slotNum = obj->numProp;
         }
@@ -426,7 +519,7 @@ PUBLIC int ejsCheckSlot(Ejs *ejs, EjsPot *obj, int slotNum)
         }
         obj->numProp++;
     }
-    assert(obj->numProp <= obj->properties->size);
+    assert(obj->shaped || obj->numProp <= obj->properties->size);
     return slotNum;
 }
 
@@ -447,8 +540,12 @@ static int setPotProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsObj *value)
         return EJS_ERR;
     }
     assert(slotNum < obj->numProp);
-    assert(obj->numProp <= obj->properties->size);
-    obj->properties->slots[slotNum].value.ref = value;
+    if (obj->shaped) {
+        VALUES(obj)->values[slotNum] = value;
+    } else {
+        assert(obj->numProp <= obj->properties->size);
+        obj->properties->slots[slotNum].value.ref = value;
+    }
     return slotNum;
 }
 
@@ -456,20 +553,36 @@ static int setPotProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsObj *value)
 /*
     Set the name for a property. Objects maintain a hash lookup for property names. This is hash is created on demand 
     if there are more than N properties. If an object is not dynamic, it will use the types name hash. If dynamic, 
-    then the types name hash will be copied when required. 
+    then the types name hash will be copied when required. Shaped objects transition to a new shape when adding a 
+    property and revert to a dictionary if a property is renamed.
  */
 static int setPotPropertyName(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname)
 {
     EjsProperties   *props;
+    int             index;
 
     assert(obj);
     assert(ejsIsPot(ejs, obj));
     assert(qname.name);
     assert(qname.space);
 
+    if (obj->shaped) {
+        if (slotNum < 0 || slotNum == obj->numProp) {
+            if ((index = addShapedProperty(ejs, obj, qname)) >= 0) {
+                return index;
+            }
+        } else if (slotNum < obj->numProp && 
+                CMP_QNAME(&ejsGetShape(obj)->layout->properties->slots[slotNum].qname, &qname)) {
+            return slotNum;
+        }
+    }
     if ((slotNum = ejsCheckSlot(ejs, obj, slotNum)) < 0) {
         return EJS_ERR;
     }
+    if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+        ejsThrowMemoryError(ejs);
+        return EJS_ERR;
+    }
     assert(slotNum < obj->numProp);
     props = obj->properties;
 
@@ -491,10 +604,44 @@ static int setPotPropertyName(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname)
             return EJS_ERR;
         }
     }
+    if (!obj->dupNames && hasDuplicateName(obj, slotNum, qname)) {
+        obj->dupNames = 1;
+    }
+    CHECK_SHAPE(ejs, obj);
     return slotNum;
 }
 
 
+/*
+    Test if another property has the same name (in a different namespace). Objects with such properties cannot 
+    be resolved by name alone and are not cached by the VM.
+ */
+static bool hasDuplicateName(EjsPot *obj, int slotNum, EjsName qname)
+{
+    EjsProperties   *props;
+    EjsSlot         *slots;
+    int             i;
+
+    props = obj->properties;
+    slots = props->slots;
+    if (props->hash && props->hash->size > 0) {
+        i = props->hash->buckets[ejsGetStringHash(qname.name) % props->hash->size];
+        for (; i >= 0; i = slots[i].hashChain) {
+            if (i != slotNum && CMP_NAME(&slots[i].qname, &qname)) {
+                return 1;
+            }
+        }
+    } else {
+        for (i = 0; i < obj->numProp; i++) {
+            if (i != slotNum && CMP_NAME(&slots[i].qname, &qname)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+
 /******************************* Slot Routines ********************************/
 /*
     Grow and object and update numProp and numTraits if required
@@ -503,6 +650,14 @@ PUBLIC int ejsGrowPot(Ejs *ejs, EjsPot *obj, int numProp)
 {
     assert(ejsIsPot(ejs, obj));
 
+    if (obj->shaped) {
+        if (numProp <= obj->numProp) {
+            return 0;
+        }
+        if (ejsMakeDictionary(ejs, obj) < 0) {
+            return EJS_ERR;
+        }
+    }
     if (obj->properties == 0 || numProp > obj->properties->size) {
         if (growSlots(ejs, obj, numProp) < 0) {
             return EJS_ERR;
@@ -532,6 +687,9 @@ PUBLIC int ejsInsertPotProperties(Ejs *ejs, EjsPot *obj, int incr, int offset)
     if (incr <= 0) {
         return 0;
     }
+    if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+        return EJS_ERR;
+    }
     size = obj->numProp + incr;
     if (obj->properties == 0 || obj->properties->size < size) {
         if (growSlots(ejs, obj, size) < 0) {
@@ -546,6 +704,7 @@ PUBLIC int ejsInsertPotProperties(Ejs *ejs, EjsPot *obj, int incr, int offset)
         slots[i] = *sp;
     }
     ejsZeroSlots(ejs, &slots[offset], incr);
+    CHECK_SHAPE(ejs, obj);
     if (ejsIndexProperties(ejs, obj) < 0) {
         return EJS_ERR;
     }   
@@ -625,6 +784,9 @@ static void removeSlot(Ejs *ejs, EjsPot *obj, int slotNum, int compact)
     assert(slotNum >= 0);
     assert(compact);
 
+    if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+        return;
+    }
     if (obj->properties) {
         slots = obj->properties->slots;
         if (compact) {
@@ -638,6 +800,7 @@ static void removeSlot(Ejs *ejs, EjsPot *obj, int slotNum, int compact)
         }
         ejsZeroSlots(ejs, &slots[i], 1);
         ejsIndexProperties(ejs, obj);
+        CHECK_SHAPE(ejs, obj);
     }
 }
 
@@ -668,11 +831,15 @@ PUBLIC void ejsCopySlots(Ejs *ejs, EjsPot *dest, int destOff, EjsPot *src, int s
 {
     EjsSlot     *sp, *dp;
 
+    if ((dest->shaped && ejsMakeDictionary(ejs, dest) < 0) || (src->shaped && ejsMakeDictionary(ejs, src) < 0)) {
+        return;
+    }
     assert(dest->properties);
     assert(src->properties);
     assert(srcOff < src->numProp);
     assert(destOff < dest->numProp);
 
+    dest->dupNames |= src->dupNames;
     for (sp = &src->properties->slots[srcOff], dp = &dest->properties->slots[destOff]; count > 0; count--) {
         *dp = *sp;
         dp->hashChain = -1;
@@ -715,6 +882,10 @@ static EjsTrait *getPotPropertyTraits(Ejs *ejs, EjsPot *obj, int slotNum)
     if (slotNum < 0 || slotNum >= obj->numProp) {
         return NULL;
     }
+    if (obj->shaped) {
+        /* Shared by all objects of this shape. Use ejsSetPropertyTraits to modify */
+        return &ejsGetShape(obj)->layout->properties->slots[slotNum].trait;
+    }
     return &obj->properties->slots[slotNum].trait;
 }
 
@@ -727,6 +898,15 @@ static int setPotPropertyTraits(Ejs *ejs, EjsPot *obj, int slotNum, EjsType *typ
     if ((slotNum = ejsCheckSlot(ejs, obj, slotNum)) < 0) {
         return EJS_ERR;
     }
+    if (obj->shaped) {
+        if (setShapedTraits(ejs, obj, slotNum, type, attributes) == 0) {
+            return slotNum;
+        }
+        if (ejsMakeDictionary(ejs, obj) < 0) {
+            ejsThrowMemoryError(ejs);
+            return EJS_ERR;
+        }
+    }
     if (type) {
         obj->properties->slots[slotNum].trait.type = type;
     }
@@ -776,7 +956,7 @@ static int hashProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname)
     }
     hash = props->hash;
     slots = props->slots;
-    index = whash(qname.name->value, qname.name->length) % hash->size;
+    index = ejsGetStringHash(qname.name) % hash->size;
 
     /* Scan the collision chain */
     lastSlot = -1;
@@ -825,7 +1005,8 @@ PUBLIC int ejsIndexProperties(Ejs *ejs, EjsPot *obj)
     assert(obj);
     assert(ejsIsPot(ejs, obj));
 
-    if (obj->properties == 0) {
+    if (obj->properties == 0 || obj->shaped) {
+        /* Shaped objects use the index of their shape */
         return 0;
     }
     if (obj->numProp <= EJS_HASH_MIN_PROP && obj->properties->hash == 0) {
@@ -898,7 +1079,7 @@ static void removeHashEntry(Ejs *ejs, EjsPot *obj, EjsName qname)
         assert(0);
         return;
     }
-    index = whash(qname.name->value, qname.name->length) % obj->properties->hash->size;
+    index = ejsGetStringHash(qname.name) % obj->properties->hash->size;
     slotNum = obj->properties->hash->buckets[index];
     lastSlot = -1;
     buckets = obj->properties->hash->buckets;
@@ -931,6 +1112,9 @@ PUBLIC int ejsCompactPot(Ejs *ejs, EjsPot *obj)
 
     assert(ejsIsPot(ejs, obj));
 
+    if (obj->shaped && ejsMakeDictionary(ejs, obj) < 0) {
+        return EJS_ERR;
+    }
     src = dest = slots = obj->properties->slots;
     for (removed = i = 0; i < obj->numProp; i++, src++) {
         if (!ejsIsDefined(ejs, src->value.ref)) {
@@ -941,6 +1125,7 @@ PUBLIC int ejsCompactPot(Ejs *ejs, EjsPot *obj)
     }
     obj->numProp -= removed;
     ejsIndexProperties(ejs, obj);
+    CHECK_SHAPE(ejs, obj);
     return obj->numProp;
 }
 
@@ -950,13 +1135,264 @@ PUBLIC bool ejsMatchName(Ejs *ejs, EjsName *a, EjsName *b)
     return a->name == b->name && a->space == b->space;
 }
 
+/******************************* Shape Routines *******************************/
+/*
+    Create a shape that adds one property to the parent shape. The root shape has no parent and no properties.
+    The layout is a private dictionary that holds the names, traits and hash for the shape. 
+ */
+static EjsShape *createShape(Ejs *ejs, EjsShape *parent, EjsName qname, EjsType *propType, int attributes)
+{
+    EjsShape    *shape;
+    EjsPot      *layout;
+    EjsSlot     *sp;
+    int         numProp;
+
+    if ((shape = mprAllocObj(EjsShape, manageShape)) == 0) {
+        return 0;
+    }
+    if ((layout = ejsAlloc(ejs, ESV(Object), 0)) == 0) {
+        return 0;
+    }
+    shape->layout = layout;
+    shape->parent = parent;
+    if (parent) {
+        numProp = parent->layout->numProp + 1;
+        if (growSlots(ejs, layout, numProp) < 0) {
+            return 0;
+        }
+        layout->numProp = numProp;
+        if (numProp > 1) {
+            ejsCopySlots(ejs, layout, 0, parent->layout, 0, numProp - 1);
+        }
+        sp = &layout->properties->slots[numProp - 1];
+        sp->qname = qname;
+        sp->trait.type = propType;
+        sp->trait.attributes = attributes;
+        if (ejsIndexProperties(ejs, layout) < 0) {
+            return 0;
+        }
+        if (!layout->dupNames && hasDuplicateName(layout, numProp - 1, qname)) {
+            layout->dupNames = 1;
+        }
+        shape->qname = qname;
+        shape->trait = sp->trait;
+    }
+    return shape;
+}
+
+
+static EjsShape *matchShape(EjsShape *shape, EjsName qname, EjsType *propType, int attributes)
+{
+    EjsShape    *child;
+
+    for (child = shape->children; child; child = child->sibling) {
+        if (CMP_QNAME(&child->qname, &qname) && child->trait.type == propType && child->trait.attributes == attributes) {
+            return child;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Find or create the transition from a shape that adds the given property. Transitions are read without locking. 
+    New shapes are fully initialized before being published. Returns null if the shape tree is too large.
+ */
+static EjsShape *findShape(Ejs *ejs, EjsShape *shape, EjsName qname, EjsType *propType, int attributes)
+{
+    EjsShape    *child, *root;
+
+    if ((child = matchShape(shape, qname, propType, attributes)) != 0) {
+        return child;
+    }
+    ejsLockService();
+    if ((child = matchShape(shape, qname, propType, attributes)) == 0) {
+        for (root = shape; root->parent; root = root->parent) ;
+        if (shape->numChildren < EJS_SHAPE_MAX_TRANSITIONS && root->numShapes < EJS_SHAPE_MAX) {
+            if ((child = createShape(ejs, shape, qname, propType, attributes)) != 0) {
+                child->sibling = shape->children;
+                mprAtomicBarrier();
+                shape->children = child;
+                shape->numChildren++;
+                root->numShapes++;
+            }
+        }
+    }
+    ejsUnlockService();
+    return child;
+}
+
+
+static EjsShape *getRootShape(Ejs *ejs, EjsType *type)
+{
+    EjsShape    *shape;
+    EjsName     qname;
+
+    if ((shape = type->shape) == 0) {
+        ejsLockService();
+        if ((shape = type->shape) == 0) {
+            qname.name = qname.space = 0;
+            if ((shape = createShape(ejs, NULL, qname, NULL, 0)) != 0) {
+                mprAtomicBarrier();
+                type->shape = shape;
+            }
+        }
+        ejsUnlockService();
+    }
+    return shape;
+}
+
+
+/*
+    Add a property to a shaped object by transitioning to the shape with the extra property. Returns the new slot 
+    number or EJS_ERR if the object cannot remain shaped.
+ */
+static int addShapedProperty(Ejs *ejs, EjsPot *obj, EjsName qname)
+{
+    EjsShape    *shape;
+    int         slotNum;
+
+    assert(obj->shaped);
+
+    if (!DYNAMIC(obj) || obj->isPrototype || obj->isType || obj->numProp >= EJS_SHAPE_MAX_PROP) {
+        return EJS_ERR;
+    }
+    if ((shape = ejsGetShape(obj)) == 0 && (shape = getRootShape(ejs, TYPE(obj))) == 0) {
+        return EJS_ERR;
+    }
+    if ((shape = findShape(ejs, shape, qname, NULL, 0)) == 0) {
+        return EJS_ERR;
+    }
+    slotNum = obj->numProp;
+    if (growValues(ejs, obj, slotNum + 1) < 0) {
+        return EJS_ERR;
+    }
+    VALUES(obj)->values[slotNum] = ESV(null);
+    VALUES(obj)->shape = shape;
+    obj->numProp++;
+    obj->dupNames = shape->layout->dupNames;
+    return slotNum;
+}
+
+
+/*
+    Change the traits of a property in a shaped object. Only the last property added can be changed. This is done by 
+    taking the transition with the new traits from the parent shape. Returns EJS_ERR if the object cannot remain shaped.
+ */
+static int setShapedTraits(Ejs *ejs, EjsPot *obj, int slotNum, EjsType *type, int attributes)
+{
+    EjsShape    *shape;
+    EjsTrait    *trait;
+
+    shape = ejsGetShape(obj);
+    trait = &shape->layout->properties->slots[slotNum].trait;
+    if (type == 0) {
+        type = trait->type;
+    }
+    if (attributes == -1) {
+        attributes = trait->attributes;
+    }
+    if (type == trait->type && attributes == trait->attributes) {
+        return 0;
+    }
+    if (slotNum == obj->numProp - 1 && (shape = findShape(ejs, shape->parent, shape->qname, type, attributes)) != 0) {
+        VALUES(obj)->shape = shape;
+        return 0;
+    }
+    return EJS_ERR;
+}
+
+
+/*
+    Allocate or grow the values storage for a shaped object. Does not update numProp.
+ */
+static int growValues(Ejs *ejs, EjsPot *obj, int count)
+{
+    EjsValues   *values;
+    int         size;
+
+    assert(obj->shaped);
+
+    values = VALUES(obj);
+    if (values && count <= values->size) {
+        return 0;
+    }
+    size = values ? min(values->size * 2, EJS_SHAPE_MAX_PROP) : 4;
+    size = max(size, count);
+    if (values) {
+        values = mprRealloc(values, sizeof(EjsValues) + size * sizeof(EjsAny*));
+    } else if ((values = mprAlloc(sizeof(EjsValues) + size * sizeof(EjsAny*))) != 0) {
+        values->shape = 0;
+    }
+    if (values == 0) {
+        return EJS_ERR;
+    }
+    values->size = size;
+    obj->properties = (EjsProperties*) values;
+    return 0;
+}
+
+
+PUBLIC int ejsMakeDictionary(Ejs *ejs, EjsPot *obj)
+{
+    EjsValues   *values;
+    EjsSlot     *sp, *dp;
+    int         numProp, i;
+
+    assert(ejsIsPot(ejs, obj));
+
+    if (!obj->shaped) {
+        return 0;
+    }
+    values = VALUES(obj);
+    numProp = obj->numProp;
+    obj->shaped = 0;
+    obj->properties = 0;
+    obj->numProp = 0;
+    if (values && numProp > 0) {
+        if (growSlots(ejs, obj, numProp) < 0) {
+            obj->shaped = 1;
+            obj->properties = (EjsProperties*) values;
+            obj->numProp = numProp;
+            return EJS_ERR;
+        }
+        obj->numProp = numProp;
+        sp = values->shape->layout->properties->slots;
+        dp = obj->properties->slots;
+        for (i = 0; i < numProp; i++, sp++, dp++) {
+            dp->qname = sp->qname;
+            dp->trait = sp->trait;
+            dp->hashChain = -1;
+            dp->value.ref = values->values[i];
+        }
+        if (ejsIndexProperties(ejs, obj) < 0) {
+            return EJS_ERR;
+        }
+    }
+    return 0;
+}
+
+
+static void manageShape(EjsShape *shape, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(shape->parent);
+        mprMark(shape->children);
+        mprMark(shape->sibling);
+        mprMark(shape->layout);
+        mprMark(shape->qname.name);
+        mprMark(shape->qname.space);
+    }
+}
+
 
 /************************************ Factory *********************************/
 /*
     Create an object which is an instance of a given type. NOTE: only initialize the Object base class. It is up to the 
     caller to complete the initialization for all other base classes by calling the appropriate constructors. The numProp 
     arg is the number of property slots to pre-allocate. It is typically zero and slots are allocated on-demand. If the 
-    type creates dynamic instances, then the property slots are allocated separately and can grow. 
+    type creates dynamic instances, then the property slots are allocated separately and can grow. Plain dynamic 
+    objects without pre-allocated slots start out shaped.
  */
 PUBLIC void *ejsCreatePot(Ejs *ejs, EjsType *type, int numProp)
 {
@@ -974,6 +1410,8 @@ PUBLIC void *ejsCreatePot(Ejs *ejs, EjsType *type, int numProp)
         }
         if (numProp > 0) {
             growSlots(ejs, obj, numProp);
+        } else if (SHAPED_TYPE(type)) {
+            obj->shaped = 1;
         }
         SET_DYNAMIC(obj, 1);
     } else {
@@ -1011,12 +1449,24 @@ PUBLIC void ejsManagePot(void *ptr, int flags)
 {
     EjsSlot     *sp;
     EjsPot      *obj;
+    EjsValues   *values;
     int         i, numProp;
 
     if (ptr) {
         obj = (EjsPot*) ptr;
 
         if (flags & MPR_MANAGE_MARK) {
+            if (obj->shaped) {
+                if ((values = VALUES(obj)) != 0) {
+                    mprMark(values);
+                    mprMark(values->shape);
+                    numProp = obj->numProp;
+                    for (i = 0; i < numProp; i++) {
+                        mprMark(values->values[i]);
+                    }
+                }
+                return;
+            }
             if (obj->separateSlots) {
                 mprMark(obj->properties);
             }
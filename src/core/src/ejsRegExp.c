@@ -14,9 +14,27 @@
     #define BIT_MAX_REGEX_MATCHES 64
 #endif
 
+/*
+    Compiled regular expression program. Programs are immutable and are shared by all RegExp objects with the same
+    pattern and flags via the service-wide regular expression cache. Match state such as lastIndex is kept per object.
+ */
+typedef struct EjsRegProgram {
+    wchar           *pattern;           /* Pattern to match */
+    void            *compiled;          /* Compiled pattern (malloced by pcre) */
+    int             options;            /* Pattern matching options */
+    uint            global: 1;          /* Search for pattern globally */
+    uint            ignoreCase: 1;      /* Do case insensitive matching */
+    uint            multiline: 1;       /* Match patterns over multiple lines */
+    uint            sticky: 1;          /* Sticky match */
+} EjsRegProgram;
+
 /********************************* Forwards ***********************************/
 
+static EjsRegExp *bindProgram(EjsRegExp *rp, EjsRegProgram *prog);
+static EjsRegProgram *createProgram(Ejs *ejs, EjsRegExp *rp, cchar *key);
+static char *makeKey(EjsRegExp *rp, wchar *pattern);
 static char *makeFlags(EjsRegExp *rp);
+static EjsRegProgram *lookupProgram(Ejs *ejs, cchar *key);
 static int parseFlags(EjsRegExp *rp, wchar *flags);
 
 /******************************************************************************/
@@ -75,23 +93,25 @@ static EjsAny *castRegExp(Ejs *ejs, EjsRegExp *rp, EjsType *type)
 
 static EjsRegExp *regex_Constructor(Ejs *ejs, EjsRegExp *rp, int argc, EjsObj **argv)
 {
-    cchar       *errMsg;
-    int         column, errCode;
+    EjsRegProgram   *prog;
+    wchar           *pattern;
+    char            *key;
 
-    rp->pattern = wclone(ejsToString(ejs, argv[0])->value);
+    pattern = ejsToString(ejs, argv[0])->value;
+    rp->global = rp->ignoreCase = rp->multiline = rp->sticky = 0;
     rp->options = PCRE_JAVASCRIPT_COMPAT;
 
     if (argc == 2) {
         rp->options |= parseFlags(rp, ejsToString(ejs, argv[1])->value);
     }
-    if (rp->compiled) {
-        free(rp->compiled);
-    }
-    if ((rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL)) == 0) {
-        ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
-        return 0;
+    key = makeKey(rp, pattern);
+    if ((prog = lookupProgram(ejs, key)) == 0) {
+        rp->pattern = wclone(pattern);
+        if ((prog = createProgram(ejs, rp, key)) == 0) {
+            return 0;
+        }
     }
-    return rp;
+    return bindProgram(rp, prog);
 }
 
 
@@ -224,21 +244,22 @@ PUBLIC EjsString *ejsRegExpToString(Ejs *ejs, EjsRegExp *rp)
  */
 PUBLIC EjsRegExp *ejsCreateRegExp(Ejs *ejs, cchar *pattern, cchar *flags)
 {
-    EjsRegExp   *rp;
-    cchar       *errMsg;
-    int         column, errCode;
+    EjsRegExp       *rp;
+    EjsRegProgram   *prog;
+    char            *key;
 
     if ((rp = ejsCreateObj(ejs, ESV(RegExp), 0)) == 0) {
         return 0;
     }
-    rp->pattern = sclone(pattern);
     rp->options = parseFlags(rp, (wchar*) flags);
-    rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL);
-    if (rp->compiled == NULL) {
-        ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
-        return 0;
+    key = makeKey(rp, (wchar*) pattern);
+    if ((prog = lookupProgram(ejs, key)) == 0) {
+        rp->pattern = sclone(pattern);
+        if ((prog = createProgram(ejs, rp, key)) == 0) {
+            return 0;
+        }
     }
-    return rp;
+    return bindProgram(rp, prog);
 }
 
 
@@ -248,11 +269,10 @@ PUBLIC EjsRegExp *ejsCreateRegExp(Ejs *ejs, cchar *pattern, cchar *flags)
  */
 PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern)
 {
-    EjsRegExp   *rp;
-    cchar       *errMsg;
-    char        *cp, *dp;
-    wchar       *flags;
-    int         column, errCode;
+    EjsRegExp       *rp;
+    EjsRegProgram   *prog;
+    char            *cp, *dp;
+    wchar           *flags;
 
     if (pattern->length == 0 || pattern->value[0] != '/') {
         ejsThrowArgError(ejs, "Bad regular expression pattern. Must start with '/'");
@@ -261,6 +281,13 @@ PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern)
     if ((rp = ejsCreateObj(ejs, ESV(RegExp), 0)) == 0) {
         return 0;
     }
+    /*
+        Regular expression literals are cached by their source text. This avoids parsing and compiling the literal 
+        each time the literal is evaluated.
+     */
+    if ((prog = lookupProgram(ejs, pattern->value)) != 0) {
+        return bindProgram(rp, prog);
+    }
     /*
         Strip off flags for passing to pcre_compile2
      */
@@ -288,11 +315,98 @@ PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern)
     } else {
         rp->pattern = sclone(&pattern->value[1]);
     }
-    rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL);
-    if (rp->compiled == NULL) {
+    if ((prog = createProgram(ejs, rp, pattern->value)) == 0) {
+        return 0;
+    }
+    return bindProgram(rp, prog);
+}
+
+
+/*
+    Make a cache key for a pattern and the flags parsed into "rp". Keys never start with "/", so they are distinct from
+    the regular expression literals used as keys by ejsParseRegExp.
+ */
+static char *makeKey(EjsRegExp *rp, wchar *pattern)
+{
+    return sfmt("%x%s%s:%s", rp->options, rp->global ? "g" : "", rp->sticky ? "y" : "", pattern);
+}
+
+
+static EjsRegProgram *lookupProgram(Ejs *ejs, cchar *key)
+{
+    EjsService      *sp;
+    EjsRegProgram   *prog;
+
+    sp = ejs->service;
+    lock(sp);
+    prog = (sp->regexCache) ? mprLookupKey(sp->regexCache, key) : 0;
+    unlock(sp);
+    return prog;
+}
+
+
+static void manageRegProgram(EjsRegProgram *prog, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(prog->pattern);
+
+    } else if (flags & MPR_MANAGE_FREE) {
+        if (prog->compiled) {
+            free(prog->compiled);
+            prog->compiled = 0;
+        }
+    }
+}
+
+
+/*
+    Compile the pattern and flags in "rp" and add the program to the cache. When the cache is full, it is replaced.
+    Programs still used by RegExp objects stay alive until those objects are collected.
+ */
+static EjsRegProgram *createProgram(Ejs *ejs, EjsRegExp *rp, cchar *key)
+{
+    EjsService      *sp;
+    EjsRegProgram   *prog;
+    cchar           *errMsg;
+    int             column, errCode;
+
+    if ((prog = mprAllocObj(EjsRegProgram, manageRegProgram)) == 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
+    prog->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL);
+    if (prog->compiled == NULL) {
         ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
         return 0;
     }
+    prog->pattern = rp->pattern;
+    prog->options = rp->options;
+    prog->global = rp->global;
+    prog->ignoreCase = rp->ignoreCase;
+    prog->multiline = rp->multiline;
+    prog->sticky = rp->sticky;
+
+    sp = ejs->service;
+    lock(sp);
+    if (sp->regexCache == 0 || mprGetHashLength(sp->regexCache) >= EJS_REGEXP_CACHE_MAX) {
+        sp->regexCache = mprCreateHash(EJS_REGEXP_CACHE_MAX, 0);
+    }
+    mprAddKey(sp->regexCache, key, prog);
+    unlock(sp);
+    return prog;
+}
+
+
+static EjsRegExp *bindProgram(EjsRegExp *rp, EjsRegProgram *prog)
+{
+    rp->program = prog;
+    rp->compiled = prog->compiled;
+    rp->pattern = prog->pattern;
+    rp->options = prog->options;
+    rp->global = prog->global;
+    rp->ignoreCase = prog->ignoreCase;
+    rp->multiline = prog->multiline;
+    rp->sticky = prog->sticky;
     return rp;
 }
 
@@ -378,12 +492,8 @@ static void manageRegExp(EjsRegExp *rp, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         mprMark(rp->pattern);
-
-    } else if (flags & MPR_MANAGE_FREE) {
-        if (rp->compiled) {
-            free(rp->compiled);
-            rp->compiled = 0;
-        }
+        mprMark(rp->program);
+        mprMark(rp->matched);
     }
 }
 
@@ -16,16 +16,22 @@
 #endif
 
 static int internHashSizes[] = {
-     389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 0
+     53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317, 196613, 0
 };
 
 /***************************** Forward Declarations ***************************/
 
 static EjsString *buildString(Ejs *ejs, EjsString *result, wchar *str, ssize len);
-static ssize indexof(wchar *str, ssize len, EjsString *pattern, ssize patternLength, int dir);
+static EjsString *finishString(Ejs *ejs, EjsString *sp);
+static int compareCaseless(wchar *s1, ssize len1, wchar *s2, ssize len2);
+static ssize findChar(wchar *str, ssize len, int c);
+static ssize indexof(wchar *str, ssize len, wchar *pat, ssize patLen, int dir);
+static ssize skipSpace(wchar *str, ssize len);
+static ssize skipSpaceBack(wchar *str, ssize len);
 static void linkString(EjsString *head, EjsString *sp);
+static void manageBuckets(EjsString *buckets, int flags);
 static void manageIntern(EjsIntern *intern, int flags);
-static int rebuildIntern(EjsIntern *intern);
+static int growShard(EjsInternShard *shard);
 static void unlinkString(EjsString *sp);
 
 /************************************* Code ***********************************/
@@ -39,7 +45,7 @@ static EjsAny *castString(Ejs *ejs, EjsString *sp, EjsType *type)
 
     switch (type->sid) {
     case S_Boolean:
-        if (sp != ESV(empty)) {
+        if (sp->length > 0) {
             return ESV(true);
         }
         return ESV(false);
@@ -169,21 +175,11 @@ static EjsAny *invokeStringOperator(Ejs *ejs, EjsString *lhs, int opcode, EjsStr
     switch (opcode) {
     case EJS_OP_COMPARE_STRICTLY_EQ:
     case EJS_OP_COMPARE_EQ:
-        //  OPT -- should use lhs == rhs
-        if (lhs->value == rhs->value) {
-            assert(lhs == rhs);
-            return ESV(true);
-        }
-        return ESV(false);
+        return ejsMatchString(lhs, rhs) ? ESV(true) : ESV(false);
 
     case EJS_OP_COMPARE_NE:
     case EJS_OP_COMPARE_STRICTLY_NE:
-        //  OPT -- should use lhs == rhs
-        if (lhs->value != rhs->value) {
-            assert(lhs != rhs);
-            return ESV(true);
-        }
-        return ESV(false);
+        return ejsMatchString(lhs, rhs) ? ESV(false) : ESV(true);
 
     case EJS_OP_COMPARE_LT:
         return ejsCreateBoolean(ejs, 
@@ -291,7 +287,7 @@ static EjsString *stringConstructor(Ejs *ejs, EjsString *sp, int argc, EjsObj **
             return ejsToString(ejs, ejsGetProperty(ejs, args, 0));
         }
     }
-    return ejsInternString(sp);
+    return finishString(ejs, sp);
 }
 
 
@@ -318,12 +314,12 @@ static EjsNumber *caseCompare(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
  */
 static EjsNumber *caselessCompare(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
 {
-    int     result;
+    EjsString   *other;
 
     assert(argc == 1 && ejsIs(ejs, argv[0], String));
 
-    result = wcasecmp(sp->value, ((EjsString*) argv[0])->value);
-    return ejsCreateNumber(ejs, result);
+    other = (EjsString*) argv[0];
+    return ejsCreateNumber(ejs, compareCaseless(sp->value, sp->length, other->value, other->length));
 }
 
 
@@ -406,7 +402,10 @@ static EjsBoolean *containsString(Ejs *ejs, EjsString *sp, int argc, EjsObj **ar
 
     if (ejsIs(ejs, pat, String)) {
         spat = (EjsString*) pat;
-        return ejsCreateBoolean(ejs, wcontains(sp->value, spat->value) != 0);
+        if (spat->length == 0) {
+            return ESV(false);
+        }
+        return ejsCreateBoolean(ejs, indexof(sp->value, sp->length, spat->value, spat->length, 1) >= 0);
 
     } else if (ejsIs(ejs, pat, RegExp)) {
         EjsRegExp   *rp;
@@ -496,6 +495,7 @@ static EjsString *expandString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     EjsAny      *obj, *options, *vp;
     EjsString   *join;
     char        *src, *cp, *tok, *fill;
+    ssize       len;
 
     fill = 0;
     join = ejsCreateStringFromAsc(ejs, " ");
@@ -521,7 +521,7 @@ static EjsString *expandString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
         return ESV(empty);
     }
     //  UNICODE
-    if (schr(sp->value, '$') == 0) {
+    if (findChar(sp->value, sp->length, '$') < 0) {
         return sp;
     }
     buf = mprCreateBuf(0, 0);
@@ -541,7 +541,11 @@ static EjsString *expandString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
                 src = cp + 1;
             }
         } else {
-            mprPutCharToBuf(buf, *src++);
+            /* Copy up to the next '$' */
+            len = findChar(&src[1], &sp->value[sp->length] - src - 1, '$');
+            len = (len < 0) ? &sp->value[sp->length] - src : len + 1;
+            mprPutBlockToBuf(buf, src, len);
+            src += len;
         }
     }
     mprAddNullToBuf(buf);
@@ -670,7 +674,7 @@ static EjsString *formatString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     if (sp->length > last) {
         result = buildString(ejs, result, &sp->value[last], sp->length - last);
     }
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -698,7 +702,7 @@ static EjsString *fromCharCode(Ejs *ejs, EjsString *unused, int argc, EjsObj **a
     }
     result->value[i] = '\0';
     result->length = args->length;
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -808,7 +812,7 @@ static EjsNumber *indexOf(Ejs *ejs, EjsString *sp, int argc,  EjsObj **argv)
     } else {
         start = 0;
     }
-    index = indexof(&sp->value[start], sp->length - start, pattern, patternLength, 1);
+    index = indexof(&sp->value[start], sp->length - start, pattern->value, patternLength, 1);
     if (index < 0) {
         return ESV(minusOne);
     }
@@ -938,7 +942,7 @@ static EjsNumber *lastIndexOf(Ejs *ejs, EjsString *sp, int argc,  EjsObj **argv)
     } else {
         start = 0;
     }
-    index = indexof(sp->value, sp->length, pattern, patternLength, -1);
+    index = indexof(sp->value, sp->length, pattern->value, patternLength, -1);
     if (index < 0) {
         return ESV(minusOne);
     }
@@ -1031,7 +1035,7 @@ static EjsString *printable(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     }
     result->value[j] = '\0';
     result->length = j;
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1047,7 +1051,7 @@ static EjsString *quote(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     result->value[sp->length + 1] = '"';
     result->value[sp->length + 2] = '\0';
     result->length = sp->length + 2;
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1095,7 +1099,7 @@ static EjsString *removeCharsFromString(Ejs *ejs, EjsString *sp, int argc, EjsOb
         result->value[j] = sp->value[i];
     }
     result->value[j] = '\0';
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1246,7 +1250,7 @@ static EjsString *replace(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     } else {
         pattern = ejsToString(ejs, argv[0]);
         patternLength = pattern->length;
-        index = indexof(sp->value, sp->length, pattern, patternLength, 1);
+        index = indexof(sp->value, sp->length, pattern->value, patternLength, 1);
         if (index >= 0) {
             if ((result = ejsCreateBareString(ejs, BIT_MAX_BUFFER)) == NULL) {
                 return 0;
@@ -1269,7 +1273,7 @@ static EjsString *replace(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
             result = ejsClone(ejs, sp, 0);
         }
     }
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1289,7 +1293,7 @@ static EjsString *reverseString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv
     for (i = sp->length - 1; i >= 0; i--) {
         *cp++ = sp->value[i];
     }
-    return ejsInternString(rp);
+    return finishString(ejs, rp);
 }
 
 
@@ -1307,7 +1311,7 @@ static EjsNumber *searchString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     if (ejsIs(ejs, argv[0], String)) {
         pattern = (EjsString*) argv[0];
         patternLength = (int) pattern->length;
-        index = indexof(sp->value, sp->length, pattern, patternLength, 1);
+        index = indexof(sp->value, sp->length, pattern->value, patternLength, 1);
         return ejsCreateNumber(ejs, (MprNumber) index);
 
     } else if (ejsIs(ejs, argv[0], RegExp)) {
@@ -1382,7 +1386,7 @@ static EjsString *sliceString(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     }
     result->value[j] = '\0';
     result->length = j;
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1395,8 +1399,8 @@ static EjsArray *split(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
 {
     EjsArray    *results;
     EjsString   *elt, *delim;
-    wchar       *cp, *mark, *end;
-    ssize      limit;
+    wchar       *cp, *end;
+    ssize       limit, len, index;
 
     assert(1 <= argc && argc <= 2);
 
@@ -1410,16 +1414,25 @@ static EjsArray *split(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
                 ejsSetProperty(ejs, results, -1, ejsCreateString(ejs, cp, 1));
             }
         } else {
+            /*
+                The limit counts the candidate positions examined for the delimiter
+             */
             end = &sp->value[sp->length];
-            for (mark = cp = sp->value; limit > 0 && mark < end; mark++, limit--) {
-                if (wncmp(mark, delim->value, delim->length) == 0) {
-                    elt = ejsCreateString(ejs, cp, (int) (mark - cp));
-                    ejsSetProperty(ejs, results, -1, elt);
-                    cp = mark + delim->length;
-                    mark = cp - 1;
+            for (cp = sp->value; limit > 0 && cp < end; ) {
+                len = end - cp;
+                if (limit < len) {
+                    len = min(len, limit + delim->length - 1);
+                }
+                if ((index = indexof(cp, len, delim->value, delim->length, 1)) < 0) {
+                    break;
                 }
+                elt = ejsCreateString(ejs, cp, (int) index);
+                ejsSetProperty(ejs, results, -1, elt);
+                cp += index + delim->length;
+                limit -= index + 1;
             }
-            elt = ejsCreateString(ejs, cp, (int) (mark - cp));
+            len = max(min(limit, end - cp), 0);
+            elt = ejsCreateString(ejs, cp, (int) len);
             ejsSetProperty(ejs, results, -1, elt);
         }
         return results;
@@ -1530,7 +1543,7 @@ static EjsString *toCamel(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     }
     memcpy(result->value, sp->value, sp->length * sizeof(wchar));
     result->value[0] = tolower((uchar) sp->value[0]);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1590,7 +1603,7 @@ static EjsString *toPascal(Ejs *ejs, EjsString *sp, int argc, EjsObj **argv)
     }
     memcpy(result->value, sp->value, sp->length * sizeof(wchar));
     result->value[0] = toupper((uchar) sp->value[0]);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1677,21 +1690,12 @@ static EjsString *trim(Ejs *ejs, EjsString *sp, EjsString *pattern, int where)
     if (pattern == 0) {
         start = sp->value;
         if (where & MPR_TRIM_START) {
-            for (; start < &sp->value[sp->length]; start++) {
-                if (!isspace((uchar) *start)) {
-                    break;
-                }
-            }
+            start += skipSpace(sp->value, sp->length);
         }
-        end = &sp->value[sp->length - 1];
+        end = &sp->value[sp->length];
         if (where & MPR_TRIM_END) {
-            for (end = &sp->value[sp->length - 1]; end >= start; end--) {
-                if (!isspace((uchar) *end)) {
-                    break;
-                }
-            }
+            end = start + skipSpaceBack(start, end - start);
         }
-        end++;
     } else {
         patternLength = pattern->length;
         if (patternLength <= 0 || patternLength > sp->length) {
@@ -1700,7 +1704,7 @@ static EjsString *trim(Ejs *ejs, EjsString *sp, EjsString *pattern, int where)
         mark = sp->value;
         if (where & MPR_TRIM_START) {
             for (; &mark[patternLength] <= &sp->value[sp->length]; mark += patternLength) {
-                index = indexof(mark, patternLength, pattern, patternLength, 1);
+                index = indexof(mark, patternLength, pattern->value, patternLength, 1);
                 if (index != 0) {
                     break;
                 }
@@ -1711,7 +1715,7 @@ static EjsString *trim(Ejs *ejs, EjsString *sp, EjsString *pattern, int where)
         mark = &sp->value[sp->length - patternLength];
         if (where & MPR_TRIM_END) {
             for (; mark >= sp->value; mark -= patternLength) {
-                index = indexof(mark, patternLength, pattern, patternLength, 1);
+                index = indexof(mark, patternLength, pattern->value, patternLength, 1);
                 if (index != 0) {
                     break;
                 }
@@ -1855,38 +1859,167 @@ static EjsString *buildString(Ejs *ejs, EjsString *result, wchar *str, ssize len
 }
 
 
+/*
+    Return a completed string result. Results are not interned until they are used as property names.
+ */
+static EjsString *finishString(Ejs *ejs, EjsString *sp)
+{
+    if (sp && sp->length == 0) {
+        return ESV(empty);
+    }
+    return sp;
+}
+
+
+/*
+    Vectorized search primitives for 8-bit characters. These examine a vector of characters per step and finish with
+    a scalar loop. The vector width is selected when compiling: AVX2 if enabled (-mavx2), otherwise SSE2 which is
+    always available on x64.
+ */
+#if BIT_CHAR_LEN == 1 && defined(__AVX2__)
+    #include <immintrin.h>
+    #define EJS_SIMD_STRINGS 1
+    #define VEC_SIZE        32
+    #define VEC_ALL         0xFFFFFFFF
+    typedef __m256i         Vec;
+    #define vecLoad(p)      _mm256_loadu_si256((const Vec*) (p))
+    #define vecSet(c)       _mm256_set1_epi8((char) (c))
+    #define vecEq(a, b)     _mm256_cmpeq_epi8(a, b)
+    #define vecAnd(a, b)    _mm256_and_si256(a, b)
+    #define vecOr(a, b)     _mm256_or_si256(a, b)
+    #define vecSub(a, b)    _mm256_sub_epi8(a, b)
+    #define vecMin(a, b)    _mm256_min_epu8(a, b)
+    #define vecMask(a)      ((uint) _mm256_movemask_epi8(a))
+#elif BIT_CHAR_LEN == 1 && defined(__SSE2__)
+    #include <emmintrin.h>
+    #define EJS_SIMD_STRINGS 1
+    #define VEC_SIZE        16
+    #define VEC_ALL         0xFFFF
+    typedef __m128i         Vec;
+    #define vecLoad(p)      _mm_loadu_si128((const Vec*) (p))
+    #define vecSet(c)       _mm_set1_epi8((char) (c))
+    #define vecEq(a, b)     _mm_cmpeq_epi8(a, b)
+    #define vecAnd(a, b)    _mm_and_si128(a, b)
+    #define vecOr(a, b)     _mm_or_si128(a, b)
+    #define vecSub(a, b)    _mm_sub_epi8(a, b)
+    #define vecMin(a, b)    _mm_min_epu8(a, b)
+    #define vecMask(a)      ((uint) _mm_movemask_epi8(a))
+#endif
+
+#if EJS_SIMD_STRINGS
+#define firstBit(mask)      __builtin_ctz(mask)
+#define lastBit(mask)       (31 - __builtin_clz(mask))
+
+/*
+    Test for characters in the range [lo, lo + span]. Unsigned wrap maps characters below lo above the span.
+    Callers create the constant vectors outside their loops.
+ */
+#define vecRange(v, lo, span)   vecEq(vecMin(vecSub(v, lo), span), vecSub(v, lo))
+
+/*
+    White space as defined by isspace() in the C locale: space and \t \n \v \f \r
+ */
+#define SPACE_VECTORS           Vec space = vecSet(' '), tab = vecSet('\t'), tabSpan = vecSet('\r' - '\t')
+#define spaceMask(v)            vecMask(vecOr(vecEq(v, space), vecRange(v, tab, tabSpan)))
+#endif /* EJS_SIMD_STRINGS */
+
+
+/*
+    Return the index of the first occurrence of a character or -1 if not found
+ */
+static ssize findChar(wchar *str, ssize len, int c)
+{
+#if BIT_CHAR_LEN == 1
+    char    *cp;
+
+    /* The C library memchr is vectorized and selects the best instructions for the CPU at runtime */
+    if ((cp = memchr(str, c, len)) == 0) {
+        return -1;
+    }
+    return cp - str;
+#else
+    ssize   i;
+
+    for (i = 0; i < len; i++) {
+        if (str[i] == c) {
+            return i;
+        }
+    }
+    return -1;
+#endif
+}
+
+
 /*
     Find a substring. Search forward or backwards. Return the index in the string where the pattern was found.
-    Return -1 if not found.
+    Return -1 if not found. The vectorized search compares the first and last pattern characters at each candidate
+    position and only compares the full pattern where both match.
  */
-static ssize indexof(wchar *str, ssize len, EjsString *pattern, ssize patternLength, int dir)
+static ssize indexof(wchar *str, ssize len, wchar *pat, ssize patLen, int dir)
 {
-    wchar       *s1, *s2;
-    ssize       i, j;
+    ssize       i, last;
+#if EJS_SIMD_STRINGS
+    Vec         first, final;
+    uint        mask;
+    int         bit;
+#endif
 
     assert(dir == 1 || dir == -1);
 
+    if (patLen <= 0) {
+        if (len <= 0) {
+            return -1;
+        }
+        return (dir > 0) ? 0 : len - 1;
+    }
+    if (patLen > len) {
+        return -1;
+    }
+    last = patLen - 1;
     if (dir > 0) {
-        for (i = 0; i < len; i++) {
-            s1 = &str[i];
-            for (j = 0, s2 = pattern->value; j < patternLength; s1++, s2++, j++) {
-                if (*s1 != *s2) {
-                    break;
+        if (patLen == 1) {
+            return findChar(str, len, pat[0]);
+        }
+        i = 0;
+#if EJS_SIMD_STRINGS
+        first = vecSet(pat[0]);
+        final = vecSet(pat[last]);
+        for (; i + last + VEC_SIZE <= len; i += VEC_SIZE) {
+            mask = vecMask(vecAnd(vecEq(first, vecLoad(&str[i])), vecEq(final, vecLoad(&str[i + last]))));
+            while (mask) {
+                bit = firstBit(mask);
+                if (memcmp(&str[i + bit + 1], &pat[1], (patLen - 2) * sizeof(wchar)) == 0) {
+                    return i + bit;
                 }
+                mask &= mask - 1;
             }
-            if (*s2 == '\0') {
+        }
+#endif
+        for (; i + patLen <= len; i++) {
+            if (str[i] == pat[0] && str[i + last] == pat[last] && memcmp(&str[i], pat, patLen * sizeof(wchar)) == 0) {
                 return i;
             }
         }
     } else {
-        for (i = len - 1; i >= 0; i--) {
-            s1 = &str[i];
-            for (j = 0, s2 = pattern->value; j < patternLength; s1++, s2++, j++) {
-                if (*s1 != *s2) {
-                    break;
+        /* Candidate positions are [0, i] */
+        i = len - patLen;
+#if EJS_SIMD_STRINGS
+        first = vecSet(pat[0]);
+        final = vecSet(pat[last]);
+        for (; i + 1 >= VEC_SIZE; i -= VEC_SIZE) {
+            mask = vecMask(vecAnd(vecEq(first, vecLoad(&str[i + 1 - VEC_SIZE])), 
+                vecEq(final, vecLoad(&str[i + 1 - VEC_SIZE + last]))));
+            while (mask) {
+                bit = lastBit(mask);
+                if (memcmp(&str[i + 1 - VEC_SIZE + bit], pat, patLen * sizeof(wchar)) == 0) {
+                    return i + 1 - VEC_SIZE + bit;
                 }
+                mask &= ~(1U << bit);
             }
-            if (*s2 == '\0') {
+        }
+#endif
+        for (; i >= 0; i--) {
+            if (str[i] == pat[0] && str[i + last] == pat[last] && memcmp(&str[i], pat, patLen * sizeof(wchar)) == 0) {
                 return i;
             }
         }
@@ -1894,7 +2027,140 @@ static ssize indexof(wchar *str, ssize len, EjsString *pattern, ssize patternLen
     return -1;
 }
 
+
+/*
+    Return the index of the first character that is not white space, or len if all white space
+ */
+static ssize skipSpace(wchar *str, ssize len)
+{
+    ssize   i;
+#if EJS_SIMD_STRINGS
+    SPACE_VECTORS;
+    Vec     v;
+    uint    mask;
+
+    for (i = 0; i + VEC_SIZE <= len; i += VEC_SIZE) {
+        v = vecLoad(&str[i]);
+        if ((mask = ~spaceMask(v) & VEC_ALL) != 0) {
+            return i + firstBit(mask);
+        }
+    }
+#else
+    i = 0;
+#endif
+    for (; i < len; i++) {
+        if (!isspace((uchar) str[i])) {
+            break;
+        }
+    }
+    return i;
+}
+
+
+/*
+    Return the index after the last character that is not white space, or zero if all white space
+ */
+static ssize skipSpaceBack(wchar *str, ssize len)
+{
+    ssize   i;
+#if EJS_SIMD_STRINGS
+    SPACE_VECTORS;
+    Vec     v;
+    uint    mask;
+
+    for (i = len; i >= VEC_SIZE; i -= VEC_SIZE) {
+        v = vecLoad(&str[i - VEC_SIZE]);
+        if ((mask = ~spaceMask(v) & VEC_ALL) != 0) {
+            return i - VEC_SIZE + lastBit(mask) + 1;
+        }
+    }
+#else
+    i = len;
+#endif
+    for (; i > 0; i--) {
+        if (!isspace((uchar) str[i - 1])) {
+            break;
+        }
+    }
+    return i;
+}
+
+
+/*
+    Compare two strings ignoring the case of ASCII letters. Return -1, 0 or 1.
+ */
+static int compareCaseless(wchar *s1, ssize len1, wchar *s2, ssize len2)
+{
+    ssize   i, len;
+    int     rc;
+#if EJS_SIMD_STRINGS
+    Vec     upper, span, caseBit, v1, v2;
+    uint    mask;
+#endif
+
+    len = min(len1, len2);
+    i = 0;
+#if EJS_SIMD_STRINGS
+    /* Map A-Z to lower case by setting the case bit */
+    upper = vecSet('A');
+    span = vecSet('Z' - 'A');
+    caseBit = vecSet(0x20);
+    for (; i + VEC_SIZE <= len; i += VEC_SIZE) {
+        v1 = vecLoad(&s1[i]);
+        v2 = vecLoad(&s2[i]);
+        v1 = vecOr(v1, vecAnd(vecRange(v1, upper, span), caseBit));
+        v2 = vecOr(v2, vecAnd(vecRange(v2, upper, span), caseBit));
+        if ((mask = ~vecMask(vecEq(v1, v2)) & VEC_ALL) != 0) {
+            i += firstBit(mask);
+            break;
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        if ((rc = tolower((uchar) s1[i]) - tolower((uchar) s2[i])) != 0) {
+            return (rc > 0) ? 1 : -1;
+        }
+    }
+    if (len1 == len2) {
+        return 0;
+    }
+    return (len1 < len2) ? -1 : 1;
+}
+
 /******************************************** String API *******************************************/
+/*
+    String builders are bare strings that link to themselves. They are not interned and are only referenced from
+    the interpreter stack while a chain of additions is evaluated, so they may be appended to in place.
+ */
+#define isBuilder(sp) ((sp)->next == 0 && (sp)->prev == (sp))
+
+PUBLIC EjsString *ejsAppendString(Ejs *ejs, EjsString *dest, EjsString *src)
+{
+    EjsString   *result;
+    ssize       len, room;
+
+    len = dest->length + src->length;
+    if (isBuilder(dest)) {
+        room = (mprGetBlockSize(dest) - sizeof(EjsString)) / sizeof(wchar);
+        if (len < room) {
+            memcpy(&dest->value[dest->length], src->value, src->length * sizeof(wchar));
+            dest->length = len;
+            dest->value[len] = 0;
+            return dest;
+        }
+    }
+    /* Grow geometrically so a chain of additions copies each character a constant number of times */
+    if ((result = ejsCreateBareString(ejs, len + max(len / 2, 32))) == NULL) {
+        return NULL;
+    }
+    memcpy(result->value, dest->value, dest->length * sizeof(wchar));
+    memcpy(&result->value[dest->length], src->value, src->length * sizeof(wchar));
+    result->length = len;
+    result->value[len] = 0;
+    result->prev = result;
+    return result;
+}
+
 
 PUBLIC int ejsAtoi(Ejs *ejs, EjsString *sp, int radix)
 {
@@ -1913,6 +2179,13 @@ PUBLIC EjsString *ejsJoinString(Ejs *ejs, EjsString *s1, EjsString *s2)
     EjsString   *result;
     ssize       len;
 
+    if (isBuilder(s1)) {
+        if ((result = ejsAppendString(ejs, s1, s2)) == NULL) {
+            return NULL;
+        }
+        result->prev = 0;
+        return finishString(ejs, result);
+    }
     if (s1->length == 0) {
         return s2;
     }
@@ -1925,7 +2198,7 @@ PUBLIC EjsString *ejsJoinString(Ejs *ejs, EjsString *s1, EjsString *s2)
     }
     memcpy(result->value, s1->value, s1->length * sizeof(wchar));
     memcpy(&result->value[s1->length], s2->value, s2->length * sizeof(wchar));
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -1956,7 +2229,7 @@ PUBLIC EjsString *ejsJoinStrings(Ejs *ejs, EjsString *src, ...)
         result->length += src->length;
     }
     va_end(args);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -2051,6 +2324,21 @@ PUBLIC int ejsCompareString(Ejs *ejs, EjsString *sp1, EjsString *sp2)
 }
 
 
+PUBLIC bool ejsMatchString(EjsString *s1, EjsString *s2)
+{
+    if (s1 == s2) {
+        return 1;
+    }
+    if (s1->length != s2->length || (ejsIsInterned(s1) && ejsIsInterned(s2))) {
+        return 0;
+    }
+    if (s1->hash && s2->hash && s1->hash != s2->hash) {
+        return 0;
+    }
+    return memcmp(s1->value, s2->value, s1->length * sizeof(wchar)) == 0;
+}
+
+
 PUBLIC int ejsCompareSubstring(Ejs *ejs, EjsString *sp1, EjsString *sp2, ssize offset, ssize len)
 {
     assert(0 <= len && len < MAXINT);
@@ -2103,16 +2391,9 @@ PUBLIC int ejsCompareWide(Ejs *ejs, EjsString *sp1, wchar *sp2, ssize len)
  */
 PUBLIC int ejsContainsChar(Ejs *ejs, EjsString *sp, int charPat)
 {
-    int     i;
-
     assert(sp);
 
-    for (i = 0; i < sp->length; i++) {
-        if (sp->value[i] == charPat) {
-            return i;
-        }
-    }
-    return -1;
+    return (int) findChar(sp->value, sp->length, charPat);
 }
 
 
@@ -2147,7 +2428,9 @@ PUBLIC int ejsContainsStringAnyCase(Ejs *ejs, EjsString *sp, EjsString *pat)
 PUBLIC int ejsContainsAsc(Ejs *ejs, EjsString *sp, cchar *pat)
 {
     ssize   len;
+#if BIT_CHAR_LEN > 1
     int     i, j, k;
+#endif
 
     assert(sp);
     assert(pat);
@@ -2156,7 +2439,9 @@ PUBLIC int ejsContainsAsc(Ejs *ejs, EjsString *sp, cchar *pat)
         return 0;
     }
     len = strlen(pat);
-    
+#if BIT_CHAR_LEN == 1
+    return (int) indexof(sp->value, sp->length, (wchar*) pat, len, 1);
+#else
     for (i = 0; i < sp->length; i++) {
         for (j = 0, k = i; j < len; j++, k++) {
             if (sp->value[k] != pat[j]) {
@@ -2168,13 +2453,12 @@ PUBLIC int ejsContainsAsc(Ejs *ejs, EjsString *sp, cchar *pat)
         }
     }
     return -1;
+#endif
 }
 
 
 PUBLIC int ejsContainsString(Ejs *ejs, EjsString *sp, EjsString *pat)
 {
-    int     i, j, k;
-
     assert(sp);
     assert(pat);
     assert(pat->value);
@@ -2182,17 +2466,7 @@ PUBLIC int ejsContainsString(Ejs *ejs, EjsString *sp, EjsString *pat)
     if (pat == 0 || pat->value == 0) {
         return 0;
     }
-    for (i = 0; i < sp->length; i++) {
-        for (j = 0, k = i; j < pat->length; j++, k++) {
-            if (sp->value[k] != pat->value[j]) {
-                break;
-            }
-        }
-        if (j == pat->length) {
-            return 1;
-        }
-    }
-    return -1;
+    return indexof(sp->value, sp->length, pat->value, pat->length, 1) >= 0 ? 1 : -1;
 }
 
 
@@ -2259,7 +2533,7 @@ PUBLIC EjsString *ejsSubstring(Ejs *ejs, EjsString *src, ssize start, ssize len)
         return NULL;
     }
     memcpy(result->value, &src->value[start], len);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -2275,7 +2549,7 @@ PUBLIC EjsString *ejsToLower(Ejs *ejs, EjsString *sp)
     for (i = 0; i < sp->length; i++) {
         result->value[i] = tolower((uchar) sp->value[i]);
     }
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -2291,7 +2565,7 @@ PUBLIC EjsString *ejsToUpper(Ejs *ejs, EjsString *sp)
     for (i = 0; i < sp->length; i++) {
         result->value[i] = toupper((uchar) sp->value[i]);
     }
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
@@ -2338,7 +2612,7 @@ PUBLIC EjsString *ejsTrimString(Ejs *ejs, EjsString *sp, cchar *pat, int flags)
     }
     result = ejsCreateBareString(ejs, sp->length - trimmed);
     memcpy(result->value, start, result->length);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 #endif
 
@@ -2352,103 +2626,179 @@ PUBLIC EjsString *ejsTruncateString(Ejs *ejs, EjsString *sp, ssize len)
     len = min(len, sp->length);
     result = ejsCreateBareString(ejs, len);
     memcpy(result->value, sp->value, len);
-    return ejsInternString(result);
+    return finishString(ejs, result);
 }
 
 
 /*********************************** Interning *********************************/
+/*
+    The intern hash is split into shards selected by the string hash. Each shard has its own lock. When a shard grows,
+    the new bucket array replaces the old and the old buckets are migrated a few at a time by later accesses. Old
+    buckets are also migrated on demand before they are searched. This keeps the time a shard lock is held short.
+ */
+#define SHARD(ip, hash)     (&(ip)->shards[(hash) & (EJS_INTERN_SHARDS - 1)])
+#define BUCKET(hash, size)  (((hash) / EJS_INTERN_SHARDS) % (size))
+
+/*
+    Move the strings in an old bucket to the new buckets. Must be called locked.
+ */
+static void migrateBucket(EjsInternShard *shard, int index)
+{
+    EjsString   *head, *sp, *next;
+
+    head = &shard->oldBuckets[index];
+    for (sp = head->next; sp != head; sp = next) {
+        next = sp->next;
+        sp->next = sp->prev = sp;
+        linkString(&shard->buckets[BUCKET(sp->hash, shard->size)], sp);
+    }
+    head->next = head->prev = head;
+}
+
+
+/*
+    Migrate the old bucket for a hash and the next few old buckets in order. Must be called locked.
+ */
+static void migrateBuckets(EjsInternShard *shard, uint hash)
+{
+    int     i;
+
+    migrateBucket(shard, BUCKET(hash, shard->oldSize));
+    for (i = 0; i < EJS_INTERN_MIGRATE && shard->migrated < shard->oldSize; i++) {
+        migrateBucket(shard, shard->migrated++);
+    }
+    if (shard->migrated >= shard->oldSize) {
+        shard->oldBuckets = 0;
+        shard->oldSize = 0;
+        shard->migrated = 0;
+    }
+}
+
+
+/*
+    Lock the shard for a hash and return the head of the bucket chain for the hash
+ */
+static EjsString *lockBucket(EjsIntern *ip, uint hash, EjsInternShard **shardp)
+{
+    EjsInternShard  *shard;
+
+    shard = SHARD(ip, hash);
+    if (!mprTryLock(shard->mutex)) {
+        mprLock(shard->mutex);
+        shard->contended++;
+    }
+    //  MOB - accesses should be debug only
+    shard->accesses++;
+    if (shard->oldBuckets) {
+        migrateBuckets(shard, hash);
+    }
+    *shardp = shard;
+    return &shard->buckets[BUCKET(hash, shard->size)];
+}
+
+
+/*
+    Add a string to a bucket chain and unlock the shard. Start growing the shard if chains get too long.
+ */
+static void addString(EjsInternShard *shard, EjsString *head, EjsString *sp, int step)
+{
+    shard->count++;
+    linkString(head, sp);
+    if (step > EJS_MAX_COLLISIONS && shard->count > (shard->size / 2)) {
+        growShard(shard);
+    }
+    mprUnlock(shard->mutex);
+}
+
+
 /*
     Intern a unicode string. Lookup a string and return an interned string (this may be an existing interned string)
  */
 PUBLIC EjsString *ejsInternString(EjsString *str)
 {
-    EjsString   *head, *sp;
-    EjsIntern   *ip;
-    ssize       i, len;
-    int         index, step;
+    EjsInternShard  *shard;
+    EjsString       *head, *sp;
+    ssize           i, len;
+    int             step;
 
-    ip = ((EjsService*) MPR->ejsService)->intern;
     step = 0;
-
-    lock(ip);
-    //  MOB - accesses should be debug only
-    ip->accesses++;
-    index = whash(str->value, str->length) % ip->size;
-    if ((head = &ip->buckets[index]) != NULL) {
-        for (sp = head->next; sp != head; sp = sp->next, step++) {
-            if (str == sp) {
+    head = lockBucket(((EjsService*) MPR->ejsService)->intern, ejsGetStringHash(str), &shard);
+    for (sp = head->next; sp != head; sp = sp->next, step++) {
+        if (str == sp) {
+            mprRevive(sp);
+            mprUnlock(shard->mutex);
+            return sp;
+        }
+        if (sp->length == str->length && sp->hash == str->hash) {
+            len = min(sp->length, str->length);
+            //  OPT
+            for (i = 0; i < len; i++) {
+                if (sp->value[i] != str->value[i]) {
+                    break;
+                }
+            }
+            if (i == sp->length && i == str->length) {
+                //  MOB - reuse should be debug only
+                shard->reuse++;
+                /* Revive incase almost stale or dead */
                 mprRevive(sp);
-                unlock(ip);
+                mprUnlock(shard->mutex);
                 return sp;
             }
-            if (sp->length == str->length) {
-                len = min(sp->length, str->length);
-                //  OPT
-                for (i = 0; i < len; i++) {
-                    if (sp->value[i] != str->value[i]) {
-                        break;
-                    }
-                }
-                if (i == sp->length && i == str->length) {
-                    //  MOB - reuse should be debug only
-                    ip->reuse++;
-                    /* Revive incase almost stale or dead */
-                    mprRevive(sp);
-                    unlock(ip);
-                    return sp;
-                }
-            }
         }
     }
-    ip->count++;
-    linkString(head, str);
-    if (step > EJS_MAX_COLLISIONS && ip->count > (ip->size/2)) {
-        /*  Remake the entire hash - should not happen often */
-        //  OPT - BAD holding lock while rebuildingIntern
-        rebuildIntern(ip);
-    }
-    unlock(ip);
+    addString(shard, head, str, step);
     return str;
 }
 
 
+/*
+    Intern the name and space of a qualified name. Strings are not interned when created, so this is called where
+    strings become property names. Property names are then compared by reference.
+ */
+PUBLIC void ejsInternName(EjsName *qname)
+{
+    if (qname->name && !ejsIsInterned(qname->name)) {
+        qname->name = ejsInternString(qname->name);
+    }
+    if (qname->space && !ejsIsInterned(qname->space)) {
+        qname->space = ejsInternString(qname->space);
+    }
+}
+
+
 /*
     Intern a wide C string and return an interned wide string
  */
 PUBLIC EjsString *ejsInternWide(Ejs *ejs, wchar *value, ssize len)
 {
-    EjsString   *head, *sp;
-    EjsIntern   *ip;
-    ssize       i, end;
-    int         index, step;
+    EjsInternShard  *shard;
+    EjsString       *head, *sp;
+    ssize           i, end;
+    uint            hash;
+    int             step;
 
     assert(0 <= len && len < MAXINT);
 
-    ip = ejs->service->intern;
     step = 0;
-
-    lock(ip);
-    //  MOB - accesses should be debug only
-    ip->accesses++;
-    index = whash(value, len) % ip->size;
-    if ((head = &ip->buckets[index]) != NULL) {
-        for (sp = head->next; sp != head; sp = sp->next, step++) {
-            if (sp->length == len) {
-                end = min(sp->length, len);
-                for (i = 0; i < end && value[i]; i++) {
-                    if (sp->value[i] != value[i]) {
-                        break;
-                    }
-                }
-                if (i == sp->length) {
-                    //  MOB - reuse should be debug only
-                    ip->reuse++;
-                    /* Revive incase almost stale or dead */
-                    mprRevive(sp);
-                    unlock(ip);
-                    return sp;
+    hash = whash(value, len);
+    head = lockBucket(ejs->service->intern, hash, &shard);
+    for (sp = head->next; sp != head; sp = sp->next, step++) {
+        if (sp->length == len) {
+            end = min(sp->length, len);
+            for (i = 0; i < end && value[i]; i++) {
+                if (sp->value[i] != value[i]) {
+                    break;
                 }
             }
+            if (i == sp->length) {
+                //  MOB - reuse should be debug only
+                shard->reuse++;
+                /* Revive incase almost stale or dead */
+                mprRevive(sp);
+                mprUnlock(shard->mutex);
+                return sp;
+            }
         }
     }
     if ((sp = ejsAlloc(ejs, ESV(String), (len + 1) * sizeof(wchar))) != NULL) {
@@ -2456,53 +2806,41 @@ PUBLIC EjsString *ejsInternWide(Ejs *ejs, wchar *value, ssize len)
         sp->value[len] = 0;
     }
     sp->length = len;
-    ip->count++;
-    linkString(head, sp);
-    if (step > EJS_MAX_COLLISIONS && ip->count > (ip->size/2)) {
-        /*  Remake the entire hash - should not happen often */
-        //  OPT - BAD holding lock while rebuildingIntern
-        rebuildIntern(ip);
-    }
-    unlock(ip);
+    sp->hash = hash;
+    addString(shard, head, sp, step);
     return sp;
 }
 
 
 PUBLIC EjsString *ejsInternAsc(Ejs *ejs, cchar *value, ssize len)
 {
-    EjsString   *head, *sp;
-    EjsIntern   *ip;
-    ssize       i, end;
-    int         index, step;
+    EjsInternShard  *shard;
+    EjsString       *head, *sp;
+    ssize           i, end;
+    uint            hash;
+    int             step;
 
     assert(0 <= len && len < MAXINT);
 
     step = 0;
-    ip = ejs->service->intern;
-
-    lock(ip);
-    //  MOB - accesses should be debug only
-    ip->accesses++;
-    assert(ip->size > 0);
-    index = shash(value, len) % ip->size;
-    if ((head = &ip->buckets[index]) != NULL) {
-        for (sp = head->next; sp != head; sp = sp->next, step++) {
-            if (sp->length == len) {
-                end = min(len, sp->length);
-                for (i = 0; i < end && value[i]; i++) {
-                    if (sp->value[i] != (uchar) value[i]) {
-                        break;
-                    }
-                }
-                if (i == sp->length) {
-                    //  MOB - reuse should be debug only
-                    ip->reuse++;
-                    /* Revive incase almost stale or dead */
-                    mprRevive(sp);
-                    unlock(ip);
-                    return sp;
+    hash = shash(value, len);
+    head = lockBucket(ejs->service->intern, hash, &shard);
+    for (sp = head->next; sp != head; sp = sp->next, step++) {
+        if (sp->length == len) {
+            end = min(len, sp->length);
+            for (i = 0; i < end && value[i]; i++) {
+                if (sp->value[i] != (uchar) value[i]) {
+                    break;
                 }
             }
+            if (i == sp->length) {
+                //  MOB - reuse should be debug only
+                shard->reuse++;
+                /* Revive incase almost stale or dead */
+                mprRevive(sp);
+                mprUnlock(shard->mutex);
+                return sp;
+            }
         }
     }
     if ((sp = ejsAlloc(ejs, ESV(String), (len + 1) * sizeof(wchar))) != NULL) {
@@ -2517,14 +2855,8 @@ PUBLIC EjsString *ejsInternAsc(Ejs *ejs, cchar *value, ssize len)
         sp->value[len] = 0;
     }
     sp->length = len;
-    ip->count++;
-    linkString(head, sp);
-    if (step > EJS_MAX_COLLISIONS && ip->count > (ip->size/2)) {
-        /*  Remake the entire hash - should not happen often */
-        //  OPT - BAD holding lock while rebuildingIntern
-        rebuildIntern(ip);
-    }
-    unlock(ip);
+    sp->hash = hash;
+    addString(shard, head, sp, step);
     return sp;
 }
 
@@ -2539,9 +2871,7 @@ PUBLIC EjsString *ejsInternMulti(Ejs *ejs, cchar *value, ssize len)
 
 PUBLIC EjsString *ejsInternMulti(Ejs *ejs, cchar *value, ssize len)
 {
-    EjsString   *head, *sp, src;
-    ssize       i, end;
-    int         index;
+    EjsString   *src;
 
     assert(0 < len && len < MAXINT);
 
@@ -2552,45 +2882,22 @@ PUBLIC EjsString *ejsInternMulti(Ejs *ejs, cchar *value, ssize len)
         Have to convert the multibyte string to unicode before comparision. Convert into an EjsString to it is ready
         to intern if not found.
      */
-    if ((src = ejsAlloc(ejs, ESV(String), (len + 1) * sizeof(wchar))) != NULL) {
-        src->length = mtow(src->value, len + 1, value, len);
-        value = src->value;
-    }
-    lock(ip);
-    //  MOB - accesses should be debug only
-    ip->accesses++;
-    index = whash(value, len) % ip->size;
-    if ((head = &ip->buckets[index]) != NULL) {
-        for (sp = head->next; sp != head; sp = sp->next) {
-            end = min(len, sp->length);
-            for (i = 0; i < end && value[i]; i++) {
-                if (sp->value[i] != sp->value[i]) {
-                    break;
-                }
-            }
-            if (i == sp->length && value[i] == 0) {
-                //  MOB - reuse should be debug only
-                ip->reuse++;
-                /* Revive incase almost stale or dead */
-                mprRevive(sp);
-                unlock(ip);
-                return sp;
-            }
-        }
-    }
-    ip->count++;
-    linkString(head, src);
-    if (step > EJS_MAX_COLLISIONS && ip->count > (ip->size/2)) {
-        /*  Remake the entire hash - should not happen often */
-        //  OPT - BAD holding lock while rebuildingIntern
-        rebuildIntern(ip);
+    if ((src = ejsAlloc(ejs, ESV(String), (len + 1) * sizeof(wchar))) == NULL) {
+        return NULL;
     }
-    unlock(ip);
-    return sp;
+    src->length = mtow(src->value, len + 1, value, len);
+    return ejsInternString(src);
 }
 #endif /* BIT_CHAR_LEN > 1 */
 
 
+PUBLIC uint ejsHashString(EjsString *sp)
+{
+    sp->hash = whash(sp->value, sp->length);
+    return sp->hash;
+}
+
+
 static int getInternHashSize(int size)
 {
     int     i;
@@ -2604,43 +2911,41 @@ static int getInternHashSize(int size)
 }
 
 
-static int rebuildIntern(EjsIntern *ip)
+/*
+    Allocate larger buckets for a shard. The strings in the old buckets are migrated incrementally by later accesses.
+    Must be called locked.
+ */
+static int growShard(EjsInternShard *shard)
 {
-    EjsString   *oldBuckets, *sp, *next, *head;
-    int         i, newSize, oldSize;
+    EjsString   *buckets, *sp;
+    int         i, newSize;
 
-    assert(ip);
-
-    oldBuckets = ip->buckets;
-    newSize = getInternHashSize(ip->size + 1);
-    oldSize = 0;
-    if (oldBuckets) {
-        oldSize = ip->size;
-        if (oldSize > newSize) {
-            return 0;
-        }
+    if (shard->oldBuckets) {
+        /* Still migrating from the last resize */
+        return 0;
+    }
+    newSize = getInternHashSize(shard->size + 1);
+    if (newSize <= shard->size) {
+        return 0;
     }
-    mprTrace(6, "Grow string intern new size %d old size %d, count %d, sizeof(EjsString) %d", 
-        newSize, oldSize, ip->count, sizeof(EjsString));
+    mprTrace(6, "Grow string intern shard new size %d old size %d, count %d, sizeof(EjsString) %d", 
+        newSize, shard->size, shard->count, sizeof(EjsString));
 
-    if ((ip->buckets = mprAllocZeroed((newSize * sizeof(EjsString)))) == NULL) {
+    if ((buckets = mprAllocBlock(newSize * sizeof(EjsString), MPR_ALLOC_MANAGER | MPR_ALLOC_ZERO)) == NULL) {
         return MPR_ERR_MEMORY;
     }
-    ip->size = newSize;
+    mprSetManager(buckets, (MprManager) manageBuckets);
     for (i = 0; i < newSize; i++) {
-        sp = &ip->buckets[i];
+        sp = &buckets[i];
         sp->next = sp->prev = sp;
     }
-    if (oldBuckets) {
-        for (i = 0; i < oldSize; i++) {
-            head = &oldBuckets[i];
-            for (sp = head->next; sp != head; sp = next) {
-                next = sp->next;
-                sp->next = sp->prev = sp;
-                ejsInternString(sp);
-            }
-        }
+    if (shard->buckets) {
+        shard->oldBuckets = shard->buckets;
+        shard->oldSize = shard->size;
+        shard->migrated = 0;
     }
+    shard->buckets = buckets;
+    shard->size = newSize;
     return 0;
 }
 
@@ -2714,10 +3019,30 @@ PUBLIC EjsString *ejsCreateStringFromMulti(Ejs *ejs, cchar *value, ssize len)
 }
 
 
+/*
+    Byte data is typically bulk text (file, command and network content) that is not interned
+ */
 PUBLIC EjsString *ejsCreateStringFromBytes(Ejs *ejs, cchar *value, ssize len)
 {
+    EjsString   *sp;
+#if BIT_CHAR_LEN > 1
+    ssize       i;
+#endif
+
     assert(0 <= len && len < MAXINT);
-    return ejsInternAsc(ejs, value, len);
+    if (len == 0) {
+        return ESV(empty);
+    }
+    if ((sp = ejsCreateBareString(ejs, len)) != NULL) {
+#if BIT_CHAR_LEN > 1
+        for (i = 0; i < len; i++) {
+            sp->value[i] = (uchar) value[i];
+        }
+#else
+        memcpy(sp->value, value, len);
+#endif
+    }
+    return sp;
 }
 
 
@@ -2738,76 +3063,143 @@ PUBLIC EjsString *ejsCreateBareString(Ejs *ejs, ssize len)
 }
 
 
-#if UNUSED && KEEP
+/*
+    Create a string that is not interned. It will be interned on demand if used as a property name.
+ */
 PUBLIC EjsString *ejsCreateNonInternedString(Ejs *ejs, wchar *value, ssize len)
 {
     EjsString   *sp;
     
     assert(0 <= len && len < MAXINT);
     if ((sp = ejsAlloc(ejs, ESV(String), (len + 1) * sizeof(wchar))) != NULL) {
-        memcpy(sp->value, value, (len + 1) * sizeof(wchar));
+        memcpy(sp->value, value, len * sizeof(wchar));
         sp->length = len;
         sp->value[len] = 0;
     }
     return sp;
 }
-#endif
 
 
 PUBLIC void ejsManageString(EjsString *sp, int flags)
 {
-    EjsIntern   *ip;
+    EjsInternShard  *shard;
 
     if (flags & MPR_MANAGE_MARK) {
         mprMark(TYPE(sp));
 
     } else if (flags & MPR_MANAGE_FREE) {
-        ip = ((EjsService*) MPR->ejsService)->intern;
-        lock(ip);
-        ip->count--;
-        unlinkString(sp);
-        unlock(ip);
+        /*
+            Some strings are not interned (ejsCreateBareString). These have sp->next == NULL.
+         */
+        if (sp->next && sp->next != sp) {
+            shard = SHARD(((EjsService*) MPR->ejsService)->intern, sp->hash);
+            mprLock(shard->mutex);
+            shard->count--;
+            unlinkString(sp);
+            mprUnlock(shard->mutex);
+        }
     }
 }
 
 
 PUBLIC EjsIntern *ejsCreateIntern(EjsService *sp)
 {
-    EjsIntern   *intern;
+    EjsIntern       *intern;
+    EjsInternShard  *shard;
+    int             i;
     
     intern = mprAllocObj(EjsIntern, manageIntern);
-    intern->mutex = mprCreateLock();
-    rebuildIntern(intern);
+    for (i = 0; i < EJS_INTERN_SHARDS; i++) {
+        shard = &intern->shards[i];
+        shard->mutex = mprCreateLock();
+        growShard(shard);
+    }
     return intern;
 }
 
 
-PUBLIC void ejsDestroyIntern(EjsIntern *ip)
+static void unlinkBuckets(EjsInternShard *shard, EjsString *buckets, int size)
 {
     EjsString   *sp, *head, *next;
     int         i;
 
-    /*
-        Unlink strings now as when they are freed later, the intern structure may not exist in memory.
-     */
-    lock(ip);
-    for (i = ip->size - 1; i >= 0; i--) {
-        head = &ip->buckets[i];
+    for (i = size - 1; i >= 0; i--) {
+        head = &buckets[i];
         for (sp = head->next; sp != head; sp = next) {
             next = sp->next;
-            ip->count--;
+            shard->count--;
             unlinkString(sp);
         }
     }
-    unlock(ip);
+}
+
+
+PUBLIC void ejsDestroyIntern(EjsIntern *ip)
+{
+    EjsInternShard  *shard;
+    int             i;
+
+    /*
+        Unlink strings now as when they are freed later, the intern structure may not exist in memory.
+     */
+    for (i = 0; i < EJS_INTERN_SHARDS; i++) {
+        shard = &ip->shards[i];
+        mprLock(shard->mutex);
+        if (shard->oldBuckets) {
+            unlinkBuckets(shard, shard->oldBuckets, shard->oldSize);
+        }
+        if (shard->buckets) {
+            unlinkBuckets(shard, shard->buckets, shard->size);
+        }
+        mprUnlock(shard->mutex);
+    }
+}
+
+
+PUBLIC void ejsShowInternStats(Ejs *ejs)
+{
+    EjsIntern       *ip;
+    EjsInternShard  *shard;
+    uint64          accesses, reuse, contended;
+    int             i, count, size;
+
+    ip = ejs->service->intern;
+    accesses = reuse = contended = 0;
+    count = size = 0;
+    for (i = 0; i < EJS_INTERN_SHARDS; i++) {
+        shard = &ip->shards[i];
+        accesses += shard->accesses;
+        reuse += shard->reuse;
+        contended += shard->contended;
+        count += shard->count;
+        size += shard->size;
+    }
+    mprPrintf("Intern strings: %,d strings, %,d buckets, %,Ld accesses, %,Ld reused, %,Ld contended\n", 
+        count, size, accesses, reuse, contended);
+}
+
+
+/*
+    The bucket lists are weak references. Strings unlink themselves when freed. The manager stops minor collections 
+    from scanning the buckets conservatively, which would keep all young interned strings alive.
+ */
+static void manageBuckets(EjsString *buckets, int flags)
+{
 }
 
 
 static void manageIntern(EjsIntern *intern, int flags)
 {
+    EjsInternShard  *shard;
+    int             i;
+
     if (flags & MPR_MANAGE_MARK) {
-        mprMark(intern->buckets);
-        mprMark(intern->mutex);
+        for (i = 0; i < EJS_INTERN_SHARDS; i++) {
+            shard = &intern->shards[i];
+            mprMark(shard->buckets);
+            mprMark(shard->oldBuckets);
+            mprMark(shard->mutex);
+        }
 
     } else if (flags & MPR_MANAGE_FREE) {
         ejsDestroyIntern(intern);
@@ -188,7 +188,7 @@ static void manageTimer(EjsTimer *tp, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         /* Pooled interpreter being abandoned */
-        if (tp->ejs->abandoned) {
+        if (tp->ejs && tp->ejs->abandoned) {
             if (tp->event) {
                 mprRemoveEvent(tp->event);
                 tp->event = 0;
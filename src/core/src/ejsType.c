@@ -280,6 +280,9 @@ PUBLIC EjsType *ejsCreateArchetype(Ejs *ejs, EjsFunction *fun, EjsPot *prototype
     }
     if (fun) {
         code = fun->body.code;
+        if (code->byteCode == 0 && ejsLoadFunctionCode(ejs, fun) < 0) {
+            return 0;
+        }
         /*  using ESV(Object) as the return type because the Yahoo module pattern returns {} in the constructor */
         ejsInitFunction(ejs, (EjsFunction*) type, type->qname.name, code->byteCode, code->codeLen, 
             fun->numArgs, fun->numDefault, code->numHandlers, ESV(Object), EJS_TRAIT_HIDDEN | EJS_TRAIT_FIXED, 
@@ -1008,6 +1011,7 @@ static void manageType(EjsType *type, int flags)
         mprMark(type->baseType);
         mprMark(type->mutex);
         mprMark(type->implements);
+        mprMark(type->shape);
         mprMark(type->module);
         mprMark(type->typeData);
     }
@@ -18,13 +18,33 @@ typedef struct Message {
     int         callbackSlot;
 } Message;
 
+/*
+    Messages to and from an isolated worker process are framed as this character, the data length in decimal, a colon,
+    the data and a new line. Messages from the worker are written to its standard error output. Other error output is 
+    reported via onerror if the worker fails.
+ */
+#define EJS_WORKER_FRAME    '\036'
+#define EJS_WORKER_HEADER   24              /* Maximum frame header length */
+
+static int workerSeqno = 0;
+
 /*********************************** Forwards *********************************/
 
 static void addWorker(Ejs *ejs, EjsWorker *worker);
 static int join(Ejs *ejs, EjsObj *workers, int timeout);
+static void closeIsolatedWorker(EjsWorker *worker);
+static Message *createMessage();
+static EjsObj *getResult(Ejs *ejs, Ejs *inside);
+static int doMessage(Message *msg, MprEvent *mprEvent);
 static void handleError(Ejs *ejs, EjsWorker *worker, EjsObj *exception, int throwOutside);
+static void isolatedIO(MprCmd *cmd, int channel, EjsWorker *worker);
+static int rejectIsolated(Ejs *ejs, EjsWorker *worker);
 static void loadFile(EjsWorker *insideWorker, cchar *filename);
+static void parentIO(EjsWorker *worker, MprEvent *event);
+static void receiveMessages(EjsWorker *worker);
 static void removeWorker(EjsWorker *worker);
+static void sendMessage(Ejs *ejs, EjsWorker *worker, cchar *data);
+static EjsWorker *startIsolatedWorker(Ejs *ejs, EjsWorker *worker, cchar *name, cchar *scriptFile);
 static int workerMain(EjsWorker *worker, MprEvent *event);
 static EjsObj *workerPreload(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv);
 
@@ -35,7 +55,7 @@ static EjsWorker *initWorker(Ejs *ejs, EjsWorker *worker, Ejs *baseVM, cchar *na
     Ejs             *wejs;
     EjsWorker       *self;
     EjsName         sname;
-    static int      workerSeqno = 0;
+    MprPartition    *prior;
 
     ejsBlockGC(ejs);
     if (worker == 0) {
@@ -69,6 +89,10 @@ static EjsWorker *initWorker(Ejs *ejs, EjsWorker *worker, Ejs *baseVM, cchar *na
             return 0;
         }
     }
+    /*
+        The inside worker is allocated in the heap partition of the worker interpreter
+     */
+    prior = mprSetThreadPartition(wejs->partition);
     worker->pair = self = ejsCreateWorker(wejs);
     self->state = EJS_WORKER_BEGIN;
     self->ejs = wejs;
@@ -76,12 +100,8 @@ static EjsWorker *initWorker(Ejs *ejs, EjsWorker *worker, Ejs *baseVM, cchar *na
     self->pair = worker;
     self->name = sjoin("inside-", worker->name, NULL);
     mprEnableDispatcher(wejs->dispatcher);
-    if (search) {
-        ejsSetSearchPath(ejs, (EjsArray*) search);
-    }
 
     //  TODO - these should be don't delete
-    ejsSetProperty(ejs, worker, ES_Worker_name, ejsCreateStringFromAsc(ejs, self->name));
     ejsSetProperty(wejs, self,  ES_Worker_name, ejsCreateStringFromAsc(wejs, self->name));
 
     sname = ejsName(wejs, EJS_WORKER_NAMESPACE, "self");
@@ -91,7 +111,12 @@ static EjsWorker *initWorker(Ejs *ejs, EjsWorker *worker, Ejs *baseVM, cchar *na
         Workers have a dedicated namespace to enable viewing of the worker globals (self, onmessage, postMessage...)
      */
     ejsDefineReservedNamespace(wejs, wejs->global, NULL, EJS_WORKER_NAMESPACE);
-    
+    mprSetThreadPartition(prior);
+
+    if (search) {
+        ejsSetSearchPath(ejs, (EjsArray*) search);
+    }
+    ejsSetProperty(ejs, worker, ES_Worker_name, ejsCreateStringFromAsc(ejs, self->name));
     addWorker(ejs, worker);
 
     if (scriptFile) {
@@ -112,6 +137,7 @@ static EjsWorker *workerConstructor(Ejs *ejs, EjsWorker *worker, int argc, EjsOb
     EjsArray    *search;
     EjsObj      *options, *value;
     cchar       *name, *scriptFile;
+    int         isolate;
 
     ejsBlockGC(ejs);
 
@@ -119,19 +145,293 @@ static EjsWorker *workerConstructor(Ejs *ejs, EjsWorker *worker, int argc, EjsOb
     options = (argc == 2) ? (EjsObj*) argv[1]: NULL;
     name = 0;
     search = 0;
+    isolate = 0;
     if (options) {
         search = ejsGetPropertyByName(ejs, options, EN("search"));
         value = ejsGetPropertyByName(ejs, options, EN("name"));
         if (ejsIs(ejs, value, String)) {
             name = ejsToMulti(ejs, value);
         }
+        isolate = (ejsGetPropertyByName(ejs, options, EN("isolate")) == ESV(true));
     }
     worker->ejs = ejs;
     worker->state = EJS_WORKER_BEGIN;
+    if (isolate) {
+        if (scriptFile == 0) {
+            ejsThrowArgError(ejs, "An isolated worker requires a script");
+            return 0;
+        }
+        return startIsolatedWorker(ejs, worker, name, scriptFile);
+    }
     return initWorker(ejs, worker, 0, name, search, scriptFile);
 }
 
 
+/*
+    Start an isolated worker. The script runs in a new "ejs" process with its own heap and garbage collector.
+    Messages to the worker are written to its standard input. Each message is one line of JSON.
+ */
+static EjsWorker *startIsolatedWorker(Ejs *ejs, EjsWorker *worker, cchar *name, cchar *scriptFile)
+{
+    MprCmd      *cmd;
+    cchar       *argv[3], *env[2], *program;
+
+    worker->isolated = 1;
+    if (name) {
+        worker->name = sclone(name);
+    } else {
+        lock(ejs);
+        worker->name = sfmt("worker-%d", workerSeqno++);
+        unlock(ejs);
+    }
+    ejsSetProperty(ejs, worker, ES_Worker_name, ejsCreateStringFromAsc(ejs, worker->name));
+    worker->scriptFile = sclone(scriptFile);
+    worker->input = mprCreateBuf(BIT_MAX_BUFFER, -1);
+    worker->errors = mprCreateBuf(0, -1);
+
+    program = mprJoinPath(mprGetAppDir(), "ejs" BIT_EXE);
+    if (!mprPathExists(program, X_OK)) {
+        program = "ejs" BIT_EXE;
+    }
+    argv[0] = program;
+    argv[1] = worker->scriptFile;
+    argv[2] = 0;
+    env[0] = sfmt("EJS_WORKER=%s", worker->name);
+    env[1] = 0;
+
+    if ((cmd = mprCreateCmd(ejs->dispatcher)) == 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
+    worker->cmd = cmd;
+    mprSetCmdCallback(cmd, (MprCmdProc) isolatedIO, worker);
+    addWorker(ejs, worker);
+    if (mprStartCmd(cmd, 2, argv, env, MPR_CMD_IN | MPR_CMD_ERR) < 0) {
+        removeWorker(worker);
+        ejsThrowIOError(ejs, "Cannot start worker process %s", program);
+        return 0;
+    }
+    mprDisableCmdEvents(cmd, MPR_CMD_STDIN);
+    worker->state = EJS_WORKER_STARTED;
+    return worker;
+}
+
+
+/*
+    Attach to the parent process of an isolated worker. Messages from the parent are read from the standard input.
+ */
+PUBLIC int ejsAttachWorker(Ejs *ejs, cchar *name)
+{
+    EjsWorker   *self;
+    EjsName     sname;
+
+    if ((self = ejsCreateWorker(ejs)) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    self->ejs = ejs;
+    self->inside = 1;
+    self->isolated = 1;
+    self->state = EJS_WORKER_STARTED;
+    self->name = sclone(name);
+    self->input = mprCreateBuf(BIT_MAX_BUFFER, -1);
+    ejsSetProperty(ejs, self, ES_Worker_name, ejsCreateStringFromAsc(ejs, self->name));
+
+    sname = ejsName(ejs, EJS_WORKER_NAMESPACE, "self");
+    ejsSetPropertyByName(ejs, ejs->global, sname, self);
+    ejsDefineReservedNamespace(ejs, ejs->global, NULL, EJS_WORKER_NAMESPACE);
+
+    if ((self->handler = mprCreateWaitHandler(0, MPR_READABLE, ejs->dispatcher, parentIO, self, 0)) == 0) {
+        return MPR_ERR_CANT_OPEN;
+    }
+    return 0;
+}
+
+
+/*
+    I/O callback in the parent for an isolated worker process
+ */
+static void isolatedIO(MprCmd *cmd, int channel, EjsWorker *worker)
+{
+    MprBuf      *buf;
+    ssize       len;
+
+    if (channel == MPR_CMD_STDERR) {
+        buf = worker->input;
+        mprResetBufIfEmpty(buf);
+        if (mprGetBufSpace(buf) < (BIT_MAX_BUFFER / 4) && mprGrowBuf(buf, BIT_MAX_BUFFER) < 0) {
+            mprCloseCmdFd(cmd, channel);
+            return;
+        }
+        len = mprReadCmd(cmd, channel, mprGetBufEnd(buf), mprGetBufSpace(buf));
+        if (len > 0) {
+            mprAdjustBufEnd(buf, len);
+            receiveMessages(worker);
+            mprEnableCmdEvents(cmd, channel);
+        } else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            mprEnableCmdEvents(cmd, channel);
+        } else {
+            mprCloseCmdFd(cmd, channel);
+        }
+    }
+    if (mprIsCmdComplete(cmd) && worker->state < EJS_WORKER_CLOSED) {
+        closeIsolatedWorker(worker);
+    }
+}
+
+
+/*
+    I/O callback in an isolated worker process for messages from the parent
+ */
+static void parentIO(EjsWorker *worker, MprEvent *event)
+{
+    MprBuf      *buf;
+    ssize       len;
+
+    buf = worker->input;
+    mprResetBufIfEmpty(buf);
+    if (mprGetBufSpace(buf) < (BIT_MAX_BUFFER / 4)) {
+        mprGrowBuf(buf, BIT_MAX_BUFFER);
+    }
+    len = mprReadFile(mprGetStdin(), mprGetBufEnd(buf), mprGetBufSpace(buf));
+    if (len > 0) {
+        mprAdjustBufEnd(buf, len);
+        receiveMessages(worker);
+        mprWaitOn(worker->handler, MPR_READABLE);
+    } else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        mprWaitOn(worker->handler, MPR_READABLE);
+    } else {
+        /* The parent has exited or terminated the worker */
+        mprRemoveWaitHandler(worker->handler);
+        worker->handler = 0;
+        worker->ejs->exiting = 1;
+        mprSignalDispatcher(worker->ejs->dispatcher);
+    }
+}
+
+
+/*
+    Post each complete message frame of input as a message to the worker. Error output from an isolated worker process
+    that is not a message is saved a line at a time to report if the worker fails.
+ */
+static void receiveMessages(EjsWorker *worker)
+{
+    MprBuf      *buf;
+    Message     *msg;
+    char        *start, *end, *colon;
+    ssize       len, avail, size;
+
+    buf = worker->input;
+    while ((avail = mprGetBufLength(buf)) > 0) {
+        start = mprGetBufStart(buf);
+        if (*start == EJS_WORKER_FRAME) {
+            colon = memchr(start, ':', min(avail, EJS_WORKER_HEADER));
+            if (colon == 0 && avail < EJS_WORKER_HEADER) {
+                /* Wait for the rest of the header */
+                break;
+            }
+            size = colon ? (ssize) stoi(&start[1]) : -1;
+            if (size >= 0) {
+                len = (colon - start) + 1;
+                if (avail < len + size + 1) {
+                    break;
+                }
+                if ((msg = createMessage()) == 0) {
+                    return;
+                }
+                msg->data = snclone(&colon[1], size);
+                msg->worker = worker;
+                msg->callback = "onmessage";
+                msg->callbackSlot = ES_Worker_onmessage;
+                mprCreateEvent(worker->ejs->dispatcher, "postMessage", 0, doMessage, msg, 0);
+                mprAdjustBufStart(buf, len + size + 1);
+                continue;
+            }
+        }
+        if ((end = memchr(start, '\n', avail)) == 0) {
+            break;
+        }
+        len = end - start;
+        if (!worker->inside) {
+            mprPutBlockToBuf(worker->errors, start, len + 1);
+        }
+        mprAdjustBufStart(buf, len + 1);
+    }
+}
+
+
+/*
+    The isolated worker process has exited. Report a failure via onerror, then close the worker.
+ */
+static void closeIsolatedWorker(EjsWorker *worker)
+{
+    Ejs         *ejs;
+    Message     *msg;
+    cchar       *errors;
+    int         status;
+
+    ejs = worker->ejs;
+    worker->state = EJS_WORKER_CLOSED;
+    status = mprGetCmdExitStatus(worker->cmd);
+    if (status != 0 && !worker->cmd->stopped) {
+        mprPutBlockToBuf(worker->errors, mprGetBufStart(worker->input), mprGetBufLength(worker->input));
+        mprFlushBuf(worker->input);
+        mprAddNullToBuf(worker->errors);
+        errors = strim(mprGetBufStart(worker->errors), " \t\r\n", MPR_TRIM_BOTH);
+        if (*errors == '\0') {
+            errors = sfmt("Worker exited with status %d", status);
+        }
+        if ((msg = createMessage()) != 0) {
+            msg->worker = worker;
+            msg->callback = "onerror";
+            msg->callbackSlot = ES_Worker_onerror;
+            msg->message = (EjsObj*) ejsCreateStringFromAsc(ejs, errors);
+            mprCreateEvent(ejs->dispatcher, "doMessage-error", 0, (MprEventProc) doMessage, msg, 0);
+        }
+    }
+    if ((msg = createMessage()) != 0) {
+        msg->worker = worker;
+        msg->callback = "onclose";
+        msg->callbackSlot = ES_Worker_onclose;
+        mprCreateEvent(ejs->dispatcher, "doMessage", 0, (MprEventProc) doMessage, msg, 0);
+    }
+}
+
+
+/*
+    Send a message between the parent and an isolated worker process
+ */
+static void sendMessage(Ejs *ejs, EjsWorker *worker, cchar *data)
+{
+    char    *frame;
+    ssize   len;
+
+    frame = sfmt("%c%Ld:%s\n", EJS_WORKER_FRAME, (int64) slen(data), data);
+    len = slen(frame);
+    if (worker->inside) {
+        if (mprWriteFile(mprGetStderr(), frame, len) != len) {
+            ejsThrowIOError(ejs, "Cannot post message to the parent process");
+        }
+    } else {
+        if (mprWriteCmdBlock(worker->cmd, MPR_CMD_STDIN, frame, len) != len) {
+            ejsThrowIOError(ejs, "Cannot post message to the worker process");
+        }
+    }
+}
+
+
+/*
+    Throw an exception for operations that isolated workers do not support. Returns true if the worker is isolated.
+ */
+static int rejectIsolated(Ejs *ejs, EjsWorker *worker)
+{
+    if (worker->isolated) {
+        ejsThrowStateError(ejs, "Not supported for isolated workers");
+        return 1;
+    }
+    return 0;
+}
+
+
 /*
     Add a worker object to the list of running workers for this interpreter
  */
@@ -187,6 +487,9 @@ PUBLIC void ejsRemoveWorkers(Ejs *ejs)
     int         next;
 
     for (next = 0; (worker = mprGetNextItem(ejs->workers, &next)) != NULL; ) {
+        if (worker->cmd) {
+            mprStopCmd(worker->cmd, -1);
+        }
         worker->ejs = 0;
     }
     ejs->workers = 0;
@@ -200,7 +503,6 @@ static EjsObj *startWorker(Ejs *ejs, EjsWorker *outsideWorker, int timeout)
 {
     EjsWorker   *insideWorker;
     Ejs         *inside;
-    EjsString   *result;
 
     assert(ejs);
     assert(outsideWorker);
@@ -235,7 +537,25 @@ static EjsObj *startWorker(Ejs *ejs, EjsWorker *outsideWorker, int timeout)
     if (join(ejs, (EjsObj*) outsideWorker, timeout) < 0) {
         return ESV(undefined);
     }
+    return getResult(ejs, inside);
+}
+
+
+/*
+    Get the result of the inside interpreter. The result is serialized bound to the partition of the inside interpreter
+    into the shared heap and then deserialized into the outside interpreter.
+ */
+static EjsObj *getResult(Ejs *ejs, Ejs *inside)
+{
+    MprPartition    *prior;
+    EjsString       *result;
+    bool            shared;
+
+    prior = mprSetThreadPartition(inside->partition);
+    shared = mprShareAlloc(1);
     result = ejsToJSON(inside, inside->result, NULL);
+    mprShareAlloc(shared);
+    mprSetThreadPartition(prior);
     if (result == 0) {
         return ESV(null);
     }
@@ -248,6 +568,9 @@ static EjsObj *startWorker(Ejs *ejs, EjsWorker *outsideWorker, int timeout)
  */
 static EjsWorker *workerClone(Ejs *ejs, EjsWorker *baseWorker, int argc, EjsObj **argv)
 {
+    if (rejectIsolated(ejs, baseWorker)) {
+        return 0;
+    }
     return initWorker(ejs, 0, baseWorker->pair->ejs, 0, 0, 0);
 }
 
@@ -270,6 +593,9 @@ static EjsObj *workerEval(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv)
 
     assert(ejsIs(ejs, argv[0], String));
 
+    if (rejectIsolated(ejs, worker)) {
+        return 0;
+    }
     worker->scriptLiteral = (EjsString*) argv[0];
     timeout = argc == 2 ? ejsGetInt(ejs, argv[1]): MAXINT;
     return startWorker(ejs, worker, timeout);
@@ -423,6 +749,9 @@ static EjsObj *workerLoad(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv)
 
     assert(argc == 0 || ejsIs(ejs, argv[0], Path));
 
+    if (rejectIsolated(ejs, worker)) {
+        return 0;
+    }
     worker->scriptFile = sclone(((EjsPath*) argv[0])->value);
     timeout = argc == 2 ? ejsGetInt(ejs, argv[1]): 0;
     return startWorker(ejs, worker, timeout);
@@ -539,12 +868,15 @@ static int doMessage(Message *msg, MprEvent *mprEvent)
  */
 static EjsObj *workerPreeval(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv)
 {
-    Ejs         *inside;
-    EjsWorker   *insideWorker;
-    EjsString   *result;
+    Ejs             *inside;
+    EjsWorker       *insideWorker;
+    MprPartition    *prior;
 
     assert(!worker->inside);
 
+    if (rejectIsolated(ejs, worker)) {
+        return 0;
+    }
     if (worker->state > EJS_WORKER_BEGIN) {
         ejsThrowStateError(ejs, "Worker has already started");
         return 0;
@@ -553,16 +885,14 @@ static EjsObj *workerPreeval(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **arg
     assert(insideWorker->inside);
     inside = insideWorker->ejs;
 
+    prior = mprSetThreadPartition(inside->partition);
     (inside->service->loadScriptLiteral)(inside, (EjsString*) argv[0], NULL);
+    mprSetThreadPartition(prior);
     if (inside->exception) {
         handleError(ejs, worker, inside->exception, 1);
         return 0;
     }
-    result = ejsToJSON(inside, inside->result, NULL);
-    if (result == 0) {
-        return ESV(null);
-    }
-    return ejsDeserialize(ejs, result);
+    return getResult(ejs, inside);
 }
 
 
@@ -572,13 +902,16 @@ static EjsObj *workerPreeval(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **arg
  */
 static EjsObj *workerPreload(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv)
 {
-    Ejs         *inside;
-    EjsWorker   *insideWorker;
-    EjsString   *result;
+    Ejs             *inside;
+    EjsWorker       *insideWorker;
+    MprPartition    *prior;
 
     assert(argc > 0 && ejsIs(ejs, argv[0], Path));
     assert(!worker->inside);
 
+    if (rejectIsolated(ejs, worker)) {
+        return 0;
+    }
     if (worker->state > EJS_WORKER_BEGIN) {
         ejsThrowStateError(ejs, "Worker has already started");
         return 0;
@@ -587,16 +920,14 @@ static EjsObj *workerPreload(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **arg
     assert(insideWorker->inside);
     inside = insideWorker->ejs;
 
+    prior = mprSetThreadPartition(inside->partition);
     loadFile(worker->pair, ((EjsPath*) argv[0])->value);
+    mprSetThreadPartition(prior);
     if (inside->exception) {
         handleError(ejs, worker, inside->exception, 1);
         return 0;
     }
-    result = ejsToJSON(inside, inside->result, NULL);
-    if (result == 0) {
-        return ESV(null);
-    }
-    return ejsDeserialize(ejs, result);
+    return getResult(ejs, inside);
 }
 
 
@@ -627,6 +958,7 @@ static EjsObj *workerPostMessage(Ejs *ejs, EjsWorker *worker, int argc, EjsObj *
     EjsWorker       *target;
     MprDispatcher   *dispatcher;
     Message         *msg;
+    bool            shared;
 
     if (worker->state >= EJS_WORKER_CLOSED) {
         ejsThrowStateError(ejs, "Worker has completed");
@@ -640,12 +972,22 @@ static EjsObj *workerPostMessage(Ejs *ejs, EjsWorker *worker, int argc, EjsObj *
         ejsThrowArgError(ejs, "Cannot serialize message data");
         return 0;
     }
+    if (worker->isolated) {
+        sendMessage(ejs, worker, ejsToMulti(ejs, data));
+        return 0;
+    }
+    /*
+        The message is used by the target interpreter which may be in another heap partition
+     */
+    shared = mprShareAlloc(1);
     if ((msg = createMessage()) == 0) {
+        mprShareAlloc(shared);
         ejsThrowMemoryError(ejs);
         return 0;
     }
     target = worker->pair;
     msg->data = ejsToMulti(ejs, data);
+    mprShareAlloc(shared);
     msg->worker = target;
     msg->callback = "onmessage";
     msg->callbackSlot = ES_Worker_onmessage;
@@ -665,6 +1007,7 @@ static int workerMain(EjsWorker *insideWorker, MprEvent *event)
     EjsWorker       *outsideWorker;
     MprDispatcher   *dispatcher;
     Message         *msg;
+    bool            shared;
 
     assert(insideWorker->inside);
     outsideWorker = insideWorker->pair;
@@ -696,7 +1039,10 @@ static int workerMain(EjsWorker *insideWorker, MprEvent *event)
         inside->exception = 0;
     }
     ejsBlockGC(inside);
-    if ((msg = createMessage()) == 0) {
+    shared = mprShareAlloc(1);
+    msg = createMessage();
+    mprShareAlloc(shared);
+    if (msg == 0) {
         ejsThrowMemoryError(outside);
         return 0;
     }
@@ -727,10 +1073,16 @@ static EjsObj *workerTerminate(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **a
     if (worker->state >= EJS_WORKER_COMPLETE) {
         return 0;
     }
+    if (worker->isolated && !worker->inside) {
+        if (worker->cmd) {
+            mprStopCmd(worker->cmd, -1);
+        }
+        return 0;
+    }
     /*
         Switch to the inside worker if called from outside
      */
-    assert(worker->pair && worker->pair->ejs);
+    assert(worker->inside || (worker->pair && worker->pair->ejs));
     ejs = (!worker->inside) ? worker->pair->ejs : ejs;
     ejs->exiting = 1;
     mprSignalDispatcher(ejs->dispatcher);
@@ -776,21 +1128,31 @@ static void handleError(Ejs *ejs, EjsWorker *worker, EjsObj *exception, int thro
     Ejs             *inside;
     EjsObj          *e;
     MprDispatcher   *dispatcher;
+    MprPartition    *prior;
     Message         *msg;
+    bool            shared;
 
     assert(!worker->inside);
     assert(exception);
     assert(ejs == worker->ejs);
 
     ejsBlockGC(ejs);
+    /*
+        This may run in either interpreter. Bind to the inside interpreter's heap partition to read the exception and
+        allocate the message from the shared heap.
+     */
+    inside = worker->pair->ejs;
+    prior = mprSetThreadPartition(inside->partition);
+    shared = mprShareAlloc(1);
     if ((msg = createMessage()) == 0) {
+        mprShareAlloc(shared);
+        mprSetThreadPartition(prior);
         ejsThrowMemoryError(ejs);
         return;
     }
     msg->worker = worker;
     msg->callback = "onerror";
     msg->callbackSlot = ES_Worker_onerror;
-    inside = worker->pair->ejs;
     
     inside->exception = 0;
     e = ejsDeserialize(ejs, ejsSerialize(inside, exception, 0));
@@ -807,6 +1169,8 @@ static void handleError(Ejs *ejs, EjsWorker *worker, EjsObj *exception, int thro
         msg->message = e;
         msg->stack = 0;
     }
+    mprShareAlloc(shared);
+    mprSetThreadPartition(prior);
     if (throwOutside) {
         if (msg->stack) {
             ejsThrowStateError(ejs, "%@\n%@", ejsToString(ejs, msg->message), ejsToString(ejs, msg->stack));
@@ -835,6 +1199,10 @@ static void manageWorker(EjsWorker *worker, int flags)
         mprMark(worker->pair);
         mprMark(worker->scriptFile);
         mprMark(worker->scriptLiteral);
+        mprMark(worker->cmd);
+        mprMark(worker->handler);
+        mprMark(worker->input);
+        mprMark(worker->errors);
 
     } else if (flags & MPR_MANAGE_FREE) {
         if (!worker->inside) {
@@ -574,7 +574,7 @@ static bool deepCompare(EjsXML *lhs, EjsXML *rhs)
         //  TODO - must compare all the children
         return 0;
 
-    } else if (lhs->value != rhs->value) {
+    } else if (lhs->value != rhs->value && (!lhs->value || !rhs->value || !ejsMatchString(lhs->value, rhs->value))) {
         return 0;
 
     } else {
@@ -52,7 +52,7 @@ MprXml *ejsCreateXmlParser(Ejs *ejs, EjsXML *xml, cchar *filename)
     //  TODO - these 2 are not really needed. Can use ejs->
     parser->xmlType = ESV(XML);
     parser->xmlListType = ESV(XMLList);
-    parser->filename = filename;
+    parser->filename = sclone(filename);
 
     mprXmlSetParseArg(xp, parser);
     mprXmlSetParserHandler(xp, parserHandler);
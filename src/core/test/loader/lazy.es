@@ -0,0 +1,22 @@
+/*
+    Script run by lazy.tst. Function bodies load when first called.
+ */
+require lazymod
+
+let before = Memory.functions
+assert(before.loaded <= before.deferred)
+
+//  Exception handlers load with the body and resolve their catch types
+
+assert(shout("abc") == "ABC")
+assert(shout(7) == "bad not a string")
+assert(shouted == 2)
+
+let after = Memory.functions
+assert(after.deferred == before.deferred)
+assert(after.loaded == before.loaded + 2)
+
+//  Bodies load once
+shout("x")
+assert(Memory.functions.loaded == after.loaded)
+print("lazy ok")
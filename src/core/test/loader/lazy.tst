@@ -0,0 +1,23 @@
+/*
+    Lazy function body loading
+ */
+require ejs.unix
+
+Cmd.run(Cmd.locate("ejsc") + " --out lazymod.mod lazymod.es")
+assert(Path("lazymod.mod").exists)
+
+let ejs = Cmd.locate("ejs")
+let out = Cmd.run(ejs + " --lazy --stats lazy.es")
+assert(out.contains("lazy ok"))
+let counts = out.match(/Function bodies: ([0-9]+) loaded of ([0-9]+) deferred/)
+assert(counts && counts[1] - 0 < counts[2] - 0)
+
+//  Same results with mapped modules
+
+assert(Cmd.run(ejs + " --lazy --map lazy.es").contains("lazy ok"))
+
+//  All bodies load up front by default
+
+out = Cmd.run(ejs + " --stats --cmd 'print(serialize(Memory.functions))'")
+assert(out.contains('{"deferred":0,"loaded":0}'))
+rm("lazymod.mod")
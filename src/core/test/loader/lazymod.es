@@ -0,0 +1,25 @@
+module lazymod {
+    public function shout(s) {
+        let result
+        shouted++
+        try {
+            result = check(s)
+        } catch (e: TypeError) {
+            result = "bad " + e.message
+        }
+        return result
+    }
+    function check(s) {
+        if (!(s is String)) {
+            throw new TypeError("not a string")
+        }
+        return s.toUpperCase()
+    }
+    public function unused1() {
+        return 1
+    }
+    public function unused2() {
+        return 2
+    }
+    public var shouted = 0
+}
@@ -0,0 +1,9 @@
+module mapmod {
+    public function fib(n) {
+        return n < 2 ? n : fib(n - 1) + fib(n - 2)
+    }
+    public function fail() {
+        throw new Error("mapped failure")
+    }
+    public var greeting = "hello from a mapped module"
+}
@@ -0,0 +1,27 @@
+/*
+    Script run by mapped.tst with module files mapped
+ */
+require mapmod
+
+assert(fib(20) == 6765)
+assert(greeting == "hello from a mapped module")
+
+//  Debug information is read from the mapping
+
+let caught = false
+try {
+    fail()
+} catch (e) {
+    assert(e.formatStack().contains("mapmod.es, line 6"))
+    caught = true
+}
+assert(caught)
+
+//  Hot code is rewritten in place
+
+let sum = 0
+for (let i = 0; i < 100000; i++) {
+    sum += i
+}
+assert(sum == 4999950000)
+print("mapped ok")
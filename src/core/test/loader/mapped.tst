@@ -0,0 +1,18 @@
+/*
+    Memory mapped module loading
+ */
+require ejs.unix
+
+Cmd.run(Cmd.locate("ejsc") + " --debug --out mapmod.mod mapmod.es")
+assert(Path("mapmod.mod").exists)
+
+let ejs = Cmd.locate("ejs")
+let out = Cmd.run(ejs + " --map --stats mapped.es")
+assert(out.contains("mapped ok"))
+let mapped = out.match(/Mapped module files: ([0-9]+)/)
+assert(mapped && mapped[1] >= 2)
+
+//  Same results without mapping
+
+assert(Cmd.run(ejs + " mapped.es").contains("mapped ok"))
+rm("mapmod.mod")
@@ -0,0 +1,33 @@
+/*
+    Allocator statistics. Small blocks are allocated from per-thread caches.
+ */
+
+let stats = Memory.allocator
+assert(stats.heapLocks > 0)
+assert(stats.heapLockWaits >= 0 && stats.heapLockWaits <= stats.heapLocks)
+assert(stats.cacheHits >= 0)
+assert(stats.cacheRefills >= 0)
+assert(stats.cached >= 0)
+assert(stats.caches >= 0)
+
+if (Config.OS == "linux" || Config.OS == "macosx") {
+    let prior = stats.cacheHits
+    let list = []
+    for (let i = 0; i < 1000; i++) {
+        list.push({ value: i })
+    }
+    let now = Memory.allocator
+    assert(now.cacheHits > prior)
+    assert(now.cacheRefills > 0)
+    assert(now.caches >= 1)
+
+    //  Worker threads get their own caches which are returned to the heap when the thread exits
+
+    let w = Worker.fork()
+    assert(w.eval('let a = []; for (let i = 0; i < 1000; i++) { a.push({ value: i }) }; a.length') == 1000)
+    Worker.join(w)
+    GC.run()
+    for (let i = 0; i < 1000; i++) {
+        assert(list[i].value == i)
+    }
+}
@@ -0,0 +1,53 @@
+/*
+    Parallel marking. Helper threads mark in parallel with the collector.
+ */
+
+let prior = GC.threads
+assert(prior >= 1)
+
+GC.threads = 3
+assert(GC.threads == 3)
+
+//  A deep list and many small trees that must all survive collection
+
+let list = null
+for (let i = 0; i < 20000; i++) {
+    list = { next: list, value: i, data: [i, "s" + i] }
+}
+let trees = []
+for (let i = 0; i < 2000; i++) {
+    trees.push({ left: { value: i }, right: { value: [i, { value: i }] } })
+}
+GC.run()
+GC.run()
+
+let count = 0
+for (let item = list; item; item = item.next) {
+    assert(item.data[1] == "s" + item.value)
+    count++
+}
+assert(count == 20000)
+for (let i = 0; i < 2000; i++) {
+    assert(trees[i].left.value == i)
+    assert(trees[i].right.value[1].value == i)
+}
+
+//  Garbage is still collected
+
+list = null
+trees = null
+GC.run()
+
+//  Bad thread counts
+
+let caught = false
+try {
+    GC.threads = -1
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(GC.threads == 3)
+
+GC.threads = prior
+assert(GC.threads == prior)
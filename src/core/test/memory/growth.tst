@@ -0,0 +1,43 @@
+/*
+    Heap growth between collections. Short-lived objects are collected in batches sized to the live heap.
+ */
+
+let prior = GC.growth
+assert(prior >= 0)
+
+function churn(count) {
+    let keep = []
+    for (let i = 0; i < count; i++) {
+        let temp = { value: i, text: "t" + i, list: [i, i + 1] }
+        if ((i & 15) == 0) {
+            keep.push(temp)
+        }
+    }
+    for (let i = 0; i < keep.length; i++) {
+        assert(keep[i].value == i * 16)
+        assert(keep[i].text == "t" + (i * 16))
+        assert(keep[i].list[1] == keep[i].value + 1)
+    }
+    return keep.length
+}
+
+for each (let percent in [0, 50, 300]) {
+    GC.growth = percent
+    assert(GC.growth == percent)
+    assert(churn(20000) == 1250)
+    GC.run()
+}
+
+//  Bad growth percentages
+
+let caught = false
+try {
+    GC.growth = -1
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(GC.growth == 300)
+
+GC.growth = prior
+assert(GC.growth == prior)
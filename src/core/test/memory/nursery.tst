@@ -0,0 +1,59 @@
+/*
+    Young generation nursery. New objects stored in old objects and arrays must survive minor collections.
+ */
+
+let prior = GC.nursery
+assert(prior >= 0)
+
+function churn(old, table, count) {
+    let local = { name: "local", list: [1, 2, 3] }
+    for (let i = 0; i < count; i++) {
+        let temp = { value: i, text: "t" + i, list: [i, i + 1] }
+        if ((i & 63) == 0) {
+            old.push(temp)
+        }
+        table["k" + (i % 100)] = temp
+    }
+    assert(local.name == "local" && local.list[2] == 3)
+}
+
+function check(old, table, count) {
+    for (let i = 0; i < old.length; i++) {
+        assert(old[i].value == i * 64)
+        assert(old[i].text == "t" + (i * 64))
+        assert(old[i].list[1] == old[i].value + 1)
+    }
+    for (let i = 0; i < 100; i++) {
+        let temp = table["k" + i]
+        assert(temp.value % 100 == i && temp.value >= count - 100)
+        assert(temp.text == "t" + temp.value)
+    }
+}
+
+for each (let size in [64 * 1024, 0, prior]) {
+    GC.nursery = size
+    assert(size == 0 || GC.nursery == 0 || GC.nursery == size)
+    let old = [], table = {}
+    GC.run()
+    churn(old, table, 20000)
+    check(old, table, 20000)
+    assert(old.length == 313)
+}
+
+let stats = GC.stats
+assert(stats.minorCollections >= 0 && stats.promoted >= 0)
+assert(stats.nursery == GC.nursery)
+if (GC.nursery > 0) {
+    assert(stats.minorCollections > 0)
+}
+
+//  Bad nursery size
+
+let caught = false
+try {
+    GC.nursery = -1
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(GC.nursery == prior)
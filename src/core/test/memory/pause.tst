@@ -0,0 +1,56 @@
+/*
+    Collector pause targets. Garbage not freed within the target is freed after threads resume.
+ */
+
+let prior = GC.pauseTarget
+assert(prior >= 0)
+
+//  Interned strings must not be found again once collected, even if their memory is freed later
+
+function churn(count) {
+    let keep = []
+    for (let i = 0; i < count; i++) {
+        let temp = { value: i, text: "pause-" + i }
+        if ((i % 10) == 0) {
+            keep.push(temp)
+        }
+    }
+    for (let i = 0; i < keep.length; i++) {
+        assert(keep[i].text == "pause-" + (i * 10))
+    }
+    return keep.length
+}
+
+let before = GC.pauses.count
+for each (let msec in [0, 1, 100]) {
+    GC.pauseTarget = msec
+    assert(GC.pauseTarget == msec)
+    assert(churn(20000) == 2000)
+    GC.run()
+    assert(churn(20000) == 2000)
+}
+
+let pauses = GC.pauses
+assert(pauses.count > before)
+assert(pauses.last <= pauses.max)
+assert(pauses.p50 <= pauses.p99)
+assert(pauses.p99 <= pauses.max)
+let total = 0
+for each (let n in pauses.histogram) {
+    total += n
+}
+assert(total == pauses.count)
+
+//  Bad pause targets
+
+let caught = false
+try {
+    GC.pauseTarget = -1
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(GC.pauseTarget == 100)
+
+GC.pauseTarget = prior
+assert(GC.pauseTarget == prior)
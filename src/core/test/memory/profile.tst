@@ -0,0 +1,67 @@
+/*
+    Sampling allocation profiler
+ */
+
+class Gadget {
+    var value
+    function Gadget(value) {
+        this.value = value
+    }
+}
+
+function makeGadgets(count) {
+    let keep = []
+    for (let i = 0; i < count; i++) {
+        keep.push(new Gadget(i))
+    }
+    return keep
+}
+
+assert(Memory.profiling == 0)
+assert(Memory.profile(true) is String)
+
+Memory.profiling = 4096
+assert(Memory.profiling == 4096)
+let before = GC.stats.allocated
+makeGadgets(10000)
+let allocated = GC.stats.allocated - before
+Memory.profiling = 0
+assert(Memory.profiling == 0)
+
+//  Report is in folded stack format: "outer;inner;leaf bytes"
+
+let report = Memory.profile()
+let total = 0
+let found = false
+for each (let line in report.split("\n")) {
+    if (line == "") {
+        continue
+    }
+    let bytes = line.split(" ").pop() - 0
+    assert(bytes > 0)
+    total += bytes
+    let frames = line.slice(0, line.lastIndexOf(" ")).split(";")
+    if (frames.pop() == "[Gadget]") {
+        assert(frames.pop().startsWith("makeGadgets (profile.tst:"))
+        found = true
+    }
+}
+assert(found)
+assert(total > allocated / 2 && total < allocated * 2)
+
+//  Stopped profilers take no more samples
+
+makeGadgets(1000)
+assert(Memory.profile(true) == report)
+assert(Memory.profile() == "")
+
+//  Bad intervals
+
+let caught = false
+try {
+    Memory.profiling = -1
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(Memory.profiling == 0)
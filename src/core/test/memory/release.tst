@@ -0,0 +1,56 @@
+/*
+    Returning free heap memory to the O/S
+ */
+
+//  Committed memory is measured when a collection completes
+GC.run()
+let stats = GC.stats
+assert(stats.committed > 0)
+assert(stats.used > 0 && stats.used <= stats.heap)
+assert(stats.hugePages is Boolean)
+
+//  Interleave long lived objects with garbage so regions keep live blocks around large free spans
+
+let pins = []
+let temps = []
+let chunk = "x".times(8000)
+for (let i = 0; i < 400; i++) {
+    let row = []
+    for (let j = 0; j < 12; j++) {
+        row.push(chunk + i + j)
+    }
+    temps.push(row)
+    pins.push({ index: i })
+}
+GC.run()
+let before = GC.stats
+temps = null
+GC.run()
+GC.run()
+
+let after = GC.stats
+assert(after.used < before.used)
+assert(after.committed < before.committed)
+if (!after.hugePages && Config.OS == "linux") {
+    assert(after.releases > before.releases)
+    assert(after.committed < after.heap)
+}
+for (let i = 0; i < pins.length; i++) {
+    assert(pins[i].index == i)
+}
+
+//  Spans already released are not released again by later collections. Only newly freed spans are released.
+
+let settled = GC.stats.releases
+for (let i = 0; i < 3; i++) {
+    GC.run()
+}
+assert(GC.stats.releases - settled < after.releases - before.releases)
+
+//  Released memory is reusable
+
+let again = []
+for (let i = 0; i < 400; i++) {
+    again.push(chunk + i)
+}
+assert(again[399] == chunk + 399)
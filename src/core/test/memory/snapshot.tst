@@ -0,0 +1,69 @@
+/*
+    Heap snapshots and retained size analysis
+ */
+
+class Leaf {
+    var value
+    function Leaf(value) {
+        this.value = value
+    }
+}
+
+class Holder {
+    var leaves = []
+}
+
+let base = Path("base.snapshot")
+let grown = Path("grown.snapshot")
+
+Memory.snapshot(base)
+assert(base.exists)
+assert(base.readLines()[0].startsWith("mpr-snapshot 1 "))
+
+let holder = new Holder
+for (let i = 0; i < 300; i++) {
+    holder.leaves.push(new Leaf(i))
+}
+Memory.snapshot(grown)
+
+//  Each label line is "retained bytes count label"
+
+function labels(report: String): Object {
+    let result = {}
+    for each (let line in report.split("\n")) {
+        let fields = line.trim().split(/ +/)
+        if (fields.length == 4 && fields[0].match(/^[0-9]+$/)) {
+            result[fields[3]] = { retained: fields[0] - 0, bytes: fields[1] - 0, count: fields[2] - 0 }
+        }
+    }
+    return result
+}
+
+let report = Memory.analyze(grown)
+let stats = labels(report)
+assert(stats.Leaf.count == 300)
+assert(stats.Holder.count == 1)
+assert(stats.Leaf.retained >= stats.Leaf.bytes)
+assert(stats.Holder.retained > stats.Leaf.retained)
+assert(report.contains("Largest retained blocks"))
+
+//  Growth since the baseline
+
+let growth = Memory.analyze(grown, base)
+assert(growth.contains("Growth since baseline"))
+let line = growth.split("\n").find(function (l) l.trim().endsWith(" Leaf"))
+assert(line)
+assert(line.trim().split(/ +/)[5] == "+300")
+
+//  Bad snapshots
+
+let caught = false
+try {
+    Memory.analyze(Path("missing.snapshot"))
+} catch (e) {
+    caught = true
+}
+assert(caught)
+
+base.remove()
+grown.remove()
@@ -0,0 +1,52 @@
+/*
+    Collector and allocation statistics
+ */
+
+class Widget {
+    var value
+    function Widget(value) {
+        this.value = value
+    }
+}
+
+let before = GC.stats
+let keep = []
+for (let i = 0; i < 2000; i++) {
+    keep.push(new Widget(i))
+}
+for (let i = 0; i < 20000; i++) {
+    let temp = { value: i }
+}
+GC.run()
+
+let stats = GC.stats
+assert(stats.collections > before.collections)
+assert(stats.allocated > before.allocated)
+assert(stats.freed > before.freed)
+assert(stats.allocated >= stats.freed)
+assert(stats.heap >= stats.free)
+assert(stats.largestFree <= stats.free)
+assert(stats.fragmentation >= 0 && stats.fragmentation <= 100)
+assert(stats.live > 0 && stats.live <= stats.heap)
+assert(stats.maxPause > 0 && stats.pauseTime >= stats.maxPause)
+assert(stats.newQuota == GC.newQuota)
+
+let history = stats.history
+assert(history.length > 0 && history.length <= stats.collections)
+let last = history[history.length - 1]
+assert(last.pause >= last.mark)
+assert(last.live <= last.heap)
+for each (let record in history) {
+    assert(record.pause <= stats.maxPause)
+    assert(record.freed >= 0 && record.freedBlocks >= 0)
+}
+
+//  Object counts by type
+
+let objects = Memory.objects()
+assert(objects.Widget.count == 2000)
+assert(objects.Widget.bytes > 0)
+assert(objects.Array.count > 0)
+keep = null
+GC.run()
+assert(Memory.objects().Widget == undefined)
@@ -0,0 +1,30 @@
+/*
+    Shared small integers. Cached numbers must behave exactly like allocated numbers.
+ */
+let values = [-257, -256, -2, 2, 100, 4095, 4096, 1e6]
+for each (v in values) {
+    let a = v + 1 - 1
+    let b = v * 2 / 2
+    assert(a === v && b === v)
+    assert(a + 1 == v + 1)
+    assert(a.toString() == v.toString())
+}
+
+let sum = 0
+for (let i = 0; i < 5000; i++) {
+    sum += i
+}
+assert(sum == 12497500)
+
+//  Boxed numbers are distinct objects
+
+let n = new Number(42)
+assert(n == 42)
+assert(40 + 2 == 42)
+assert(Number("7") + 1 == 8)
+
+//  Fractions and signed zero are not cached
+
+assert(0.5 + 1 == 1.5)
+assert(2.5 - 0.5 == 2)
+assert(1 / (-1 * 0) == 1 / -0)
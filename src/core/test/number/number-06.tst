@@ -0,0 +1,53 @@
+/*
+    Typed Number arithmetic and comparisons
+ */
+function arith(a: Number, b: Number): Array {
+    return [a + b, a - b, a * b, a / b, a % b, a < b, a <= b, a > b, a >= b, a == b, a != b]
+}
+
+assert(arith(7, 2).join(",") == "9,5,14,3.5,1,false,false,true,true,false,true")
+assert(arith(2, 2).join(",") == "4,0,4,1,0,false,true,false,true,true,false")
+
+function div(a: Number, b: Number): Number {
+    return a / b
+}
+assert(div(1, 0) == Infinity)
+assert(arith(2.5, 1.5)[0] == 4)
+
+//  NaN compares false
+
+function compare(a: Number, b: Number): Array {
+    return [a < b, a <= b, a > b, a >= b, a == b, a != b]
+}
+assert(compare(NaN, 1).join(",") == "false,false,false,false,false,true")
+assert(isNaN(div(0, 0) + 1))
+
+//  Loops with typed counters
+
+function sum(n: Number): Number {
+    var total: Number = 0
+    for (var i: Number = 0; i < n; i++) {
+        total = total + i
+    }
+    for (var j: Number = n; j > 0; --j) {
+        total = total - 1
+    }
+    return total
+}
+assert(sum(100) == 4850)
+
+//  Mixed typed and untyped operands
+
+function mixed(a: Number, b) {
+    return a + b
+}
+assert(mixed(1, 2) == 3)
+assert(mixed(1, "2") == "12")
+
+class Point {
+    var x: Number = 0
+    var y: Number = 0
+    function Point(x, y) { this.x = x; this.y = y }
+    function dist(): Number { return this.x * this.x + this.y * this.y }
+}
+assert(new Point(3, 4).dist() == 25)
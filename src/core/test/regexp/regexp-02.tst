@@ -0,0 +1,66 @@
+/*
+    Shared compiled regular expressions. Objects with the same pattern share a program but keep their own match state.
+ */
+
+//  Literals evaluated in a loop are distinct objects with their own lastIndex
+
+let list = []
+for (let i = 0; i < 3; i++) {
+    list.push(/a(\d)/g)
+}
+assert(list[0] != list[1])
+assert(list[0].exec("a1 a2") == "a1,1")
+assert(list[0].lastIndex == 2)
+assert(list[1].lastIndex == 0)
+assert(list[1].exec("a1 a2") == "a1,1")
+assert(list[0].exec("a1 a2") == "a2,2")
+assert(list[2].source == "a(\\d)")
+assert(list[2].global)
+
+//  Same pattern with different flags
+
+let a = new RegExp("abc")
+let b = new RegExp("abc", "i")
+let c = new RegExp("abc", "g")
+assert(!a.test("ABC"))
+assert(b.test("ABC"))
+assert(!a.global && c.global)
+assert(/abc/i.test("ABC"))
+assert(!/abc/.test("ABC"))
+assert(a.toString() == "/abc/")
+assert(b.toString() == "/abc/i")
+
+//  Literals and constructed expressions with the same text
+
+assert(new RegExp("/x/").test("a/x/b"))
+assert(!new RegExp("/x/").test("x"))
+assert(/x/.test("x"))
+
+//  Bad patterns fail every time
+
+for (let i = 0; i < 2; i++) {
+    let caught = false
+    try {
+        new RegExp("(unclosed")
+    } catch (e) {
+        caught = true
+    }
+    assert(caught)
+}
+
+//  More patterns than the cache holds
+
+for (let i = 0; i < 600; i++) {
+    let re = new RegExp("p" + i + "$")
+    assert(re.test("xp" + i))
+    assert(!re.test("p" + i + "x"))
+}
+assert(new RegExp("p1$").test("p1"))
+
+//  String methods with shared programs
+
+for (let i = 0; i < 3; i++) {
+    assert("a-b-c".replace(/-/g, "+") == "a+b+c")
+    assert("a-b-c".split(/-/).length == 3)
+    assert("abc".match(/b/) == "b")
+}
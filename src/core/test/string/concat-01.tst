@@ -0,0 +1,55 @@
+/*
+    Chained string concatenation. Additions whose result feeds another addition build the string in place.
+ */
+
+let n = 5, b = true, o = { toString: function() { return "O" } }
+
+//  Mixed operand types
+
+assert("<td>" + n + "</td>" == "<td>5</td>")
+assert("a" + 1 + 2 == "a12")
+assert(1 + 2 + "a" + 3 + 4 == "3a34")
+assert(1 + 2 + 3 == 6)
+assert(null + "a" + undefined + b == "nullaundefinedtrue")
+assert("[" + o + "]" + o == "[O]O")
+assert("" + "" + "" == "")
+assert("a" + "" + "" == "a")
+
+//  Results are interned
+
+let s = "ab" + "c" + n
+assert(s === "abc5")
+assert(s == "ab" + "c5")
+let obj = {}
+obj["k" + n + "x"] = 1
+assert(obj.k5x == 1)
+assert(obj["k" + "5" + "x"] == 1)
+
+//  Longer than the initial builder room
+
+let part = "0123456789"
+let long = part + part + part + part + part + part + part + part + part + part + "!"
+assert(long.length == 101)
+assert(long.endsWith("9!"))
+assert(long.indexOf("!") == 100)
+
+//  Building in a loop
+
+let html = ""
+for (let i = 0; i < 1000; i++) {
+    html += "<li>" + i + "</li>" + "\n"
+}
+assert(html.split("\n").length == 1001)
+assert(html.startsWith("<li>0</li>\n<li>1</li>"))
+
+//  Exceptions while converting an operand
+
+let bad = { toString: function() { throw "boom" } }
+let caught
+try {
+    let x = "a" + bad + "b"
+} catch (e) {
+    caught = e
+}
+assert(caught == "boom")
+assert("a" + "b" + "c" == "abc")
@@ -0,0 +1,40 @@
+/*
+    Interned strings. The intern hash is sharded and grows incrementally while strings are being created.
+ */
+
+//  Enough strings to grow every shard
+
+let o = {}
+for (let i = 0; i < 5000; i++) {
+    o["key" + i] = i
+}
+for (let i = 0; i < 5000; i++) {
+    assert(o["key" + i] == i)
+    assert(("key" + i) == ("ke" + "y" + i))
+}
+assert(Object.getOwnPropertyNames(o).length == 5000)
+
+//  Strings collected and recreated
+
+let list = []
+for (let i = 0; i < 5000; i++) {
+    list.push("value-" + i)
+}
+list = null
+GC.run()
+for (let i = 0; i < 5000; i++) {
+    assert(("value-" + i).length == 6 + String(i).length)
+}
+assert(o["key4999"] == 4999)
+
+//  Strings created by worker interpreters
+
+let code = 'let sum = 0; for (let i = 0; i < 5000; i++) { if (("w" + i) == ("w" + i)) sum++ }; sum'
+let w1 = Worker.fork()
+let w2 = Worker.fork()
+let r1 = w1.eval(code)
+let r2 = w2.eval(code)
+assert(r1 == 5000)
+assert(r2 == 5000)
+Worker.join(w1, w2)
+assert(o["key1"] == 1)
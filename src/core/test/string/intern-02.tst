@@ -0,0 +1,69 @@
+/*
+    Lazy interning. String results are interned on demand when used as property names.
+ */
+
+let base = "alpha-beta-gamma"
+let a = base.slice(0, 5), b = base.split("-")[1], c = base.substring(11), u = "ALPHA".toLowerCase()
+
+//  Equality by value
+
+assert(a == "alpha")
+assert(a === "alpha")
+assert(u === a)
+assert(a != b)
+assert(a !== b)
+assert(b == "beta" && c == "gamma")
+assert("x".concat("y") == "xy")
+
+switch (c) {
+case "beta":
+    assert(false)
+    break
+case "gamma":
+    break
+default:
+    assert(false)
+}
+
+//  Property names
+
+let o = {}
+o[a] = 1
+o[b] = 2
+assert(o.alpha == 1)
+assert(o["beta"] == 2)
+assert(o[u] == 1)
+assert(a in o)
+assert(o.hasOwnProperty(base.slice(6, 10)))
+assert(Object.getOwnPropertyNames(o).length == 2)
+let key = base.slice(0, 5)
+delete o[key]
+assert(!("alpha" in o))
+o[c] = 3
+assert(serialize(o) == '{"beta":2,"gamma":3}')
+assert(deserialize('{"' + "ab".toUpperCase() + '": 7}').AB == 7)
+
+//  Empty results
+
+assert(!"abc".slice(3))
+assert(!("" + ""))
+assert(!!"abc".slice(2))
+assert("abc".slice(1, 1) === "")
+
+//  Array search by value
+
+let list = ["alpha", "beta"]
+assert(list.indexOf(a) == 0)
+assert(list.contains(b))
+assert([a, b].indexOf("beta") == 1)
+
+//  Bulk text
+
+let path = Path("intern-02.tmp")
+path.write("line one\nline two\n")
+let text = path.readString()
+assert(text == "line one\nline two\n")
+assert(text.split("\n")[1] == "line two")
+o[text.split("\n")[0]] = true
+assert(o["line one"])
+path.remove()
@@ -0,0 +1,91 @@
+/*
+    String search, trim and caseless comparison. Vectorized scans are tested across block boundaries.
+ */
+
+function pad(n, c) {
+    let s = ""
+    for (let i = 0; i < n; i++) {
+        s += c
+    }
+    return s
+}
+
+//  Substring search at every offset around 16 and 32 character blocks
+
+for (let n = 0; n < 70; n++) {
+    let s = pad(n, "a") + "xyz" + pad(70 - n, "a")
+    assert(s.indexOf("xyz") == n)
+    assert(s.lastIndexOf("xyz") == n)
+    assert(s.indexOf("xy") == n)
+    assert(s.indexOf("z") == n + 2)
+    assert(s.contains("xyz"))
+    assert(!s.contains("xzy"))
+    assert(s.indexOf("xyz", n + 1) == -1)
+    assert(s.startsWith(pad(n, "a") + "x"))
+}
+
+//  First and last characters match but the middle does not
+
+let s = pad(40, "ab") + "abcab" + pad(40, "ab")
+assert(s.indexOf("abcab") == 80)
+assert(s.lastIndexOf("abcab") == 80)
+assert(s.indexOf("aXb") == -1)
+assert(s.lastIndexOf("aXb") == -1)
+
+//  Multiple matches
+
+s = pad(50, "-") + "ab" + pad(50, "-") + "ab" + pad(5, "-")
+assert(s.indexOf("ab") == 50)
+assert(s.lastIndexOf("ab") == 102)
+assert(s.indexOf("ab", 51) == 102)
+assert(s.split("ab").length == 3)
+assert(s.replace("ab", "X").indexOf("X") == 50)
+assert(s.replace("ab", "X").indexOf("ab") == 101)
+
+//  Patterns at the ends and longer than the string
+
+assert("abc".indexOf("abcd") == -1)
+assert("abc".lastIndexOf("bc") == 1)
+assert("abc".lastIndexOf("ab") == 0)
+assert("abc".indexOf("c") == 2)
+assert("".indexOf("a") == -1)
+assert("abc".indexOf("") == 0)
+assert(!"".contains("a"))
+assert((pad(100, "a") + "b").indexOf("ab") == 99)
+assert(("b" + pad(100, "a")).lastIndexOf("ba") == 0)
+
+//  Trimming white space
+
+for (let n = 0; n < 40; n++) {
+    let ws = pad(n, " \t\r\n")
+    assert((ws + "x y" + ws).trim() == "x y")
+    assert((ws + "x y" + ws).trimStart() == "x y" + ws)
+    assert((ws + "x y" + ws).trimEnd() == ws + "x y")
+    assert(ws.trim() == "")
+}
+assert(" \v\fa\f\v ".trim() == "a")
+assert("\x01a\x01".trim() == "\x01a\x01")
+assert(pad(3, "ab").trim("ab") == "")
+assert("--x--".trim("-") == "x")
+
+//  Caseless comparison
+
+for (let n = 0; n < 40; n++) {
+    let a = pad(n, "Hello") + "World"
+    let b = pad(n, "hELLO") + "wORLD"
+    assert(a.caselessCompare(b) == 0)
+    assert(a.caselessCompare(b + "!") == -1)
+    assert((a + "!").caselessCompare(b) == 1)
+    assert(a.caselessCompare(pad(n, "hello") + "worle") == -1)
+    assert(a.caselessCompare(pad(n, "hello") + "WORLC") == 1)
+}
+assert("@".caselessCompare("`") == -1)
+assert("[".caselessCompare("{") == -1)
+assert("".caselessCompare("") == 0)
+
+//  Expansion
+
+let t = pad(20, "text ") + "${a} and $${b} " + pad(20, "$ ") + "${c.d}"
+let r = t.expand({a: 1, c: {d: 2}})
+assert(r == pad(20, "text ") + "1 and ${b} " + pad(20, "$ ") + "2")
+assert("no tokens".expand({}) == "no tokens")
@@ -0,0 +1,42 @@
+/*
+    Inline property caches. Repeated by-name accesses at the same site must see shape and prototype changes.
+ */
+
+class Point {
+    var x: Number
+    function Point(x) { this.x = x }
+}
+
+function getX(o) {
+    return o.x
+}
+
+//  Monomorphic and polymorphic sites
+
+let list = [new Point(1), {x: 7}, {y: 1, x: 8}, {x: 9}, new Point(4)]
+let expect = [1, 7, 8, 9, 4]
+for (let iter = 0; iter < 3; iter++) {
+    for (let i = 0; i < list.length; i++) {
+        assert(getX(list[i]) == expect[i])
+    }
+}
+
+//  Deleting and re-adding properties
+
+let d = {x: 1, y: 2}
+assert(getX(d) == 1)
+delete d.x
+assert(getX(d) == undefined)
+d.x = 3
+assert(getX(d) == 3)
+
+//  Prototype changes
+
+function Shape() {}
+Shape.prototype.x = 10
+let s = new Shape
+assert(getX(s) == 10)
+Shape.prototype.x = 20
+assert(getX(s) == 20)
+s.x = 30
+assert(getX(s) == 30)
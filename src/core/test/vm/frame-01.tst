@@ -0,0 +1,51 @@
+/*
+    Function frame reuse. Frames are recycled on return unless captured by closures.
+ */
+
+function add(a, b) {
+    let c = a + b
+    return c
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2)
+}
+
+assert(fib(15) == 610)
+
+//  Closures keep their frames after return
+
+function counter(start) {
+    let count = start
+    return function() { return count++ }
+}
+let counters = []
+for (let i = 0; i < 10; i++) {
+    counters.push(counter(i * 100))
+    add(i, i)
+}
+GC.run()
+assert(counters[3]() == 300)
+assert(counters[3]() == 301)
+
+//  Frames unwound by exceptions
+
+function thrower(n) {
+    if (n == 0) {
+        throw new Error("bottom")
+    }
+    return thrower(n - 1) + n
+}
+for (let i = 0; i < 10; i++) {
+    try {
+        thrower(5)
+        assert(false)
+    } catch (e) {
+        assert(e.message == "bottom")
+    }
+    assert(add(i, 1) == i + 1)
+}
+
+//  Calls from native code
+
+assert([1, 2, 3].map(function(v) { return add(v, v) }).join(",") == "2,4,6")
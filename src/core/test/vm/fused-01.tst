@@ -0,0 +1,100 @@
+/*
+    Fused op codes. Sequences that the compiler fuses must behave as the separate instructions.
+ */
+
+function count(n: Number): Number {
+    var total: Number = 0
+    for (var i: Number = 0; i < n; i++) {
+        total++
+    }
+    return total
+}
+
+function classify(a, b) {
+    let result = ""
+    if (a == b) result += "eq,"
+    if (a != b) result += "ne,"
+    if (a < b) result += "lt,"
+    if (a <= b) result += "le,"
+    if (a > b) result += "gt,"
+    if (a >= b) result += "ge,"
+    return result
+}
+
+assert(count(1000) == 1000)
+assert(classify(1, 2) == "ne,lt,le,")
+assert(classify(2, 2) == "eq,le,ge,")
+assert(classify("2", 2) == "eq,le,ge,")
+assert(classify(NaN, 1) == "ne,")
+
+//  Postfix increment on untyped and property values
+
+let s = "1"
+assert(s++ == "1" && s == "11")
+let p = {x: 1}
+assert(p.x++ == 1 && p.x == 2)
+
+//  Jumps into the loop branch
+
+let visits = []
+for (let j = 0; j < 6; j++) {
+    if (j % 2) {
+        continue
+    }
+    visits.push(j)
+}
+assert(visits == "0,2,4")
+
+//  Local variable sequences
+
+function sum(n) {
+    var total = 0, i = 0
+    while (i < n) {
+        total = total + i
+        i++
+    }
+    return total
+}
+assert(sum(100) == 4950)
+assert(sum(0) == 0)
+
+function below(limit) {
+    var hits = 0, misses = 0
+    for (var k = 0; k < 100; k++) {
+        if (k < limit) {
+            hits++
+        } else {
+            misses++
+        }
+    }
+    return hits + misses * 1000
+}
+assert(below(10) == 90010)
+assert(below(-1) == 100000)
+
+//  Operands that are not Numbers
+
+function concat(a, b) {
+    var total = a, i = 0
+    total = total + b
+    return total
+}
+assert(concat("a", "b") == "ab")
+assert(concat("a", 1) == "a1")
+
+//  A getter or exception in the middle of a sequence
+
+let calls = 0
+Object.defineProperty(global, "limit", { get: function() { calls++; return 5 } })
+let total = 0
+for (let n = 0; n < limit; n++) total++
+assert(total == 5)
+assert(calls == 6)
+
+let caught = false
+try {
+    for (let n = 0; n < undefinedName; n++) {}
+} catch (e) {
+    caught = e is ReferenceError
+}
+assert(caught)
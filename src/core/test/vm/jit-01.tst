@@ -0,0 +1,91 @@
+/*
+    Native code for hot functions. Loops, calls and returns enter the native code, which returns to the interpreter
+    for exceptions, getters and unsupported op codes.
+ */
+
+function sum(n) {
+    var total = 0
+    for (var i = 0; i < n; i++) {
+        total = total + i * 2 - 1
+    }
+    return total
+}
+
+function countDown(n) {
+    let count = 0
+    while (n > 0) {
+        n = n - 1
+        count++
+    }
+    return count
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2)
+}
+
+assert(sum(1000) == 998000)
+assert(countDown(1000) == 1000)
+assert(fib(20) == 6765)
+
+//  Comparisons and branches on other types in compiled code
+
+function pick(a, b) {
+    if (a < b) {
+        return a
+    }
+    return b
+}
+for (let i = 0; i < 1000; i++) {
+    assert(pick(i, i + 1) == i)
+}
+assert(pick("b", "a") == "a")
+assert(pick(NaN, 1) == 1)
+assert(pick(null, 1) == null)
+
+//  Exceptions thrown in compiled code are caught by the interpreter
+
+function fail(n) {
+    let caught = 0
+    for (let i = 0; i < n; i++) {
+        try {
+            if (i % 100 == 99) {
+                throw new Error("boom")
+            }
+        } catch (e) {
+            caught++
+        }
+    }
+    return caught
+}
+assert(fail(1000) == 10)
+
+function undefinedName(n) {
+    for (let i = 0; i < n; i++) {
+        if (i == n - 1) {
+            return missingVariable
+        }
+    }
+}
+let caught = false
+try {
+    undefinedName(1000)
+} catch (e) {
+    assert(e is ReferenceError)
+    caught = true
+}
+assert(caught)
+
+//  Getters called from compiled code
+
+var calls = 0
+Object.defineProperty(global, "step", { get: function() { calls++; return 2 } })
+function stride(n) {
+    let total = 0
+    for (let i = 0; i < n; i += step) {
+        total = total + i
+    }
+    return total
+}
+assert(stride(1000) == 249500)
+assert(calls == 500)
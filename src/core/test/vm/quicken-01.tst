@@ -0,0 +1,38 @@
+/*
+    Runtime op code specialization. Hot functions specialize generic op codes for Numbers and revert for other types.
+ */
+
+function add(a, b) {
+    return a + b
+}
+
+function less(a, b) {
+    if (a < b) {
+        return true
+    }
+    return false
+}
+
+//  Warm up with Numbers so the sites are specialized
+
+for (let i = 0; i < 1000; i++) {
+    assert(add(i, 1) == i + 1)
+    assert(less(i, i + 1))
+}
+
+//  Other types at the same sites
+
+assert(add("a", 1) == "a1")
+assert(add(null, 1) == 1)
+assert(less("a", "b"))
+assert(!less(NaN, 1))
+
+//  Sites that keep changing types
+
+for (let i = 0; i < 1000; i++) {
+    if (i & 1) {
+        assert(add(i, i) == i * 2)
+    } else {
+        assert(add("x", i) == "x" + i)
+    }
+}
@@ -0,0 +1,50 @@
+/*
+    Shared object shapes. Objects built in the same order share property layouts and revert to dictionaries on change.
+ */
+
+function make(i) {
+    let o = {}
+    o.a = i
+    o.b = i * 2
+    o.c = i * 3
+    return o
+}
+
+function sum(o) {
+    return o.a + o.b + o.c
+}
+
+//  Same and different insertion orders
+
+let list = []
+for (let i = 0; i < 100; i++) {
+    list.push(make(i))
+}
+assert(sum(list[10]) == 60)
+assert(Object.getOwnPropertyNames(list[10]).join(",") == "a,b,c")
+let x = {}
+x.c = 3
+x.b = 2
+x.a = 1
+assert(Object.getOwnPropertyNames(x).join(",") == "c,b,a")
+assert(sum(x) == 6)
+
+//  Delete and clone do not disturb objects sharing the shape
+
+let o = make(1)
+delete o.b
+o.b = 5
+assert(sum(o) == 9)
+let c = list[5].clone()
+c.d = 1
+assert(list[5].d == undefined)
+assert(Object.getOwnPropertyNames(c).join(",") == "a,b,c,d")
+
+//  Many properties revert to a dictionary
+
+let big = {}
+for (let i = 0; i < 200; i++) {
+    big["p" + i] = i
+}
+assert(big.p150 == 150)
+assert(Object.getOwnPropertyNames(big).length == 200)
@@ -0,0 +1,18 @@
+/*
+    Isolated worker. Runs in a separate process and collects its own garbage.
+ */
+
+onmessage = function (e) {
+    let data = deserialize(e.data)
+    if (data.stop) {
+        exit()
+    }
+    let list = []
+    for (let i = 0; i < data.count; i++) {
+        list.push({ value: i, text: "item-" + i })
+    }
+    GC.run()
+    postMessage({ name: self.name, count: list.length, text: "line\nbreak", echo: data.text,
+        big: data.big })
+}
+App.run()
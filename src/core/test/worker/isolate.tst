@@ -0,0 +1,59 @@
+/*
+    Isolated Worker Tests
+ */
+
+var w: Worker
+
+//  Messages are copied between processes
+
+let replies = []
+let closed = 0
+w = new Worker("isolate.es", { isolate: true, name: "isolated" })
+assert(w.name == "isolated")
+w.onmessage = function (e) {
+    let data = deserialize(e.data)
+    replies.push(data)
+    w.postMessage(replies.length < 3 ? { count: 1000 * replies.length } : { stop: true })
+}
+w.onclose = function (e) {
+    closed++
+}
+//  Frames carry escapes, new lines and messages larger than a pipe buffer unchanged
+let big = "0123456789".times(20000)
+w.postMessage({ count: 5000, text: "escaped \\n and\nnew line", big: big })
+assert(Worker.join(w, 30000))
+assert(closed == 1)
+assert(replies.length == 3)
+assert(replies[0].name == "isolated")
+assert(replies[0].count == 5000)
+assert(replies[1].count == 1000)
+assert(replies[2].count == 2000)
+assert(replies[0].text == "line\nbreak")
+assert(replies[0].echo == "escaped \\n and\nnew line")
+assert(replies[0].big == big)
+
+//  Failures are reported via onerror
+
+let message = null
+w = new Worker("onerror.es", { isolate: true })
+w.onerror = function (e) {
+    message = e.message
+}
+assert(Worker.join(w, 30000))
+assert(message.contains("Can't continue"))
+
+//  Terminate
+
+w = new Worker("terminate.es", { isolate: true })
+w.terminate()
+assert(Worker.join(w, 30000))
+
+//  Unsupported operations
+
+let caught = false
+try {
+    w.eval("1")
+} catch (e) {
+    caught = true
+}
+assert(caught)
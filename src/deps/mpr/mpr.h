@@ -775,6 +775,29 @@ PUBLIC void *mprAtomicExchange(void * volatile *target, cvoid *value);
     #define BIT_MEMORY_STACK        0
 #endif
 
+/*
+    Per-thread caches of small free blocks. Use configure --set mprAllocCache=false to disable.
+ */
+#ifndef BIT_MPR_ALLOC_CACHE
+    #define BIT_MPR_ALLOC_CACHE     BIT_UNIX_LIKE
+#endif
+
+/*
+    Young generation (nursery) with minor collections. Writes to the old generation are tracked by the O/S 
+    (userfaultfd write protection) instead of by a write barrier. Use configure --set mprNursery=false to disable.
+ */
+#ifndef BIT_MPR_NURSERY
+    #define BIT_MPR_NURSERY         (BIT_MPR_ALLOC_CACHE && LINUX && BIT_64)
+#endif
+
+/*
+    Heap partitions that are collected without pausing threads bound to other partitions. Uses the nursery region index
+    and young block flag. Use configure --set mprPartition=false to disable.
+ */
+#ifndef BIT_MPR_PARTITION
+    #define BIT_MPR_PARTITION       BIT_MPR_NURSERY
+#endif
+
 /*
     Alignment bit sizes for the allocator. Blocks are aligned on 4 byte boundaries for 32 bits systems and 8 byte 
     boundaries for 64 bit systems and those systems that require doubles to be 8 byte aligned.
@@ -806,6 +829,7 @@ PUBLIC void *mprAtomicExchange(void * volatile *target, cvoid *value);
 /*
     MprMem.size field bits. Layout for 32 bits. This field can be read while unlocked.
         gen/2 << 30 | free << 29 | size/29 | mark/2
+    On 64 bit systems, sizes are 8 byte aligned and bit 2 flags blocks in the young generation (nursery).
 */
 #define MPR_SHIFT_MARK          0
 #define MPR_SHIFT_SIZE          0
@@ -814,7 +838,12 @@ PUBLIC void *mprAtomicExchange(void * volatile *target, cvoid *value);
 #define MPR_MASK_MARK           (0x3)
 #define MPR_MASK_GEN            (((size_t) 0x3) << MPR_SHIFT_GEN)
 #define MPR_MASK_FREE           (((size_t) 0x1) << MPR_SHIFT_FREE)
-#define MPR_MASK_SIZE           ~(MPR_MASK_GEN | MPR_MASK_FREE | MPR_MASK_MARK)
+#if BIT_64
+#define MPR_MASK_YOUNG          (0x4)
+#else
+#define MPR_MASK_YOUNG          (0x0)
+#endif
+#define MPR_MASK_SIZE           ~(MPR_MASK_GEN | MPR_MASK_FREE | MPR_MASK_MARK | MPR_MASK_YOUNG)
 
 /**
     Memory Allocation Service.
@@ -843,12 +872,13 @@ PUBLIC void *mprAtomicExchange(void * volatile *target, cvoid *value);
 
     @stability Internal
     @defgroup MprMem MprMem
-    @see MprFreeMem MprHeap MprManager MprMemNotifier MprRegion mprAddRoot mprAlloc mprAllocMem mprAllocObj 
-        mprAllocZeroed mprCreateMemService mprDestroyMemService mprEnableGC mprGetBlockSize mprGetMem 
-        mprGetMemStats mprGetMpr mprGetPageSize mprHasMemError mprHold mprIsDead mprIsParent mprIsValid mprMark 
-        mprMemcmp mprMemcpy mprMemdup mprPrintMem mprRealloc mprRelease mprRemoveRoot mprRequestGC mprResetMemError 
-        mprRevive mprSetAllocLimits mprSetManager mprSetMemError mprSetMemLimits mprSetMemNotifier mprSetMemPolicy 
-        mprSetName mprValidateBlock mprVerifyMem mprVirtAlloc mprVirtFree 
+    @see MprFreeMem MprHeap MprManager MprMemNotifier MprRegion mprAddRoot mprAlloc mprAllocMem mprAllocObj
+        mprAllocZeroed mprCreateMemService mprDestroyMemService mprEnableGC mprGetBlockSize mprGetMem mprGetGCPause
+        mprGetMemStats mprGetMpr mprGetPageSize mprHasMemError mprHold mprIsDead mprIsParent mprIsValid mprMark
+        mprMemcmp mprMemcpy mprMemdup mprPrintMem mprRealloc mprRelease mprRemember mprForget mprRemoveRoot mprRequestGC 
+        mprResetMemError mprRevive mprSetAllocLimits mprSetAllocSampler mprSetGCGrowth mprSetGCPauseTarget mprSetGCThreads mprSetManager mprSetMemError
+        mprSetMemLimits mprSetMemNotifier mprSetMemPolicy mprSetName mprSetNurserySize mprValidateBlock mprVerifyMem mprVirtAlloc
+        mprVirtFree mprWalkMem mprWriteMemSnapshot
  */
 typedef struct MprMem {
     /*
@@ -891,6 +921,8 @@ typedef struct MprMem {
 #define MPR_ALLOC_BITS_PER_GROUP    (sizeof(void*) * 8)
 #define MPR_ALLOC_NUM_GROUPS        (MPR_ALLOC_BITS_PER_GROUP - MPR_ALLOC_BUCKET_SHIFT - MPR_ALIGN_SHIFT - 1)
 #define MPR_ALLOC_NUM_BUCKETS       (1 << MPR_ALLOC_BUCKET_SHIFT)
+#define MPR_ALLOC_CACHE_QUEUES      (2 * MPR_ALLOC_NUM_BUCKETS) /**< Free queues served by thread caches */
+#define MPR_ALLOC_CACHE_BATCH       8                           /**< Blocks moved to a thread cache per refill */
 #define MPR_GET_PTR(bp)             ((void*) (((char*) (bp)) + sizeof(MprMem)))
 #define MPR_GET_MEM(ptr)            ((MprMem*) (((char*) (ptr)) - sizeof(MprMem)))
 #define MPR_GET_GEN(mp)             ((mp->field2 & MPR_MASK_GEN) >> MPR_SHIFT_GEN)
@@ -901,6 +933,12 @@ typedef struct MprMem {
  */
 #define MPR_GEN_ETERNAL             3           /**< Objects immune from collection */
 #define MPR_MAX_GEN                 3           /**< Number of generations for object allocation */
+#define MPR_GC_MAX_GROWTH           1000        /**< Maximum percentage heap growth between collections */
+#define MPR_GC_MAX_THREADS          64          /**< Maximum number of threads marking in parallel */
+#define MPR_GC_PAUSE_BUCKETS        24          /**< Buckets in the histogram of collector pauses */
+#define MPR_GC_HISTORY              16          /**< Number of recent collections recorded */
+#define MPR_MARK_BATCH_SIZE         64          /**< Maximum blocks shared for stealing at once */
+#define MPR_HUGE_PAGE_SIZE          (2 * 1024 * 1024) /**< Transparent huge page size and heap region size when enabled */
 
 /*
     Manager callback flags
@@ -966,6 +1004,40 @@ typedef void (*MprMemNotifier)(int cause, int policy, ssize size, ssize total);
  */
 typedef void (*MprManager)(void *ptr, int flags);
 
+/**
+    Memory block walker prototype for mprWalkMem
+    @param ptr Memory block
+    @param size Size of the block including the block header
+    @param manager Block manager. Set to NULL if the block does not have a manager.
+    @param data Data argument provided to mprWalkMem
+    @ingroup MprMem
+    @stability Evolving.
+ */
+typedef void (*MprMemWalker)(void *ptr, ssize size, MprManager manager, void *data);
+
+/**
+    Allocation sampler prototype for mprSetAllocSampler
+    @param ptr Newly allocated memory block. The block contents are not yet initialized.
+    @param size Size of the block including the block header
+    @param weight Bytes of allocation represented by this sample
+    @param caller Code address of the call to mprAllocMem. May be NULL if the compiler cannot provide it.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+typedef void (*MprAllocSampler)(void *ptr, ssize size, ssize weight, cvoid *caller);
+
+/**
+    Memory snapshot labeler prototype for mprWriteMemSnapshot
+    @param ptr Memory block
+    @param manager Manager function for the block. Set to NULL if the block has no manager.
+    @param data Data argument passed to mprWriteMemSnapshot
+    @return A label for the block such as its type name. The label must remain valid until mprWriteMemSnapshot
+        returns. Return NULL to use the default label.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+typedef cchar *(*MprMemLabeler)(void *ptr, MprManager manager, void *data);
+
 /**
     Block structure when on a free list. This overlays MprMem and replaces sibling and children with forw/back
     The implies a minimum memory block size of 8 bytes in 32 bits and 16 bytes in 64 bits.
@@ -983,9 +1055,25 @@ typedef struct MprFreeMem {
     } info;
     struct MprFreeMem *next;                /**< Next free block */
     struct MprFreeMem *prev;                /**< Previous free block */
+    int               released;             /**< Pages of the block have been returned to the O/S */
 } MprFreeMem;
 
 
+/**
+    Free queues of a heap or heap partition. The free map is a two dimensional array of free queues indexed by
+    group and bucket. See initFree() in mprLib.c for details.
+    @ingroup MemMem
+    @stability Internal.
+ */
+typedef struct MprFreeQueues {
+    MprFreeMem      freeq[MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS];
+    ulong           bucketMap[MPR_ALLOC_NUM_GROUPS];
+    MprFreeMem      *freeEnd;
+    ssize           groupMap;
+    ssize           bytesFree;              /**< Bytes on these free queues */
+} MprFreeQueues;
+
+
 #if BIT_MEMORY_STATS
 #define MPR_TRACK_HASH        2053          /* Size of location name hash */
 #define MPR_TRACK_NAMES       8             /* Length of collision chain */
@@ -997,6 +1085,24 @@ typedef struct MprLocationStats {
 #endif
 
 
+/**
+    Record of a garbage collection. Times are in microseconds.
+    @ingroup MemMem
+    @stability Internal.
+  */
+typedef struct MprGCRecord {
+    uint64          pause;                  /**< Time other threads were paused */
+    uint64          markTime;               /**< Time spent marking */
+    uint64          sweepTime;              /**< Time spent sweeping while threads were paused */
+    uint64          allocated;              /**< Bytes allocated since the prior collection */
+    uint64          freedBlocks;            /**< Count of blocks freed */
+    ssize           freed;                  /**< Bytes freed. Updated when sweeping completes. */
+    ssize           live;                   /**< Bytes in use after the collection */
+    ssize           heap;                   /**< Heap size after the collection */
+    ssize           promoted;               /**< Bytes of young blocks promoted to the old generation */
+    int             minor;                  /**< Minor collection of the nursery only */
+} MprGCRecord;
+
 /**
     Memory allocator statistics
     @ingroup MemMem
@@ -1012,12 +1118,64 @@ typedef struct MprMemStats {
     ssize           bytesAllocated;         /**< Bytes currently allocated */
     ssize           bytesFree;              /**< Bytes currently free */
     ssize           freed;                  /**< Bytes freed in last sweep */
+    ssize           liveBytes;              /**< Bytes in use after the last sweep */
+    ssize           largestFree;            /**< Largest free block in bytes */
+    uint64          totalAllocated;         /**< Total bytes allocated */
+    uint64          totalFreed;             /**< Total bytes freed by the collector */
     ssize           redLine;                /**< Warn if allocation exceeds this level */
     ssize           maxMemory;              /**< Max memory that can be allocated */
     ssize           rss;                    /**< OS calculated resident stack size in bytes */
     uint64          user;                   /**< System user RAM size in bytes (excludes kernel) */
     uint64          ram;                    /**< System RAM size in bytes */
 
+    /*
+        Allocator contention stats
+     */
+    uint64          heapLocks;              /**< Count of heap lock acquisitions */
+    uint64          heapLockWaits;          /**< Count of heap lock acquisitions that waited for another thread */
+    uint64          cacheHits;              /**< Count of allocations served from thread caches and nurseries without locking */
+    uint64          cacheRefills;           /**< Count of block batches moved from the heap to thread caches and nurseries */
+    uint64          cacheFlushes;           /**< Count of thread caches returned to the heap */
+    ssize           bytesCached;            /**< Bytes held in thread caches */
+    int             caches;                 /**< Number of thread caches */
+
+    /*
+        O/S memory stats
+     */
+    ssize           bytesCommitted;         /**< Heap bytes backed by physical memory (resident) after the last sweep */
+    uint64          releases;               /**< Count of free spans returned to the O/S */
+    int             hugePages;              /**< Heap regions are backed by transparent huge pages */
+
+    /*
+        Collector pause stats. Times are in microseconds.
+     */
+    uint64          collections;            /**< Count of completed collections */
+    uint64          pauseTime;              /**< Total time threads have been paused for collection */
+    uint64          lastPause;              /**< Duration of the last pause */
+    uint64          maxPause;               /**< Longest pause */
+    uint64          pauses[MPR_GC_PAUSE_BUCKETS]; /**< Pause histogram. Bucket N counts pauses under 2^N usec */
+    uint64          lastSweepTime;          /**< Time spent sweeping in the last pause */
+    uint64          deferredSweeps;         /**< Count of collections that finished sweeping after resuming threads */
+    MprGCRecord     history[MPR_GC_HISTORY]; /**< Recent collections. Collection N is at index (N - 1) % MPR_GC_HISTORY */
+    uint64          lastMarkTime;           /**< Time spent marking in the last collection */
+    uint64          markSteals;             /**< Count of mark stack batches stolen by idle marking threads */
+    int             markThreads;            /**< Number of threads that marked the last collection */
+
+    /*
+        Young generation stats
+     */
+    uint64          minorCollections;       /**< Count of collections of the nursery only */
+    uint64          promoted;               /**< Total bytes of young blocks promoted to the old generation */
+    uint64          writtenPages;           /**< Total old generation pages scanned for references to young blocks */
+    ssize           nursery;                /**< Nursery size. Zero if minor collections are disabled */
+
+    /*
+        Heap partition stats
+     */
+    uint64          partitionCollections;   /**< Count of collections of a single partition */
+    uint64          partitionPauseTime;     /**< Total time partition threads have been paused for collection */
+    int             partitions;             /**< Number of heap partitions */
+
 #if BIT_MEMORY_STATS
     /*
         Extended memory stats
@@ -1049,19 +1207,91 @@ typedef struct MprRegion {
     MprSpin          lock;                  /**< Region multithread lock */
     ssize            size;                  /**< Size of region including region header */
     int              freeable;              /**< Set to true when completely unused */
+    int              garbage;               /**< Region has blocks to be freed by the sweeper */
+    uint             *starts;               /**< Offset of a block starting at or before each page (minor collections) */
+    struct MprPartition *partition;         /**< Owning heap partition. Null for the shared heap. */
+    ulong            *blocks;               /**< Block start bitmap while collecting the partition (malloc) */
 } MprRegion;
 
 
+/**
+    Heap partition. Blocks allocated by threads bound to a partition are allocated from regions owned by the partition.
+    A partition collection pauses only the threads bound to the partition and threads not bound to any partition.
+    @ingroup MemMem
+    @stability Internal.
+ */
+typedef struct MprPartition {
+    MprFreeQueues   queues;                 /**< Free queues for the partition regions */
+    struct MprPartition *next;              /**< Next partition in the heap or spare list */
+    ssize           bytes;                  /**< Size of the partition regions */
+    ssize           growTarget;             /**< Size above which growing the partition will trigger a collection */
+    ssize           live;                   /**< Bytes in use after the last partition collection */
+    uint64          allocated;              /**< Bytes allocated from the partition */
+    uint64          collections;            /**< Count of partition collections */
+    uint64          pauseTime;              /**< Total time partition threads have been paused for collection */
+    int             gcRequested;            /**< Partition collection has been requested */
+    int             destroyed;              /**< Merge into the shared heap at the next full collection */
+} MprPartition;
+
+
+/**
+    Per-thread allocation cache. Small blocks are moved from the heap free queues in batches and are then allocated
+    by the owning thread without locking the heap. Cached blocks are in the eternal generation so the sweeper skips them.
+    Blocks are kept on separate lists depending on whether the block has a manager.
+    @ingroup MemMem
+    @stability Internal.
+ */
+typedef struct MprAllocCache {
+    MprFreeMem      *free[MPR_ALLOC_CACHE_QUEUES][2];   /**< Cached blocks indexed by free queue and manager */
+    struct MprAllocCache *next;             /**< Next cache in the heap list */
+    struct MprAllocCache *prev;             /**< Previous cache in the heap list */
+    uint64          hits;                   /**< Count of allocations served from this cache */
+    uint64          allocated;              /**< Bytes allocated from this cache */
+    ssize           sampleCountdown;        /**< Bytes to allocate before the next allocation sample */
+    int             sampling;               /**< Running the allocation sampler */
+    ssize           bytes;                  /**< Bytes held in this cache */
+    struct MprNursery *nursery;             /**< Nursery chunk for bump allocation of young blocks */
+    int             nurseryEpoch;           /**< Collection count when the nursery chunk was taken */
+    MprPartition    *partition;             /**< Heap partition the thread is bound to */
+    int             shared;                 /**< Allocate from the shared heap while bound to a partition */
+} MprAllocCache;
+
+
+/**
+    Mark stack for a thread marking blocks. Blocks with managers are pushed when marked and their managers are 
+    then run from the stack instead of recursively. The stack is private to its thread.
+    @ingroup MemMem
+    @stability Internal.
+ */
+typedef struct MprMarkStack {
+    void            **items;                /**< Marked blocks waiting for their managers to run (malloc) */
+    int             top;                    /**< Index of the next free item */
+    int             size;                   /**< Allocated length of items */
+    int             cycle;                  /**< Last collection joined by the helper thread */
+    struct MprThread *thread;               /**< Helper marking thread. Null for the marker thread. */
+    MprCond         *cond;                  /**< Helper thread wakeup */
+} MprMarkStack;
+
+
+/**
+    Batch of marked blocks shared by a busy marking thread for idle marking threads to steal
+    @ingroup MemMem
+    @stability Internal.
+ */
+typedef struct MprMarkBatch {
+    struct MprMarkBatch *next;              /**< Next batch in the pool or spare list */
+    int             count;                  /**< Number of items */
+    void            *items[MPR_MARK_BATCH_SIZE]; /**< Marked blocks waiting for their managers to run */
+} MprMarkBatch;
+
+
 /**
     Memory allocator heap
     @ingroup MemMem
     @stability Internal.
  */
 typedef struct MprHeap {
-    MprFreeMem       freeq[MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS];
-    ulong            bucketMap[MPR_ALLOC_NUM_GROUPS];
-    MprFreeMem       *freeEnd;
-    ssize            groupMap;
+    MprFreeQueues    queues;                 /**< Free queues of the shared heap */
     struct MprList   *roots;                 /**< List of GC root objects */
     MprMemStats      stats;
     MprMemNotifier   notifier;               /**< Memory allocation failure callback */
@@ -1072,6 +1302,11 @@ typedef struct MprHeap {
     MprRegion        *regions;               /**< List of memory regions */
     struct MprThread *marker;                /**< Marker thread */
     struct MprThread *sweeper;               /**< Optional sweeper thread */
+    MprMarkStack     *markStacks;            /**< Mark stacks for the marker and helper threads (malloc) */
+    MprMarkBatch     *markPool;              /**< Shared batches waiting to be stolen (malloc) */
+    MprMarkBatch     *markSpare;             /**< Spare batches for reuse (malloc) */
+    MprSpin          markLock;               /**< Shared batch lock */
+    struct MprThreadLocal *markKey;          /**< Thread data key for the mark stack of helper threads */
 
     int              eternal;                /**< Eternal generation (permanent and dead blocks) */
     int              active;                 /**< Active generation for new and active blocks */
@@ -1085,11 +1320,20 @@ typedef struct MprHeap {
     int              enabled;                /**< GC is enabled */
     int              flags;                  /**< GC operational control flags */
     int              from;                   /**< Eligible mprCollectGarbage flags */
+    int              gcGrowth;               /**< Percentage the heap may grow over live memory before a GC */
+    int              gcThreads;              /**< Number of threads to mark with (marker and helpers) */
     int              gcRequested;            /**< GC has been requested */
     int              hasError;               /**< Memory allocation error */
     int              hasSweeper;             /**< Has dedicated sweeper thread */
+    int              hugePages;              /**< Back heap regions with transparent huge pages */
     int              iteration;              /**< GC iteration counter (debug only) */
     int              marking;                /**< Actually marking objects now */
+    volatile int     markBusy;               /**< Count of marking threads with work */
+    int              markCycle;              /**< Collection sequence for helper threads */
+    volatile int     markDone;               /**< Marking is complete. Helper threads must stop. */
+    int              markHelpers;            /**< Count of helper marking threads started */
+    volatile int     markJoined;             /**< Count of helper threads participating in marking */
+    int              markThreads;            /**< Number of threads marking the current collection */
     int              mustYield;              /**< Threads must yield for GC which is due */
     int              newCount;               /**< Count of new gen allocations */
     int              earlyYieldQuota;        /**< Quota of new allocations before yielding threads early to cleanup */
@@ -1097,13 +1341,53 @@ typedef struct MprHeap {
     int              nextSeqno;              /**< Next sequence number */
     int              pauseGC;                /**< Pause GC (short) */
     int              pageSize;               /**< System page size */
+    int              pauseTarget;            /**< Target maximum pause in milliseconds (0 for no target) */
+    ssize            releaseSize;            /**< Minimum free span to return to the O/S (0 to never release) */
+    ssize            growTarget;             /**< Heap size above which growing the heap will trigger a GC */
     int              priorNewCount;          /**< Last sweep new count */
     ssize            priorFree;              /**< Last sweep free memory */
     int              rootIndex;              /**< Marker root scan index */
     int              scribble;               /**< Scribble over freed memory (slow) */
     int              sweeping;               /**< Actually sweeping objects now */
+    volatile int     sweepPending;           /**< Regions remain to be swept after resuming threads */
+    MprRegion        *sweepRegion;           /**< Next region to sweep */
+    MprRegion        *sweepPrior;            /**< Last region retained by the sweeper */
+    ssize            sweepBytes;             /**< Bytes of garbage not yet freed by the sweeper */
     int              track;                  /**< Track memory allocations */
     int              verify;                 /**< Verify memory contents (very slow) */
+    uint64           allocated;              /**< Bytes allocated without a thread cache or by exited threads */
+    uint64           priorAllocated;         /**< Total bytes allocated at the prior collection */
+    MprAllocSampler  sampler;                /**< Allocation sampler */
+    ssize            sampleInterval;         /**< Average bytes allocated between samples */
+    ssize            sampleCountdown;        /**< Bytes to allocate before the next sample without thread caches */
+    int              sampling;               /**< Running the sampler without thread caches */
+    struct MprSnapshot *snapshot;            /**< Pending heap snapshot request */
+    int              tracing;                /**< Tracing references for a snapshot instead of marking */
+#if BIT_MPR_ALLOC_CACHE
+    MprAllocCache    *caches;                /**< List of thread allocation caches */
+    pthread_key_t    cacheKey;               /**< Thread data key for the allocation cache */
+    uint64           retiredHits;            /**< Cache hits of exited threads */
+#endif
+    struct MprList   *remembered;            /**< Blocks whose managers run on every minor collection */
+    struct MprNursery **nurseries;           /**< Nursery chunks taken since the last collection (malloc) */
+    int              nurseryCount;           /**< Count of nursery chunks */
+    int              nurseryMax;             /**< Allocated length of nurseries */
+    int              nurseryEpoch;           /**< Incremented when the nursery chunks are retired */
+    int              nursery;                /**< Allocate young blocks from the nursery */
+    ssize            nurserySize;            /**< Nursery bytes to allocate before a minor collection (0 to disable) */
+    ssize            nurseryBytes;           /**< Nursery bytes taken since the last collection */
+    ssize            retiredBytes;           /**< Unallocated nursery tails freed by the current collection */
+    char             *nurseryLow;            /**< Lowest nursery chunk address */
+    char             *nurseryHigh;           /**< Highest nursery chunk end address */
+    int              gcFull;                 /**< Next collection must be a full collection */
+    int              minor;                  /**< Current collection is a minor collection */
+    int              sweepMinor;             /**< Sweeping the nursery after a minor collection */
+    int              trackFd;                /**< Userfaultfd tracking writes to the heap. -1 if not tracking */
+    int              pagemapFd;              /**< Pagemap to read and reset written heap pages */
+    MprPartition     *partitions;            /**< List of heap partitions */
+    MprPartition     *spare;                 /**< Merged partitions for reuse */
+    MprPartition     *partition;             /**< Partition being collected */
+    int              partitionRequested;     /**< A partition collection has been requested */
 } MprHeap;
 
 /**
@@ -1155,6 +1439,49 @@ PUBLIC void *mprAllocMem(ssize size, int flags);
  */
 PUBLIC MprMemStats *mprGetMemStats();
 
+/**
+    Walk the allocated memory blocks
+    @description Invoke a callback for each allocated memory block. Blocks that are unreachable and waiting to be 
+        freed by the collector are not visited. Blocks reserved by thread allocation caches are visited. The heap is 
+        locked while walking, so the callback must not allocate memory. The heap may be modified by other threads 
+        before the walk returns, so the callback should not dereference pointers from one block to another without
+        independent knowledge the other block is valid.
+    @param fn Callback function
+    @param data Data argument to pass to the callback
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC void mprWalkMem(MprMemWalker fn, void *data);
+
+/**
+    Write a snapshot of the reachable heap to a file
+    @description The heap is traced from the GC roots while other threads are paused for a forced collection. 
+        Block managers enumerate the references from each block. Blocks are labeled by the labeler, or otherwise 
+        by the name of their manager function (or by their allocation name in memory debug builds). 
+        The snapshot is a text file. The first line is "mpr-snapshot 1 NODES EDGES LABELS". It is followed by one 
+        "L name" line per label and then one "N size label count ref ref ..." line per block. Labels and blocks 
+        are referenced by their zero based order in the file. The first block is a pseudo block for the GC roots.
+    @param path Snapshot filename
+    @param labeler Optional callback to label blocks
+    @param data Data argument to pass to the labeler
+    @return Zero if successful, otherwise a negative MPR error code.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC int mprWriteMemSnapshot(cchar *path, MprMemLabeler labeler, void *data);
+
+/**
+    Sample memory allocations
+    @description Invoke a callback after every interval bytes allocated by each thread. The callback receives the
+        block that crossed the interval and the number of bytes the sample represents. Allocations made by the callback
+        are not sampled. The callback may allocate memory, but must not yield.
+    @param sampler Callback function. Set to NULL to stop sampling.
+    @param interval Bytes to allocate between samples
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC void mprSetAllocSampler(MprAllocSampler sampler, ssize interval);
+
 /**
     Return the amount of memory currently used by the application. On Unix, this returns the total application memory
     size including code, stack, data and heap. On Windows, VxWorks and other operatings systems, it returns the
@@ -1535,6 +1862,164 @@ PUBLIC void mprRequestGC(int flags);
  */
 PUBLIC bool mprEnableGC(bool on);
 
+/**
+    Set the heap growth permitted between collections
+    @description When the heap must grow to satisfy an allocation, a garbage collection is triggered if the heap
+        has grown by more than the given percentage of the memory that survived the last collection. Short-lived
+        objects are then collected in batches and the collector marks live memory less often as the heap grows.
+    @param percent Percentage of live memory the heap may grow by. Set to zero to collect whenever the heap must grow.
+        Defaults to BIT_MPR_GC_GROWTH (100). The maximum is MPR_GC_MAX_GROWTH.
+    @return The prior growth percentage.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC int mprSetGCGrowth(int percent);
+
+/**
+    Set the target maximum garbage collection pause
+    @description The collector pauses other threads while it marks memory and runs the destructors of unreachable
+        blocks. It then frees unreachable blocks while the pause is within the target and frees the rest on the 
+        marker thread after resuming other threads. Marking is not limited by the target.
+    @param msec Target pause in milliseconds. Set to zero to free all unreachable blocks before resuming threads.
+        Defaults to BIT_MPR_GC_PAUSE (10).
+    @return The prior pause target.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC int mprSetGCPauseTarget(int msec);
+
+/**
+    Set the minimum free span returned to the O/S
+    @description When the collector frees blocks, free blocks are coalesced with their neighbours. If the merged block 
+        is at least this size, the whole pages inside it are returned to the O/S (via madvise) while the block stays 
+        in the heap for reuse. This reduces the resident size of heaps with large free spans in regions that 
+        cannot be unmapped because they still hold live blocks. Returned pages are zero filled when next touched.
+        When huge pages are enabled (MPR_HUGE_PAGES=1), only whole huge pages are returned.
+    @param size Minimum span size in bytes. Set to zero to never return free spans.
+        Defaults to BIT_MPR_RELEASE_SIZE (64K) or to the MPR_RELEASE_MEM environment variable if defined.
+    @return The prior minimum span size.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC ssize mprSetMemRelease(ssize size);
+
+/**
+    Get a percentile of collector pause times
+    @description Pauses are recorded in a histogram with power of two buckets, so the result is the upper bound of 
+        the bucket holding the percentile, limited by the longest pause.
+    @param percentile Percentile between 0 and 100. For example: 50 for the median pause or 99 for the 99th percentile.
+    @return The pause time in microseconds. Returns zero if there have been no collections.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC uint64 mprGetGCPause(int percentile);
+
+/**
+    Set the number of threads used to mark memory
+    @description The garbage collector marks memory on the marker thread while other threads are paused. If more
+        than one thread is requested, helper threads are started that mark in parallel with the marker by stealing
+        work from each other. This reduces pause times for large heaps on multicore systems.
+    @param count Number of marking threads including the marker thread. Set to zero to use one thread per CPU.
+        Defaults to one. The maximum is MPR_GC_MAX_THREADS.
+    @return The prior number of marking threads.
+    @ingroup MprMem
+    @stability Evolving.
+ */
+PUBLIC int mprSetGCThreads(int count);
+
+/**
+    Set the size of the young generation nursery
+    @description Small blocks are allocated from the nursery by bumping a pointer in per-thread chunks. When the 
+        nursery is full, a minor collection marks only the young blocks in the nursery. References to young blocks from
+        older blocks are found by scanning the heap pages written since the last collection, which the O/S tracks 
+        (Linux userfaultfd write protection). Surviving young blocks are promoted in place to the old generation and
+        dead young blocks are freed. Full collections are still triggered by heap growth (see #mprSetGCGrowth) and 
+        by mprRequestGC(MPR_GC_FORCE). If the O/S cannot track writes, the nursery is disabled.
+    @param size Nursery size in bytes. Set to zero to disable the nursery and minor collections.
+        Defaults to BIT_MPR_NURSERY_SIZE (4MB) or to the MPR_NURSERY environment variable if defined.
+    @return The prior nursery size.
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC ssize mprSetNurserySize(ssize size);
+
+/**
+    Create a heap partition
+    @description Threads bound to a partition via #mprSetThreadPartition allocate from regions owned by the partition.
+        When the partition grows, it is collected by itself. A partition collection pauses only the threads bound to 
+        the partition and threads not bound to any partition. Threads bound to other partitions keep running.
+        Blocks in other partitions and the shared heap are scanned conservatively for references into the partition.
+        So blocks of a partition may be referenced from elsewhere, but such references must only be changed by threads
+        bound to the partition or while holding a lock taken by the partition's managers. Full collections still 
+        pause all threads and collect all partitions.
+    @return The partition or null if partitions are not supported.
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC MprPartition *mprCreatePartition();
+
+/**
+    Destroy a heap partition
+    @description The partition's threads must first be unbound. The partition is merged into the shared heap at
+        the next full collection. Its live blocks are then collected normally.
+    @param partition Partition created by #mprCreatePartition
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC void mprDestroyPartition(MprPartition *partition);
+
+/**
+    Get the heap partition of the current thread
+    @return The partition or null if the thread is not bound to a partition.
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC MprPartition *mprGetThreadPartition();
+
+/**
+    Bind the current thread to a heap partition
+    @description Subsequent allocations by the thread are made from the partition. A thread must only use memory of 
+        a partition while bound to that partition or while not bound to any partition. Changing the binding is a
+        yield point. If the new partition is being collected, this call blocks until the collection completes.
+        Calls from threads not created by the MPR are ignored.
+    @param partition Partition created by #mprCreatePartition. Set to null to allocate from the shared heap.
+    @return The prior partition.
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC MprPartition *mprSetThreadPartition(MprPartition *partition);
+
+/**
+    Allocate from the shared heap
+    @description Blocks that are linked into memory of another partition, such as events queued for a dispatcher
+        bound to another partition, must be allocated from the shared heap. This does not change the thread binding.
+    @param shared Set to true to allocate from the shared heap. Set to false to allocate from the bound partition.
+    @return The prior setting.
+    @ingroup MprMem
+    @stability Internal.
+ */
+PUBLIC bool mprShareAlloc(bool shared);
+
+/**
+    Remember a memory block for minor collections
+    @description Minor collections find references to young blocks in the heap pages that have been written since
+        the last collection. Blocks whose managers mark memory referenced from outside the heap (such as a stack 
+        allocated via mprVirtAlloc or on the C stack) must be remembered so their managers run on every 
+        minor collection. Remembered blocks are forgotten when they are freed.
+    @param ptr Any memory block
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC void mprRemember(void *ptr);
+
+/**
+    Forget a remembered memory block
+    @param ptr Memory block previously passed to #mprRemember
+    @ingroup MprMem
+    @stability Prototype.
+ */
+PUBLIC void mprForget(void *ptr);
+
 /**
     Hold a memory block
     @description This call will protect a memory block from freeing by the garbage collector. Call mprRelease to
@@ -5292,6 +5777,18 @@ PUBLIC MprModule *mprLookupModule(cchar *name);
  */
 PUBLIC void *mprLookupModuleData(cchar *name);
 
+/**
+    Get the name of the native function containing a code address
+    @description Only functions exported from the executable or a shared library can be named. Other addresses are
+        reported as the nearest preceding exported function.
+    @param addr Code address
+    @returns The function name. Returns NULL if the address cannot be resolved or the platform does not support
+        symbol lookup.
+    @ingroup MprModule
+    @stability Evolving
+ */
+PUBLIC cchar *mprGetNativeSymbol(cvoid *addr);
+
 /**
     Search for a module on the current module path
     @param module Name of the module to locate.
@@ -5444,6 +5941,7 @@ typedef struct MprDispatcher {
     struct MprEventService *service;    /**< Event service reference */
     struct MprWorker *requiredWorker;   /**< Worker affinity */
     MprOsThread     owner;              /**< Owning thread of the dispatcher */
+    struct MprPartition *partition;     /**< Heap partition to bind to while dispatching events */
 } MprDispatcher;
 
 
@@ -6008,6 +6506,7 @@ typedef struct MprThread {
 #endif
     int             stickyYield;        /**< Yielded does not auto-clear after GC */
     int             yielded;            /**< Thread has yielded to GC */
+    struct MprPartition *partition;     /**< Heap partition the thread is bound to */
 } MprThread;
 
 
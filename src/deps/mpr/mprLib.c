@@ -23,16 +23,47 @@
 
 /********************************* Includes ***********************************/
 
-
+#if BIT_MPR_NURSERY
+    #include    <sys/syscall.h>
+    #include    <linux/userfaultfd.h>
+#endif
 
 /********************************** Defines ***********************************/
 
 #ifndef BIT_MAX_GC_QUOTA
     #define BIT_MAX_GC_QUOTA   4096            /* Number of allocations before a GC is worthwhile */
 #endif
+#ifndef BIT_MPR_GC_GROWTH
+    #define BIT_MPR_GC_GROWTH  100             /* Percentage the heap may grow over live memory before a GC */
+#endif
+#ifndef BIT_MPR_GC_PAUSE
+    #define BIT_MPR_GC_PAUSE   10              /* Target maximum collector pause in milliseconds */
+#endif
 #ifndef BIT_MAX_REGION
     #define BIT_MAX_REGION     (128 * 1024)    /* Memory allocation chunk size */
 #endif
+#ifndef BIT_MPR_RELEASE_SIZE
+    #define BIT_MPR_RELEASE_SIZE (64 * 1024)   /* Minimum free span to return to the O/S */
+#endif
+#ifndef BIT_MPR_RELEASE_LAZY
+    #define BIT_MPR_RELEASE_LAZY 0             /* Return free spans with MADV_FREE instead of MADV_DONTNEED */
+#endif
+#ifndef BIT_MPR_HUGE_PAGES
+    #define BIT_MPR_HUGE_PAGES 0               /* Back heap regions with transparent huge pages */
+#endif
+#ifndef BIT_MPR_NURSERY_SIZE
+    #define BIT_MPR_NURSERY_SIZE (4 * 1024 * 1024) /* Young blocks allocated between minor collections */
+#endif
+#if PARALLEL_GC
+    /* Minor collections require other threads to be paused */
+    #undef BIT_MPR_NURSERY
+    #define BIT_MPR_NURSERY 0
+#endif
+#if !BIT_MPR_NURSERY
+    /* Partition collections use the nursery region index */
+    #undef BIT_MPR_PARTITION
+    #define BIT_MPR_PARTITION 0
+#endif
 
 #if BIT_HAS_MMU 
     #define VALLOC 1                            /* Use virtual memory allocations */
@@ -56,9 +87,12 @@ static int stopSeqno = -1;
 #define GET_PTR(mp)                 ((char*) (((char*) mp) + sizeof(MprMem)))
 #define GET_USIZE(mp)               ((ssize) (GET_SIZE(mp) - sizeof(MprMem) - (HAS_MANAGER(mp) * sizeof(void*))))
 #define UNMARKED                    MPR_GEN_ETERNAL
+#define MPR_MARK_STACK_SIZE         1024        /* Initial mark stack length */
+#define MPR_MARK_SPINS              16          /* Idle polls for work before backing off */
 
 #define GET_NEXT(mp)                (IS_LAST(mp)) ? NULL : ((MprMem*) ((char*) mp + GET_SIZE(mp)))
 #define GET_REGION(mp)              ((MprRegion*) (((char*) mp) - MPR_ALLOC_ALIGN(sizeof(MprRegion))))
+#define REGION_QUEUES(region)       ((region)->partition ? &(region)->partition->queues : &heap->queues)
 
 /*
     Macros to set and extract "prior" fields. All accesses (read and write) must be done locked.
@@ -86,11 +120,15 @@ static int stopSeqno = -1;
 #define SET_GEN(mp, value)          mp->field2 = (((size_t) value) << MPR_SHIFT_GEN) | (mp->field2 & ~MPR_MASK_GEN)
 #define GET_MARK(mp)                (mp->field2 & MPR_MASK_MARK)
 #define SET_MARK(mp, value)         mp->field2 = (value) | (mp->field2 & ~MPR_MASK_MARK)
-#define SET_FIELD2(mp, size, gen, mark, free) mp->field2 = \
-                                        (((size_t) (gen)) << MPR_SHIFT_GEN) | \
+#define IS_YOUNG(mp)                (mp->field2 & MPR_MASK_YOUNG)
+#define SET_YOUNG(mp)               mp->field2 |= MPR_MASK_YOUNG
+#define CLEAR_YOUNG(mp)             mp->field2 &= ~MPR_MASK_YOUNG
+#define MAKE_FIELD2(size, gen, mark, free) \
+                                        ((((size_t) (gen)) << MPR_SHIFT_GEN) | \
                                         (((size_t) (free)) << MPR_SHIFT_FREE) | \
                                         ((size) << MPR_SHIFT_SIZE) | \
-                                        ((mark) << MPR_SHIFT_MARK)
+                                        ((mark) << MPR_SHIFT_MARK))
+#define SET_FIELD2(mp, size, gen, mark, free) mp->field2 = MAKE_FIELD2(size, gen, mark, free)
 /*
     Padding fields (only manager stored in padding region)
  */
@@ -146,11 +184,111 @@ static int stopSeqno = -1;
     SET_NAME(mp, NULL); \
     } else
 
-#define lockHeap()              mprSpinLock(&heap->heapLock);
+/*
+    Count heap lock contention. The counters are updated while locked.
+ */
+#define lockHeap() if (1) { \
+    if (!mprTrySpinLock(&heap->heapLock)) { \
+        mprSpinLock(&heap->heapLock); \
+        heap->stats.heapLockWaits++; \
+    } \
+    heap->stats.heapLocks++; \
+    } else
 #define unlockHeap()            mprSpinUnlock(&heap->heapLock);
 
 #define percent(a,b) ((int) ((a) * 100 / (b)))
 
+/*
+    Heap snapshots are built with malloc by the marker thread while other threads are paused.
+    Addresses are indexed with open addressing. Values are node or label indexes.
+ */
+typedef struct MprSnapIndex {
+    cvoid           **keys;
+    int             *values;
+    int             size;               /* Power of two */
+    int             count;
+} MprSnapIndex;
+
+#define SNAP_HASH(key, size) ((uint) (((((uint64) (size_t) (key)) >> 4) * 0x9E3779B1) & ((size) - 1)))
+
+typedef struct MprSnapshot {
+    cchar           *path;              /* Snapshot filename */
+    MprMemLabeler   labeler;            /* Block labeler callback */
+    void            *data;              /* Labeler data */
+    int             status;             /* Result of the snapshot */
+    void            **nodes;            /* Blocks in the order traced. Node zero is the root set */
+    int             *starts;            /* Index of the first reference of each node */
+    int             *refs;              /* References as node indexes */
+    cchar           **labels;           /* Label names */
+    int             nodeCount;
+    int             nodeMax;
+    int             refCount;
+    int             refMax;
+    int             labelCount;
+    int             labelMax;
+    MprSnapIndex    blocks;             /* Node index by block */
+    MprSnapIndex    labelIndex;         /* Label index by label name */
+    MprSnapIndex    managers;           /* Label index by manager function */
+} MprSnapshot;
+
+#if BIT_MPR_NURSERY
+#define MPR_NURSERY_CHUNK       (64 * 1024)     /* Nursery memory taken from the heap by a thread at a time */
+#define MPR_NURSERY_MIN_CHUNK   (8 * 1024)      /* Smallest free block used for a chunk before growing the heap */
+#define MPR_NURSERY_MAX_BLOCK   (2 * 1024)      /* Larger blocks are allocated from the heap */
+#define MPR_TRACK_GAP           (1024 * 1024)   /* Scan regions separated by less than this as one span */
+#define MPR_START_SHIFT         12              /* Granularity of the region block start index */
+
+/*
+    Nursery chunk. Each thread allocates young blocks by carving them from the end of its chunk. The tail is the 
+    remaining unallocated start of the chunk. Descriptors are allocated with malloc and are freed by the collector 
+    while other threads are paused. The starts bitmap has a bit for the start of each young block.
+ */
+typedef struct MprNursery {
+    MprMem          *tail;              /* Unallocated start of the chunk */
+    MprMem          *last;              /* Block most recently carved from the tail */
+    char            *end;               /* End of the chunk */
+    int             final;              /* Chunk is the last block in its region */
+    ulong           starts[ARRAY_FLEX]; /* Block start bitmap. One bit per MPR_ALIGN bytes */
+} MprNursery;
+
+#define NURSERY_BITS            ((int) (sizeof(ulong) * 8))
+
+/*
+    Pagemap write tracking. Defined here as older system headers may not define these.
+ */
+#ifndef UFFD_FEATURE_WP_UNPOPULATED
+    #define UFFD_FEATURE_WP_UNPOPULATED (1 << 13)
+#endif
+#ifndef UFFD_FEATURE_WP_ASYNC
+    #define UFFD_FEATURE_WP_ASYNC (1 << 15)
+#endif
+#ifndef PAGEMAP_SCAN
+struct page_region {
+    uint64          start;
+    uint64          end;
+    uint64          categories;
+};
+
+struct pm_scan_arg {
+    uint64          size;
+    uint64          flags;
+    uint64          start;
+    uint64          end;
+    uint64          walk_end;
+    uint64          vec;
+    uint64          vec_len;
+    uint64          max_pages;
+    uint64          category_inverted;
+    uint64          category_mask;
+    uint64          category_anyof_mask;
+    uint64          return_mask;
+};
+#define PAGEMAP_SCAN            _IOWR('f', 16, struct pm_scan_arg)
+#define PAGE_IS_WRITTEN         (1 << 1)
+#define PM_SCAN_WP_MATCHING     (1 << 0)
+#endif
+#endif /* BIT_MPR_NURSERY */
+
 /*
     Fast find first/last bit set
  */
@@ -181,23 +319,43 @@ PUBLIC Mpr          *MPR;
 static MprHeap      *heap;
 static MprMemStats  memStats;
 static int          padding[] = { 0, MANAGER_SIZE };
+#if BIT_MPR_NURSERY
+static MprRegion    **regionIndex;          /* Regions sorted by address for minor collections (malloc) */
+static int          regionCount;
+static int          regionMax;
+static ulong        *nurseryMap;            /* Pages holding nursery chunks for minor collections (malloc) */
+static ssize        nurseryMapMax;
+#endif
+#if BIT_MPR_PARTITION
+static char         *partitionLow;          /* Lowest region address of the partition being collected */
+static char         *partitionHigh;         /* Highest region end address of the partition being collected */
+#endif
 
 /***************************** Forward Declarations ***************************/
 
 static void allocException(int cause, ssize size);
+static bool awaitMarks(MprMarkStack *ms);
 static void checkYielded();
+static void drainMarks(MprMarkStack *ms);
 static void dummyManager(void *ptr, int flags);
 static ssize fastMemSize();
+static uint64 getGCTicks();
 static void *getNextRoot();
 static void getSystemInfo();
 static void initGen();
 static void mark();
 static void marker(void *unused, MprThread *tp);
+static void markHelper(void *unused, MprThread *tp);
+static void markParallel(MprMarkStack *ms);
 static void markRoots();
 static void nextGen();
 static int pauseThreads();
-static void sweep();
+static void pushMark(cvoid *ptr);
+static void sweep(uint64 deadline);
 static void resumeThreads();
+static void shareMarks(MprMarkStack *ms);
+static void startMarkHelpers();
+static bool stealMarks(MprMarkStack *ms);
 static void triggerGC(int flags);
 
 #if BIT_WIN_LIKE
@@ -220,17 +378,72 @@ static void triggerGC(int flags);
 static void monitorStack();
 #endif
 
-static int initFree();
+static void initFree(MprFreeQueues *fq);
 static MprMem *allocMem(ssize size, int flags);
-static MprMem *freeBlock(MprMem *mp);
+static MprMem *allocFromHeap(ssize required, int index, int flags);
+static MprMem *findBlock(MprFreeQueues *fq, ssize required, int index, int flags);
+#if BIT_MPR_ALLOC_CACHE
+static MprMem *allocFromCache(ssize required, int index, int flags);
+static MprAllocCache *createCache();
+static void freeCache(void *data);
+static MprFreeMem *refillCache(MprAllocCache *cache, ssize required, int index, int manager);
+#endif
+static MprMem *freeBlock(MprFreeQueues *fq, MprMem *mp);
 static int getQueueIndex(ssize size, int roundup);
-static MprMem *growHeap(ssize size, int flags);
-static void linkBlock(MprMem *mp); 
-static void unlinkBlock(MprFreeMem *fp);
+static MprMem *growHeap(MprPartition *pp, ssize size, int flags);
+static void *allocRegion(ssize size, int huge);
+static void releaseFree(ssize retain);
+static int releaseSpan(MprMem *mp, ssize size);
+static ssize getCommitted();
+static void setGrowTarget();
+static void sweepRegions(uint64 deadline);
+static void freeRegion(MprRegion *region, MprRegion *prior);
+static uint64 getAllocated();
+static ssize getLargestFree();
+static void sampleAlloc(MprMem *mp, cvoid *caller);
+static void traceRef(cvoid *ptr);
+static void writeSnapshot(MprSnapshot *sp);
+static void forgetDead();
+static void linkBlock(MprFreeQueues *fq, MprMem *mp); 
+static void unlinkBlock(MprFreeQueues *fq, MprFreeMem *fp);
 static void *vmalloc(ssize size, int mode);
 static void vmfree(void *ptr, ssize size);
 #if BIT_MEMORY_STATS
-    static MprFreeMem *getQueue(ssize size);
+    static MprFreeMem *getQueue(MprFreeQueues *fq, ssize size);
+#endif
+#if BIT_MPR_NURSERY
+static MprMem *allocFromNursery(ssize required, int flags);
+static MprNursery *findNursery(cchar *ptr);
+static MprMem *findYoung(cchar *ptr);
+static void freeNurseries();
+static MprNursery *getNursery(MprAllocCache *cache);
+static void indexRegions();
+static int indexStarts(MprRegion *region);
+static void initNursery(MprRegion *region);
+static void mapNurseries();
+static void markWritten();
+static void markYoung();
+static MprRegion *findRegion(cvoid *ptr);
+static void resetWrites();
+static void retireNursery();
+static void scanYoung(cvoid *start, cvoid *end);
+static void setStarts(MprRegion *region, MprMem *first, MprMem *mp, MprMem *next);
+static void stopTracking();
+static void sweepYoung();
+static void trackRegion(void *ptr, ssize size);
+#endif
+#if BIT_MPR_PARTITION
+static MprMem *allocFromPartition(MprPartition *pp, ssize required, int index, int flags);
+static void collectPartition(MprPartition *pp);
+static void collectPartitions();
+static MprMem *findPartitionBlock(cchar *ptr);
+static void markPartition(MprPartition *pp);
+static void mergePartitions();
+static int preparePartition(MprPartition *pp);
+static void scanPartition(cvoid *start, cvoid *end);
+static void setPartitionTarget(MprPartition *pp);
+static void sweepPartition(MprPartition *pp);
+static void triggerPartitionGC(MprPartition *pp);
 #endif
 
 /************************************* Code ***********************************/
@@ -241,6 +454,7 @@ PUBLIC Mpr *mprCreateMemService(MprManager manager, int flags)
     MprMem      *spare;
     MprRegion   *region;
     ssize       size, mprSize, spareSize, regionSize;
+    char        *cp;
 
     getSystemInfo();
 
@@ -255,6 +469,11 @@ PUBLIC Mpr *mprCreateMemService(MprManager manager, int flags)
     heap->stats.redLine = MAXINT / 100 * 95;
     mprInitSpinLock(&heap->heapLock);
     initGen();
+#if BIT_MPR_ALLOC_CACHE
+    if (pthread_key_create(&heap->cacheKey, freeCache) != 0) {
+        return NULL;
+    }
+#endif
 
     /*
         Hand-craft the Mpr structure
@@ -281,6 +500,37 @@ PUBLIC Mpr *mprCreateMemService(MprManager manager, int flags)
     heap->stats.redLine = MAXINT / 100 * 99;
     heap->newQuota = BIT_MAX_GC_QUOTA;
     heap->earlyYieldQuota = heap->newQuota * 5;
+    if ((heap->markStacks = calloc(MPR_GC_MAX_THREADS, sizeof(MprMarkStack))) == 0) {
+        return NULL;
+    }
+    mprInitSpinLock(&heap->markLock);
+    heap->gcThreads = 1;
+    if ((cp = getenv("MPR_GC_THREADS")) != 0) {
+        mprSetGCThreads((int) stoi(cp));
+    }
+    heap->gcGrowth = BIT_MPR_GC_GROWTH;
+    if ((cp = getenv("MPR_GC_GROWTH")) != 0) {
+        mprSetGCGrowth((int) stoi(cp));
+    }
+    heap->pauseTarget = BIT_MPR_GC_PAUSE;
+    if ((cp = getenv("MPR_GC_PAUSE")) != 0) {
+        mprSetGCPauseTarget((int) stoi(cp));
+    }
+    heap->releaseSize = BIT_MPR_RELEASE_SIZE;
+    if ((cp = getenv("MPR_RELEASE_MEM")) != 0) {
+        mprSetMemRelease(stoi(cp));
+    }
+#if defined(MADV_HUGEPAGE)
+    heap->hugePages = BIT_MPR_HUGE_PAGES;
+    if ((cp = getenv("MPR_HUGE_PAGES")) != 0) {
+        heap->hugePages = scmp(cp, "1") == 0;
+    }
+    if (heap->hugePages) {
+        heap->chunkSize = MPR_HUGE_PAGE_SIZE;
+    }
+    heap->stats.hugePages = heap->hugePages;
+#endif
+    heap->trackFd = heap->pagemapFd = -1;
     heap->enabled = !(heap->flags & MPR_DISABLE_GC);
     if (scmp(getenv("MPR_DISABLE_GC"), "1") == 0) {
         heap->enabled = 0;
@@ -301,7 +551,7 @@ PUBLIC Mpr *mprCreateMemService(MprManager manager, int flags)
     mprInitSpinLock(&heap->heapLock);
     mprInitSpinLock(&heap->rootLock);
     initGen();
-    initFree();
+    initFree(&heap->queues);
 
     spareSize = size - regionSize - mprSize;
     if (spareSize > 0) {
@@ -311,12 +561,17 @@ PUBLIC Mpr *mprCreateMemService(MprManager manager, int flags)
         SET_FREE(spare, 1);
         heap->regions = region;
         SCRIBBLE(spare);
-        linkBlock(spare);
+        linkBlock(&heap->queues, spare);
     }
+    setGrowTarget();
     heap->markerCond = mprCreateCond();
     heap->mutex = mprCreateLock();
     heap->roots = mprCreateList(-1, MPR_LIST_STATIC_VALUES);
+    heap->remembered = mprCreateList(-1, MPR_LIST_STATIC_VALUES);
     mprAddRoot(MPR);
+#if BIT_MPR_NURSERY
+    initNursery(region);
+#endif
     return MPR;
 }
 
@@ -332,6 +587,12 @@ PUBLIC void mprDestroyMemService()
     if (heap->destroying) {
         return;
     }
+    /*
+        The marker may still be freeing blocks whose destructors have already run
+     */
+    while (heap->sweepPending) {
+        mprNap(1);
+    }
     heap->destroying = 1;
     for (region = heap->regions; region; region = region->next) {
         for (mp = region->start; mp; mp = next) {
@@ -355,7 +616,7 @@ PUBLIC void *mprAllocMem(ssize usize, int flags)
     ssize       size;
     int         padWords;
 
-    assert(!heap->marking);
+    assert(!heap->marking || heap->partition);
     assert(usize >= 0);
 
     padWords = padding[flags & MPR_ALLOC_PAD_MASK];
@@ -374,10 +635,76 @@ PUBLIC void *mprAllocMem(ssize usize, int flags)
     BREAKPOINT(mp);
     CHECK(mp);
     assert(GET_GEN(mp) != heap->eternal);
+    if (unlikely(heap->sampler)) {
+#if __GNUC__
+        sampleAlloc(mp, __builtin_return_address(0));
+#else
+        sampleAlloc(mp, NULL);
+#endif
+    }
     return ptr;
 }
 
 
+/*
+    Invoke the allocation sampler once per sample interval of bytes allocated. Each thread counts down in its own
+    cache. The sample weight covers any intervals skipped by a large allocation.
+ */
+static void sampleAlloc(MprMem *mp, cvoid *caller)
+{
+    MprAllocSampler sampler;
+    ssize           *countdown, interval, samples;
+    int             *sampling;
+#if BIT_MPR_ALLOC_CACHE
+    MprAllocCache   *cache;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) != 0) {
+        countdown = &cache->sampleCountdown;
+        sampling = &cache->sampling;
+    } else
+#endif
+    {
+        countdown = &heap->sampleCountdown;
+        sampling = &heap->sampling;
+    }
+    if (*sampling || (*countdown -= GET_SIZE(mp)) > 0) {
+        return;
+    }
+    sampler = heap->sampler;
+    interval = heap->sampleInterval;
+    if (sampler == 0 || interval <= 0) {
+        return;
+    }
+    samples = 1 + (-*countdown / interval);
+    *countdown += samples * interval;
+    *sampling = 1;
+    (sampler)(GET_PTR(mp), GET_SIZE(mp), samples * interval, caller);
+    *sampling = 0;
+}
+
+
+PUBLIC void mprSetAllocSampler(MprAllocSampler sampler, ssize interval)
+{
+#if BIT_MPR_ALLOC_CACHE
+    MprAllocCache   *cache;
+#endif
+
+    if (interval <= 0) {
+        sampler = 0;
+    }
+    lockHeap();
+    heap->sampleInterval = interval;
+    heap->sampleCountdown = interval;
+#if BIT_MPR_ALLOC_CACHE
+    for (cache = heap->caches; cache; cache = cache->next) {
+        cache->sampleCountdown = interval;
+    }
+#endif
+    heap->sampler = sampler;
+    unlockHeap();
+}
+
+
 /*
     Realloc will always zero new memory
  */
@@ -490,7 +817,7 @@ PUBLIC ssize mprMemcpy(void *dest, ssize destMax, cvoid *src, ssize nbytes)
     | 0 | 0 | 1 | 1 | 1 | 1 | X | X |
     +-------------------------------+
  */
-static int initFree() 
+static void initFree(MprFreeQueues *fq) 
 {
     MprFreeMem  *freeq;
 #if BIT_MEMORY_STATS
@@ -498,13 +825,13 @@ static int initFree()
     int         index, group, bucket;
 #endif
     
-    heap->freeEnd = &heap->freeq[MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS];
-    for (freeq = heap->freeq; freeq != heap->freeEnd; freeq++) {
+    fq->freeEnd = &fq->freeq[MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS];
+    for (freeq = fq->freeq; freeq != fq->freeEnd; freeq++) {
 #if BIT_MEMORY_STATS
         /*
             NOTE: skip the buckets with MSB == 0 (round up)
          */
-        index = (int) (freeq - heap->freeq);
+        index = (int) (freeq - fq->freeq);
         group = index / MPR_ALLOC_NUM_BUCKETS;
         bucket = index % MPR_ALLOC_NUM_BUCKETS;
 
@@ -517,27 +844,52 @@ static int initFree()
 #endif
         freeq->next = freeq->prev = freeq;
     }
-    return 0;
 }
 
 
 static MprMem *allocMem(ssize required, int flags)
 {
-    MprFreeMem  *freeq, *fp;
-    MprMem      *mp, *after, *spare;
-    ssize       size, maxBlock;
-    ulong       groupMap, bucketMap;
-    int         bucket, baseGroup, group, index, miss;
+#if BIT_MPR_ALLOC_CACHE
+    MprMem      *mp;
+#endif
+#if BIT_MPR_PARTITION
+    MprAllocCache   *cache;
+#endif
+    int         index;
     
 #if BIT_MEMORY_STACK
     monitorStack();
 #endif
 
     index = getQueueIndex(required, 1);
-    baseGroup = index / MPR_ALLOC_NUM_BUCKETS;
-    bucket = index % MPR_ALLOC_NUM_BUCKETS;
+#if BIT_MPR_PARTITION
+    if (heap->partitions && (cache = pthread_getspecific(heap->cacheKey)) != 0 && cache->partition && !cache->shared) {
+        INC(requests);
+        return allocFromPartition(cache->partition, required, index, flags);
+    }
+#endif
     heap->newCount += index;
     INC(requests);
+#if BIT_MPR_NURSERY
+    if (heap->nursery && required <= MPR_NURSERY_MAX_BLOCK && (mp = allocFromNursery(required, flags)) != 0) {
+        return mp;
+    }
+#endif
+#if BIT_MPR_ALLOC_CACHE
+    if (index < MPR_ALLOC_CACHE_QUEUES && (mp = allocFromCache(required, index, flags)) != 0) {
+        return mp;
+    }
+#endif
+    return allocFromHeap(required, index, flags);
+}
+
+
+/*
+    Allocate a block from the heap free queues. The index is the free queue for the required size.
+ */
+static MprMem *allocFromHeap(ssize required, int index, int flags)
+{
+    MprMem      *mp;
 
     /*
         OPT - could break this locked section up.
@@ -548,14 +900,77 @@ static MprMem *allocMem(ssize required, int flags)
         - Long term use lockfree
      */
     lockHeap();
-    
+    if ((mp = findBlock(&heap->queues, required, index, flags)) != 0) {
+        heap->allocated += GET_SIZE(mp);
+    }
+    unlockHeap();
+    if (mp) {
+        return mp;
+    }
+    /*
+        Growing the heap only triggers a GC once the heap has grown in proportion to the memory that survived the last 
+        collection. Each full collection marks all live memory, so this keeps the cost of collecting proportional to the 
+        volume of allocation rather than the product of allocation volume and the live heap size.
+     */
+    if ((heap->stats.bytesAllocated + required) > heap->growTarget || 
+            (heap->stats.bytesAllocated + required) > heap->stats.redLine) {
+        heap->gcFull = 1;
+        triggerGC(MPR_GC_FORCE);
+    }
+    return growHeap(NULL, required, flags);
+}
+
+
+#if BIT_MPR_PARTITION
+/*
+    Allocate a block from the free queues of a partition. Growing the partition past its target triggers a collection 
+    of the partition only. The partition regions do not hold thread caches or nursery chunks.
+ */
+static MprMem *allocFromPartition(MprPartition *pp, ssize required, int index, int flags)
+{
+    MprMem      *mp;
+
+    lockHeap();
+    if ((mp = findBlock(&pp->queues, required, index, flags)) != 0) {
+        heap->allocated += GET_SIZE(mp);
+        pp->allocated += GET_SIZE(mp);
+    }
+    unlockHeap();
+    if (mp) {
+        return mp;
+    }
+    if ((heap->stats.bytesAllocated + required) > heap->stats.redLine) {
+        heap->gcFull = 1;
+        triggerGC(MPR_GC_FORCE);
+    } else if ((pp->bytes + required) > pp->growTarget) {
+        triggerPartitionGC(pp);
+    }
+    return growHeap(pp, required, flags);
+}
+#endif
+
+
+/*
+    Find a free block of the required size and remove it from the free queues. Must be called locked.
+ */
+static MprMem *findBlock(MprFreeQueues *fq, ssize required, int index, int flags)
+{
+    MprFreeMem  *freeq, *fp;
+    MprMem      *mp, *after, *spare;
+    ssize       size, maxBlock;
+    ulong       groupMap, bucketMap;
+    int         bucket, baseGroup, group, miss;
+
+    baseGroup = index / MPR_ALLOC_NUM_BUCKETS;
+    bucket = index % MPR_ALLOC_NUM_BUCKETS;
+
     /* Mask groups lower than the base group */
     miss = 0;
-    groupMap = heap->groupMap & ~((((ssize) 1) << baseGroup) - 1);
+    groupMap = fq->groupMap & ~((((ssize) 1) << baseGroup) - 1);
     while (groupMap) {
         group = (int) (ffsl(groupMap) - 1);
         if (groupMap & ((((ssize) 1) << group))) {
-            bucketMap = heap->bucketMap[group];
+            bucketMap = fq->bucketMap[group];
             if (baseGroup == group) {
                 /* Mask buckets lower than the base bucket */
                 bucketMap &= ~((((ssize) 1) << bucket) - 1);
@@ -563,13 +978,13 @@ static MprMem *allocMem(ssize required, int flags)
             while (bucketMap) {
                 bucket = (int) (ffsl(bucketMap) - 1);
                 index = (group * MPR_ALLOC_NUM_BUCKETS) + bucket;
-                freeq = &heap->freeq[index];
+                freeq = &fq->freeq[index];
 
                 if (freeq->next != freeq) {
                     fp = freeq->next;
                     mp = (MprMem*) fp;
                     assert(IS_FREE(mp));
-                    unlinkBlock(fp);
+                    unlinkBlock(fq, fp);
 
                     assert(GET_GEN(mp) == heap->eternal);
                     SET_GEN(mp, heap->active);
@@ -599,44 +1014,315 @@ static MprMem *allocMem(ssize required, int flags)
                             SET_LAST(mp, 0);
                             mprAtomicBarrier();
                             INC(splits);
-                            linkBlock(spare);
+                            linkBlock(fq, spare);
+                            /* The rest of a released block is still released */
+                            ((MprFreeMem*) spare)->released = fp->released;
                         }
                     }
                     /* Tested empirically to trigger GC when we are searching too much for an allocation */
-                    if (miss > 9) {
+                    if (miss > 9 && fq == &heap->queues) {
                         triggerGC(MPR_GC_FORCE);
                     }
-                    unlockHeap();
                     return mp;
                 }
                 bucketMap &= ~(((ssize) 1) << bucket);
-                heap->bucketMap[group] &= ~(((ssize) 1) << bucket);
+                fq->bucketMap[group] &= ~(((ssize) 1) << bucket);
             }
             groupMap &= ~(((ssize) 1) << group);
-            heap->groupMap &= ~(((ssize) 1) << group);
+            fq->groupMap &= ~(((ssize) 1) << group);
             miss++;
         }
     }
+    return 0;
+}
+
+
+#if BIT_MPR_ALLOC_CACHE
+/*
+    Allocate a small block from the thread's cache. Does not lock the heap unless the cache must be refilled.
+ */
+static MprMem *allocFromCache(ssize required, int index, int flags)
+{
+    MprAllocCache   *cache;
+    MprFreeMem      *fp;
+    MprMem          *mp;
+    int             manager;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) == 0 && (cache = createCache()) == 0) {
+        return 0;
+    }
+    manager = (flags & MPR_ALLOC_MANAGER) ? 1 : 0;
+    if ((fp = cache->free[index][manager]) == 0 && (fp = refillCache(cache, required, index, manager)) == 0) {
+        return 0;
+    }
+    cache->free[index][manager] = fp->next;
+    mp = (MprMem*) fp;
+    cache->bytes -= GET_SIZE(mp);
+    cache->allocated += GET_SIZE(mp);
+    cache->hits++;
+
+    /* The manager was set when the block was cached. The block header prior field must only be updated locked */
+    SET_GEN(mp, heap->active);
+    mprAtomicBarrier();
+    CHECK(mp);
+    return mp;
+}
+
+
+static MprAllocCache *createCache()
+{
+    MprAllocCache   *cache;
+
+    if ((cache = malloc(sizeof(MprAllocCache))) == 0) {
+        return 0;
+    }
+    memset(cache, 0, sizeof(MprAllocCache));
+    if (pthread_setspecific(heap->cacheKey, cache) != 0) {
+        free(cache);
+        return 0;
+    }
+    lockHeap();
+    cache->next = heap->caches;
+    if (heap->caches) {
+        heap->caches->prev = cache;
+    }
+    heap->caches = cache;
+    heap->stats.caches++;
+    unlockHeap();
+    return cache;
+}
+
+
+/*
+    Move a batch of blocks from the heap to the cache using one lock of the heap. Stops early rather than grow the heap. 
+    Cached blocks are eternal and not free, so the sweeper will neither free nor coalesce them. Blocks with a manager 
+    keep the dummy manager until allocated as the heap may be destroyed with blocks still cached.
+ */
+static MprFreeMem *refillCache(MprAllocCache *cache, ssize required, int index, int manager)
+{
+    MprFreeMem  *fp, **list;
+    MprMem      *mp;
+    int         count;
+
+    list = &cache->free[index][manager];
+    lockHeap();
+    for (count = 0; count < MPR_ALLOC_CACHE_BATCH; count++) {
+        if ((mp = findBlock(&heap->queues, required, index, manager ? MPR_ALLOC_MANAGER : 0)) == 0) {
+            break;
+        }
+        SET_GEN(mp, heap->eternal);
+        if (manager) {
+            /* Set after any split */
+            SET_MANAGER(mp, dummyManager);
+        }
+        fp = (MprFreeMem*) mp;
+        fp->next = *list;
+        *list = fp;
+        cache->bytes += GET_SIZE(mp);
+    }
+    if (count > 0) {
+        heap->stats.cacheRefills++;
+    }
+    unlockHeap();
+    return *list;
+}
+
+
+/*
+    Return the blocks in a thread's cache to the heap. Called when the thread exits. The blocks are made active and 
+    unreferenced so the sweeper will free them and coalesce them with their neighbours. Only the sweeper coalesces blocks.
+ */
+static void freeCache(void *data)
+{
+    MprAllocCache   *cache;
+    MprFreeMem      *fp, *next;
+    MprMem          *mp;
+    int             index, manager;
+
+    cache = data;
+    if (!heap->destroying) {
+        lockHeap();
+        for (index = 0; index < MPR_ALLOC_CACHE_QUEUES; index++) {
+            for (manager = 0; manager < 2; manager++) {
+                for (fp = cache->free[index][manager]; fp; fp = next) {
+                    next = fp->next;
+                    mp = (MprMem*) fp;
+                    SET_FIELD2(mp, GET_SIZE(mp), heap->active, UNMARKED, 0);
+                }
+            }
+        }
+        if (cache->prev) {
+            cache->prev->next = cache->next;
+        } else {
+            heap->caches = cache->next;
+        }
+        if (cache->next) {
+            cache->next->prev = cache->prev;
+        }
+        heap->retiredHits += cache->hits;
+        heap->allocated += cache->allocated;
+        heap->stats.caches--;
+        heap->stats.cacheFlushes++;
+        unlockHeap();
+    }
+    free(cache);
+}
+#endif /* BIT_MPR_ALLOC_CACHE */
+
+
+#if BIT_MPR_NURSERY
+/*
+    Allocate a young block from the thread's nursery chunk. Blocks are carved from the end of the chunk tail so only 
+    the block after the first carved block belongs to another thread. Does not lock the heap unless a new chunk is
+    required or for the first block carved from a chunk.
+ */
+static MprMem *allocFromNursery(ssize required, int flags)
+{
+    MprAllocCache   *cache;
+    MprNursery      *np;
+    MprMem          *mp, *tail, *next;
+    ssize           size, index;
+    int             hasManager;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) == 0 && (cache = createCache()) == 0) {
+        return 0;
+    }
+    np = cache->nursery;
+    if (np == 0 || cache->nurseryEpoch != heap->nurseryEpoch || 
+            GET_SIZE(np->tail) < (ssize) (required + sizeof(MprFreeMem))) {
+        if ((np = getNursery(cache)) == 0) {
+            return 0;
+        }
+    }
+    tail = np->tail;
+    size = GET_SIZE(tail) - required;
+    mp = (MprMem*) ((char*) tail + size);
+    hasManager = (flags & MPR_ALLOC_MANAGER) ? 1 : 0;
+
+    if (np->last) {
+        /* The blocks carved from the chunk are only accessed by this thread until the next collection */
+        INIT_BLK(mp, required, hasManager, 0, tail);
+        SET_YOUNG(mp);
+        if (hasManager) {
+            SET_MANAGER(mp, dummyManager);
+        }
+        mprAtomicBarrier();
+        SET_PRIOR(np->last, mp);
+        SET_SIZE(tail, size);
+        mprAtomicBarrier();
+        cache->hits++;
+    } else {
+        lockHeap();
+        INIT_BLK(mp, required, hasManager, IS_LAST(tail), tail);
+        SET_YOUNG(mp);
+        if (hasManager) {
+            SET_MANAGER(mp, dummyManager);
+        }
+        if (!np->final) {
+            next = (MprMem*) np->end;
+            SET_PRIOR(next, mp);
+        }
+        mprAtomicBarrier();
+        SET_SIZE(tail, size);
+        mprAtomicBarrier();
+        SET_LAST(tail, 0);
+        unlockHeap();
+    }
+    np->last = mp;
+    index = (((char*) mp) - ((char*) tail)) >> MPR_ALIGN_SHIFT;
+    np->starts[index / NURSERY_BITS] |= ((ulong) 1) << (index % NURSERY_BITS);
+    cache->allocated += required;
+    return mp;
+}
+
+
+/*
+    Take a new nursery chunk from the heap for the thread. Young blocks that survive collections are not moved, so 
+    smaller free blocks are used before growing the heap. A minor collection is triggered when the nursery is full.
+ */
+static MprNursery *getNursery(MprAllocCache *cache)
+{
+    MprNursery  *np, **list;
+    MprMem      *mp;
+    ssize       size, words, grown;
+    int         max, full;
+
+    lockHeap();
+    if ((mp = findBlock(&heap->queues, MPR_NURSERY_CHUNK, getQueueIndex(MPR_NURSERY_CHUNK, 1), 0)) == 0) {
+        mp = findBlock(&heap->queues, MPR_NURSERY_MIN_CHUNK, getQueueIndex(MPR_NURSERY_MIN_CHUNK, 1), 0);
+    }
+    unlockHeap();
+    grown = 0;
+    if (mp == 0) {
+        if ((mp = allocFromHeap(MPR_NURSERY_CHUNK, getQueueIndex(MPR_NURSERY_CHUNK, 1), 0)) == 0) {
+            return 0;
+        }
+        /* Counted as allocated by allocFromHeap */
+        grown = GET_SIZE(mp);
+    }
+    size = GET_SIZE(mp);
+    words = ((size >> MPR_ALIGN_SHIFT) + NURSERY_BITS - 1) / NURSERY_BITS;
+    if ((np = malloc(sizeof(MprNursery) + words * sizeof(ulong))) == 0) {
+        /* Let the collector free the block */
+        return 0;
+    }
+    memset(np->starts, 0, words * sizeof(ulong));
+    np->tail = mp;
+    np->last = 0;
+    np->end = (char*) mp + size;
+    np->final = IS_LAST(mp);
+
+    /* The tail is eternal and not free so the sweeper will neither free nor coalesce it */
+    SET_FIELD2(mp, size, heap->eternal, UNMARKED, 0);
+    lockHeap();
+    if (heap->nurseryCount >= heap->nurseryMax) {
+        max = max(heap->nurseryMax * 2, 64);
+        if ((list = realloc(heap->nurseries, max * sizeof(MprNursery*))) == 0) {
+            SET_FIELD2(mp, size, heap->active, UNMARKED, 0);
+            unlockHeap();
+            free(np);
+            return 0;
+        }
+        heap->nurseries = list;
+        heap->nurseryMax = max;
+    }
+    heap->nurseries[heap->nurseryCount++] = np;
+    heap->stats.cacheRefills++;
+    heap->allocated -= grown;
+    heap->nurseryBytes += size;
+    full = heap->nurseryBytes >= heap->nurserySize;
     unlockHeap();
-    triggerGC(MPR_GC_FORCE);
-    return growHeap(required, flags);
+
+    cache->nursery = np;
+    cache->nurseryEpoch = heap->nurseryEpoch;
+    if (full) {
+        triggerGC(MPR_GC_FORCE);
+    }
+    return np;
 }
+#endif /* BIT_MPR_NURSERY */
 
 
 /*
-    Grow the heap and return a block of the required size (unqueued)
+    Grow the heap and return a block of the required size (unqueued). If pp is set, the new region is owned by
+    the partition.
  */
-static MprMem *growHeap(ssize required, int flags)
+static MprMem *growHeap(MprPartition *pp, ssize required, int flags)
 {
     MprRegion           *region;
     MprMem              *mp, *spare;
     ssize               size, rsize, spareLen;
-    int                 hasManager;
+    int                 hasManager, huge;
 
     assert(required > 0);
 
     rsize = MPR_ALLOC_ALIGN(sizeof(MprRegion));
     size = max(required + rsize, (ssize) heap->chunkSize);
+    huge = heap->hugePages && required <= BIT_MAX_REGION;
+    if (heap->hugePages && !huge) {
+        /* Big blocks get a region of their own without huge pages so it can be unmapped when the block is freed */
+        size = required + rsize;
+    }
     size = MPR_PAGE_ALIGN(size, memStats.pageSize);
     if (size < 0 || size >= ((ssize) 1 << MPR_SIZE_BITS)) {
         allocException(MPR_MEM_TOO_BIG, size);
@@ -652,13 +1338,20 @@ static MprMem *growHeap(ssize required, int flags)
     }
 }
 #endif
-    if ((region = mprVirtAlloc(size, MPR_MAP_READ | MPR_MAP_WRITE)) == NULL) {
+    if ((region = allocRegion(size, huge)) == NULL) {
         return 0;
     }
+#if BIT_MPR_NURSERY
+    trackRegion(region, size);
+#endif
     mprInitSpinLock(&((MprRegion*) region)->lock);
     region->size = size;
     region->start = (MprMem*) (((char*) region) + rsize);
     region->freeable = 0;
+    region->garbage = 0;
+    region->starts = 0;
+    region->partition = pp;
+    region->blocks = 0;
     mp = (MprMem*) region->start;
     hasManager = (flags & MPR_ALLOC_MANAGER) ? 1 : 0;
     spareLen = size - required - rsize;
@@ -678,16 +1371,21 @@ static MprMem *growHeap(ssize required, int flags)
 
     lockHeap();
     region->next = heap->regions;
+    heap->allocated += required;
     heap->stats.bytesAllocated += size;
     heap->regions = region;
     heap->stats.regions++;
+    if (pp) {
+        pp->bytes += size;
+        pp->allocated += required;
+    }
     if (spareLen > 0) {
         assert(spareLen >= sizeof(MprFreeMem));
         spare = (MprMem*) ((char*) mp + required);
         INIT_BLK(spare, spareLen, 0, 1, mp);
         CHECK(spare);
         INC(allocs);
-        linkBlock(spare);
+        linkBlock(pp ? &pp->queues : &heap->queues, spare);
     } else {
         INC(allocs);
     }
@@ -697,28 +1395,128 @@ static MprMem *growHeap(ssize required, int flags)
 
 
 /*
-    Free a block. MUST only ever be called by the sweeper. The sweeper takes advantage of the fact that only it 
-    coalesces blocks.
+    Allocate virtual memory for a heap region. Huge page regions are aligned to the huge page size so the O/S can back 
+    them with transparent huge pages and use fewer TLB entries.
  */
-static MprMem *freeBlock(MprMem *mp)
+static void *allocRegion(ssize size, int huge)
 {
-    MprMem      *prev, *next, *after;
-    MprRegion   *region;
-    ssize       size;
+#if defined(MADV_HUGEPAGE) && VALLOC
+    char    *ptr, *aligned, *end;
 
-    BREAKPOINT(mp);
-    SCRIBBLE(mp);
-    size = GET_SIZE(mp);
-    prev = NULL;
-    lockHeap();
-    
-    /*
-        Coalesce with next if it is free
-     */
-    next = GET_NEXT(mp);
-    if (next && IS_FREE(next)) {
+    if (huge) {
+        assert(MPR_PAGE_ALIGNED(size, MPR_HUGE_PAGE_SIZE));
+        if ((ptr = mprVirtAlloc(size + MPR_HUGE_PAGE_SIZE, MPR_MAP_READ | MPR_MAP_WRITE)) == NULL) {
+            return 0;
+        }
+        aligned = (char*) MPR_PAGE_ALIGN(ptr, MPR_HUGE_PAGE_SIZE);
+        end = ptr + size + MPR_HUGE_PAGE_SIZE;
+        if (aligned > ptr) {
+            vmfree(ptr, aligned - ptr);
+        }
+        if (end > (aligned + size)) {
+            vmfree(aligned + size, end - (aligned + size));
+        }
+        madvise(aligned, size, MADV_HUGEPAGE);
+        return aligned;
+    }
+#endif
+    return mprVirtAlloc(size, MPR_MAP_READ | MPR_MAP_WRITE);
+}
+
+
+/*
+    Return the pages of large free blocks to the O/S once free memory exceeds what is likely to be reused before the 
+    next collection: the larger of the last allocation volume and the permitted heap growth. Smaller free blocks are 
+    reused first, so the largest blocks are released first. Released blocks stay on the free queues and are marked so 
+    they are not released again until reused. Called when sweeping completes.
+ */
+static void releaseFree(ssize retain)
+{
+    MprFreeMem  *freeq, *fp;
+    MprMem      *mp;
+    ssize       excess, size;
+    int         index, first;
+
+    if (heap->releaseSize <= 0) {
+        return;
+    }
+    lockHeap();
+    excess = heap->queues.bytesFree - retain;
+    first = getQueueIndex(heap->releaseSize, 0);
+    for (index = MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS - 1; index >= first && excess > 0; index--) {
+        freeq = &heap->queues.freeq[index];
+        for (fp = freeq->next; fp != freeq && excess > 0; fp = fp->next) {
+            mp = (MprMem*) fp;
+            size = GET_SIZE(mp);
+            if (fp->released || releaseSpan(mp, size)) {
+                excess -= size;
+            }
+        }
+    }
+    unlockHeap();
+}
+
+
+/*
+    Return the whole pages inside a free block to the O/S. The pages holding the block header and its neighbours are 
+    retained. MADV_DONTNEED drops the pages immediately so the resident size falls at once. MADV_FREE 
+    (BIT_MPR_RELEASE_LAZY) is cheaper but the O/S only reclaims the pages under memory pressure. Returned pages are zero 
+    filled when next touched. Must be called locked so that other threads cannot allocate the block meanwhile.
+ */
+static int releaseSpan(MprMem *mp, ssize size)
+{
+#if BIT_UNIX_LIKE && VALLOC
+    char    *start, *end;
+    ssize   align;
+
+    if (size < heap->releaseSize) {
+        return 0;
+    }
+    align = heap->hugePages ? MPR_HUGE_PAGE_SIZE : memStats.pageSize;
+    start = (char*) MPR_PAGE_ALIGN((char*) mp + sizeof(MprFreeMem), align);
+    end = (char*) (((ssize) mp + size) & ~(align - 1));
+    if (start < end) {
+#if BIT_MPR_RELEASE_LAZY && defined(MADV_FREE)
+        if (madvise(start, end - start, MADV_FREE) == 0) {
+#else
+        if (madvise(start, end - start, MADV_DONTNEED) == 0) {
+#endif
+            heap->stats.releases++;
+            ((MprFreeMem*) mp)->released = 1;
+            return 1;
+        }
+    }
+#endif
+    return 0;
+}
+
+
+/*
+    Free a block. MUST only ever be called by the sweeper. The sweeper takes advantage of the fact that only it 
+    coalesces blocks.
+ */
+static MprMem *freeBlock(MprFreeQueues *fq, MprMem *mp)
+{
+    MprMem      *prev, *next, *after;
+    MprRegion   *region;
+    ssize       size, freed;
+    int         released;
+
+    BREAKPOINT(mp);
+    SCRIBBLE(mp);
+    size = freed = GET_SIZE(mp);
+    prev = NULL;
+    released = 0;
+    lockHeap();
+    
+    /*
+        Coalesce with next if it is free
+     */
+    next = GET_NEXT(mp);
+    if (next && IS_FREE(next)) {
         BREAKPOINT(next);
-        unlinkBlock((MprFreeMem*) next);
+        released |= ((MprFreeMem*) next)->released;
+        unlinkBlock(fq, (MprFreeMem*) next);
         if ((after = GET_NEXT(next)) != NULL) {
             assert(GET_PRIOR(after) == next);
             SET_PRIOR(after, mp);
@@ -737,7 +1535,8 @@ static MprMem *freeBlock(MprMem *mp)
     prev = GET_PRIOR(mp);
     if (prev && IS_FREE(prev)) {
         BREAKPOINT(prev);
-        unlinkBlock((MprFreeMem*) prev);
+        released |= ((MprFreeMem*) prev)->released;
+        unlinkBlock(fq, (MprFreeMem*) prev);
         if ((after = GET_NEXT(mp)) != NULL) {
             assert(GET_PRIOR(after) == mp);
             SET_PRIOR(after, prev);
@@ -762,16 +1561,22 @@ static MprMem *freeBlock(MprMem *mp)
      */
     if (GET_PRIOR(mp) == NULL && IS_LAST(mp)) {
         region = GET_REGION(mp);
-        if (region->size > BIT_MAX_REGION || heap->stats.bytesFree > (BIT_MAX_REGION * 4)) {
+        if (region->size > BIT_MAX_REGION || fq->bytesFree > (BIT_MAX_REGION * 4)) {
             unlockHeap();
             region->freeable = 1;
             assert(next == NULL);
         } else {
-            linkBlock(mp);
+            linkBlock(fq, mp);
             unlockHeap();
         }
     } else {
-        linkBlock(mp);
+        linkBlock(fq, mp);
+        /*
+            A released span that absorbs a block too small to release by itself stays released
+         */
+        if (released && freed < heap->releaseSize) {
+            ((MprFreeMem*) mp)->released = 1;
+        }
         unlockHeap();
     }
     /*
@@ -806,11 +1611,11 @@ static int getQueueIndex(ssize size, int roundup)
     assert(bucket < MPR_ALLOC_NUM_BUCKETS);
 
     index = (group * MPR_ALLOC_NUM_BUCKETS) + bucket;
-    assert(index < (heap->freeEnd - heap->freeq));
+    assert(index < (heap->queues.freeEnd - heap->queues.freeq));
     
 #if BIT_MEMORY_STATS
-    assert(heap->freeq[index].info.stats.minSize <= (int) usize && 
-        (int) usize < heap->freeq[index + 1].info.stats.minSize);
+    assert(heap->queues.freeq[index].info.stats.minSize <= (int) usize && 
+        (int) usize < heap->queues.freeq[index + 1].info.stats.minSize);
 #endif
     if (roundup) {
         /*
@@ -836,7 +1641,7 @@ static int getQueueIndex(ssize size, int roundup)
     Add a block to a free q. Must be called locked.
     Called by user threads from allocMem and by sweeper from freeBlock.
  */
-static void linkBlock(MprMem *mp) 
+static void linkBlock(MprFreeQueues *fq, MprMem *mp) 
 {
     MprFreeMem  *freeq, *fp;
     ssize       size;
@@ -857,14 +1662,15 @@ static void linkBlock(MprMem *mp)
     index = getQueueIndex(size, 0);
     group = index / MPR_ALLOC_NUM_BUCKETS;
     bucket = index % MPR_ALLOC_NUM_BUCKETS;
-    heap->groupMap |= (((ssize) 1) << group);
-    heap->bucketMap[group] |= (((ssize) 1) << bucket);
+    fq->groupMap |= (((ssize) 1) << group);
+    fq->bucketMap[group] |= (((ssize) 1) << bucket);
 
     /*
         Link onto free queue
      */
     fp = (MprFreeMem*) mp;
-    freeq = &heap->freeq[index];
+    fp->released = 0;
+    freeq = &fq->freeq[index];
     assert(fp != freeq);
     fp->next = freeq->next;
     fp->prev = freeq;
@@ -873,6 +1679,7 @@ static void linkBlock(MprMem *mp)
     assert(fp != fp->next);
     assert(fp != fp->prev);
 
+    fq->bytesFree += size;
     heap->stats.bytesFree += size;
 #if BIT_MEMORY_STATS
     freeq->info.stats.count++;
@@ -883,7 +1690,7 @@ static void linkBlock(MprMem *mp)
 /*
     Remove a block from a free q. Must be called locked.
  */
-static void unlinkBlock(MprFreeMem *fp) 
+static void unlinkBlock(MprFreeQueues *fq, MprFreeMem *fp) 
 {
     MprMem  *mp;
     ssize   size;
@@ -897,13 +1704,14 @@ static void unlinkBlock(MprFreeMem *fp)
 
     mp = (MprMem*) fp;
     size = GET_SIZE(mp);
+    fq->bytesFree -= size;
     heap->stats.bytesFree -= size;
     assert(IS_FREE(mp));
     SET_FREE(mp, 0);
     mprAtomicBarrier();
 #if BIT_MEMORY_STATS
 {
-    MprFreeMem *freeq = getQueue(size);
+    MprFreeMem *freeq = getQueue(fq, size);
     freeq->info.stats.count--;
     assert(freeq->info.stats.count >= 0);
 }
@@ -912,13 +1720,13 @@ static void unlinkBlock(MprFreeMem *fp)
 
 
 #if BIT_MEMORY_STATS
-static MprFreeMem *getQueue(ssize size)
+static MprFreeMem *getQueue(MprFreeQueues *fq, ssize size)
 {   
     MprFreeMem  *freeq;
     int         index;
     
     index = getQueueIndex(size, 0);
-    freeq = &heap->freeq[index];
+    freeq = &fq->freeq[index];
     return freeq;
 }
 #endif
@@ -1017,6 +1825,7 @@ PUBLIC void mprStartGCService()
             } else {
                 mprStartThread(heap->marker);
             }
+            startMarkHelpers();
         }
 #if FUTURE && KEEP
         if (heap->flags & MPR_SWEEP_THREAD) {
@@ -1043,11 +1852,130 @@ PUBLIC void mprStopGCService()
 
 PUBLIC void mprWakeGCService()
 {
+    int     i;
+
     mprSignalCond(heap->markerCond);
+    for (i = 1; i <= heap->markHelpers; i++) {
+        mprSignalCond(heap->markStacks[i].cond);
+    }
     mprResumeThreads();
 }
 
 
+PUBLIC int mprSetGCGrowth(int percent)
+{
+    int     old;
+
+    old = heap->gcGrowth;
+    heap->gcGrowth = min(max(percent, 0), MPR_GC_MAX_GROWTH);
+    setGrowTarget();
+    return old;
+}
+
+
+PUBLIC int mprSetGCPauseTarget(int msec)
+{
+    int     old;
+
+    old = heap->pauseTarget;
+    heap->pauseTarget = max(msec, 0);
+    return old;
+}
+
+
+PUBLIC ssize mprSetMemRelease(ssize size)
+{
+    ssize   old;
+
+    old = heap->releaseSize;
+    heap->releaseSize = max(size, 0);
+    return old;
+}
+
+
+PUBLIC ssize mprSetNurserySize(ssize size)
+{
+    ssize   old;
+
+    old = heap->nurserySize;
+    heap->nurserySize = max(size, 0);
+#if BIT_MPR_NURSERY
+    heap->nursery = heap->nurserySize > 0 && heap->trackFd >= 0;
+#endif
+    heap->stats.nursery = heap->nursery ? heap->nurserySize : 0;
+    return old;
+}
+
+
+PUBLIC uint64 mprGetGCPause(int percentile)
+{
+    uint64      want, count;
+    int         i;
+
+    if (heap->stats.collections == 0) {
+        return 0;
+    }
+    percentile = min(max(percentile, 0), 100);
+    want = max((heap->stats.collections * percentile + 99) / 100, 1);
+    for (count = 0, i = 0; i < MPR_GC_PAUSE_BUCKETS - 1; i++) {
+        if ((count += heap->stats.pauses[i]) >= want) {
+            break;
+        }
+    }
+    return min(((uint64) 1) << i, heap->stats.maxPause);
+}
+
+
+PUBLIC int mprSetGCThreads(int count)
+{
+    int     old;
+
+    old = heap->gcThreads;
+    if (count <= 0) {
+        count = heap->stats.numCpu;
+    }
+    heap->gcThreads = min(max(count, 1), MPR_GC_MAX_THREADS);
+    if (heap->marker) {
+        startMarkHelpers();
+    }
+    return old;
+}
+
+
+/*
+    Start helper threads to mark in parallel with the marker. Helpers are never stopped, but are only used if
+    heap->gcThreads is large enough when a collection starts.
+ */
+static void startMarkHelpers()
+{
+    MprMarkStack    *ms;
+    int             index;
+
+    mprLock(heap->mutex);
+    if (heap->gcThreads > 1 && heap->markKey == 0) {
+        heap->markKey = mprCreateThreadLocal();
+    }
+    while (heap->markKey && heap->markHelpers + 1 < heap->gcThreads) {
+        index = heap->markHelpers + 1;
+        ms = &heap->markStacks[index];
+        if ((ms->cond = mprCreateCond()) == 0) {
+            break;
+        }
+        if ((ms->thread = mprCreateThread(sfmt("marker.%d", index), markHelper, NULL, 0)) == 0) {
+            mprError("Cannot create marker helper thread");
+            break;
+        }
+        ms->thread->stickyYield = 1;
+        ms->thread->yielded = 1;
+        ms->cycle = heap->markCycle;
+        mprStartThread(ms->thread);
+        mprAtomicBarrier();
+        heap->markHelpers = index;
+    }
+    mprUnlock(heap->mutex);
+}
+
+
 static void triggerGC(int flags)
 {
     if (!heap->gcRequested && ((flags & MPR_GC_FORCE) || (heap->newCount > heap->newQuota))) {
@@ -1062,6 +1990,24 @@ static void triggerGC(int flags)
 }
 
 
+#if BIT_MPR_PARTITION
+/*
+    Request a collection of a single partition. The marker collects requested partitions when a full collection is 
+    not due.
+ */
+static void triggerPartitionGC(MprPartition *pp)
+{
+    if (!pp->gcRequested && !heap->gcRequested && heap->enabled) {
+        pp->gcRequested = 1;
+        heap->partitionRequested = 1;
+        if (heap->flags & MPR_MARK_THREAD) {
+            mprSignalCond(heap->markerCond);
+        }
+    }
+}
+#endif
+
+
 PUBLIC void mprRequestGC(int flags)
 {
     int     i, count;
@@ -1074,12 +2020,22 @@ PUBLIC void mprRequestGC(int flags)
 #if PARALLEL_GC
             heap->mustYield = 1;
 #endif
+            if (flags & MPR_GC_FORCE) {
+                /* Forced collections collect all generations */
+                heap->gcFull = 1;
+            }
             triggerGC(MPR_GC_FORCE);
         }
         if (!(flags & MPR_GC_NO_YIELD)) {
             mprYield((flags & MPR_GC_NO_BLOCK) ? MPR_YIELD_NO_BLOCK: 0);
         }
     }
+    if (!(flags & (MPR_GC_NO_BLOCK | MPR_GC_NO_YIELD))) {
+        /* Wait for the marker to free the blocks it did not free while threads were paused */
+        while (heap->sweepPending && !mprIsFinished()) {
+            mprNap(1);
+        }
+    }
 }
 
 
@@ -1115,7 +2071,12 @@ static void resumeThreads()
 
 static void mark()
 {
+    MprGCRecord *record;
+    uint64      start, markStart, sweepStart, deadline, pause, allocated;
+    int         bucket;
+
     mprTrace(7, "GC: mark started");
+    start = getGCTicks();
 
     /*
         When parallel, we mark blocks using the current heap->active mark. After marking, synchronization will rotate
@@ -1137,36 +2098,112 @@ static void mark()
         // resumeThreads();
         return;
     }
-    nextGen();
+    if (heap->sweepPending) {
+        /* All dead blocks must be freed before the generations rotate */
+        sweepRegions(0);
+    }
+#if BIT_MPR_PARTITION
+    if (heap->partitions) {
+        mergePartitions();
+    }
+#endif
+#if BIT_MPR_NURSERY
+    /*
+        A minor collection only collects the young blocks in the nursery. Forced collections, heap growth and heap 
+        snapshots collect all generations.
+     */
+    heap->minor = heap->nursery && heap->enabled && !heap->gcFull && !heap->snapshot && heap->nurseryCount > 0;
+    heap->gcFull = 0;
+    retireNursery();
+    if (!heap->minor) {
+        freeNurseries();
+    }
+#endif
+    if (!heap->minor) {
+        nextGen();
+    }
 #endif
+    heap->stats.collections++;
+    record = &heap->stats.history[(heap->stats.collections - 1) % MPR_GC_HISTORY];
+    memset(record, 0, sizeof(MprGCRecord));
+    record->minor = heap->minor;
+    allocated = getAllocated();
+    record->allocated = allocated - heap->priorAllocated;
+    heap->priorAllocated = allocated;
     heap->priorNewCount = heap->newCount;
     heap->priorFree = heap->stats.bytesFree;
     heap->newCount = 0;
     heap->gcRequested = 0;
     checkYielded();
+    markStart = getGCTicks();
+#if BIT_MPR_NURSERY
+    if (heap->minor) {
+        markYoung();
+    } else
+#endif
     markRoots();
+    forgetDead();
+    heap->stats.lastMarkTime = getGCTicks() - markStart;
     heap->marking = 0;
+    if (heap->snapshot) {
+        /* Before sweeping so unreachable blocks used by the requester are not yet freed */
+        writeSnapshot(heap->snapshot);
+        heap->snapshot = 0;
+    }
     if (!heap->hasSweeper) {
         heap->sweeping = 1;
-        MPR_MEASURE(7, "GC", "sweep", sweep());
+        deadline = heap->pauseTarget ? (start + heap->pauseTarget * 1000) : 0;
+        sweepStart = getGCTicks();
+#if BIT_MPR_NURSERY
+        if (heap->minor) {
+            MPR_MEASURE(7, "GC", "sweep", sweepYoung());
+        } else
+#endif
+        MPR_MEASURE(7, "GC", "sweep", sweep(deadline));
+        heap->stats.lastSweepTime = getGCTicks() - sweepStart;
         heap->sweeping = 0;
     }
+#if BIT_MPR_NURSERY
+    if (heap->minor) {
+        heap->stats.minorCollections++;
+        heap->minor = 0;
+    }
+    if (heap->nursery) {
+        /* Young blocks may only be referenced by old blocks written after this point */
+        resetWrites();
+    }
+#endif
+    pause = getGCTicks() - start;
+    record->pause = pause;
+    record->markTime = heap->stats.lastMarkTime;
+    record->sweepTime = heap->stats.lastSweepTime;
+    heap->stats.lastPause = pause;
+    heap->stats.pauseTime += pause;
+    heap->stats.maxPause = max(heap->stats.maxPause, pause);
+    for (bucket = 0; bucket < MPR_GC_PAUSE_BUCKETS - 1 && (((uint64) 1) << bucket) <= pause; bucket++) ;
+    heap->stats.pauses[bucket]++;
     resumeThreads();
+
+    if (heap->sweepPending) {
+        /*
+            Free the remaining garbage while other threads run. Allocations may split free blocks concurrently, 
+            but only the marker coalesces blocks or releases regions.
+         */
+        heap->stats.deferredSweeps++;
+        sweepRegions(0);
+    }
 }
 
 
 /*
-    Sweep up the garbage.
-    WARNING: This code uses lock-free algorithms. The sweeper traverses the region list and block list without locking. 
-    Other code must similarly use lock-free code -- only add regions to the start of the regions list and never 
-    otherwise modify the region list. Other code may modify blocks on the list, but must atomically update MprMem.field1.
-    The sweeper is the only routine to do coalesing, other code may split blocks, but this can be done in a lock-free 
-    manner by creating the spare 2nd half block first and then updating mp->field2 with the size and last bit.
-*/
-static void sweep()
+    Sweep up the garbage. Destructors for all unreachable blocks are run while other threads are paused. The blocks are 
+    then freed region by region until the deadline (if non-zero). Remaining regions are freed by sweepRegions after 
+    resuming threads.
+ */
+static void sweep(uint64 deadline)
 {
-    MprRegion   *region, *nextRegion, *prior;
-    MprMem      *mp, *next;
+    MprRegion   *region;
+    MprMem      *mp;
     MprManager  mgr;
     
     if (!heap->enabled) {
@@ -1182,20 +2219,27 @@ static void sweep()
 
     /*
         Run all destructors first so all destructors can guarantee dependant memory blocks will still exist.
-        Actually free the memory in a 2nd pass below.
+        Destructors must run before threads resume as they remove blocks from weak lists and hashes such as the 
+        interned string table. Actually free the memory in a 2nd pass below.
      */
+    heap->sweepBytes = 0;
     for (region = heap->regions; region; region = region->next) {
+        region->garbage = 0;
         /*
             This code assumes that no other code coalesces blocks and that splitting blocks will be done lock-free
          */
         for (mp = region->start; mp; mp = GET_NEXT(mp)) {
-            if (unlikely(GET_GEN(mp) == heap->dead && HAS_MANAGER(mp))) {
-                mgr = GET_MANAGER(mp);
-                assert(!IS_FREE(mp));
-                CHECK(mp);
-                BREAKPOINT(mp);
-                if (mgr && VALID_BLK(mp)) {
-                    (mgr)(GET_PTR(mp), MPR_MANAGE_FREE);
+            if (unlikely(GET_GEN(mp) == heap->dead)) {
+                region->garbage = 1;
+                heap->sweepBytes += GET_SIZE(mp);
+                if (HAS_MANAGER(mp)) {
+                    mgr = GET_MANAGER(mp);
+                    assert(!IS_FREE(mp));
+                    CHECK(mp);
+                    BREAKPOINT(mp);
+                    if (mgr && VALID_BLK(mp)) {
+                        (mgr)(GET_PTR(mp), MPR_MANAGE_FREE);
+                    }
                 }
             }
         }
@@ -1204,16 +2248,44 @@ static void sweep()
     heap->stats.sweepVisited = 0;
     heap->stats.swept = 0;
 #endif
+    heap->sweepRegion = heap->regions;
+    heap->sweepPrior = NULL;
+    heap->sweepPending = 1;
+    setGrowTarget();
+    sweepRegions(deadline);
+}
+
+
+/*
+    Free the garbage in regions not yet swept. Stop after the first region completed past the deadline (if non-zero).
+    WARNING: This code uses lock-free algorithms. The sweeper traverses the region list and block list without locking. 
+    Other code must similarly use lock-free code -- only add regions to the start of the regions list and never 
+    otherwise modify the region list. Other code may modify blocks on the list, but must atomically update MprMem.field1.
+    The sweeper is the only routine to do coalesing, other code may split blocks, but this can be done in a lock-free 
+    manner by creating the spare 2nd half block first and then updating mp->field2 with the size and last bit.
+ */
+static void sweepRegions(uint64 deadline)
+{
+    MprRegion   *region, *nextRegion, *prior;
+    MprMem      *mp, *next, *first;
+    MprGCRecord *record;
+    ssize       size;
 
     /*
         growHeap() will append new regions to the front of heap->regions and so will not race with this code. This code
         is the only code that frees regions.
         RACE: Take from the front. Racing with growHeap.
      */
-    prior = NULL;
-    for (region = heap->regions; region; region = nextRegion) {
+    record = &heap->stats.history[(heap->stats.collections - 1) % MPR_GC_HISTORY];
+    prior = heap->sweepPrior;
+    for (region = heap->sweepRegion; region; region = nextRegion) {
         assert(region->freeable == 0 || region->freeable == 1);
         nextRegion = region->next;
+        if (!region->garbage) {
+            prior = region;
+            continue;
+        }
+        region->garbage = 0;
 
         /*
             This code assumes that no other code coalesces blocks and that splitting blocks will be done lock-free
@@ -1226,124 +2298,1384 @@ static void sweep()
                 CHECK(mp);
                 BREAKPOINT(mp);
                 INC(swept);
+                size = GET_SIZE(mp);
 #if BIT_MEMORY_STATS
                 if (heap->track) {
-                    freeLocation(mp->name, GET_SIZE(mp));
+                    freeLocation(mp->name, size);
                 }
 #endif
-                heap->stats.freed += GET_SIZE(mp);
-                next = freeBlock(mp);
+                heap->stats.freed += size;
+                heap->sweepBytes -= size;
+                record->freedBlocks++;
+                /* The block may be joined to the prior block */
+                first = GET_PRIOR(mp) ? GET_PRIOR(mp) : mp;
+                next = freeBlock(REGION_QUEUES(region), mp);
             } else {
                 /*
                     RACE: Block could be allocated here, but will never be coalesced (sweeper is the only one to do that).
                     So mp->field2 may be reduced so we may skip a newly created block -- no problem. Get it next scan.
                  */
+                first = mp;
                 next = GET_NEXT(mp);
             }
+#if BIT_MPR_NURSERY
+            if (region->starts) {
+                setStarts(region, first, mp, next);
+            }
+#else
+            (void) first;
+#endif
         }
-        /*
-            The sweeper is the only one who removes regions. 
-            Currently all threads are suspended so no locks needed. 
-            FUTURE - When doing parallel collection, do this lock-free because user code traverses the region list.
-         */ 
         if (region->freeable) {
-            lockHeap();
-            INC(unpins);
-            if (prior) {
-                prior->next = nextRegion;
-            } else {
-                heap->regions = nextRegion;
-            }
-            heap->stats.regions--;
-            heap->stats.bytesAllocated -= region->size;
-            assert(heap->stats.bytesAllocated >= 0);
-            unlockHeap();
-            mprTrace(9, "DEBUG: Unpin %p to %p size %d, used %d", region, 
-                ((char*) region) + region->size, region->size,fastMemSize());
-            mprManageSpinLock(&region->lock, MPR_MANAGE_FREE);
-            mprVirtFree(region, region->size);
+            freeRegion(region, prior);
         } else {
             prior = region;
         }
+        if (deadline && nextRegion && getGCTicks() >= deadline) {
+            heap->sweepRegion = nextRegion;
+            heap->sweepPrior = prior;
+            return;
+        }
+    }
+    heap->sweepRegion = heap->sweepPrior = NULL;
+    heap->sweepBytes = 0;
+    setGrowTarget();
+    if (!heap->sweepMinor) {
+        /* Minor collections leave free memory for the nursery and do not walk the heap */
+        releaseFree(max((ssize) record->allocated, heap->growTarget - heap->stats.bytesAllocated));
+        heap->stats.bytesCommitted = getCommitted();
+    }
+    heap->sweepMinor = 0;
+#if BIT_MPR_NURSERY
+    heap->stats.freed -= heap->retiredBytes;
+    heap->retiredBytes = 0;
+#endif
+    heap->stats.totalFreed += heap->stats.freed;
+    record = &heap->stats.history[(heap->stats.collections - 1) % MPR_GC_HISTORY];
+    record->freed = heap->stats.freed;
+    record->live = heap->stats.liveBytes;
+    record->heap = heap->stats.bytesAllocated;
+    mprAtomicBarrier();
+    heap->sweepPending = 0;
+}
+
+
+/*
+    Remove an empty region from the region list and return it to the O/S. The prior region may be null if unknown.
+    The sweeper is the only one who removes regions. Other threads may be running and may have added regions to
+    the front of the list, so the head region may have gained a prior region.
+ */
+static void freeRegion(MprRegion *region, MprRegion *prior)
+{
+    lockHeap();
+    INC(unpins);
+    if (prior == NULL && heap->regions != region) {
+        for (prior = heap->regions; prior->next != region; prior = prior->next) ;
+    }
+    if (prior) {
+        prior->next = region->next;
+    } else {
+        heap->regions = region->next;
+    }
+    heap->stats.regions--;
+    heap->stats.bytesAllocated -= region->size;
+    assert(heap->stats.bytesAllocated >= 0);
+    if (region->partition) {
+        region->partition->bytes -= region->size;
+    }
+    unlockHeap();
+    mprTrace(9, "DEBUG: Unpin %p to %p size %d, used %d", region, 
+        ((char*) region) + region->size, region->size,fastMemSize());
+    mprManageSpinLock(&region->lock, MPR_MANAGE_FREE);
+    free(region->starts);
+    free(region->blocks);
+    mprVirtFree(region, region->size);
+}
+
+
+/*
+    Set the heap size that will trigger a GC when the heap must grow. This is proportional to the memory in use.
+    Minor collections keep the target set by the last full collection so promoted blocks eventually trigger a full
+    collection.
+ */
+static void setGrowTarget()
+{
+    ssize   live, growth;
+
+    live = heap->stats.bytesAllocated - heap->stats.bytesFree - heap->sweepBytes;
+    heap->stats.liveBytes = live;
+    if (heap->sweepMinor) {
+        return;
+    }
+    growth = heap->gcGrowth ? max((ssize) heap->chunkSize, live / 100 * heap->gcGrowth) : 0;
+    heap->growTarget = heap->stats.bytesAllocated + growth;
+}
+
+
+/*
+    Start helper threads marking in parallel. Helpers join and steal work from the marker's stack while the roots 
+    are being marked.
+ */
+static void startParallelMark()
+{
+    int     i;
+
+    heap->markBusy = 1;
+    heap->markDone = 0;
+    assert(heap->markPool == 0);
+    heap->markCycle++;
+    mprSetThreadData(heap->markKey, heap->markStacks);
+    mprAtomicBarrier();
+    for (i = 1; i < heap->markThreads; i++) {
+        mprSignalCond(heap->markStacks[i].cond);
+    }
+}
+
+
+/*
+    Help the other marking threads until no thread has work left. Then wait for all helpers to stop.
+ */
+static void finishParallelMark()
+{
+    markParallel(heap->markStacks);
+    heap->markDone = 1;
+    mprAtomicBarrier();
+    while (heap->markJoined > 0) {
+        mprNap(0);
     }
 }
 
 
 static void markRoots()
 {
-    void    *root;
+    MprMarkStack    *ms;
+    void            *root;
+    int             i;
 
 #if BIT_MEMORY_STATS
     heap->stats.markVisited = 0;
     heap->stats.marked = 0;
 #endif
+    ms = heap->markStacks;
+    heap->markThreads = min(heap->gcThreads, heap->markHelpers + 1);
+    heap->stats.markThreads = heap->markThreads;
+    if (heap->markThreads > 1) {
+        startParallelMark();
+    }
     mprMark(heap->roots);
+    mprMark(heap->remembered);
     mprMark(heap->mutex);
     mprMark(heap->markerCond);
+    mprMark(heap->markKey);
+    for (i = 1; i <= heap->markHelpers; i++) {
+        mprMark(heap->markStacks[i].thread);
+        mprMark(heap->markStacks[i].cond);
+    }
+    drainMarks(ms);
 
     heap->rootIndex = 0;
     while ((root = getNextRoot()) != 0) {
         checkYielded();
         mprMark(root);
+        drainMarks(ms);
     }
     heap->rootIndex = -1;
+    if (heap->markThreads > 1) {
+        finishParallelMark();
+    }
 }
 
 
 PUBLIC void mprMarkBlock(cvoid *ptr)
 {
     MprMem      *mp;
+    size_t      field2;
     int         gen;
-#if BIT_DEBUG
-    static int  depth = 0;
-#endif
 
     if (ptr == 0) {
         return;
     }
-    mp = MPR_GET_MEM(ptr);
-#if BIT_DEBUG
-    if (!mprIsValid(ptr)) {
+    if (unlikely(heap->tracing)) {
+        traceRef(ptr);
+        return;
+    }
+#if BIT_MPR_PARTITION
+    if (heap->partition) {
+        /* Partition collections only mark unmarked blocks of the partition. References may be interior. */
+        if ((mp = findPartitionBlock(ptr)) == 0 || !IS_YOUNG(mp)) {
+            return;
+        }
+        /* Keeps the generation and mark for full collections */
+        CLEAR_YOUNG(mp);
+        INC(marked);
+        pushMark(GET_PTR(mp));
+        return;
+    }
+#endif
+    mp = MPR_GET_MEM(ptr);
+#if BIT_MPR_NURSERY
+    if (heap->minor && !IS_YOUNG(mp)) {
+        /* Minor collections do not collect old blocks */
+        return;
+    }
+#endif
+#if BIT_DEBUG
+    if (!mprIsValid(ptr)) {
         mprError("Memory block is either not dynamically allocated, or is corrupted");
         return;
     }
-    assert(!IS_FREE(mp));
-#if PARALLEL_GC
-    assert(GET_MARK(mp) != heap->dead);
-    assert(GET_GEN(mp) != heap->dead);
-    if (GET_MARK(mp) == heap->dead || IS_FREE(mp)) {
-        assert(0);
-        return;
+    assert(!IS_FREE(mp));
+#if PARALLEL_GC
+    assert(GET_MARK(mp) != heap->dead);
+    assert(GET_GEN(mp) != heap->dead);
+    if (GET_MARK(mp) == heap->dead || IS_FREE(mp)) {
+        assert(0);
+        return;
+    }
+#endif
+#endif
+    CHECK(mp);
+    INC(markVisited);
+    assert((GET_MARK(mp) != heap->active) || GET_GEN(mp) == heap->active);
+
+    if (GET_MARK(mp) != heap->active) {
+        BREAKPOINT(mp);
+        gen = GET_GEN(mp);
+        if (gen != heap->eternal) {
+            gen = heap->active;
+        }
+        if (heap->markThreads > 1 && heap->marking) {
+            /* Claim the block so only one marking thread runs the manager */
+            field2 = mp->field2;
+            if ((int) (field2 & MPR_MASK_MARK) == heap->active || !mprAtomicCas((void* volatile*) &mp->field2, 
+                    (void*) field2, (void*) MAKE_FIELD2(GET_SIZE(mp), gen, heap->active, 0))) {
+                return;
+            }
+        } else {
+            /* Lock-free update */
+            SET_FIELD2(mp, GET_SIZE(mp), gen, heap->active, 0);
+        }
+        INC(marked);
+        if (HAS_MANAGER(mp) || heap->minor) {
+            pushMark(ptr);
+        }
+    }
+}
+
+
+/*
+    Run the manager of a marked block. In minor collections, young blocks without managers are scanned for 
+    references to young blocks as their owner's manager may not be run. In partition collections, all marked blocks
+    are also scanned for references to the partition.
+ */
+static MPR_INLINE void manageMark(void *ptr)
+{
+    MprMem      *mp;
+
+    mp = GET_MEM(ptr);
+#if BIT_MPR_PARTITION
+    if (heap->partition) {
+        /* Managers do not mark all references. For example, events are linked into dispatcher queues. */
+        if (HAS_MANAGER(mp)) {
+            (GET_MANAGER(mp))(ptr, MPR_MANAGE_MARK);
+        }
+        scanPartition(ptr, (char*) ptr + GET_USIZE(mp));
+        return;
+    }
+#endif
+#if BIT_MPR_NURSERY
+    if (!HAS_MANAGER(mp)) {
+        scanYoung(ptr, (char*) ptr + GET_USIZE(mp));
+        return;
+    }
+#endif
+    (GET_MANAGER(mp))(ptr, MPR_MANAGE_MARK);
+}
+
+
+/*
+    Push a marked block on the mark stack of the current marking thread. Its manager will be run by drainMarks.
+    If not called by a marking thread, or if the stack cannot grow, the manager is run immediately.
+ */
+static void pushMark(cvoid *ptr)
+{
+    MprMarkStack    *ms;
+    void            **items;
+    int             size;
+
+    ms = 0;
+    if (heap->marking) {
+        ms = (heap->markThreads > 1) ? mprGetThreadData(heap->markKey) : heap->markStacks;
+    }
+    if (ms && ms->top >= ms->size) {
+        size = max(ms->size * 2, MPR_MARK_STACK_SIZE);
+        if ((items = realloc(ms->items, size * sizeof(void*))) != 0) {
+            ms->items = items;
+            ms->size = size;
+        }
+    }
+    if (ms && ms->top < ms->size) {
+        ms->items[ms->top++] = (void*) ptr;
+    } else {
+        manageMark((void*) ptr);
+    }
+}
+
+
+/*
+    Run the managers of blocks on the mark stack. This marks their dependant blocks which may push more blocks.
+    Mark stacks are private to their thread. When marking in parallel and another thread is idle, part of the 
+    stack is shared so the idle thread can steal it.
+ */
+static void drainMarks(MprMarkStack *ms)
+{
+    void    *ptr;
+
+    while (ms->top > 0) {
+        ptr = ms->items[--ms->top];
+        if (heap->markThreads > 1 && heap->markBusy < heap->markThreads && !heap->markPool && ms->top > 1) {
+            shareMarks(ms);
+        }
+        manageMark(ptr);
+    }
+}
+
+
+/*
+    Move the oldest half of a mark stack to the shared pool. The oldest blocks are taken as they are likely to have 
+    the most unmarked dependants. Each pooled batch is counted in heap->markBusy until stolen.
+ */
+static void shareMarks(MprMarkStack *ms)
+{
+    MprMarkBatch    *batch;
+    int             count;
+
+    mprSpinLock(&heap->markLock);
+    if ((batch = heap->markSpare) != 0) {
+        heap->markSpare = batch->next;
+    }
+    mprSpinUnlock(&heap->markLock);
+    if (batch == 0 && (batch = malloc(sizeof(MprMarkBatch))) == 0) {
+        return;
+    }
+    count = min(ms->top / 2, MPR_MARK_BATCH_SIZE);
+    memcpy(batch->items, ms->items, count * sizeof(void*));
+    memmove(ms->items, &ms->items[count], (ms->top - count) * sizeof(void*));
+    ms->top -= count;
+    batch->count = count;
+
+    mprAtomicAdd(&heap->markBusy, 1);
+    mprSpinLock(&heap->markLock);
+    batch->next = heap->markPool;
+    heap->markPool = batch;
+    mprSpinUnlock(&heap->markLock);
+}
+
+
+/*
+    Steal a batch of blocks from the shared pool. On success, the caller is counted in heap->markBusy.
+ */
+static bool stealMarks(MprMarkStack *ms)
+{
+    MprMarkBatch    *batch;
+    int             i;
+
+    mprSpinLock(&heap->markLock);
+    if ((batch = heap->markPool) != 0) {
+        heap->markPool = batch->next;
+        heap->stats.markSteals++;
+    }
+    mprSpinUnlock(&heap->markLock);
+    if (batch == 0) {
+        return 0;
+    }
+    for (i = 0; i < batch->count; i++) {
+        pushMark(batch->items[i]);
+    }
+    mprSpinLock(&heap->markLock);
+    batch->next = heap->markSpare;
+    heap->markSpare = batch;
+    mprSpinUnlock(&heap->markLock);
+    return 1;
+}
+
+
+/*
+    Wait until work can be stolen or until no thread has work left. A thread must be counted in heap->markBusy 
+    while it holds any work, so marking is complete once heap->markBusy reaches zero. Returns true if work was stolen.
+ */
+static bool awaitMarks(MprMarkStack *ms)
+{
+    int     spins;
+
+    for (spins = 0; heap->markBusy > 0 && !heap->markDone; spins++) {
+        if (heap->markPool && stealMarks(ms)) {
+            return 1;
+        }
+        /* Back off so idle threads do not take CPU from busy threads */
+        mprNap(spins < MPR_MARK_SPINS ? 0 : 1);
+    }
+    return 0;
+}
+
+
+/*
+    Mark in parallel with other marking threads. The caller must be counted in heap->markBusy.
+ */
+static void markParallel(MprMarkStack *ms)
+{
+    do {
+        drainMarks(ms);
+        mprAtomicAdd(&heap->markBusy, -1);
+    } while (awaitMarks(ms));
+}
+
+
+#if BIT_MPR_NURSERY
+/*
+    Enable the nursery if the O/S can track writes to the heap. Heap regions are registered with a userfaultfd in 
+    asynchronous write protect mode. The kernel then records which pages are written without signalling. Each 
+    collection reads and resets the written pages via the PAGEMAP_SCAN ioctl. Old blocks written since the last 
+    collection are the remembered set for minor collections and no write barrier is required.
+ */
+static void initNursery(MprRegion *region)
+{
+    struct uffdio_api   api;
+    char                *cp;
+
+    heap->nurserySize = BIT_MPR_NURSERY_SIZE;
+    if ((cp = getenv("MPR_NURSERY")) != 0) {
+        heap->nurserySize = max(stoi(cp), 0);
+    }
+    if (heap->nurserySize > 0) {
+        if ((heap->trackFd = (int) syscall(SYS_userfaultfd, O_CLOEXEC | O_NONBLOCK)) < 0) {
+            return;
+        }
+        memset(&api, 0, sizeof(api));
+        api.api = UFFD_API;
+        api.features = UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED;
+        if (ioctl(heap->trackFd, UFFDIO_API, &api) < 0 || 
+                (heap->pagemapFd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC)) < 0) {
+            stopTracking();
+            return;
+        }
+        /* A forked child does not inherit the registrations */
+        pthread_atfork(NULL, NULL, stopTracking);
+        trackRegion(region, region->size);
+        mprSetNurserySize(heap->nurserySize);
+    }
+}
+
+
+/*
+    Stop tracking writes. All subsequent collections are full collections.
+ */
+static void stopTracking()
+{
+    heap->nursery = 0;
+    heap->stats.nursery = 0;
+    if (heap->trackFd >= 0) {
+        close(heap->trackFd);
+        heap->trackFd = -1;
+    }
+    if (heap->pagemapFd >= 0) {
+        close(heap->pagemapFd);
+        heap->pagemapFd = -1;
+    }
+}
+
+
+/*
+    Register a new heap region for write tracking. Pages written before registration read as written.
+ */
+static void trackRegion(void *ptr, ssize size)
+{
+    struct uffdio_register  reg;
+
+    if (heap->trackFd >= 0) {
+        memset(&reg, 0, sizeof(reg));
+        reg.range.start = (size_t) ptr;
+        reg.range.len = size;
+        reg.mode = UFFDIO_REGISTER_MODE_WP;
+        if (ioctl(heap->trackFd, UFFDIO_REGISTER, &reg) < 0) {
+            mprTrace(7, "GC: Cannot track writes to region, using full collections only");
+            stopTracking();
+        }
+    }
+}
+
+
+static int compareRegion(cvoid *r1, cvoid *r2)
+{
+    MprRegion   *a, *b;
+
+    a = *(MprRegion**) r1;
+    b = *(MprRegion**) r2;
+    return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+
+static int compareNursery(cvoid *n1, cvoid *n2)
+{
+    MprNursery  *a, *b;
+
+    a = *(MprNursery**) n1;
+    b = *(MprNursery**) n2;
+    return (a->tail < b->tail) ? -1 : ((a->tail > b->tail) ? 1 : 0);
+}
+
+
+/*
+    Index the regions by address. Called while other threads are paused.
+ */
+static void indexRegions()
+{
+    MprRegion   *region, **list;
+    int         max;
+
+    regionCount = 0;
+    for (region = heap->regions; region; region = region->next) {
+        if (regionCount >= regionMax) {
+            max = max(regionMax * 2, 256);
+            if ((list = realloc(regionIndex, max * sizeof(MprRegion*))) == 0) {
+                break;
+            }
+            regionIndex = list;
+            regionMax = max;
+        }
+        regionIndex[regionCount++] = region;
+    }
+    qsort(regionIndex, regionCount, sizeof(MprRegion*), compareRegion);
+}
+
+
+/*
+    Scan the regions for pages written since the last scan and protect the pages again. If ranges is not null, 
+    return the written page ranges in address order (malloc). Adjacent regions are scanned as one span.
+    Returns the count of ranges.
+ */
+static int scanWrites(struct page_region **ranges)
+{
+    struct pm_scan_arg  arg;
+    struct page_region  *vec, *bigger;
+    char                *start, *end;
+    int                 count, max, i, j, n;
+
+    vec = 0;
+    count = max = 0;
+    for (i = 0; i < regionCount; i = j) {
+        start = (char*) regionIndex[i];
+        end = start + regionIndex[i]->size;
+        for (j = i + 1; j < regionCount && (char*) regionIndex[j] <= end + MPR_TRACK_GAP; j++) {
+            end = max(end, (char*) regionIndex[j] + regionIndex[j]->size);
+        }
+        memset(&arg, 0, sizeof(arg));
+        arg.size = sizeof(arg);
+        arg.flags = PM_SCAN_WP_MATCHING;
+        arg.category_mask = PAGE_IS_WRITTEN;
+        arg.return_mask = PAGE_IS_WRITTEN;
+        arg.start = (uint64) (size_t) start;
+        arg.end = (uint64) (size_t) end;
+        do {
+            if (ranges && count >= max) {
+                max = max(max * 2, 256);
+                if ((bigger = realloc(vec, max * sizeof(struct page_region))) == 0) {
+                    /* Cannot see which pages were written */
+                    free(vec);
+                    stopTracking();
+                    return -1;
+                }
+                vec = bigger;
+            }
+            arg.vec = ranges ? (uint64) (size_t) &vec[count] : 0;
+            arg.vec_len = ranges ? max - count : 0;
+            if ((n = ioctl(heap->pagemapFd, PAGEMAP_SCAN, &arg)) < 0) {
+                free(vec);
+                stopTracking();
+                return -1;
+            }
+            count += n;
+            arg.start = arg.walk_end;
+        } while (ranges && arg.walk_end < arg.end);
+    }
+    if (ranges) {
+        *ranges = vec;
+    }
+    return count;
+}
+
+
+/*
+    Protect all heap pages so that writes by other threads are seen by the next minor collection
+ */
+static void resetWrites()
+{
+    indexRegions();
+    scanWrites(0);
+}
+
+
+/*
+    Retire the nursery chunks so threads take new chunks after the collection. The unallocated tails become young 
+    blocks that are freed by the collection.
+ */
+static void retireNursery()
+{
+    MprMem      *tail;
+    int         i;
+
+    heap->retiredBytes = 0;
+    for (i = 0; i < heap->nurseryCount; i++) {
+        tail = heap->nurseries[i]->tail;
+        /* The tails were never counted as allocated */
+        heap->retiredBytes += GET_SIZE(tail);
+        SET_FIELD2(tail, GET_SIZE(tail), heap->active, UNMARKED, 0);
+        SET_YOUNG(tail);
+    }
+    heap->nurseryEpoch++;
+}
+
+
+static void freeNurseries()
+{
+    int     i;
+
+    for (i = 0; i < heap->nurseryCount; i++) {
+        free(heap->nurseries[i]);
+    }
+    heap->nurseryCount = 0;
+    heap->nurseryBytes = 0;
+}
+
+
+/*
+    Find the nursery chunk containing an address. The chunks must be sorted.
+ */
+static MprNursery *findNursery(cchar *ptr)
+{
+    MprNursery  *np;
+    int         lo, hi, mid;
+
+    for (lo = 0, hi = heap->nurseryCount - 1; lo <= hi; ) {
+        mid = (lo + hi) / 2;
+        np = heap->nurseries[mid];
+        if (ptr < (char*) np->tail) {
+            hi = mid - 1;
+        } else if (ptr >= np->end) {
+            lo = mid + 1;
+        } else {
+            return np;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Find the young block containing an address. Returns null if the address is not in an allocated young block.
+ */
+static MprMem *findYoung(cchar *ptr)
+{
+    MprNursery  *np;
+    ulong       bits;
+    ssize       index;
+    int         word;
+
+    if ((np = findNursery(ptr)) == 0) {
+        return 0;
+    }
+    index = (ptr - (char*) np->tail) >> MPR_ALIGN_SHIFT;
+    word = (int) (index / NURSERY_BITS);
+    bits = np->starts[word] & ((((ulong) 2) << (index % NURSERY_BITS)) - 1);
+    while (bits == 0) {
+        if (word == 0) {
+            /* In the unallocated tail */
+            return 0;
+        }
+        bits = np->starts[--word];
+    }
+    return (MprMem*) ((char*) np->tail + (((ssize) word * NURSERY_BITS + flsl(bits) - 1) << MPR_ALIGN_SHIFT));
+}
+
+
+/*
+    Map the pages holding nursery chunks so conservative scans can quickly skip references to old pages. 
+    The chunks must be sorted.
+ */
+static void mapNurseries()
+{
+    MprNursery  *np;
+    ulong       *map;
+    ssize       words, page, last;
+    int         i;
+
+    heap->nurseryLow = (char*) heap->nurseries[0]->tail;
+    heap->nurseryHigh = heap->nurseries[heap->nurseryCount - 1]->end;
+    words = ((heap->nurseryHigh - heap->nurseryLow) >> MPR_START_SHIFT) / NURSERY_BITS + 1;
+    if (words > nurseryMapMax) {
+        if ((map = realloc(nurseryMap, words * sizeof(ulong))) == 0) {
+            free(nurseryMap);
+            nurseryMap = 0;
+            nurseryMapMax = 0;
+            return;
+        }
+        nurseryMap = map;
+        nurseryMapMax = words;
+    }
+    memset(nurseryMap, 0, words * sizeof(ulong));
+    for (i = 0; i < heap->nurseryCount; i++) {
+        np = heap->nurseries[i];
+        page = ((char*) np->tail - heap->nurseryLow) >> MPR_START_SHIFT;
+        last = (np->end - 1 - heap->nurseryLow) >> MPR_START_SHIFT;
+        for (; page <= last; page++) {
+            nurseryMap[page / NURSERY_BITS] |= ((ulong) 1) << (page % NURSERY_BITS);
+        }
+    }
+}
+
+
+/*
+    Conservatively scan memory for references to young blocks and mark them. Interior references are permitted.
+ */
+static void scanYoung(cvoid *start, cvoid *end)
+{
+    MprMem      *mp;
+    char        **pp, *ptr;
+    ssize       page;
+
+    for (pp = (char**) MPR_ALLOC_ALIGN((size_t) start); (char*) (pp + 1) <= (char*) end; pp++) {
+        ptr = *pp;
+        if (ptr < heap->nurseryLow || ptr >= heap->nurseryHigh) {
+            continue;
+        }
+        if (nurseryMap) {
+            page = (ptr - heap->nurseryLow) >> MPR_START_SHIFT;
+            if (!(nurseryMap[page / NURSERY_BITS] & (((ulong) 1) << (page % NURSERY_BITS)))) {
+                continue;
+            }
+        }
+        if ((mp = findYoung(ptr)) != 0 && IS_YOUNG(mp)) {
+            mprMarkBlock(GET_PTR(mp));
+        }
+    }
+}
+
+
+/*
+    Record the block to walk from for the pages starting within the block mp to next. The first block starts at or 
+    before mp and is not joined to a prior block before the region is swept again.
+ */
+static void setStarts(MprRegion *region, MprMem *first, MprMem *mp, MprMem *next)
+{
+    ssize   page, last, offset;
+
+    offset = (char*) mp - (char*) region;
+    page = (offset + (1 << MPR_START_SHIFT) - 1) >> MPR_START_SHIFT;
+    last = ((next ? (char*) next - (char*) region : region->size) - 1) >> MPR_START_SHIFT;
+    offset = (char*) first - (char*) region;
+    for (; page <= last; page++) {
+        region->starts[page] = (uint) offset;
+    }
+}
+
+
+/*
+    Index the blocks starting at or before each page of a region so minor collections can walk the blocks on written 
+    pages without walking the region from the start. The sweeper updates the index as it joins free blocks.
+ */
+static int indexStarts(MprRegion *region)
+{
+    MprNursery  *np;
+    MprMem      *mp, *next;
+    ssize       pages;
+
+    pages = (region->size >> MPR_START_SHIFT) + 1;
+    if ((region->starts = malloc(pages * sizeof(uint))) == 0) {
+        return 0;
+    }
+    region->starts[0] = (uint) ((char*) region->start - (char*) region);
+    for (mp = region->start; mp; mp = next) {
+        next = GET_NEXT(mp);
+        if (IS_YOUNG(mp) && (np = findNursery((char*) mp)) != 0 && np->tail == mp) {
+            next = np->final ? 0 : (MprMem*) np->end;
+        }
+        setStarts(region, mp, mp, next);
+    }
+    return 1;
+}
+
+
+/*
+    Mark the young blocks referenced by the old blocks on pages written since the last collection. Old blocks with 
+    managers are marked by their managers. Old blocks without managers are scanned conservatively.
+ */
+static void markWritten()
+{
+    struct page_region  *written;
+    MprRegion           *region;
+    MprNursery          *np;
+    MprMem              *mp, *next, *from;
+    char                *start, *end, *lo, *hi;
+    int                 count, i, w, j;
+
+    if ((count = scanWrites(&written)) < 0) {
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        heap->stats.writtenPages += (written[i].end - written[i].start) / heap->stats.pageSize;
+    }
+    for (i = 0, w = 0; i < regionCount && w < count; i++) {
+        region = regionIndex[i];
+        start = (char*) region;
+        end = start + region->size;
+        while (w < count && (char*) (size_t) written[w].end <= start) {
+            w++;
+        }
+        if (w >= count || (char*) (size_t) written[w].start >= end) {
+            continue;
+        }
+        if (region->starts == 0 && !indexStarts(region)) {
+            continue;
+        }
+        mp = region->start;
+        for (; w < count && (char*) (size_t) written[w].start < end; w++) {
+            lo = max((char*) (size_t) written[w].start, start);
+            from = (MprMem*) (start + region->starts[(lo - start) >> MPR_START_SHIFT]);
+            if (mp && from > mp) {
+                mp = from;
+            }
+            for (; mp && (char*) mp < (char*) (size_t) written[w].end; mp = next) {
+                next = GET_NEXT(mp);
+                lo = (char*) mp;
+                hi = lo + GET_SIZE(mp);
+                if (IS_YOUNG(mp)) {
+                    /* Skip the young blocks in nursery chunks */
+                    if ((np = findNursery(lo)) != 0 && np->tail == mp) {
+                        next = np->final ? 0 : (MprMem*) np->end;
+                    }
+                    continue;
+                }
+                if (hi <= (char*) (size_t) written[w].start || IS_FREE(mp)) {
+                    continue;
+                }
+                if (HAS_MANAGER(mp)) {
+                    (GET_MANAGER(mp))(GET_PTR(mp), MPR_MANAGE_MARK);
+                } else {
+                    for (j = w; j < count && (char*) (size_t) written[j].start < hi; j++) {
+                        scanYoung(max(GET_PTR(mp), (char*) (size_t) written[j].start), 
+                            min(hi, (char*) (size_t) written[j].end));
+                    }
+                }
+                drainMarks(heap->markStacks);
+            }
+            if ((char*) (size_t) written[w].end > end) {
+                /* The written range continues in the next region */
+                break;
+            }
+        }
+    }
+    free(written);
+}
+
+
+/*
+    Mark the young blocks reachable from the roots, the remembered blocks and the old blocks written since the last 
+    collection. The managers of old roots are not run as old blocks are only collected by full collections.
+ */
+static void markYoung()
+{
+    MprMarkStack    *ms;
+    MprMem          *mp;
+    void            *root;
+    int             i, next;
+
+#if BIT_MEMORY_STATS
+    heap->stats.markVisited = 0;
+    heap->stats.marked = 0;
+#endif
+    ms = heap->markStacks;
+    heap->markThreads = 1;
+    heap->stats.markThreads = 1;
+    qsort(heap->nurseries, heap->nurseryCount, sizeof(MprNursery*), compareNursery);
+    mapNurseries();
+    indexRegions();
+
+    mprMark(heap->roots);
+    mprMark(heap->remembered);
+    mprMark(heap->mutex);
+    mprMark(heap->markerCond);
+    mprMark(heap->markKey);
+    for (i = 1; i <= heap->markHelpers; i++) {
+        mprMark(heap->markStacks[i].thread);
+        mprMark(heap->markStacks[i].cond);
+    }
+    heap->rootIndex = 0;
+    while ((root = getNextRoot()) != 0) {
+        mprMark(root);
+    }
+    heap->rootIndex = -1;
+    drainMarks(ms);
+
+    for (ITERATE_ITEMS(heap->remembered, root, next)) {
+        mp = GET_MEM(root);
+        if (IS_YOUNG(mp)) {
+            mprMark(root);
+        } else if (HAS_MANAGER(mp)) {
+            (GET_MANAGER(mp))(root, MPR_MANAGE_MARK);
+        }
+        drainMarks(ms);
+    }
+    markWritten();
+}
+
+
+/*
+    Find the region containing an address. The regions must be indexed.
+ */
+static MprRegion *findRegion(cvoid *ptr)
+{
+    MprRegion   *region;
+    int         lo, hi, mid;
+
+    for (lo = 0, hi = regionCount - 1; lo <= hi; ) {
+        mid = (lo + hi) / 2;
+        region = regionIndex[mid];
+        if ((char*) ptr < (char*) region) {
+            hi = mid - 1;
+        } else if ((char*) ptr >= (char*) region + region->size) {
+            lo = mid + 1;
+        } else {
+            return region;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Sweep the nursery after a minor collection. Destructors for young blocks that were not marked are run while other 
+    threads are paused. Marked young blocks stay where they are and are now old. The dead blocks are then freed chunk 
+    by chunk so the cost is proportional to the nursery and not the heap.
+ */
+static void sweepYoung()
+{
+    MprGCRecord *record;
+    MprNursery  *np;
+    MprRegion   *region;
+    MprMem      *mp, *next, *first, *after, *beyond;
+    MprManager  mgr;
+    ssize       promoted, size;
+    int         i;
+
+    mprTrace(7, "GC: minor sweep started");
+    record = &heap->stats.history[(heap->stats.collections - 1) % MPR_GC_HISTORY];
+    heap->stats.freed = 0;
+    heap->sweepBytes = 0;
+    promoted = 0;
+    for (i = 0; i < heap->nurseryCount; i++) {
+        np = heap->nurseries[i];
+        for (mp = np->tail; mp && (char*) mp < np->end; mp = GET_NEXT(mp)) {
+            if (IS_YOUNG(mp)) {
+                SET_GEN(mp, heap->dead);
+                heap->sweepBytes += GET_SIZE(mp);
+                if (HAS_MANAGER(mp)) {
+                    mgr = GET_MANAGER(mp);
+                    CHECK(mp);
+                    BREAKPOINT(mp);
+                    if (mgr && VALID_BLK(mp)) {
+                        (mgr)(GET_PTR(mp), MPR_MANAGE_FREE);
+                    }
+                }
+            } else {
+                promoted += GET_SIZE(mp);
+            }
+        }
+    }
+    record->promoted = promoted;
+    heap->stats.promoted += promoted;
+#if BIT_MEMORY_STATS
+    heap->stats.sweepVisited = 0;
+    heap->stats.swept = 0;
+#endif
+    heap->sweepRegion = heap->regions;
+    heap->sweepPrior = NULL;
+    heap->sweepPending = 1;
+    heap->sweepMinor = 1;
+    setGrowTarget();
+
+    /*
+        Free the blocks now. Freeing blocks writes to the heap and writes after the written pages are reset would be 
+        scanned by the next minor collection.
+     */
+    for (i = 0; i < heap->nurseryCount; i++) {
+        np = heap->nurseries[i];
+        region = findRegion(np->tail);
+        for (mp = np->tail; mp && (char*) mp < np->end; mp = next) {
+            CHECK(mp);
+            INC(sweepVisited);
+            if (GET_GEN(mp) == heap->dead) {
+                /* Join the following dead blocks so each run of garbage is freed at once */
+                lockHeap();
+                while ((after = GET_NEXT(mp)) != 0 && (char*) after < np->end && GET_GEN(after) == heap->dead) {
+                    INC(swept);
+                    record->freedBlocks++;
+                    if ((beyond = GET_NEXT(after)) != 0) {
+                        SET_PRIOR(beyond, mp);
+                    } else {
+                        SET_LAST(mp, 1);
+                    }
+                    SET_SIZE(mp, GET_SIZE(mp) + GET_SIZE(after));
+                }
+                unlockHeap();
+                INC(swept);
+                size = GET_SIZE(mp);
+                heap->stats.freed += size;
+                heap->sweepBytes -= size;
+                record->freedBlocks++;
+                first = GET_PRIOR(mp) ? GET_PRIOR(mp) : mp;
+                next = freeBlock(&heap->queues, mp);
+            } else {
+                first = mp;
+                next = GET_NEXT(mp);
+            }
+            if (region && region->starts) {
+                setStarts(region, first, mp, next);
+            }
+        }
+        if (region && region->freeable) {
+            /* Let sweepRegions release the empty region */
+            region->garbage = 1;
+        }
+    }
+    freeNurseries();
+    sweepRegions(0);
+}
+#endif /* BIT_MPR_NURSERY */
+
+
+#if BIT_MPR_PARTITION
+/*
+    Run requested partition collections until none remain or a full collection is due
+ */
+static void collectPartitions()
+{
+    MprPartition    *pp;
+
+    heap->partitionRequested = 0;
+    do {
+        lockHeap();
+        for (pp = heap->partitions; pp && !pp->gcRequested; pp = pp->next) ;
+        unlockHeap();
+        if (pp) {
+            collectPartition(pp);
+        }
+    } while (pp && !heap->mustYield && !mprIsFinished());
+}
+
+
+/*
+    Collect the blocks of one partition. Only the threads bound to the partition and threads not bound to any partition
+    are paused. Blocks outside the partition are not collected, but are scanned conservatively for references into
+    the partition. This can be done while other threads run as only the marker frees regions and the blocks of 
+    the partition are only modified by its paused threads.
+ */
+static void collectPartition(MprPartition *pp)
+{
+    uint64      start, pause;
+
+    pp->gcRequested = 0;
+    if (!heap->enabled || pp->destroyed) {
+        return;
+    }
+    start = getGCTicks();
+    heap->partition = pp;
+    mprAtomicBarrier();
+    heap->mustYield = 1;
+    if (pauseThreads()) {
+        indexRegions();
+        if (preparePartition(pp)) {
+            markPartition(pp);
+            heap->marking = 0;
+            sweepPartition(pp);
+            pause = getGCTicks() - start;
+            pp->collections++;
+            pp->pauseTime += pause;
+            heap->stats.partitionCollections++;
+            heap->stats.partitionPauseTime += pause;
+        }
+    } else {
+        mprTrace(7, "DEBUG: Partition GC synchronization timed out, some threads did not yield.");
+    }
+    heap->marking = 0;
+    heap->mustYield = heap->gcRequested;
+    mprAtomicBarrier();
+    heap->partition = 0;
+    mprResumeThreads();
+}
+
+
+/*
+    Flag the blocks of the partition as unmarked and index the block starts of its regions so interior references
+    can be resolved. Held blocks are not flagged and are roots for the collection.
+ */
+static int preparePartition(MprPartition *pp)
+{
+    MprRegion   *region;
+    MprMem      *mp;
+    ssize       index, words;
+
+    partitionLow = partitionHigh = 0;
+    for (region = heap->regions; region; region = region->next) {
+        if (region->partition != pp) {
+            continue;
+        }
+        words = ((region->size >> MPR_ALIGN_SHIFT) + NURSERY_BITS - 1) / NURSERY_BITS;
+        if ((region->blocks = calloc(words, sizeof(ulong))) == 0) {
+            for (region = heap->regions; region; region = region->next) {
+                free(region->blocks);
+                region->blocks = 0;
+            }
+            return 0;
+        }
+        if (partitionLow == 0 || (char*) region < partitionLow) {
+            partitionLow = (char*) region;
+        }
+        if ((char*) region + region->size > partitionHigh) {
+            partitionHigh = (char*) region + region->size;
+        }
+    }
+    for (region = heap->regions; region; region = region->next) {
+        if (region->partition != pp) {
+            continue;
+        }
+        for (mp = region->start; mp; mp = GET_NEXT(mp)) {
+            index = ((char*) mp - (char*) region) >> MPR_ALIGN_SHIFT;
+            region->blocks[index / NURSERY_BITS] |= ((ulong) 1) << (index % NURSERY_BITS);
+            if (!IS_FREE(mp) && GET_GEN(mp) != heap->eternal) {
+                SET_YOUNG(mp);
+            }
+        }
     }
+    return 1;
+}
+
+
+/*
+    Mark the blocks of a partition. Remembered blocks of the shared heap are marked by their managers as they may 
+    reference memory outside the heap. Their threads are paused. Other regions are scanned conservatively.
+ */
+static void markPartition(MprPartition *pp)
+{
+    MprRegion   *region;
+    MprMem      *mp;
+    void        *ptr;
+    int         next;
+
+#if BIT_MEMORY_STATS
+    heap->stats.markVisited = 0;
+    heap->stats.marked = 0;
 #endif
-#endif
-    CHECK(mp);
-    INC(markVisited);
-    assert((GET_MARK(mp) != heap->active) || GET_GEN(mp) == heap->active);
+    heap->markThreads = 1;
+    lock(heap->remembered);
+    for (ITERATE_ITEMS(heap->remembered, ptr, next)) {
+        mp = GET_MEM(ptr);
+        if (HAS_MANAGER(mp) && (region = findRegion(mp)) != 0 && region->partition == 0) {
+            (GET_MANAGER(mp))(ptr, MPR_MANAGE_MARK);
+        }
+    }
+    unlock(heap->remembered);
+    drainMarks(heap->markStacks);
 
-    if (GET_MARK(mp) != heap->active) {
-        BREAKPOINT(mp);
-        INC(marked);
-        gen = GET_GEN(mp);
-        if (gen != heap->eternal) {
-            gen = heap->active;
+    for (region = heap->regions; region; region = region->next) {
+        if (region->partition == pp) {
+            for (mp = region->start; mp; mp = GET_NEXT(mp)) {
+                if (!IS_FREE(mp) && GET_GEN(mp) == heap->eternal) {
+                    pushMark(GET_PTR(mp));
+                }
+            }
+        } else {
+            scanPartition(region->start, (char*) region + region->size);
         }
-        /* Lock-free update */
-        SET_FIELD2(mp, GET_SIZE(mp), gen, heap->active, 0);
-        if (HAS_MANAGER(mp)) {
-#if BIT_DEBUG
-            if (++depth > 400) {
-                fprintf(stderr, "WARNING: Possibly too much recursion. Marking depth exceeds 400\n");
-                mprBreakpoint();
+        drainMarks(heap->markStacks);
+    }
+}
+
+
+/*
+    Conservatively scan memory for references to unmarked blocks of the partition and mark them
+ */
+static void scanPartition(cvoid *start, cvoid *end)
+{
+    MprMem      *mp;
+    char        **pp, *ptr;
+
+    for (pp = (char**) MPR_ALLOC_ALIGN((size_t) start); (char*) (pp + 1) <= (char*) end; pp++) {
+        ptr = *pp;
+        if (ptr >= partitionLow && ptr < partitionHigh && (mp = findPartitionBlock(ptr)) != 0 && IS_YOUNG(mp)) {
+            mprMarkBlock(GET_PTR(mp));
+        }
+    }
+}
+
+
+/*
+    Find the block of the partition being collected that contains an address. Returns null if the address is not
+    in the partition.
+ */
+static MprMem *findPartitionBlock(cchar *ptr)
+{
+    MprRegion   *region;
+    ulong       bits;
+    ssize       index, word;
+
+    if (ptr < partitionLow || ptr >= partitionHigh || (region = findRegion(ptr)) == 0 || region->blocks == 0 ||
+            ptr < (char*) region->start) {
+        return 0;
+    }
+    index = (ptr - (char*) region) >> MPR_ALIGN_SHIFT;
+    word = index / NURSERY_BITS;
+    bits = region->blocks[word] & ((((ulong) 2) << (index % NURSERY_BITS)) - 1);
+    while (bits == 0) {
+        if (word == 0) {
+            return 0;
+        }
+        bits = region->blocks[--word];
+    }
+    return (MprMem*) ((char*) region + ((word * NURSERY_BITS + flsl(bits) - 1) << MPR_ALIGN_SHIFT));
+}
+
+
+/*
+    Sweep the partition. Destructors for unmarked blocks are run first so they can rely on dependant blocks. The blocks 
+    are then freed to the partition free queues and empty regions are returned to the O/S.
+ */
+static void sweepPartition(MprPartition *pp)
+{
+    MprRegion   *region, *nextRegion, *prior;
+    MprMem      *mp, *next, *first;
+    MprManager  mgr;
+    ssize       freed;
+
+    for (region = heap->regions; region; region = region->next) {
+        free(region->blocks);
+        region->blocks = 0;
+        if (region->partition != pp) {
+            continue;
+        }
+        for (mp = region->start; mp; mp = GET_NEXT(mp)) {
+            if (IS_YOUNG(mp) && HAS_MANAGER(mp)) {
+                mgr = GET_MANAGER(mp);
+                CHECK(mp);
+                BREAKPOINT(mp);
+                if (mgr && VALID_BLK(mp)) {
+                    (mgr)(GET_PTR(mp), MPR_MANAGE_FREE);
+                }
+            }
+        }
+    }
+    freed = 0;
+    prior = NULL;
+    for (region = heap->regions; region; region = nextRegion) {
+        nextRegion = region->next;
+        if (region->partition != pp) {
+            prior = region;
+            continue;
+        }
+        for (mp = region->start; mp; mp = next) {
+            if (IS_YOUNG(mp)) {
+                INC(swept);
+                freed += GET_SIZE(mp);
+                first = GET_PRIOR(mp) ? GET_PRIOR(mp) : mp;
+                next = freeBlock(&pp->queues, mp);
+            } else {
+                first = mp;
+                next = GET_NEXT(mp);
+            }
+            if (region->starts) {
+                setStarts(region, first, mp, next);
+            }
+        }
+        if (region->freeable) {
+            freeRegion(region, prior);
+        } else {
+            prior = region;
+        }
+    }
+    heap->stats.totalFreed += freed;
+    pp->live = pp->bytes - pp->queues.bytesFree;
+    setPartitionTarget(pp);
+}
+
+
+/*
+    Set the partition size that will trigger a partition collection when the partition must grow
+ */
+static void setPartitionTarget(MprPartition *pp)
+{
+    ssize   growth;
+
+    growth = heap->gcGrowth ? max((ssize) heap->chunkSize, pp->live / 100 * heap->gcGrowth) : 0;
+    pp->growTarget = pp->bytes + growth;
+}
+
+
+/*
+    Merge destroyed partitions into the shared heap. Requested partition collections are done by the full collection.
+    Called by the marker while other threads are paused.
+ */
+static void mergePartitions()
+{
+    MprThreadService    *ts;
+    MprThread           *tp;
+    MprPartition        *pp, **prior;
+    MprRegion           *region;
+    MprAllocCache       *cache;
+    MprFreeMem          *freeq, *fp;
+    int                 i, released;
+
+    ts = MPR->threadService;
+    lock(ts->threads);
+    lockHeap();
+    heap->partitionRequested = 0;
+    for (prior = &heap->partitions; (pp = *prior) != 0; ) {
+        pp->gcRequested = 0;
+        if (!pp->destroyed) {
+            prior = &pp->next;
+            continue;
+        }
+        *prior = pp->next;
+        for (region = heap->regions; region; region = region->next) {
+            if (region->partition == pp) {
+                region->partition = 0;
+            }
+        }
+        for (freeq = pp->queues.freeq; freeq != pp->queues.freeEnd; freeq++) {
+            while ((fp = freeq->next) != freeq) {
+                released = fp->released;
+                unlinkBlock(&pp->queues, fp);
+                linkBlock(&heap->queues, (MprMem*) fp);
+                fp->released = released;
+            }
+        }
+        for (cache = heap->caches; cache; cache = cache->next) {
+            if (cache->partition == pp) {
+                cache->partition = 0;
+            }
+        }
+        for (i = 0; i < ts->threads->length; i++) {
+            tp = (MprThread*) mprGetItem(ts->threads, i);
+            if (tp->partition == pp) {
+                tp->partition = 0;
             }
-#endif
-            (GET_MANAGER(mp))((void*) ptr, MPR_MANAGE_MARK);
-#if BIT_DEBUG
-            --depth;
-#endif
         }
+        pp->next = heap->spare;
+        heap->spare = pp;
+        heap->stats.partitions--;
     }
+    unlockHeap();
+    unlock(ts->threads);
 }
+#endif /* BIT_MPR_PARTITION */
 
 
 /*
@@ -1445,18 +3777,52 @@ static void marker(void *unused, MprThread *tp)
     tp->yielded = 1;
 
     while (!mprIsFinished()) {
-        if (!heap->mustYield) {
+        if (!heap->mustYield && !heap->partitionRequested) {
             mprWaitForCond(heap->markerCond, -1);
             if (mprIsFinished()) {
                 break;
             }
         }
+#if BIT_MPR_PARTITION
+        if (!heap->mustYield && heap->partitionRequested) {
+            MPR_MEASURE(7, "GC", "partitions", collectPartitions());
+            continue;
+        }
+#endif
         MPR_MEASURE(7, "GC", "mark", mark());
     }
     heap->mustYield = 0;
 }
 
 
+/*
+    Helper marking thread main program. Each collection, helpers steal blocks to mark from the marker thread.
+ */
+static void markHelper(void *unused, MprThread *tp)
+{
+    MprMarkStack    *ms;
+
+    mprTrace(5, "DEBUG: marker helper thread started");
+    tp->stickyYield = 1;
+    tp->yielded = 1;
+    for (ms = &heap->markStacks[1]; ms->thread != tp; ms++) ;
+    mprSetThreadData(heap->markKey, ms);
+
+    while (!mprIsFinished()) {
+        mprWaitForCond(ms->cond, -1);
+        if (ms->cycle == heap->markCycle) {
+            continue;
+        }
+        ms->cycle = heap->markCycle;
+        mprAtomicAdd(&heap->markJoined, 1);
+        if (awaitMarks(ms)) {
+            markParallel(ms);
+        }
+        mprAtomicAdd(&heap->markJoined, -1);
+    }
+}
+
+
 #if KEEP
 /*
     Sweeper thread main program. May be called from the marker thread.
@@ -1467,7 +3833,7 @@ static void sweeper(void *unused, MprThread *tp)
 
     heap->sweeper = 1;
     while (!mprIsStoppingCore()) {
-        MPR_MEASURE(7, "GC", "sweep", sweep());
+        MPR_MEASURE(7, "GC", "sweep", sweep(0));
         mprYield(MPR_YIELD_BLOCK);
     }
     heap->sweeper = 0;
@@ -1475,6 +3841,20 @@ static void sweeper(void *unused, MprThread *tp)
 #endif
 
 
+/*
+    Test if a thread takes part in the current collection. Partition collections only pause threads bound to the
+    partition and threads not bound to any partition.
+ */
+static MPR_INLINE int inCollection(MprThread *tp)
+{
+#if BIT_MPR_PARTITION
+    return !heap->partition || !tp->partition || tp->partition == heap->partition;
+#else
+    return 1;
+#endif
+}
+
+
 /*
     Called by user code to signify the thread is ready for GC and all object references are saved. 
     If the GC marker is synchronizing, this call will block at the GC sync point (should be brief).
@@ -1499,7 +3879,7 @@ PUBLIC void mprYield(int flags)
         tp->stickyYield = 1;
     }
     //  MOB - remove heap->marker
-    while (tp->yielded && (heap->mustYield || (flags & MPR_YIELD_BLOCK)) && heap->marker) {
+    while (tp->yielded && ((heap->mustYield && inCollection(tp)) || (flags & MPR_YIELD_BLOCK)) && heap->marker) {
         if (heap->flags & MPR_MARK_THREAD) {
             mprSignalCond(ts->cond);
         }
@@ -1512,7 +3892,7 @@ PUBLIC void mprYield(int flags)
     if (!tp->stickyYield) {
         tp->yielded = 0;
     }
-    assert(!heap->marking);
+    assert(!heap->marking || !inCollection(tp));
 }
 
 
@@ -1573,7 +3953,7 @@ static int pauseThreads()
             allYielded = 1;
             for (i = 0; i < ts->threads->length; i++) {
                 tp = (MprThread*) mprGetItem(ts->threads, i);
-                if (!tp->yielded) {
+                if (!tp->yielded && inCollection(tp)) {
                     allYielded = 0;
                     if (mprGetElapsedTicks(mark) > 1000) {
                         mprTrace(7, "Thread %s is not yielding", tp->name);
@@ -1648,7 +4028,7 @@ PUBLIC void mprVerifyMem()
             CHECK(mp);
         }
     }
-    for (i = 0, freeq = heap->freeq; freeq != heap->freeEnd; freeq++, i++) {
+    for (i = 0, freeq = heap->queues.freeq; freeq != heap->queues.freeEnd; freeq++, i++) {
         for (fp = freeq->next; fp != freeq; fp = fp->next) {
             mp = (MprMem*) fp;
             CHECK(mp);
@@ -1763,20 +4143,168 @@ PUBLIC void mprAddRoot(void *root)
 }
 
 
-PUBLIC void mprRemoveRoot(void *root)
+PUBLIC void mprRemoveRoot(void *root)
+{
+    ssize   index;
+
+    mprSpinLock(&heap->rootLock);
+    index = mprRemoveItem(heap->roots, root);
+    /*
+        RemoveItem copies down. If the item was equal or before the current marker root, must adjust the marker rootIndex
+        so we don't skip a root. (OPT but only if doing parallel GC)
+     */
+    if (index <= heap->rootIndex && heap->rootIndex > 0) {
+        heap->rootIndex--;
+    }
+    mprSpinUnlock(&heap->rootLock);
+}
+
+
+PUBLIC void mprRemember(void *ptr)
+{
+    if (ptr && mprLookupItem(heap->remembered, ptr) < 0) {
+        mprAddItem(heap->remembered, ptr);
+    }
+}
+
+
+PUBLIC void mprForget(void *ptr)
+{
+    if (ptr) {
+        mprRemoveItem(heap->remembered, ptr);
+    }
+}
+
+
+PUBLIC MprPartition *mprCreatePartition()
+{
+#if BIT_MPR_PARTITION
+    MprPartition    *pp;
+
+    lockHeap();
+    if ((pp = heap->spare) != 0) {
+        heap->spare = pp->next;
+    }
+    unlockHeap();
+    if (pp == 0 && (pp = malloc(sizeof(MprPartition))) == 0) {
+        return 0;
+    }
+    memset(pp, 0, sizeof(MprPartition));
+    initFree(&pp->queues);
+    setPartitionTarget(pp);
+    lockHeap();
+    pp->next = heap->partitions;
+    heap->partitions = pp;
+    heap->stats.partitions++;
+    unlockHeap();
+    return pp;
+#else
+    return 0;
+#endif
+}
+
+
+PUBLIC void mprDestroyPartition(MprPartition *pp)
+{
+    if (pp) {
+        pp->destroyed = 1;
+    }
+}
+
+
+PUBLIC MprPartition *mprGetThreadPartition()
+{
+#if BIT_MPR_PARTITION
+    MprAllocCache   *cache;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) != 0) {
+        return cache->partition;
+    }
+#endif
+    return 0;
+}
+
+
+PUBLIC MprPartition *mprSetThreadPartition(MprPartition *pp)
+{
+#if BIT_MPR_PARTITION
+    MprThreadService    *ts;
+    MprAllocCache       *cache;
+    MprPartition        *prior;
+    MprThread           *tp;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) == 0) {
+        if (pp == 0 || (cache = createCache()) == 0) {
+            return 0;
+        }
+    }
+    prior = cache->partition;
+    if (pp == prior || (tp = mprGetCurrentThread()) == 0) {
+        return prior;
+    }
+    ts = MPR->threadService;
+    lock(ts->threads);
+    tp->partition = pp;
+    cache->partition = pp;
+    unlock(ts->threads);
+    if (heap->mustYield && heap->partition && inCollection(tp)) {
+        /* The partition is being collected */
+        mprYield(0);
+    }
+    return prior;
+#else
+    return 0;
+#endif
+}
+
+
+PUBLIC bool mprShareAlloc(bool shared)
+{
+#if BIT_MPR_PARTITION
+    MprAllocCache   *cache;
+    bool            prior;
+
+    if ((cache = pthread_getspecific(heap->cacheKey)) != 0) {
+        prior = cache->shared;
+        cache->shared = shared;
+        return prior;
+    }
+#endif
+    return 0;
+}
+
+
+/*
+    Remove unreachable blocks from the remembered list before they are freed. The list does not mark its blocks.
+ */
+static void forgetDead()
 {
-    ssize   index;
+    MprMem      *mp;
+    void        *ptr;
+    int         next;
 
-    mprSpinLock(&heap->rootLock);
-    index = mprRemoveItem(heap->roots, root);
-    /*
-        RemoveItem copies down. If the item was equal or before the current marker root, must adjust the marker rootIndex
-        so we don't skip a root. (OPT but only if doing parallel GC)
-     */
-    if (index <= heap->rootIndex && heap->rootIndex > 0) {
-        heap->rootIndex--;
+    for (ITERATE_ITEMS(heap->remembered, ptr, next)) {
+        mp = GET_MEM(ptr);
+        if (heap->minor ? IS_YOUNG(mp) : GET_GEN(mp) == heap->dead) {
+            mprRemoveItem(heap->remembered, ptr);
+            next--;
+        }
     }
-    mprSpinUnlock(&heap->rootLock);
+}
+
+
+/*
+    Return a time in microseconds for collector timing
+ */
+static uint64 getGCTicks()
+{
+#if BIT_UNIX_LIKE && defined(CLOCK_MONOTONIC)
+    struct timespec tv;
+    clock_gettime(CLOCK_MONOTONIC, &tv);
+    return ((uint64) tv.tv_sec) * 1000000 + (tv.tv_nsec / 1000);
+#else
+    return ((uint64) mprGetTicks()) * 1000;
+#endif
 }
 
 
@@ -1800,7 +4328,7 @@ static void printQueueStats()
     int         i;
 
     printf("\nFree Queue Stats\n Bucket                     Size   Count\n");
-    for (i = 0, freeq = heap->freeq; freeq != heap->freeEnd; freeq++, i++) {
+    for (i = 0, freeq = heap->queues.freeq; freeq != heap->queues.freeEnd; freeq++, i++) {
         if (freeq->info.stats.count) {
             printf("%7d %24d %7d\n", i, freeq->info.stats.minSize, freeq->info.stats.count);
         }
@@ -1864,6 +4392,8 @@ static void printGCStats()
     printf("\nRegion Stats\n");
     regionCount = 0;
     free = heap->eternal + 1;
+    /* Locked as the marker may be freeing regions */
+    lockHeap();
     for (region = heap->regions; region; region = region->next) {
         freeCount = allocatedCount = 0;
         for (mp = region->start; mp; mp = GET_NEXT(mp)) {
@@ -1883,6 +4413,7 @@ static void printGCStats()
         printf("  Region %3d is %8d bytes, has %4d allocated %3d free\n", regionCount, (int) region->size, 
             allocatedCount, freeCount);
     }
+    unlockHeap();
     printf("Regions: %d\n", regionCount);
 
     printf("\nGC Stats\n");
@@ -1908,12 +4439,34 @@ PUBLIC void mprPrintMem(cchar *msg, int detail)
     printf("  Total memory      %14d K\n",             (int) (mprGetMem() / 1024));
 
     printf("  Current heap      %14d K\n",             (int) (ap->bytesAllocated / 1024));
+    printf("  Committed heap    %14d K (%d K used)\n",  (int) (ap->bytesCommitted / 1024), 
+        (int) ((ap->bytesAllocated - ap->bytesFree) / 1024));
+    printf("  Released spans    %14d (huge pages %s)\n", (int) ap->releases, ap->hugePages ? "on" : "off");
     printf("  Free heap memory  %14d K\n",             (int) (ap->bytesFree / 1024));
+    printf("  Largest free block%14d K (%d %% fragmented)\n", (int) (ap->largestFree / 1024), 
+        ap->bytesFree ? 100 - percent(ap->largestFree, ap->bytesFree) : 0);
+    printf("  Total allocated   %14d K (%d K freed)\n", (int) (ap->totalAllocated / 1024), 
+        (int) (ap->totalFreed / 1024));
     printf("  Memory limit      %14d MB (%d %%)\n",    (int) (ap->maxMemory / (1024 * 1024)),
        percent(ap->bytesAllocated / 1024, ap->maxMemory / 1024));
     printf("  Memory redline    %14d MB (%d %%)\n",    (int) (ap->redLine / (1024 * 1024)),
        percent(ap->bytesAllocated / 1024, ap->redLine / 1024));
     printf("  Allocation errors %14d\n",               ap->errors);
+    printf("  Heap locks        %14d (%d %% waited)\n", (int) ap->heapLocks, 
+        percent(ap->heapLockWaits, max(ap->heapLocks, 1)));
+#if BIT_MPR_ALLOC_CACHE
+    printf("  Thread caches     %14d (%d K)\n",        ap->caches, (int) (ap->bytesCached / 1024));
+    printf("  Cache hits        %14d\n",              (int) ap->cacheHits);
+    printf("  Cache refills     %14d\n",              (int) ap->cacheRefills);
+#endif
+    printf("  Collections       %14d\n",              (int) ap->collections);
+    printf("  Live after GC     %14d K (%d %% growth)\n", (int) (ap->liveBytes / 1024), heap->gcGrowth);
+    printf("  Last GC pause     %14d usec (max %d usec)\n", (int) ap->lastPause, (int) ap->maxPause);
+    printf("  GC pause p50/p99  %14d usec (%d usec)\n", (int) mprGetGCPause(50), (int) mprGetGCPause(99));
+    printf("  GC pause target   %14d msec (%d deferred sweeps)\n", heap->pauseTarget, (int) ap->deferredSweeps);
+    printf("  Marking threads   %14d (%d steals)\n",  ap->markThreads, (int) ap->markSteals);
+    printf("  Minor collections %14d (%d K promoted)\n", (int) ap->minorCollections, (int) (ap->promoted / 1024));
+    printf("  Nursery           %14d K (%d written pages)\n", (int) (ap->nursery / 1024), (int) ap->writtenPages);
 
 #if BIT_MEMORY_STATS
     printf("  Memory requests   %14d\n",               (int) ap->requests);
@@ -2266,11 +4819,413 @@ PUBLIC MprMemStats *mprGetMemStats()
     sysctl(mib, 2, &usermem, &len, NULL, 0);
     heap->stats.user = usermem;
 #endif
+#if BIT_MPR_ALLOC_CACHE
+{
+    MprAllocCache   *cache;
+
+    lockHeap();
+    heap->stats.cacheHits = heap->retiredHits;
+    heap->stats.bytesCached = 0;
+    for (cache = heap->caches; cache; cache = cache->next) {
+        heap->stats.cacheHits += cache->hits;
+        heap->stats.bytesCached += cache->bytes;
+    }
+    unlockHeap();
+}
+#endif
+    heap->stats.totalAllocated = getAllocated();
+    heap->stats.largestFree = getLargestFree();
     heap->stats.rss = mprGetMem();
     return &heap->stats;
 }
 
 
+/*
+    Return the total bytes allocated. Thread caches count their own allocations to avoid sharing a counter.
+ */
+static uint64 getAllocated()
+{
+    uint64          allocated;
+#if BIT_MPR_ALLOC_CACHE
+    MprAllocCache   *cache;
+#endif
+
+    lockHeap();
+    allocated = heap->allocated;
+#if BIT_MPR_ALLOC_CACHE
+    for (cache = heap->caches; cache; cache = cache->next) {
+        allocated += cache->allocated;
+    }
+#endif
+    unlockHeap();
+    return allocated;
+}
+
+
+/*
+    Return the size of the largest free block. The group and bucket maps may have bits set for empty queues.
+ */
+static ssize getLargestFree()
+{
+    MprFreeMem  *freeq, *fp;
+    MprMem      *mp;
+    ssize       largest;
+    int         index;
+
+    largest = 0;
+    lockHeap();
+    for (index = MPR_ALLOC_NUM_GROUPS * MPR_ALLOC_NUM_BUCKETS - 1; index >= 0 && largest == 0; index--) {
+        freeq = &heap->queues.freeq[index];
+        for (fp = freeq->next; fp != freeq; fp = fp->next) {
+            mp = (MprMem*) fp;
+            largest = max(largest, GET_SIZE(mp));
+        }
+    }
+    unlockHeap();
+    return largest;
+}
+
+
+/*
+    Return the heap bytes backed by physical memory. Free spans returned to the O/S and untouched pages are excluded.
+    MUST only be called by the sweeper. Only the sweeper frees regions and growHeap adds regions to the front of the 
+    list, so the regions can be walked without locking the heap.
+ */
+static ssize getCommitted()
+{
+#if BIT_UNIX_LIKE && VALLOC
+    MprRegion   *region;
+    uchar       vec[512];
+    ssize       committed, offset, len;
+    int         i, pages;
+
+    committed = 0;
+    for (region = heap->regions; region; region = region->next) {
+        for (offset = 0; offset < region->size; offset += len) {
+            len = min(region->size - offset, (ssize) sizeof(vec) * memStats.pageSize);
+            pages = (int) (len / memStats.pageSize);
+            if (mincore((char*) region + offset, len, (void*) vec) < 0) {
+                committed += len;
+                continue;
+            }
+            for (i = 0; i < pages; i++) {
+                if (vec[i] & 0x1) {
+                    committed += memStats.pageSize;
+                }
+            }
+        }
+    }
+    return committed;
+#else
+    return heap->stats.bytesAllocated;
+#endif
+}
+
+
+PUBLIC void mprWalkMem(MprMemWalker fn, void *data)
+{
+    MprRegion   *region;
+    MprMem      *mp;
+
+    lockHeap();
+    for (region = heap->regions; region; region = region->next) {
+        for (mp = region->start; mp; mp = GET_NEXT(mp)) {
+            if (!IS_FREE(mp) && GET_GEN(mp) != heap->dead) {
+                (fn)(GET_PTR(mp), GET_SIZE(mp), HAS_MANAGER(mp) ? GET_MANAGER(mp) : NULL, data);
+            }
+        }
+    }
+    unlockHeap();
+}
+
+PUBLIC int mprWriteMemSnapshot(cchar *path, MprMemLabeler labeler, void *data)
+{
+    MprSnapshot     snapshot;
+
+    if (path == 0 || *path == '\0') {
+        return MPR_ERR_BAD_ARGS;
+    }
+    memset(&snapshot, 0, sizeof(MprSnapshot));
+    snapshot.path = path;
+    snapshot.labeler = labeler;
+    snapshot.data = data;
+    snapshot.status = MPR_ERR_CANT_COMPLETE;
+    if (!mprAtomicCas((void* volatile*) &heap->snapshot, NULL, &snapshot)) {
+        return MPR_ERR_BUSY;
+    }
+    /*
+        The marker writes the snapshot during the next collection. Yielding blocks until the collection completes.
+     */
+    do {
+        mprRequestGC(MPR_GC_FORCE);
+    } while (heap->snapshot == &snapshot && !mprIsFinished());
+    heap->snapshot = 0;
+    return snapshot.status;
+}
+
+
+static int snapLookup(MprSnapIndex *index, cvoid *key)
+{
+    uint    i;
+
+    if (index->size == 0) {
+        return -1;
+    }
+    for (i = SNAP_HASH(key, index->size); index->keys[i]; i = (i + 1) & (index->size - 1)) {
+        if (index->keys[i] == key) {
+            return index->values[i];
+        }
+    }
+    return -1;
+}
+
+
+static int snapInsert(MprSnapIndex *index, cvoid *key, int value)
+{
+    MprSnapIndex    old;
+    uint            i;
+    int             j;
+
+    if ((index->count + 1) * 2 > index->size) {
+        old = *index;
+        index->size = max(old.size * 2, 1024);
+        index->count = 0;
+        index->keys = calloc(index->size, sizeof(void*));
+        index->values = malloc(index->size * sizeof(int));
+        if (index->keys == 0 || index->values == 0) {
+            free(index->keys);
+            free(index->values);
+            *index = old;
+            return MPR_ERR_MEMORY;
+        }
+        for (j = 0; j < old.size; j++) {
+            if (old.keys[j]) {
+                snapInsert(index, old.keys[j], old.values[j]);
+            }
+        }
+        free(old.keys);
+        free(old.values);
+    }
+    for (i = SNAP_HASH(key, index->size); index->keys[i]; i = (i + 1) & (index->size - 1)) ;
+    index->keys[i] = key;
+    index->values[i] = value;
+    index->count++;
+    return 0;
+}
+
+
+/*
+    Grow a snapshot array to hold more than count elements
+ */
+static int snapGrow(void *arrayp, int *max, int count, ssize size)
+{
+    void    **array, *items;
+    int     len;
+
+    if (count < *max) {
+        return 0;
+    }
+    array = arrayp;
+    len = max(*max * 2, 1024);
+    if ((items = realloc(*array, len * size)) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    *array = items;
+    *max = len;
+    return 0;
+}
+
+
+static int snapAddNode(MprSnapshot *sp, cvoid *ptr)
+{
+    int     node, nodeMax;
+
+    node = sp->nodeCount;
+    nodeMax = sp->nodeMax;
+    /* The extra start entry terminates the references of the last node */
+    if (snapGrow(&sp->nodes, &sp->nodeMax, node + 1, sizeof(void*)) < 0 || 
+            snapGrow(&sp->starts, &nodeMax, node + 1, sizeof(int)) < 0) {
+        return MPR_ERR_MEMORY;
+    }
+    if (ptr && snapInsert(&sp->blocks, ptr, node) < 0) {
+        return MPR_ERR_MEMORY;
+    }
+    sp->nodes[node] = (void*) ptr;
+    sp->nodeCount++;
+    return node;
+}
+
+
+/*
+    Record a reference from the block being traced. Called from mprMarkBlock by block managers.
+ */
+static void traceRef(cvoid *ptr)
+{
+    MprSnapshot     *sp;
+    int             node;
+
+    sp = heap->snapshot;
+    if (sp->status < 0) {
+        return;
+    }
+    if ((node = snapLookup(&sp->blocks, ptr)) < 0 && (node = snapAddNode(sp, ptr)) < 0) {
+        sp->status = MPR_ERR_MEMORY;
+        return;
+    }
+    if (snapGrow(&sp->refs, &sp->refMax, sp->refCount, sizeof(int)) < 0) {
+        sp->status = MPR_ERR_MEMORY;
+        return;
+    }
+    sp->refs[sp->refCount++] = node;
+}
+
+
+static int snapAddLabel(MprSnapshot *sp, cchar *name)
+{
+    int     label;
+
+    if ((label = snapLookup(&sp->labelIndex, name)) >= 0) {
+        return label;
+    }
+    label = sp->labelCount;
+    if (snapGrow(&sp->labels, &sp->labelMax, label, sizeof(char*)) < 0 || 
+            snapInsert(&sp->labelIndex, name, label) < 0) {
+        return MPR_ERR_MEMORY;
+    }
+    sp->labels[sp->labelCount++] = name;
+    return label;
+}
+
+
+/*
+    Label a block by the labeler, then by allocation name, then by the name of its manager function
+ */
+static int snapLabel(MprSnapshot *sp, int node)
+{
+    MprMem      *mp;
+    MprManager  mgr;
+    void        *ptr;
+    cchar       *name;
+    int         label;
+
+    if ((ptr = sp->nodes[node]) == 0) {
+        return snapAddLabel(sp, "[roots]");
+    }
+    mp = GET_MEM(ptr);
+    mgr = HAS_MANAGER(mp) ? GET_MANAGER(mp) : 0;
+    name = sp->labeler ? (sp->labeler)(ptr, mgr, sp->data) : 0;
+#if BIT_MEMORY_DEBUG
+    if (name == 0) {
+        name = mp->name;
+    }
+#endif
+    if (name == 0 && mgr) {
+        if ((label = snapLookup(&sp->managers, mgr)) < 0) {
+            if ((name = mprGetNativeSymbol(mgr)) == 0) {
+                name = "[managed]";
+            }
+            if ((label = snapAddLabel(sp, name)) >= 0 && snapInsert(&sp->managers, mgr, label) < 0) {
+                return MPR_ERR_MEMORY;
+            }
+        }
+        return label;
+    }
+    return snapAddLabel(sp, name ? name : "[memory]");
+}
+
+
+/*
+    Write the traced graph. Uses stdio as the heap must not be modified while threads are paused.
+ */
+static int saveSnapshot(MprSnapshot *sp)
+{
+    FILE        *fp;
+    int         *labels;
+    int         node, i, rc;
+
+    if ((labels = malloc(sp->nodeCount * sizeof(int))) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    for (node = 0; node < sp->nodeCount; node++) {
+        if ((labels[node] = snapLabel(sp, node)) < 0) {
+            free(labels);
+            return MPR_ERR_MEMORY;
+        }
+    }
+    if ((fp = fopen(sp->path, "w")) == 0) {
+        free(labels);
+        return MPR_ERR_CANT_OPEN;
+    }
+    rc = fprintf(fp, "mpr-snapshot 1 %d %d %d\n", sp->nodeCount, sp->refCount, sp->labelCount);
+    for (i = 0; i < sp->labelCount && rc >= 0; i++) {
+        rc = fprintf(fp, "L %s\n", sp->labels[i]);
+    }
+    for (node = 0; node < sp->nodeCount && rc >= 0; node++) {
+        rc = fprintf(fp, "N %ld %d %d", node ? (long) GET_SIZE(GET_MEM(sp->nodes[node])) : 0L, labels[node], 
+            sp->starts[node + 1] - sp->starts[node]);
+        for (i = sp->starts[node]; i < sp->starts[node + 1] && rc >= 0; i++) {
+            rc = fprintf(fp, " %d", sp->refs[i]);
+        }
+        if (rc >= 0) {
+            rc = fputc('\n', fp);
+        }
+    }
+    free(labels);
+    if (fclose(fp) != 0 || rc < 0) {
+        return MPR_ERR_CANT_WRITE;
+    }
+    return 0;
+}
+
+
+/*
+    Trace the reachable heap breadth first from the roots. Block managers are run as for marking, but mprMarkBlock 
+    reports each reference to traceRef rather than marking the block.
+ */
+static void writeSnapshot(MprSnapshot *sp)
+{
+    MprMem      *mp;
+    void        *root, *ptr;
+    int         node;
+
+    sp->status = 0;
+    if (snapAddNode(sp, NULL) < 0) {
+        sp->status = MPR_ERR_MEMORY;
+    } else {
+        sp->starts[0] = 0;
+        heap->tracing = 1;
+        heap->rootIndex = 0;
+        while ((root = getNextRoot()) != 0) {
+            mprMarkBlock(root);
+        }
+        heap->rootIndex = -1;
+        for (node = 1; node < sp->nodeCount && sp->status == 0; node++) {
+            sp->starts[node] = sp->refCount;
+            ptr = sp->nodes[node];
+            mp = GET_MEM(ptr);
+            if (HAS_MANAGER(mp)) {
+                (GET_MANAGER(mp))(ptr, MPR_MANAGE_MARK);
+            }
+        }
+        sp->starts[sp->nodeCount] = sp->refCount;
+        heap->tracing = 0;
+        if (sp->status == 0) {
+            sp->status = saveSnapshot(sp);
+        }
+    }
+    free(sp->nodes);
+    free(sp->starts);
+    free(sp->refs);
+    free(sp->labels);
+    free((void*) sp->blocks.keys);
+    free(sp->blocks.values);
+    free((void*) sp->labelIndex.keys);
+    free(sp->labelIndex.values);
+    free((void*) sp->managers.keys);
+    free(sp->managers.values);
+}
+
+
 /*
     Return the amount of memory currently in use. This routine may open files and thus is not very quick on some 
     platforms. On FREEBDS it returns the peak resident set size using getrusage. If a suitable O/S API is not available,
@@ -2580,7 +5535,7 @@ static void checkYielded()
     lock(ts->threads);
     for (i = 0; i < ts->threads->length; i++) {
         tp = (MprThread*) mprGetItem(ts->threads, i);
-        assert(tp->yielded);
+        assert(tp->yielded || !inCollection(tp));
     }
     unlock(ts->threads);
 #endif
@@ -8837,12 +11792,17 @@ static int dispatchEvents(MprDispatcher *dispatcher)
 {
     MprEventService     *es;
     MprEvent            *event;
+    MprPartition        *partition;
     int                 count;
 
     assert(dispatcher->cond);
     assert(!(dispatcher->flags & MPR_DISPATCHER_DESTROYED));
 
     es = dispatcher->service;
+    /*
+        Events run bound to the heap partition of the dispatcher. Dispatchers without a partition run events unbound.
+     */
+    partition = mprSetThreadPartition(dispatcher->partition);
     /*
         OPT - mprGetNextEvent locks anyway, so should be able to get away without a lock here
      */
@@ -8882,6 +11842,7 @@ static int dispatchEvents(MprDispatcher *dispatcher)
         }
     }
     unlock(es);
+    mprSetThreadPartition(partition);
     if (count && es->waiting) {
         es->eventCount += count;
         mprWakeNotifier();
@@ -9925,13 +12886,24 @@ PUBLIC MprEvent *mprCreateEventQueue()
 PUBLIC MprEvent *mprCreateEvent(MprDispatcher *dispatcher, cchar *name, MprTicks period, void *proc, void *data, int flags)
 {
     MprEvent    *event;
+    bool        shared;
 
-    if ((event = mprAllocObj(MprEvent, manageEvent)) == 0) {
-        return 0;
-    }
     if (dispatcher == 0) {
         dispatcher = (flags & MPR_EVENT_QUICK) ? MPR->nonBlock : MPR->dispatcher;
     }
+    /*
+        Events are linked into the dispatcher queues. Events for dispatchers of other heap partitions are shared.
+     */
+    if (dispatcher && dispatcher->partition != mprGetThreadPartition()) {
+        shared = mprShareAlloc(1);
+        event = mprAllocObj(MprEvent, manageEvent);
+        mprShareAlloc(shared);
+    } else {
+        event = mprAllocObj(MprEvent, manageEvent);
+    }
+    if (event == 0) {
+        return 0;
+    }
     initEvent(dispatcher, event, name, period, proc, data, flags);
     if (!(flags & MPR_EVENT_DONT_QUEUE)) {
         mprQueueEvent(dispatcher, event);
@@ -10656,15 +13628,26 @@ PUBLIC ssize mprReadFile(MprFile *file, void *buf, ssize size)
 PUBLIC MprOff mprSeekFile(MprFile *file, int seekType, MprOff pos)
 {
     MprFileSystem   *fs;
+    MprOff          skip;
 
     assert(file);
     fs = file->fileSystem;
 
     if (file->buf) {
         if (! (seekType == SEEK_CUR && pos == 0)) {
+            if (!(file->mode & (O_WRONLY | O_RDWR)) && seekType != SEEK_END) {
+                /*
+                    Skip forward within the read buffer without discarding it
+                 */
+                skip = (seekType == SEEK_SET) ? (pos - file->pos) : pos;
+                if (0 <= skip && skip <= mprGetBufLength(file->buf)) {
+                    mprAdjustBufStart(file->buf, (ssize) skip);
+                    file->pos += skip;
+                    return file->pos;
+                }
+            }
             /*
                 Discard buffering as we may be seeking outside the buffer.
-                OPT. Could be smarter about this and preserve the buffer.
              */
             if (file->mode & (O_WRONLY | O_RDWR)) {
                 if (mprFlushFile(file) < 0) {
@@ -14938,6 +17921,19 @@ PUBLIC MprModule *mprLookupModule(cchar *name)
 }
 
 
+PUBLIC cchar *mprGetNativeSymbol(cvoid *addr)
+{
+#if BIT_UNIX_LIKE && BIT_HAS_DYN_LOAD
+    Dl_info     info;
+
+    if (addr && dladdr((void*) addr, &info) && info.dli_sname) {
+        return info.dli_sname;
+    }
+#endif
+    return 0;
+}
+
+
 PUBLIC void *mprLookupModuleData(cchar *name)
 {
     MprModule   *module;
@@ -17614,6 +20610,7 @@ typedef struct MprEjsString {
     void            *next;
     void            *prev;
     ssize           length;
+    uint            hash;
     wchar         value[0];
 } MprEjsString;
 
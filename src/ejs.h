@@ -37,11 +37,26 @@ extern "C" {
  */
 #define EJS_LOTSA_PROP              256             /**< Object with lots of properties. Grow by bigger chunks */
 #define EJS_MIN_FRAME_SLOTS         16              /**< Miniumum number of slots for function frames */
+#define EJS_FRAME_CLASSES           3               /**< Frame pool size classes (16, 32 and 64 slots) */
+#define EJS_FRAME_POOL_MAX          32              /**< Max free frames retained per size class */
 #define EJS_NUM_GLOBAL              256             /**< Number of globals slots to pre-create */
+#define EJS_NUMBER_CACHE_MIN        -256            /**< Lowest integer in the shared number cache */
+#define EJS_NUMBER_CACHE_MAX        4096            /**< Integers below this are in the shared number cache */
 #define EJS_ROUND_PROP              16              /**< Rounding for growing properties */
+#define EJS_REGEXP_CACHE_MAX        256             /**< Max compiled regular expressions in the shared cache */
+#define EJS_QUICKEN_THRESHOLD       100             /**< Calls and loop iterations before op codes are specialized */
+#define EJS_QUICKEN_MAX_DEOPT       16              /**< Max sites reverted before a function stops specializing */
+#ifndef EJS_JIT
+    #define EJS_JIT                 (BIT_CPU_ARCH == BIT_CPU_X64 && LINUX) /**< Compile hot functions to native code */
+#endif
 
 #define EJS_HASH_MIN_PROP           8               /**< Min props to hash */
+#define EJS_SHAPE_MAX_PROP          64              /**< Max properties in a shaped object before using a dictionary */
+#define EJS_SHAPE_MAX_TRANSITIONS   64              /**< Max transitions from one shape */
+#define EJS_SHAPE_MAX               1024            /**< Max shapes per type */
 #define EJS_MAX_COLLISIONS          4               /**< Max intern string collion chain before rehash */
+#define EJS_INTERN_SHARDS           16              /**< Intern table shards. Must be a power of 2 */
+#define EJS_INTERN_MIGRATE          8               /**< Intern buckets migrated per access while growing a shard */
 #define EJS_POOL_INACTIVITY_TIMEOUT (60  * 1000)    /**< Prune inactive pooled VMs older than this */
 #define EJS_SESSION_TIMER_PERIOD    (60 * 1000)     /**< Timer checks ever minute */
 #define EJS_FILE_PERMS              0664            /**< Default file perms */
@@ -460,6 +475,12 @@ typedef struct Ejs {
     int                 serializeDepth;     /**< Serialization depth */
     int                 spreadArgs;         /**< Count of spread args */
     int                 gc;                 /**< GC required (don't make bit field) */
+    uint64              cacheHits;          /**< Inline property cache hits */
+    uint64              cacheMisses;        /**< Inline property cache misses */
+    struct EjsAllocProfile *allocProfile;   /**< Sampled allocations by script stack */
+    void                *allocSample;       /**< Sampled allocation awaiting its type (not marked) */
+    struct EjsFrame     *frames[EJS_FRAME_CLASSES]; /**< Free function frames by size class */
+    int                 numFrames[EJS_FRAME_CLASSES];   /**< Count of free frames in each class */
     uint                abandoned: 1;       /**< Pooled VM is released awaiting GC  */
     uint                hosted: 1;          /**< Interp is hosted (webserver) */
     uint                configSet: 1;       /**< Config properties defined */
@@ -473,6 +494,7 @@ typedef struct Ejs {
 
     EjsAny              *exceptionArg;      /**< Exception object for catch block */
     MprDispatcher       *dispatcher;        /**< Event dispatcher */
+    MprPartition        *partition;         /**< Heap partition for the interpreter (not alloced) */
     MprList             *workers;           /**< Worker interpreters */
     MprList             *modules;           /**< Loaded modules */
     MprList             *httpServers;       /**< Configured HttpServers */
@@ -588,6 +610,7 @@ PUBLIC EjsPool *ejsCreatePool(int poolMax, cchar *templateScript, cchar *startSc
 
 /**
     Allocate a VM from the pool
+    @description The calling thread is bound to the heap partition of the VM until the VM is freed via #ejsFreePoolVM.
     @param pool EjsPool reference
     @param flags Reserved
     @returns Returns an Ejs VM instance
@@ -948,6 +971,37 @@ typedef struct EjsProperties {
 } EjsProperties;
 
 
+/**
+    Object shape
+    @description Shapes describe the property layout of dynamic objects. Objects that add the same properties in the same 
+        order share one shape that holds the property names, traits and name hash. The objects themselves only store
+        property values. Shapes form a transition tree rooted at the type. Each transition adds one property.
+        Shapes are shared across interpreters and are immutable once published.
+    @ingroup EjsPot
+    @stability Internal
+ */
+typedef struct EjsShape {
+    struct EjsShape *parent;                /**< Shape before the last property was added */
+    struct EjsShape *children;              /**< Transitions from this shape */
+    struct EjsShape *sibling;               /**< Next transition from the parent shape */
+    struct EjsPot   *layout;                /**< Property names, traits and hash. Values are not used */
+    EjsName         qname;                  /**< Name of the last property added */
+    EjsTrait        trait;                  /**< Traits of the last property added */
+    int             numChildren;            /**< Number of transitions from this shape */
+    int             numShapes;              /**< Number of shapes in the tree (root shape only) */
+} EjsShape;
+
+/**
+    Shaped object property values
+    @ingroup EjsPot
+    @stability Internal
+ */
+typedef struct EjsValues {
+    EjsShape        *shape;                 /**< Object shape describing the values */
+    int             size;                   /**< Current size of values[] in elements */
+    EjsAny          *values[ARRAY_FLEX];    /**< Property values */
+} EjsValues;
+
 /** 
     Object with properties Type. Base object for generic objects with properties.
     @description The EjsPot type is the foundation for types, blocks, functions and scripted classes. 
@@ -960,6 +1014,10 @@ typedef struct EjsProperties {
         EjsPot stores properties in an array of slots. These slots store the property name and a reference to the 
         property value.  Dynamic objects own their own name hash. Sealed object instances of a type, will refer to the 
         hash of names owned by the type.
+        \n\n
+        Plain dynamic objects start out "shaped". Their properties field refers to an EjsValues block and the names 
+        and traits are held by a shared EjsShape. Shaped objects revert to a dictionary with their own slots if
+        properties are deleted, renamed, inserted or reordered, or if too many shapes are created.
     @defgroup EjsPot EjsPot
     @see EjsPot ejsAlloc ejsBlendObject ejsCast ejsCheckSlot ejsClone ejsCloneObject ejsClonePot ejsCoerceOperands 
         ejsCompactPot ejsCopySlots ejsCreateEmptyPot ejsCreateInstance ejsCreateObject ejsCreatePot 
@@ -980,8 +1038,10 @@ typedef struct EjsPot {
     uint    separateHash    : 1;                /**< Object has separate hash memory */
     uint    separateSlots   : 1;                /**< Object has separate slots[] memory */
     uint    shortScope      : 1;                /**< Don't follow type or base classes */
+    uint    dupNames        : 1;                /**< Object has properties of the same name in different namespaces */
+    uint    shaped          : 1;                /**< Properties are values described by a shared EjsShape */
 
-    EjsProperties   *properties;                /** Object properties */
+    EjsProperties   *properties;                /** Object properties (EjsValues if shaped) */
     //  TODO - OPT - merge numProp with bits above (24 bits)
     int             numProp;                    /** Number of properties */
 } EjsPot;
@@ -1035,6 +1095,27 @@ PUBLIC EjsAny *ejsCreatePot(Ejs *ejs, struct EjsType *type, int size);
  */
 PUBLIC int ejsCompactPot(Ejs *ejs, EjsPot *obj);
 
+/**
+    Convert a shaped object to a dictionary
+    @description Shaped objects share their property names and traits with other objects of the same shape. This 
+        gives the object its own property slots so the property names and order can be modified directly.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param obj Object to convert
+    @returns Zero if successful, otherwise a negative MPR error code.
+    @ingroup EjsPot
+    @internal
+ */
+PUBLIC int ejsMakeDictionary(Ejs *ejs, EjsPot *obj);
+
+/**
+    Get the shape of an object
+    @param obj Object to examine
+    @returns The object shape if the object is shaped and has properties. Otherwise null.
+    @ingroup EjsPot
+    @internal
+ */
+#define ejsGetShape(obj) (((obj)->shaped && (obj)->properties) ? ((EjsValues*) (obj)->properties)->shape : NULL)
+
 /**
     Insert properties
     @description Insert properties at the given offset
@@ -1276,13 +1357,13 @@ PUBLIC bool ejsMatchName(Ejs *ejs, EjsName *a, EjsName *b);
     Strings are currently sequences of Unicode characters. Depending on the configuration, they may be 8, 16 or 32 bit
     code point values.
     @defgroup EjsString EjsString
-    @see EjsString ejsAtoi ejsCompareAsc ejsCompareString ejsCompareSubstring ejsCompareWide ejsContainsAsc 
-        ejsContainsChar ejsContainsString ejsCreateBareString ejsCreateString ejsCreateStringFromAsc 
-        ejsCreateStringFromBytes ejsCreateStringFromConst ejsCreateStringFromMulti ejsCreateStringWithLength 
-        ejsDestroyIntern ejsInternAsc ejsInternMulti ejsInternString ejsInternWide ejsJoinString 
-        ejsJoinStrings ejsSerialize ejsSerializeWithOptions ejsSprintf ejsStartsWithAsc ejsStrcat ejsStrdup 
-        ejsSubstring ejsToJSON ejsToLiteralString ejsToMulti ejsToString ejsToUpper ejsTruncateString ejsVarToString 
-        ejsToLower 
+    @see EjsString ejsAppendString ejsAtoi ejsCompareAsc ejsCompareString ejsCompareSubstring ejsCompareWide
+        ejsContainsAsc ejsContainsChar ejsContainsString ejsCreateBareString ejsCreateNonInternedString
+        ejsCreateString ejsCreateStringFromAsc ejsCreateStringFromBytes ejsCreateStringFromConst
+        ejsCreateStringFromMulti ejsCreateStringWithLength ejsDestroyIntern ejsInternAsc ejsInternMulti ejsInternName
+        ejsInternString ejsInternWide ejsIsInterned ejsJoinString ejsJoinStrings ejsMatchString ejsSerialize
+        ejsSerializeWithOptions ejsSprintf ejsStartsWithAsc ejsStrcat ejsStrdup ejsSubstring ejsToJSON
+        ejsToLiteralString ejsToMulti ejsToString ejsToUpper ejsTruncateString ejsVarToString ejsToLower 
     @stability Internal.
  */
 typedef struct EjsString {
@@ -1291,6 +1372,7 @@ typedef struct EjsString {
     struct EjsString *next;             /**< Next string in hash chain link when interning */
     struct EjsString *prev;             /**< Prev string in hash chain */
     ssize            length;            /**< Length of string */
+    uint             hash;              /**< Hash of the value. Computed on first use */
     wchar            value[ARRAY_FLEX]; /**< String value */
 } EjsString;
 
@@ -1328,8 +1410,9 @@ PUBLIC EjsString *ejsCreateStringFromAsc(Ejs *ejs, cchar *value);
     Create a string from an ascii block
     @param ejs Ejs reference returned from #ejsCreateVM
     @param value UTF-8 multibyte string value to intern
+    @description The string is not interned. Use this for bulk data that is not likely to be used as a property name.
     @param len Length of the string in bytes
-    @returns Allocated string. These are references into the interned string pool.
+    @returns Allocated string.
     @ingroup EjsString
  */
 PUBLIC EjsString *ejsCreateStringFromBytes(Ejs *ejs, cchar *value, ssize len);
@@ -1344,9 +1427,20 @@ PUBLIC EjsString *ejsCreateStringFromBytes(Ejs *ejs, cchar *value, ssize len);
  */
 PUBLIC EjsString *ejsCreateStringFromMulti(Ejs *ejs, cchar *value, ssize len);
 
+/** 
+    Create a string that is not interned
+    @description Strings are interned on demand when used as property names. See #ejsInternName.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param value String value
+    @param len Length of value in characters
+    @return A string object
+    @ingroup EjsString
+ */
+PUBLIC EjsString *ejsCreateNonInternedString(Ejs *ejs, wchar *value, ssize len);
+
 /** 
     Create an empty string object. This creates an uninitialized string object of the requrired size. Once initialized,
-        the string must be "interned" via $ejsInternString.
+        the string may be "interned" via $ejsInternString.
     @param ejs Ejs reference returned from #ejsCreateVM
     @param len Length of space to reserve for future string data
     @return A string object
@@ -1365,6 +1459,50 @@ PUBLIC EjsString *ejsCreateBareString(Ejs *ejs, ssize len);
  */
 PUBLIC EjsString *ejsInternString(EjsString *sp);
 
+/** 
+    Test if a string is interned
+    @param sp String object
+    @return True if the string is in the intern pool
+    @ingroup EjsString
+ */
+#define ejsIsInterned(sp) ((sp)->next != 0)
+
+/** 
+    Intern a qualified name
+    @description Strings are not interned when created by string operations. Names must be interned before defining
+        or looking up properties so they can be compared by reference. The property helper routines do this.
+    @param qname Qualified name. The name and space are updated to refer to the interned strings.
+    @ingroup EjsString
+ */
+PUBLIC void ejsInternName(EjsName *qname);
+
+/** 
+    Test if two strings have the same value
+    @param s1 First string
+    @param s2 Second string
+    @return True if the strings have the same value
+    @ingroup EjsString
+ */
+PUBLIC bool ejsMatchString(EjsString *s1, EjsString *s2);
+
+/** 
+    Compute and cache the hash of a string value
+    @description Use #ejsGetStringHash to get the cached hash. Strings must not be hashed before their value is
+        complete (see ejsCreateBareString).
+    @param sp String object
+    @return The hash of the string value
+    @ingroup EjsString
+ */
+PUBLIC uint ejsHashString(EjsString *sp);
+
+/** 
+    Get the hash of a string value. The hash is computed once and cached in the string.
+    @param sp String object
+    @return The hash of the string value
+    @ingroup EjsString
+ */
+#define ejsGetStringHash(sp) ((sp)->hash ? (sp)->hash : ejsHashString(sp))
+
 /** 
     Intern a string object from a UTF-8 string. 
     @description A string is created using the UTF-8 string as input. 
@@ -1405,6 +1543,14 @@ PUBLIC EjsString *ejsInternWide(struct Ejs *ejs, wchar *value, ssize len);
  */
 PUBLIC void ejsDestroyIntern(struct EjsIntern *intern);
 
+/** 
+    Print intern string cache statistics
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @ingroup EjsString
+    @internal
+ */
+PUBLIC void ejsShowInternStats(struct Ejs *ejs);
+
 /** 
     Parse a string and convert to an integer
     @param ejs Ejs reference returned from #ejsCreateVM
@@ -1415,8 +1561,22 @@ PUBLIC void ejsDestroyIntern(struct EjsIntern *intern);
  */
 PUBLIC int ejsAtoi(Ejs *ejs, EjsString *sp, int radix);
 
+/** 
+    Append a string to a string builder
+    @description String builders are bare strings with spare room that are open for appending. They are created
+        for the left operand of chained additions (a + b + c) and are only referenced from the interpreter stack.
+        If dest is not a builder, a new builder is created containing dest. Builders are closed by #ejsJoinString.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param dest String builder or string to append to
+    @param src String to append
+    @return A string builder representing the joined strings
+    @ingroup EjsString
+ */
+PUBLIC EjsString *ejsAppendString(Ejs *ejs, EjsString *dest, EjsString *src);
+
 /** 
     Join two strings
+    @description If s1 is a string builder created by #ejsAppendString, s2 is appended to it in place.
     @param ejs Ejs reference returned from #ejsCreateVM
     @param s1 First string to join
     @param s2 Second string to join
@@ -2021,6 +2181,7 @@ typedef struct EjsConstants {
     int           indexSize;                /**< Size of index in elements */
     int           indexCount;               /**< Number of constants used in index */
     int           locked;                   /**< No more additions allowed */
+    int           mapped;                   /**< Pool is in a mapped module file and is not a memory block */
     MprHash       *table;                   /**< Hash table for fast lookup when compiling */
     EjsString     **index;                  /**< Interned string index */
 } EjsConstants;
@@ -2059,7 +2220,65 @@ PUBLIC int ejsAddDebugLine(Ejs *ejs, EjsDebug **debug, int offset, wchar *source
 PUBLIC EjsLine *ejsGetDebugLine(Ejs *ejs, struct EjsFunction *fun, uchar *pc);
 PUBLIC int ejsGetDebugInfo(Ejs *ejs, struct EjsFunction *fun, uchar *pc, char **path, int *lineNumber, wchar **source);
 
-/** 
+#define EJS_CACHE_WAYS      4               /**< Receiver types cached per property access site */
+#define EJS_CACHE_MIN       8               /**< Minimum number of cache lines per function */
+#define EJS_CACHE_MAX       256             /**< Maximum number of cache lines per function */
+#define EJS_CACHE_MAX_EVICT 32              /**< Evictions after which a cache line is treated as megamorphic */
+
+/**
+    Inline property cache entry
+    @description Records the result of a by-name property lookup at a byte code site for one receiver type.
+        Entries are immutable once published. They are validated on use by checking the receiver shape or the property 
+        name stored at the cached slot, and the service cache epoch which is incremented whenever a type or prototype 
+        changes shape.
+    @ingroup EjsFunction
+    @stability Internal
+ */
+typedef struct EjsCacheEntry {
+    struct EjsType  *type;                  /**< Receiver type */
+    EjsAny          *holder;                /**< Object holding the property. Null if held by the receiver itself */
+    struct EjsShape *shape;                 /**< Receiver shape for shaped receivers. Otherwise null */
+    EjsName         qname;                  /**< Property name for sites with computed names. Otherwise null */
+    EjsName         target;                 /**< Resolved property name */
+    int             offset;                 /**< Byte code offset of the site */
+    int             operands;               /**< Length of the site instruction operands */
+    int             slotNum;                /**< Property slot number in the holder */
+    int             epoch;                  /**< Service cache epoch when the entry was created */
+} EjsCacheEntry;
+
+/**
+    Inline property cache line
+    @ingroup EjsFunction
+    @stability Internal
+ */
+typedef struct EjsCacheLine {
+    EjsCacheEntry   *entries[EJS_CACHE_WAYS];   /**< Entries for sites hashing to this line */
+    int             evictions;                  /**< Count of live entries evicted from this line */
+} EjsCacheLine;
+
+/**
+    Inline property cache for the by-name property access sites in a function
+    @ingroup EjsFunction
+    @stability Internal
+ */
+typedef struct EjsCache {
+    int             size;                   /**< Number of lines (power of 2) */
+    EjsCacheLine    lines[ARRAY_FLEX];      /**< Cache lines indexed by site offset */
+} EjsCache;
+
+/**
+    Native code compiled from the byte code of a hot function
+    @ingroup EjsFunction
+    @stability Internal
+ */
+typedef struct EjsJit {
+    uchar           *native;                /**< Executable mapping. Null if the byte code cannot be compiled */
+    ssize           size;                   /**< Size of the executable mapping */
+    int             entries[ARRAY_FLEX];    /**< Native code offset for each byte code offset. Zero if not an instruction.
+                                                 Negative if the instruction returns straight to the interpreter */
+} EjsJit;
+
+/**
     Byte code
     @description This structure describes a sequence of byte code for a function. It also defines a set of
         execption handlers pertaining to this byte code.
@@ -2072,11 +2291,17 @@ typedef struct EjsCode {
     struct EjsModule *module;                /**< Module owning this function */
     EjsDebug         *debug;                 /**< Source code debug information */
     EjsEx            **handlers;             /**< Exception handlers */
+    EjsCache         *cache;                 /**< Inline property cache. Created on demand by the VM */
+    EjsJit           *jit;                   /**< Native code. Compiled by the VM once the function is hot */
     int              codeLen;                /**< Byte code length */
+    int              codeOffset;             /**< Offset in mod file for byte code loaded on first call */
     int              debugOffset;            /**< Offset in mod file for debug info */
     int              numHandlers;            /**< Number of exception handlers */
     int              sizeHandlers;           /**< Size of handlers array */
-    uchar            byteCode[ARRAY_FLEX];   /**< Byte code */
+    int              hotness;                /**< Calls and backward branches. Saturates at EJS_QUICKEN_THRESHOLD */
+    int              deopts;                 /**< Specialized op codes reverted to generic op codes */
+    uchar            *byteCode;              /**< Byte code. Follows this structure unless in a mapped module file or
+                                                  loaded on first call. Null until then */
 } EjsCode;
 
 /**
@@ -2384,6 +2609,18 @@ PUBLIC EjsEx *ejsAddException(Ejs *ejs, EjsFunction *fun, uint tryStart, uint tr
 PUBLIC int ejsSetFunctionCode(Ejs *ejs, EjsFunction *fun, struct EjsModule *module, cuchar *byteCode, ssize len, 
     EjsDebug *debug);
 
+/** 
+    Load the byte code for a function
+    @description The loader defers reading the byte code and exception handlers of script functions until they are 
+        first called. This reads the deferred body of a function from its module file.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param fun Function to load
+    @return Zero if successful or if the body is already loaded, otherwise a negative MPR error code.
+    @ingroup EjsFunction
+    @internal
+ */
+PUBLIC int ejsLoadFunctionCode(Ejs *ejs, EjsFunction *fun);
+
 /*
     Internal
  */
@@ -2393,7 +2630,7 @@ PUBLIC int ejsSetFunctionCode(Ejs *ejs, EjsFunction *fun, struct EjsModule *modu
     @param ejs Ejs reference returned from #ejsCreateVM
     @param fun Function to examine
     @param module Module owning the function
-    @param byteCode ByteCode buffer
+    @param byteCode ByteCode buffer. Set to null if the byte code will be loaded when the function is first called.
     @param len Size of the byteCode buffer
     @param debug Debug record with symbolic debug information
     @return An allocated code block
@@ -2408,6 +2645,8 @@ PUBLIC void ejsShowOpFrequency(Ejs *ejs);
 /******************************************** Frame ***********************************************/
 /**
     Frame record 
+    @description Frames hold the arguments and locals for a function invocation. Frames are recycled via a per-interpreter
+        free list when the function returns, unless they have been captured by a closure or scope.
     @defgroup EjsFrame EjsFrame
     @see ejsIsFrame
     @stability Internal
@@ -2424,6 +2663,8 @@ typedef struct EjsFrame {
     uint            argc;                   /**< Actual parameter count */
     int             slotNum;                /**< Slot in owner */
     uint            getter: 1;              /**< Frame is a getter */
+    uint            captured: 1;            /**< Frame is referenced by a closure or scope and cannot be reused */
+    uint            pooled: 1;              /**< Frame is on the free frame list */
 } EjsFrame;
 
 #if DOXYGEN
@@ -2444,6 +2685,7 @@ typedef struct EjsFrame {
  */
 PUBLIC EjsFrame *ejsCreateFrame(Ejs *ejs, EjsFunction *src, EjsObj *thisObj, int argc, EjsObj **argv);
 PUBLIC EjsFrame *ejsCreateCompilerFrame(Ejs *ejs, EjsFunction *src);
+PUBLIC void ejsFreeFrame(Ejs *ejs, EjsFrame *frame);
 PUBLIC EjsBlock *ejsPopBlock(Ejs *ejs);
 PUBLIC EjsBlock *ejsPushBlock(Ejs *ejs, EjsBlock *block);
 
@@ -3528,7 +3770,8 @@ PUBLIC struct EjsNumber *ejsToNumber(Ejs *ejs, EjsAny *obj);
 typedef struct EjsRegExp {
     EjsObj          obj;                /**< Base object */
     wchar           *pattern;           /**< Pattern to match */
-    void            *compiled;          /**< Compiled pattern (not alloced) */
+    void            *compiled;          /**< Compiled pattern (not alloced, owned by program) */
+    struct EjsRegProgram *program;      /**< Shared compiled program */
     bool            global;             /**< Search for pattern globally (multiple times) */
     bool            ignoreCase;         /**< Do case insensitive matching */
     bool            multiline;          /**< Match patterns over multiple lines */
@@ -3684,9 +3927,10 @@ PUBLIC EjsUri *ejsToUri(Ejs *ejs, EjsAny *obj);
 /******************************************** Worker **********************************************/
 /** 
     Worker Class
-    @description The Worker class provides the ability to create new interpreters in dedicated threads
+    @description The Worker class provides the ability to create new interpreters in dedicated threads. Isolated
+        workers run in a separate process with their own heap and garbage collector.
     @defgroup EjsWorker EjsWorker
-    @see EjsObj ejsCreateWorker ejsRemoveWorkers
+    @see EjsObj ejsAttachWorker ejsCreateWorker ejsRemoveWorkers
     @stability Internal
  */
 typedef struct EjsWorker {
@@ -3697,8 +3941,13 @@ typedef struct EjsWorker {
     struct EjsWorker *pair;             /**< Corresponding worker object in other thread */
     char            *scriptFile;        /**< Script or module to run */
     EjsString       *scriptLiteral;     /**< Literal script string to run */
+    MprCmd          *cmd;               /**< Worker process for isolated workers */
+    MprWaitHandler  *handler;           /**< Wait handler for messages from the parent of an isolated worker */
+    MprBuf          *input;             /**< Partial message frames received from the other process */
+    MprBuf          *errors;            /**< Error output from an isolated worker process */
     int             state;              /**< Worker state */
     int             inside;             /**< Running inside the worker */
+    int             isolated;           /**< Worker runs in a separate process */
     int             complete;           /**< Worker has completed its work */
     int             gotMessage;         /**< Worker has received a message */
 } EjsWorker;
@@ -3708,6 +3957,19 @@ typedef struct EjsWorker {
 #define EJS_WORKER_CLOSED       3                   /**< Worker state when finished */
 #define EJS_WORKER_COMPLETE     4                   /**< Worker state when completed all messages */
 
+/** 
+    Attach to the parent of an isolated worker
+    @description This is called in the child process of an isolated worker. It defines the "self" worker in the 
+        interpreter, reads messages posted by the parent from the standard input and posts messages back to the parent
+        via the standard error output.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param name Worker name
+    @return Zero if successful, otherwise a negative MPR error code.
+    @ingroup EjsWorker
+    @internal
+ */
+PUBLIC int ejsAttachWorker(Ejs *ejs, cchar *name);
+
 /** 
     Create a worker
     @description This creates a bare worker object
@@ -4014,6 +4276,7 @@ typedef struct EjsType {
     MprManager      manager;                        /**< Manager callback */
     MprMutex        *mutex;                         /**< Optional locking for types that require it */
     MprList         *implements;                    /**< List of implemented interfaces */
+    EjsShape        *shape;                         /**< Root shape for dynamic instances */
         
     uint            callsSuper           : 1;       /**< Constructor calls super() */
     uint            configured           : 1;       /**< Type has been configured with native methods */
@@ -4515,17 +4778,32 @@ typedef struct EjsLookup {
 
 
 /**
-    Interned string hash shared over all interpreters
+    Interned string hash shard
     @ingroup Ejs
     @stability Internal
  */
-typedef struct EjsIntern {
+typedef struct EjsInternShard {
     struct EjsString    *buckets;               /**< Hash buckets and references to link chains of strings (unicode) */
+    struct EjsString    *oldBuckets;            /**< Buckets being migrated while the shard grows */
     int                 size;                   /**< Size of hash */
+    int                 oldSize;                /**< Size of oldBuckets */
+    int                 migrated;               /**< Count of oldBuckets migrated in order */
     int                 count;                  /**< Count of entries */
     uint64              reuse;                  /**< Reuse counter */
     uint64              accesses;               /**< NUmber of accesses to string */
+    uint64              contended;              /**< Accesses that waited for the shard lock */
     MprMutex            *mutex;
+} EjsInternShard;
+
+/**
+    Interned string hash shared over all interpreters
+    @description The hash is split into shards selected by the string hash. Each shard has its own lock and grows
+        independently and incrementally.
+    @ingroup Ejs
+    @stability Internal
+ */
+typedef struct EjsIntern {
+    EjsInternShard      shards[EJS_INTERN_SHARDS];  /**< Hash shards */
 } EjsIntern;
 
 /**
@@ -4544,9 +4822,21 @@ typedef struct EjsService {
     uint            dontExit: 1;            /**< Prevent App.exit() from exiting */
     uint            logging: 1;             /**< Using --log */
     uint            immutableInitialized: 1;/**< Immutable types are initialized */
+    uint            quicken: 1;             /**< Specialize op codes in hot functions at runtime */
+    uint            jit: 1;                 /**< Compile hot functions to native code */
+    uint            mapModules: 1;          /**< Map module files and use their code in place */
+    uint            lazyCode: 1;            /**< Load function bodies from module files when first called */
+    uint            partitions: 1;          /**< Create interpreters in their own heap partitions */
+    int             deferredCode;           /**< Function bodies deferred by the loader */
+    int             loadedCode;             /**< Deferred function bodies since loaded */
+    MprHash         *moduleMaps;            /**< Mapped module files by path. Shared over all interps */
     uint            seqno;                  /**< Interp sequence numbers */
+    int             cacheEpoch;             /**< Inline property cache epoch. Incremented when types change shape */
+    struct Ejs      *profiler;              /**< Interpreter sampling allocations (not marked) */
     EjsIntern       *intern;                /**< Interned Unicode string hash - shared over all interps */
+    MprHash         *regexCache;            /**< Compiled regular expression programs by pattern and flags */
     EjsPot          *immutable;             /**< Immutable types and special values*/
+    EjsNumber       *numbers[EJS_NUMBER_CACHE_MAX - EJS_NUMBER_CACHE_MIN]; /**< Shared small integer numbers */
     EjsHelpers      objHelpers;             /**< Default EjsObj helpers */
     EjsHelpers      potHelpers;             /**< Default EjsPot helpers */
     EjsHelpers      blockHelpers;           /**< Default EjsBlock helpers */
@@ -4561,12 +4851,17 @@ PUBLIC EjsIntern *ejsCreateIntern(EjsService *sp);
 PUBLIC int ejsInitCompiler(EjsService *sp);
 PUBLIC void ejsAttention(Ejs *ejs);
 PUBLIC void ejsClearAttention(Ejs *ejs);
+PUBLIC void ejsCommitAllocSample(Ejs *ejs, struct EjsType *type);
+PUBLIC char *ejsAnalyzeMemSnapshot(cchar *path, cchar *baseline);
 
 /*********************************** Prototypes *******************************/
 /**
     Create an ejs virtual machine 
     @description Create a virtual machine interpreter object to evalute Ejscript programs. Ejscript supports multiple 
-        interpreters. 
+        interpreters. If the EJS_PARTITIONS environment variable is set to "1", interpreters after the first are created
+        in their own heap partition so they are garbage collected without pausing other interpreters. Threads using the
+        interpreter must be bound to its partition via mprSetThreadPartition(ejs->partition). The interpreter's 
+        dispatcher runs events bound to the partition.
     @param argc Count of command line argumements in argv
     @param argv Command line arguments
     @param flags Optional flags to modify the interpreter behavior. Valid flags are:
@@ -4994,7 +5289,7 @@ typedef void (*EjsLoaderCallback)(struct Ejs *ejs, int kind, ...);
 /*
     Module file format version
  */
-#define EJS_MODULE_VERSION      3
+#define EJS_MODULE_VERSION      4
 #define EJS_VERSION_FACTOR      1000
 #define EJS_MODULE_MAGIC        0xC7DA
 
@@ -5059,6 +5354,23 @@ typedef struct EjsModuleHdr {
 } EjsModuleHdr;
 
 
+/**
+    Memory mapped module file
+    @description Module files are mapped when EjsService.mapModules is set. The mapping is shared by all interpreters
+        in the process and function byte code and the constant pool are used in place. The mapping is private and
+        writable so the VM can rewrite byte code in place. Pages that are never rewritten are shared with the O/S page
+        cache and so with other processes.
+    @ingroup EjsModule
+    @stability Internal
+ */
+typedef struct EjsModuleMap {
+    char            *path;                  /**< Module file path name */
+    uchar           *data;                  /**< Mapped file contents */
+    ssize           size;                   /**< Size of the mapping */
+    int64           modified;               /**< Modification time of the file in nanoseconds when mapped */
+    int64           inode;                  /**< File inode number when mapped */
+} EjsModuleMap;
+
 /**
     Module control structure
     @defgroup EjsModule EjsModule
@@ -5087,6 +5399,7 @@ typedef struct EjsModule {
     uint            hasInitializer  : 1;    /**< Has initializer function */
     uint            hasNative       : 1;    /**< Has native property definitions */
     uint            initialized     : 1;    /**< Initializer has run */
+    uint            lazyCode        : 1;    /**< Function bodies are loaded when first called */
     uint            visited         : 1;    /**< Module has been traversed */
     int             flags;                  /**< Loading flags */
 
@@ -5095,7 +5408,9 @@ typedef struct EjsModule {
      */
     EjsLoadState    *loadState;             /**< State while loading */
     MprList         *dependencies;          /**< Module file dependencies. List of EjsModules */
-    MprFile         *file;                  /**< File handle for loading and code generation */
+    MprFile         *file;                  /**< File handle for loading, code generation and lazy function bodies */
+    EjsModuleMap    *map;                   /**< Mapped module file. Holds function byte code and the constant pool */
+    MprOff          mapPos;                 /**< Read position in the mapped module file */
     MprList         *current;               /**< Current stack of open objects */
     EjsFunction     *currentMethod;         /**< Current method being loaded */
     EjsBlock        *scope;                 /**< Lexical scope chain */
@@ -5265,8 +5580,10 @@ PUBLIC int ejsEncodeInt32(Ejs *ejs, uchar *pos, int number);
 PUBLIC int ejsEncodeNum(Ejs *ejs, uchar *pos, int64 number);
 PUBLIC int ejsEncodeInt32AtPos(Ejs *ejs, uchar *pos, int value);
 PUBLIC char *ejsGetDocKey(Ejs *ejs, EjsBlock *block, int slotNum, char *buf, int bufsize);
+PUBLIC MprOff ejsGetModulePosition(EjsModule *mp);
 PUBLIC EjsModule *ejsLookupModule(Ejs *ejs, EjsString *name, int minVersion, int maxVersion);
 PUBLIC EjsNativeModule *ejsLookupNativeModule(Ejs *ejs, cchar *name);
+PUBLIC EjsModuleMap *ejsMapModule(Ejs *ejs, cchar *path);
 PUBLIC void ejsModuleReadBlock(Ejs *ejs, EjsModule *module, char *buf, int len);
 PUBLIC int ejsModuleReadByte(Ejs *ejs, EjsModule *module);
 PUBLIC EjsString *ejsModuleReadConst(Ejs *ejs, EjsModule *module);
@@ -5276,10 +5593,12 @@ PUBLIC EjsName ejsModuleReadName(Ejs *ejs, EjsModule *module);
 PUBLIC int64 ejsModuleReadNum(Ejs *ejs, EjsModule *module);
 PUBLIC char *ejsModuleReadMulti(Ejs *ejs, EjsModule *mp);
 PUBLIC wchar *ejsModuleReadMultiAsWide(Ejs *ejs, EjsModule *mp);
+PUBLIC uchar *ejsModuleReadMapped(Ejs *ejs, EjsModule *mp, ssize len);
 PUBLIC int ejsModuleReadType(Ejs *ejs, EjsModule *module, EjsType **typeRef, EjsTypeFixup **fixup, EjsName *typeName, 
         int *slotNum);
 PUBLIC void ejsRemoveModule(Ejs *ejs, EjsModule *up);
 PUBLIC void ejsRemoveModuleFromAll(EjsModule *up);
+PUBLIC void ejsSeekModule(EjsModule *mp, MprOff pos);
 PUBLIC double ejsSwapDouble(Ejs *ejs, double a);
 PUBLIC int ejsSwapInt32(Ejs *ejs, int word);
 PUBLIC int64 ejsSwapInt64(Ejs *ejs, int64 word);
@@ -217,8 +217,118 @@ typedef enum EjsOpCode {
     EJS_OP_XOR,
     EJS_OP_CALL_FINALLY,
     EJS_OP_GOTO_FINALLY,
+    EJS_OP_ADD_NUM,
+    EJS_OP_SUB_NUM,
+    EJS_OP_MUL_NUM,
+    EJS_OP_DIV_NUM,
+    EJS_OP_COMPARE_EQ_NUM,
+    EJS_OP_COMPARE_NE_NUM,
+    EJS_OP_COMPARE_LT_NUM,
+    EJS_OP_COMPARE_LE_NUM,
+    EJS_OP_COMPARE_GT_NUM,
+    EJS_OP_COMPARE_GE_NUM,
+    EJS_OP_INC_NUM,
+    EJS_OP_ADD_CHAIN,
+    EJS_OP_DUP_INC_PUT_SCOPED_NAME_POP,
+    EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_COMPARE_LT_BRANCH_FALSE_8,
+    EJS_OP_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP,
+    EJS_OP_ADD_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP,
+    EJS_OP_POP_GOTO_8,
+    EJS_OP_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME,
+    EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME,
+    EJS_OP_DUP_INC_PUT_LOCAL_SLOT_N_POP,
+    EJS_OP_GET_SCOPED_NAME_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8,
+    EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME,
+    EJS_OP_ADD_LOAD_N_SUB_PUT_SCOPED_NAME,
+    EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_N_MUL,
+    EJS_OP_GET_SCOPED_NAME_LOAD_INT_MUL_COMPARE_LT,
+    EJS_OP_COMPARE_LT_BRANCH_FALSE_8,
+    EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_COMPARE_LT_BRANCH_FALSE_8,
+    EJS_OP_GET_LOCAL_SLOT_3_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8,
+    EJS_OP_GET_LOCAL_SLOT_0_LOAD_N_COMPARE_GT_BRANCH_FALSE_8,
+    EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_MUL_PUT_LOCAL_SLOT_N,
+    EJS_OP_LOAD_1_SUB_PUT_LOCAL_SLOT_N_GET_LOCAL_SLOT_N,
+    EJS_OP_GET_LOCAL_SLOT_4_LOAD_INT_COMPARE_GT_BRANCH_FALSE_8,
+    EJS_OP_GET_LOCAL_SLOT_1_GET_LOCAL_SLOT_N_ADD_PUT_LOCAL_SLOT_N,
+    EJS_OP_MUL_ADD,
+    EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING,
+    EJS_OP_GET_SCOPED_NAME_MUL_GET_SCOPED_NAME,
+    EJS_OP_PUT_SCOPED_NAME_GOTO_8,
+    EJS_OP_GET_SCOPED_NAME_DUP,
+    EJS_OP_GET_SCOPED_NAME_LOAD_N_MUL,
+    EJS_OP_LOAD_STRING_ADD,
 } EjsOpCode;
 
+/*
+    Fused op codes generated by genbyte from src/test/bench/opcodes.profile. A fused op code replaces the first op code
+    of a sequence and runs the sequence in one dispatch. Expand with OP(opcode, count, first, second, third, fourth).
+    The first op code is exact. The others name their family from EJS_FUSIBLE_OPCODES. Unused op codes are -1.
+ */
+#define EJS_FUSED_OPCODES(OP) \
+    OP(EJS_OP_DUP_INC_PUT_SCOPED_NAME_POP, 4, EJS_OP_DUP, EJS_OP_INC, EJS_OP_PUT_SCOPED_NAME, EJS_OP_POP) \
+    OP(EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_COMPARE_LT_BRANCH_FALSE_8, 4, EJS_OP_GET_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_COMPARE_LT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP, 3, EJS_OP_PUT_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_DUP, -1) \
+    OP(EJS_OP_ADD_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP, 4, EJS_OP_ADD, EJS_OP_PUT_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_DUP) \
+    OP(EJS_OP_POP_GOTO_8, 2, EJS_OP_POP, EJS_OP_GOTO_8, -1, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME, 3, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_STRING, EJS_OP_GET_SCOPED_NAME, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME, 2, EJS_OP_GET_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, -1, -1) \
+    OP(EJS_OP_DUP_INC_PUT_LOCAL_SLOT_N_POP, 4, EJS_OP_DUP, EJS_OP_INC, EJS_OP_PUT_LOCAL_SLOT_0, EJS_OP_POP) \
+    OP(EJS_OP_GET_SCOPED_NAME_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8, 4, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_INT, EJS_OP_COMPARE_LT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME, 4, EJS_OP_GET_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_STRING, EJS_OP_GET_SCOPED_NAME) \
+    OP(EJS_OP_ADD_LOAD_N_SUB_PUT_SCOPED_NAME, 4, EJS_OP_ADD, EJS_OP_LOAD_0, EJS_OP_SUB, EJS_OP_PUT_SCOPED_NAME) \
+    OP(EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_N_MUL, 4, EJS_OP_GET_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_0, EJS_OP_MUL) \
+    OP(EJS_OP_GET_SCOPED_NAME_LOAD_INT_MUL_COMPARE_LT, 4, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_INT, EJS_OP_MUL, EJS_OP_COMPARE_LT) \
+    OP(EJS_OP_COMPARE_LT_BRANCH_FALSE_8, 2, EJS_OP_COMPARE_LT, EJS_OP_BRANCH_FALSE_8, -1, -1) \
+    OP(EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_COMPARE_LT_BRANCH_FALSE_8, 4, EJS_OP_GET_LOCAL_SLOT_2, EJS_OP_GET_LOCAL_SLOT_0, EJS_OP_COMPARE_LT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_GET_LOCAL_SLOT_3_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8, 4, EJS_OP_GET_LOCAL_SLOT_3, EJS_OP_LOAD_INT, EJS_OP_COMPARE_LT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_GET_LOCAL_SLOT_0_LOAD_N_COMPARE_GT_BRANCH_FALSE_8, 4, EJS_OP_GET_LOCAL_SLOT_0, EJS_OP_LOAD_0, EJS_OP_COMPARE_GT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_MUL_PUT_LOCAL_SLOT_N, 4, EJS_OP_GET_LOCAL_SLOT_2, EJS_OP_GET_LOCAL_SLOT_0, EJS_OP_MUL, EJS_OP_PUT_LOCAL_SLOT_0) \
+    OP(EJS_OP_LOAD_1_SUB_PUT_LOCAL_SLOT_N_GET_LOCAL_SLOT_N, 4, EJS_OP_LOAD_1, EJS_OP_SUB, EJS_OP_PUT_LOCAL_SLOT_0, EJS_OP_GET_LOCAL_SLOT_0) \
+    OP(EJS_OP_GET_LOCAL_SLOT_4_LOAD_INT_COMPARE_GT_BRANCH_FALSE_8, 4, EJS_OP_GET_LOCAL_SLOT_4, EJS_OP_LOAD_INT, EJS_OP_COMPARE_GT, EJS_OP_BRANCH_FALSE_8) \
+    OP(EJS_OP_GET_LOCAL_SLOT_1_GET_LOCAL_SLOT_N_ADD_PUT_LOCAL_SLOT_N, 4, EJS_OP_GET_LOCAL_SLOT_1, EJS_OP_GET_LOCAL_SLOT_0, EJS_OP_ADD, EJS_OP_PUT_LOCAL_SLOT_0) \
+    OP(EJS_OP_MUL_ADD, 2, EJS_OP_MUL, EJS_OP_ADD, -1, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING, 3, EJS_OP_GET_SCOPED_NAME, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_STRING, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_MUL_GET_SCOPED_NAME, 3, EJS_OP_GET_SCOPED_NAME, EJS_OP_MUL, EJS_OP_GET_SCOPED_NAME, -1) \
+    OP(EJS_OP_PUT_SCOPED_NAME_GOTO_8, 2, EJS_OP_PUT_SCOPED_NAME, EJS_OP_GOTO_8, -1, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_DUP, 2, EJS_OP_GET_SCOPED_NAME, EJS_OP_DUP, -1, -1) \
+    OP(EJS_OP_GET_SCOPED_NAME_LOAD_N_MUL, 3, EJS_OP_GET_SCOPED_NAME, EJS_OP_LOAD_0, EJS_OP_MUL, -1) \
+    OP(EJS_OP_LOAD_STRING_ADD, 2, EJS_OP_LOAD_STRING, EJS_OP_ADD, -1, -1)
+
+/*
+    Optable rows for the fused op codes. The other op codes of a sequence remain in the code, so a fused op code has
+    the stack effect and operands of its first op code.
+ */
+#define EJS_FUSED_OPTABLE \
+    {   "DUP_INC_PUT_SCOPED_NAME_POP", 1, { EBC_NONE, }, }, \
+    {   "GET_SCOPED_NAME_GET_SCOPED_NAME_COMPARE_LT_BRANCH_FALSE_8", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP", -1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "ADD_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP", -1, { EBC_NONE, }, }, \
+    {   "POP_GOTO_8", -1, { EBC_NONE, }, }, \
+    {   "GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_GET_SCOPED_NAME", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "DUP_INC_PUT_LOCAL_SLOT_N_POP", 1, { EBC_NONE, }, }, \
+    {   "GET_SCOPED_NAME_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "ADD_LOAD_N_SUB_PUT_SCOPED_NAME", -1, { EBC_NONE, }, }, \
+    {   "GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_N_MUL", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_LOAD_INT_MUL_COMPARE_LT", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "COMPARE_LT_BRANCH_FALSE_8", -1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_COMPARE_LT_BRANCH_FALSE_8", 1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_3_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8", 1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_0_LOAD_N_COMPARE_GT_BRANCH_FALSE_8", 1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_MUL_PUT_LOCAL_SLOT_N", 1, { EBC_NONE, }, }, \
+    {   "LOAD_1_SUB_PUT_LOCAL_SLOT_N_GET_LOCAL_SLOT_N", 1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_4_LOAD_INT_COMPARE_GT_BRANCH_FALSE_8", 1, { EBC_NONE, }, }, \
+    {   "GET_LOCAL_SLOT_1_GET_LOCAL_SLOT_N_ADD_PUT_LOCAL_SLOT_N", 1, { EBC_NONE, }, }, \
+    {   "MUL_ADD", -1, { EBC_NONE, }, }, \
+    {   "GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_MUL_GET_SCOPED_NAME", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "PUT_SCOPED_NAME_GOTO_8", -1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_DUP", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "GET_SCOPED_NAME_LOAD_N_MUL", 1, { EBC_STRING, EBC_STRING, }, }, \
+    {   "LOAD_STRING_ADD", 1, { EBC_STRING, }, }, \
+
+
 #endif
 
 /*
@@ -42,6 +42,66 @@ typedef struct EjsOptable {
     int     args[8];
 } EjsOptable;
 
+/*
+    Generic op codes and their Number specialized variants. The compiler emits the Number variant when both operands
+    are typed as Numbers and the VM quickens hot generic op codes to it. Expand with OP(generic, number) where the
+    arguments are op code names without the EJS_OP_ prefix.
+ */
+#define EJS_NUMBER_OPCODES(OP) \
+    OP(ADD,                 ADD_NUM) \
+    OP(SUB,                 SUB_NUM) \
+    OP(MUL,                 MUL_NUM) \
+    OP(DIV,                 DIV_NUM) \
+    OP(COMPARE_EQ,          COMPARE_EQ_NUM) \
+    OP(COMPARE_NE,          COMPARE_NE_NUM) \
+    OP(COMPARE_LT,          COMPARE_LT_NUM) \
+    OP(COMPARE_LE,          COMPARE_LE_NUM) \
+    OP(COMPARE_GT,          COMPARE_GT_NUM) \
+    OP(COMPARE_GE,          COMPARE_GE_NUM) \
+    OP(INC,                 INC_NUM)
+
+/*
+    Kinds of fusible op codes
+ */
+#define EJS_FUSE_OP         0x1             /* Op code is fused as itself */
+#define EJS_FUSE_NUMBER     0x2             /* Generic op code is fused with its Number variant */
+#define EJS_FUSE_SERIES     0x4             /* Numbered op code series (Op0 .. Op9) */
+#define EJS_FUSE_LAST       0x8             /* Control op code that may only end a fused sequence */
+
+#define EJS_FUSED_MAX       4               /* Maximum op codes in a fused sequence */
+
+/*
+    Op codes that may be fused into superinstructions. Each has a DO_ fragment in ejsInterp.c that the fused op code
+    handlers are built from. Number variants fuse as their generic op code. A series fuses by its first member, except
+    at the start of a sequence where the fused op code replaces the member and must name it. genbyte mines the sequences
+    of these op codes from src/test/bench/opcodes.profile and generates EJS_FUSED_OPCODES in ejsByteCode.h. Expand with 
+    OP(name, kind) where the name is an op code name without the EJS_OP_ prefix.
+ */
+#define EJS_FUSIBLE_OPCODES(OP) \
+    OP(DUP,                 EJS_FUSE_OP) \
+    OP(POP,                 EJS_FUSE_OP) \
+    OP(LOAD_INT,            EJS_FUSE_OP) \
+    OP(LOAD_STRING,         EJS_FUSE_OP) \
+    OP(LOAD_0,              EJS_FUSE_SERIES) \
+    OP(GET_LOCAL_SLOT_0,    EJS_FUSE_SERIES) \
+    OP(PUT_LOCAL_SLOT_0,    EJS_FUSE_SERIES) \
+    OP(GET_SCOPED_NAME,     EJS_FUSE_OP) \
+    OP(PUT_SCOPED_NAME,     EJS_FUSE_OP) \
+    OP(ADD,                 EJS_FUSE_NUMBER) \
+    OP(SUB,                 EJS_FUSE_NUMBER) \
+    OP(MUL,                 EJS_FUSE_NUMBER) \
+    OP(DIV,                 EJS_FUSE_NUMBER) \
+    OP(COMPARE_EQ,          EJS_FUSE_NUMBER) \
+    OP(COMPARE_NE,          EJS_FUSE_NUMBER) \
+    OP(COMPARE_LT,          EJS_FUSE_NUMBER) \
+    OP(COMPARE_LE,          EJS_FUSE_NUMBER) \
+    OP(COMPARE_GT,          EJS_FUSE_NUMBER) \
+    OP(COMPARE_GE,          EJS_FUSE_NUMBER) \
+    OP(INC,                 EJS_FUSE_NUMBER) \
+    OP(GOTO_8,              EJS_FUSE_LAST) \
+    OP(BRANCH_FALSE_8,      EJS_FUSE_LAST) \
+    OP(BRANCH_TRUE_8,       EJS_FUSE_LAST)
+
 #if EJS_DEFINE_OPTABLE
 /*  
         Opcode string         Stack Effect      Operands, ...                                   
@@ -255,12 +315,36 @@ EjsOptable ejsOptable[] = {
     {   "XOR",                      -1,         { EBC_NONE,                               },},
     {   "CALL_FINALLY",              0,         { EBC_NONE,                               },},
     {   "GOTO_FINALLY",              0,         { EBC_NONE,                               },},
+    {   "ADD_NUM",                  -1,         { EBC_NONE,                               },},
+    {   "SUB_NUM",                  -1,         { EBC_NONE,                               },},
+    {   "MUL_NUM",                  -1,         { EBC_NONE,                               },},
+    {   "DIV_NUM",                  -1,         { EBC_NONE,                               },},
+    {   "COMPARE_EQ_NUM",           -1,         { EBC_NONE,                               },},
+    {   "COMPARE_NE_NUM",           -1,         { EBC_NONE,                               },},
+    {   "COMPARE_LT_NUM",           -1,         { EBC_NONE,                               },},
+    {   "COMPARE_LE_NUM",           -1,         { EBC_NONE,                               },},
+    {   "COMPARE_GT_NUM",           -1,         { EBC_NONE,                               },},
+    {   "COMPARE_GE_NUM",           -1,         { EBC_NONE,                               },},
+    {   "INC_NUM",                   0,         { EBC_BYTE,                               },},
+    {   "ADD_CHAIN",                -1,         { EBC_NONE,                               },},
+    EJS_FUSED_OPTABLE
     {   0,                           0,         { EBC_NONE,                               },},
 };
 #endif /* EJS_DEFINE_OPTABLE */
 
 PUBLIC EjsOptable *ejsGetOptable();
 
+/*
+    Map between generic op codes and their Number variants using EJS_NUMBER_OPCODES. Return zero if there is no mapping.
+ */
+PUBLIC int ejsGetNumberOpcode(int opcode);
+PUBLIC int ejsGetGenericOpcode(int opcode);
+
+/*
+    Return the fused op code for a sequence of "count" op codes as emitted by the compiler. Return zero if none.
+ */
+PUBLIC int ejsGetFusedOpcode(int *opcodes, int count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -115,6 +115,21 @@ typedef struct EcNode   *Node;
 #endif
 
 //  MOB DOC
+/*
+    Recently encoded instruction. Used to fuse op code sequences.
+ */
+typedef struct EcOpcode {
+    int         offset;                         /* Offset of the op code in buf */
+    int         opcode;                         /* Op code as encoded */
+    int         fused;                          /* Length of the fused sequence starting here, or zero */
+    int         covered;                        /* Instruction is inside a fused sequence */
+} EcOpcode;
+
+/*
+    Number of recent instructions to keep. A longer sequence may take over the tail of a prior fused sequence.
+ */
+#define EC_RECENT_OPCODES   ((EJS_FUSED_MAX - 1) * 2)
+
 /*
     Structure for code generation buffers
  */
@@ -130,6 +145,8 @@ typedef struct EcCodeGen {
     int         stackCount;                     /* Current stack item counter */
     int         blockCount;                     /* Current block counter */
     int         lastLineNumber;                 /* Last line for debug */
+    int         numRecent;                      /* Count of entries in recent */
+    EcOpcode    recent[EC_RECENT_OPCODES];      /* Recently encoded instructions, oldest first */
 } EcCodeGen;
 
 
@@ -1162,10 +1162,16 @@
     Class property slots for the "GC" type 
  */
 #define ES_GC_enabled                                                  0
-#define ES_GC_newQuota                                                 1
-#define ES_GC_run                                                      2
-#define ES_GC_verify                                                   3
-#define ES_GC_NUM_CLASS_PROP                                           4
+#define ES_GC_growth                                                   1
+#define ES_GC_newQuota                                                 2
+#define ES_GC_nursery                                                  3
+#define ES_GC_pauseTarget                                              4
+#define ES_GC_pauses                                                   5
+#define ES_GC_run                                                      6
+#define ES_GC_stats                                                    7
+#define ES_GC_threads                                                  8
+#define ES_GC_verify                                                   9
+#define ES_GC_NUM_CLASS_PROP                                           10
 
 /*
    Prototype (instance) slots for "GC" type 
@@ -1591,13 +1597,20 @@
     Class property slots for the "Memory" type 
  */
 #define ES_Memory_allocated                                            0
-#define ES_Memory_callback                                             1
-#define ES_Memory_maximum                                              2
-#define ES_Memory_redline                                              3
-#define ES_Memory_resident                                             4
-#define ES_Memory_system                                               5
-#define ES_Memory_stats                                                6
-#define ES_Memory_NUM_CLASS_PROP                                       7
+#define ES_Memory_allocator                                            1
+#define ES_Memory_analyze                                              2
+#define ES_Memory_callback                                             3
+#define ES_Memory_functions                                            4
+#define ES_Memory_maximum                                              5
+#define ES_Memory_objects                                              6
+#define ES_Memory_profile                                              7
+#define ES_Memory_profiling                                            8
+#define ES_Memory_redline                                              9
+#define ES_Memory_resident                                             10
+#define ES_Memory_snapshot                                             11
+#define ES_Memory_system                                               12
+#define ES_Memory_stats                                                13
+#define ES_Memory_NUM_CLASS_PROP                                       14
 
 /*
    Prototype (instance) slots for "Memory" type 
@@ -1605,6 +1618,14 @@
 #define ES_Memory_NUM_INSTANCE_PROP                                    0
 #define ES_Memory_NUM_INHERITED_PROP                                   0
 
+/*
+    Local slots for methods in type "Memory" 
+ */
+#define ES_Memory_analyze_snapshot                                     0
+#define ES_Memory_analyze_baseline                                     1
+#define ES_Memory_profile_reset                                        0
+#define ES_Memory_snapshot_path                                        0
+
 
 /*
     Class property slots for the "MprLog" type 
@@ -2407,6 +2428,6 @@
 #define ES_XMLList_NUM_INSTANCE_PROP                                   20
 #define ES_XMLList_NUM_INHERITED_PROP                                  0
 
-#define _ES_CHECKSUM_ejs   1507582
+#define _ES_CHECKSUM_ejs   1526271
 
 #endif
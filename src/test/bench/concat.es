@@ -0,0 +1,30 @@
+/*
+    concat.es -- Benchmark building strings from chains of additions
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+let start = new Date
+let mark = new Date
+let count = 50000
+let line
+for (let i = 0; i < count; i++) {
+    line = "127.0.0.1" + " - " + "user" + " [" + i + "] \"GET /index.html HTTP/1.1\" " + 200 + " " + i * 7 + "\n"
+}
+report("Log line", count, mark)
+
+mark = new Date
+let row = [ "alpha", "beta", "gamma", "delta", "epsilon", "zeta" ]
+let html
+for (let i = 0; i < count / 10; i++) {
+    html = ""
+    for (let j = 0; j < row.length; j++) {
+        html += "<td class=\"" + row[j] + "\">" + row[j] + i + "</td>"
+    }
+}
+report("Table cells", count / 10 * row.length, mark)
+
+report("Total", 0, start)
@@ -0,0 +1,70 @@
+/*
+    jit.es -- Benchmark native code for hot functions against the interpreter
+
+    Compare:
+        ejs jit.es
+        ejs --nojit jit.es
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+function counted(n) {
+    var sum = 0
+    for (var i = 0; i < n; i++) {
+        sum = sum + i * 2 - 1
+    }
+    return sum
+}
+
+function branches(n) {
+    var odd = 0, even = 0
+    for (var i = 0; i < n; i++) {
+        if (i % 2 == 0) {
+            even = even + 1
+        } else {
+            odd = odd + 1
+        }
+    }
+    return odd - even
+}
+
+function nested(n) {
+    var count = 0
+    for (var r = 0; r < n; r++) {
+        for (var c = 0; c < 100; c++) {
+            if (r * c > 1000) {
+                count = count + 1
+            }
+        }
+    }
+    return count
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2)
+}
+
+let start = new Date
+let mark = new Date
+let count = 1000000
+counted(count)
+report("Counted loop", count, mark)
+
+mark = new Date
+branches(count)
+report("Branches", count, mark)
+
+mark = new Date
+count = 10000
+nested(count)
+report("Nested loop", count * 100, mark)
+
+mark = new Date
+count = 25
+fib(count)
+report("Recursive fib", count, mark)
+
+report("Total", 0, start)
@@ -0,0 +1,67 @@
+/*
+    locals.es -- Benchmark functions that work on local variables
+
+    Typical function bodies: counted loops, accumulators and recursion over "var" locals.
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+function sum(n) {
+    var total = 0
+    for (var i = 0; i < n; i++) {
+        total = total + i
+    }
+    return total
+}
+
+function table(rows) {
+    var count = 0
+    for (var r = 0; r < rows; r++) {
+        for (var c = 0; c < 100; c++) {
+            var cell = r * c
+            if (cell > 1000) {
+                count = count + 1
+            }
+        }
+    }
+    return count
+}
+
+function fib(n) {
+    if (n < 2) {
+        return n
+    }
+    return fib(n - 1) + fib(n - 2)
+}
+
+function countDown(n) {
+    var steps = 0
+    while (n > 0) {
+        n = n - 1
+        steps++
+    }
+    return steps
+}
+
+let start = new Date
+let mark = new Date
+let count = 500000
+sum(count)
+report("Sum loop", count, mark)
+
+mark = new Date
+table(count / 100)
+report("Nested loop", count, mark)
+
+mark = new Date
+fib(24)
+report("Recursion", 75024, mark)
+
+mark = new Date
+countDown(count)
+report("While loop", count, mark)
+
+report("Total", 0, start)
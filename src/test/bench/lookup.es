@@ -0,0 +1,45 @@
+/*
+    lookup.es -- Benchmark hashed property lookup by name. Long names make the cost of hashing visible.
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+let o = {}
+let names = []
+for (let i = 0; i < 64; i++) {
+    let name = "a_reasonably_long_property_name_for_hashing_" + i
+    names.push(name)
+    o[name] = i
+}
+
+let start = new Date
+let mark = new Date
+let count = 4000
+let sum = 0
+for (let n = 0; n < count; n++) {
+    for (let i = 0; i < 64; i++) {
+        sum += o[names[i]]
+    }
+}
+report("Computed name lookup", count * 64, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    for (let i = 0; i < 64; i++) {
+        o[names[i]] = n
+    }
+}
+report("Computed name update", count * 64, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    for (let i = 0; i < 64; i++) {
+        sum += names[i] in o ? 1 : 0
+    }
+}
+report("Name test", count * 64, mark)
+
+report("Total", 0, start)
@@ -0,0 +1,999 @@
+#
+#   opcodes.profile -- Op code sequence profile from which genbyte generates the fused op codes
+#
+#   Recorded by building ejsInterp.c with -DEJS_OP_PROFILE=1 and running "ejs --stats script" in this directory for
+#   each script below. Fused op codes are counted as the op codes they run. Each line is the percentage of all
+#   instructions executed by the script, then the op code or op code sequence. Regenerate the byte code headers with:
+#
+#       genbyte --profile src/test/bench/opcodes.profile src
+#
+== bench.es
+Opcode frequency (586,701,968 instructions)
+  25.94%  GET_SCOPED_NAME
+  12.07%  PUT_SCOPED_NAME
+  10.14%  GOTO_8
+   9.37%  DUP
+   6.99%  BRANCH_FALSE_8
+   5.97%  COMPARE_LT_NUM
+   5.97%  POP
+   5.97%  INC_NUM
+   3.41%  PUSH_RESULT
+   3.41%  CALL_OBJ_NAME
+   2.11%  PUT_OBJ_NAME
+   2.05%  NEW
+   1.26%  GET_OBJ_NAME
+   1.09%  LOAD_INT
+   1.02%  LOAD_2
+   0.68%  CALL_SCOPED_NAME
+   0.68%  GET_LOCAL_SLOT_0
+   0.68%  RETURN_VALUE
+   0.51%  REM
+   0.51%  DIV_NUM
+   0.07%  LOAD_TRUE
+   0.03%  LOAD_STRING
+   0.03%  LOAD_4
+   0.03%  LOAD_FALSE
+   0.00%  ADD_NAMESPACE
+   0.00%  GET_GLOBAL_SLOT
+   0.00%  DEFINE_CLASS
+   0.00%  NEW_ARRAY
+   0.00%  CLOSE_BLOCK
+   0.00%  OPEN_BLOCK
+   0.00%  LOAD_REGEXP
+   0.00%  GET_LOCAL_SLOT_3
+   0.00%  DIV
+   0.00%  DEFINE_FUNCTION
+   0.00%  RETURN
+   0.00%  ADD
+   0.00%  CALL_CONSTRUCTOR
+   0.00%  LOAD_0
+   0.00%  NEW_OBJECT
+   0.00%  ADD_NAMESPACE_REF
+Opcode sequence frequency (2)
+   6.65%  GET_SCOPED_NAME          GET_SCOPED_NAME
+   6.48%  GOTO_8                   GET_SCOPED_NAME
+   5.97%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   5.97%  BRANCH_FALSE_8           GET_SCOPED_NAME
+   5.97%  GET_SCOPED_NAME          COMPARE_LT_NUM
+   5.97%  GET_SCOPED_NAME          DUP
+   5.97%  DUP                      INC_NUM
+   5.97%  PUT_SCOPED_NAME          POP
+   5.97%  POP                      GOTO_8
+   5.97%  INC_NUM                  PUT_SCOPED_NAME
+   3.92%  PUT_SCOPED_NAME          GOTO_8
+   3.41%  CALL_OBJ_NAME            PUSH_RESULT
+   3.41%  PUSH_RESULT              PUT_SCOPED_NAME
+   3.41%  DUP                      CALL_OBJ_NAME
+   3.41%  GOTO_8                   DUP
+   2.18%  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   2.05%  GET_SCOPED_NAME          NEW
+   2.05%  NEW                      PUT_SCOPED_NAME
+   1.98%  GET_SCOPED_NAME          PUT_OBJ_NAME
+   1.87%  PUT_OBJ_NAME             GET_SCOPED_NAME
+   1.12%  GET_SCOPED_NAME          GET_OBJ_NAME
+   1.09%  LOAD_INT                 GET_SCOPED_NAME
+   1.02%  GET_SCOPED_NAME          LOAD_2
+   1.02%  BRANCH_FALSE_8           LOAD_INT
+   0.85%  GET_OBJ_NAME             GET_SCOPED_NAME
+   0.68%  GET_SCOPED_NAME          CALL_SCOPED_NAME
+   0.68%  GET_LOCAL_SLOT_0         RETURN_VALUE
+   0.51%  GET_SCOPED_NAME          PUT_SCOPED_NAME
+   0.51%  LOAD_2                   DIV_NUM
+   0.51%  LOAD_2                   REM
+   0.51%  REM                      BRANCH_FALSE_8
+   0.51%  DIV_NUM                  BRANCH_FALSE_8
+   0.26%  GOTO_8                   GOTO_8
+   0.14%  GET_OBJ_NAME             PUT_SCOPED_NAME
+   0.14%  GET_OBJ_NAME             GET_OBJ_NAME
+   0.14%  GET_OBJ_NAME             PUT_OBJ_NAME
+   0.07%  PUT_OBJ_NAME             LOAD_INT
+   0.07%  LOAD_TRUE                GET_SCOPED_NAME
+   0.07%  PUT_OBJ_NAME             LOAD_TRUE
+   0.03%  LOAD_STRING              GET_SCOPED_NAME
+Opcode sequence frequency (3)
+   5.97%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   5.97%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   5.97%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.97%  PUT_SCOPED_NAME          POP                      GOTO_8
+   5.97%  DUP                      INC_NUM                  PUT_SCOPED_NAME
+   5.97%  POP                      GOTO_8                   GET_SCOPED_NAME
+   5.97%  INC_NUM                  PUT_SCOPED_NAME          POP
+   5.97%  GET_SCOPED_NAME          DUP                      INC_NUM
+   4.94%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   3.41%  CALL_OBJ_NAME            PUSH_RESULT              PUT_SCOPED_NAME
+   3.41%  PUT_SCOPED_NAME          GOTO_8                   DUP
+   3.41%  PUSH_RESULT              PUT_SCOPED_NAME          GOTO_8
+   3.41%  DUP                      CALL_OBJ_NAME            PUSH_RESULT
+   3.41%  GOTO_8                   DUP                      CALL_OBJ_NAME
+   2.18%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   2.05%  BRANCH_FALSE_8           GET_SCOPED_NAME          NEW
+   2.05%  NEW                      PUT_SCOPED_NAME          GET_SCOPED_NAME
+   2.05%  GET_SCOPED_NAME          NEW                      PUT_SCOPED_NAME
+   1.74%  GET_SCOPED_NAME          PUT_OBJ_NAME             GET_SCOPED_NAME
+   1.70%  BRANCH_FALSE_8           GET_SCOPED_NAME          DUP
+   1.02%  BRANCH_FALSE_8           LOAD_INT                 GET_SCOPED_NAME
+   1.02%  BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_2
+   1.02%  COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_INT
+   0.99%  PUT_OBJ_NAME             GET_SCOPED_NAME          GET_OBJ_NAME
+   0.95%  LOAD_INT                 GET_SCOPED_NAME          PUT_OBJ_NAME
+   0.89%  PUT_OBJ_NAME             GET_SCOPED_NAME          DUP
+   0.85%  GET_SCOPED_NAME          GET_OBJ_NAME             GET_SCOPED_NAME
+   0.85%  GET_OBJ_NAME             GET_SCOPED_NAME          PUT_OBJ_NAME
+   0.68%  GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_SCOPED_NAME
+   0.68%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.51%  GET_SCOPED_NAME          LOAD_2                   DIV_NUM
+   0.51%  LOAD_2                   REM                      BRANCH_FALSE_8
+   0.51%  REM                      BRANCH_FALSE_8           GET_SCOPED_NAME
+   0.51%  GET_SCOPED_NAME          LOAD_2                   REM
+   0.51%  DIV_NUM                  BRANCH_FALSE_8           GET_SCOPED_NAME
+   0.51%  BRANCH_FALSE_8           GET_SCOPED_NAME          PUT_SCOPED_NAME
+   0.51%  LOAD_2                   DIV_NUM                  BRANCH_FALSE_8
+   0.51%  GOTO_8                   GET_SCOPED_NAME          DUP
+   0.51%  GET_SCOPED_NAME          PUT_SCOPED_NAME          GOTO_8
+   0.26%  GOTO_8                   GOTO_8                   GET_SCOPED_NAME
+Opcode sequence frequency (4)
+   5.97%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   5.97%  INC_NUM                  PUT_SCOPED_NAME          POP                      GOTO_8
+   5.97%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   5.97%  PUT_SCOPED_NAME          POP                      GOTO_8                   GET_SCOPED_NAME
+   5.97%  DUP                      INC_NUM                  PUT_SCOPED_NAME          POP
+   5.97%  POP                      GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.97%  GET_SCOPED_NAME          DUP                      INC_NUM                  PUT_SCOPED_NAME
+   4.94%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   3.41%  PUSH_RESULT              PUT_SCOPED_NAME          GOTO_8                   DUP
+   3.41%  PUT_SCOPED_NAME          GOTO_8                   DUP                      CALL_OBJ_NAME
+   3.41%  CALL_OBJ_NAME            PUSH_RESULT              PUT_SCOPED_NAME          GOTO_8
+   3.41%  DUP                      CALL_OBJ_NAME            PUSH_RESULT              PUT_SCOPED_NAME
+   3.41%  GOTO_8                   DUP                      CALL_OBJ_NAME            PUSH_RESULT
+   2.18%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP                      INC_NUM
+   2.05%  GET_SCOPED_NAME          NEW                      PUT_SCOPED_NAME          GET_SCOPED_NAME
+   2.05%  BRANCH_FALSE_8           GET_SCOPED_NAME          NEW                      PUT_SCOPED_NAME
+   2.05%  NEW                      PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   2.05%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          NEW
+   1.70%  BRANCH_FALSE_8           GET_SCOPED_NAME          DUP                      INC_NUM
+   1.70%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          DUP
+   1.02%  COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_INT                 GET_SCOPED_NAME
+   1.02%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_INT
+   0.89%  LOAD_INT                 GET_SCOPED_NAME          PUT_OBJ_NAME             GET_SCOPED_NAME
+   0.89%  PUT_OBJ_NAME             GET_SCOPED_NAME          DUP                      INC_NUM
+   0.89%  GET_SCOPED_NAME          PUT_OBJ_NAME             GET_SCOPED_NAME          DUP
+   0.89%  BRANCH_FALSE_8           LOAD_INT                 GET_SCOPED_NAME          PUT_OBJ_NAME
+   0.85%  GET_OBJ_NAME             GET_SCOPED_NAME          PUT_OBJ_NAME             GET_SCOPED_NAME
+   0.85%  GET_SCOPED_NAME          PUT_OBJ_NAME             GET_SCOPED_NAME          GET_OBJ_NAME
+   0.85%  GET_SCOPED_NAME          GET_OBJ_NAME             GET_SCOPED_NAME          PUT_OBJ_NAME
+   0.85%  PUT_OBJ_NAME             GET_SCOPED_NAME          GET_OBJ_NAME             GET_SCOPED_NAME
+   0.68%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.68%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_SCOPED_NAME
+   0.51%  GET_SCOPED_NAME          LOAD_2                   REM                      BRANCH_FALSE_8
+   0.51%  REM                      BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_2
+   0.51%  LOAD_2                   REM                      BRANCH_FALSE_8           GET_SCOPED_NAME
+   0.51%  BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_2                   DIV_NUM
+   0.51%  DIV_NUM                  BRANCH_FALSE_8           GET_SCOPED_NAME          PUT_SCOPED_NAME
+   0.51%  GET_SCOPED_NAME          LOAD_2                   DIV_NUM                  BRANCH_FALSE_8
+   0.51%  BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_2                   REM
+   0.51%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_2
+== lookup.es
+Opcode frequency (15,578,910 instructions)
+  29.89%  GET_SCOPED_NAME
+   8.37%  PUT_SCOPED_NAME
+   8.22%  LOAD_STRING
+   6.73%  BRANCH_FALSE_8
+   6.65%  GOTO_8
+   6.57%  GET_OBJ_NAME_EXPR
+   5.08%  COMPARE_LT_NUM
+   5.01%  LOAD_INT
+   5.01%  DUP
+   5.01%  POP
+   5.01%  INC
+   3.29%  ADD_NUM
+   1.64%  PUT_OBJ_NAME_EXPR
+   1.64%  LOAD_1
+   1.64%  IN
+   0.08%  CLOSE_BLOCK
+   0.08%  OPEN_BLOCK
+   0.08%  LOAD_0
+   0.00%  ADD_NAMESPACE
+   0.00%  COMPARE_LT
+   0.00%  ADD
+   0.00%  PUT_OBJ_NAME
+   0.00%  GET_GLOBAL_SLOT
+   0.00%  CALL_OBJ_NAME
+   0.00%  DEFINE_CLASS
+   0.00%  NEW_ARRAY
+   0.00%  LOAD_REGEXP
+   0.00%  GET_OBJ_NAME
+   0.00%  DEFINE_FUNCTION
+   0.00%  CALL_SCOPED_NAME
+   0.00%  GET_LOCAL_SLOT_0
+   0.00%  RETURN
+   0.00%  PUSH_RESULT
+   0.00%  NEW_OBJECT
+   0.00%  ADD_NAMESPACE_REF
+   0.00%  NEW
+   0.00%  RETURN_VALUE
+   0.00%  CALL_CONSTRUCTOR
+   0.00%  LOAD_DOUBLE
+   0.00%  GET_LOCAL_SLOT_1
+Opcode sequence frequency (2)
+   8.22%  LOAD_STRING              GET_SCOPED_NAME
+   8.22%  GET_SCOPED_NAME          LOAD_STRING
+   5.08%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   5.01%  GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.01%  GET_SCOPED_NAME          LOAD_INT
+   5.01%  GOTO_8                   GET_SCOPED_NAME
+   5.01%  GET_SCOPED_NAME          DUP
+   5.01%  PUT_SCOPED_NAME          POP
+   5.01%  INC                      PUT_SCOPED_NAME
+   5.01%  POP                      GOTO_8
+   5.01%  DUP                      INC
+   5.01%  LOAD_INT                 COMPARE_LT_NUM
+   4.93%  BRANCH_FALSE_8           GET_SCOPED_NAME
+   4.93%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   3.36%  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   3.29%  ADD_NUM                  PUT_SCOPED_NAME
+   1.64%  PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  BRANCH_FALSE_8           LOAD_1
+   1.64%  GET_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR
+   1.64%  GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR
+   1.64%  GET_SCOPED_NAME          IN
+   1.64%  IN                       BRANCH_FALSE_8
+   1.64%  LOAD_1                   GOTO_8
+   1.64%  GOTO_8                   ADD_NUM
+   1.64%  GET_OBJ_NAME_EXPR        ADD_NUM
+   0.08%  LOAD_0                   PUT_SCOPED_NAME
+   0.08%  BRANCH_FALSE_8           CLOSE_BLOCK
+   0.08%  OPEN_BLOCK               LOAD_0
+   0.08%  BRANCH_FALSE_8           OPEN_BLOCK
+   0.08%  CLOSE_BLOCK              GET_SCOPED_NAME
+   0.08%  GET_SCOPED_NAME          COMPARE_LT_NUM
+   0.00%  COMPARE_LT               BRANCH_FALSE_8
+   0.00%  LOAD_INT                 COMPARE_LT
+   0.00%  ADD                      PUT_SCOPED_NAME
+   0.00%  GET_GLOBAL_SLOT          PUT_OBJ_NAME
+   0.00%  GET_SCOPED_NAME          CALL_OBJ_NAME
+   0.00%  BRANCH_FALSE_8           LOAD_STRING
+   0.00%  CALL_OBJ_NAME            GET_SCOPED_NAME
+   0.00%  GET_SCOPED_NAME          ADD
+Opcode sequence frequency (3)
+   8.22%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+   5.01%  INC                      PUT_SCOPED_NAME          POP
+   5.01%  DUP                      INC                      PUT_SCOPED_NAME
+   5.01%  PUT_SCOPED_NAME          POP                      GOTO_8
+   5.01%  GET_SCOPED_NAME          DUP                      INC
+   5.01%  POP                      GOTO_8                   GET_SCOPED_NAME
+   5.01%  LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8
+   5.01%  GET_SCOPED_NAME          LOAD_INT                 COMPARE_LT_NUM
+   4.93%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING
+   4.93%  GOTO_8                   GET_SCOPED_NAME          LOAD_INT
+   4.93%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.93%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   4.93%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   3.29%  LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING
+   3.29%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   3.29%  ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   1.64%  PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME          DUP
+   1.64%  IN                       BRANCH_FALSE_8           LOAD_1
+   1.64%  BRANCH_FALSE_8           LOAD_1                   GOTO_8
+   1.64%  GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  GET_SCOPED_NAME          IN                       BRANCH_FALSE_8
+   1.64%  GET_OBJ_NAME_EXPR        GET_SCOPED_NAME          IN
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  LOAD_1                   GOTO_8                   ADD_NUM
+   1.64%  GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME
+   1.64%  GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR        ADD_NUM
+   1.64%  GET_OBJ_NAME_EXPR        ADD_NUM                  PUT_SCOPED_NAME
+   0.08%  LOAD_0                   PUT_SCOPED_NAME          GET_SCOPED_NAME
+   0.08%  OPEN_BLOCK               LOAD_0                   PUT_SCOPED_NAME
+   0.08%  COMPARE_LT_NUM           BRANCH_FALSE_8           CLOSE_BLOCK
+   0.08%  BRANCH_FALSE_8           CLOSE_BLOCK              GET_SCOPED_NAME
+   0.08%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.08%  PUT_SCOPED_NAME          GET_SCOPED_NAME          LOAD_INT
+   0.08%  CLOSE_BLOCK              GET_SCOPED_NAME          DUP
+   0.08%  BRANCH_FALSE_8           OPEN_BLOCK               LOAD_0
+   0.08%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   0.08%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   0.08%  COMPARE_LT_NUM           BRANCH_FALSE_8           OPEN_BLOCK
+Opcode sequence frequency (4)
+   5.01%  DUP                      INC                      PUT_SCOPED_NAME          POP
+   5.01%  INC                      PUT_SCOPED_NAME          POP                      GOTO_8
+   5.01%  PUT_SCOPED_NAME          POP                      GOTO_8                   GET_SCOPED_NAME
+   5.01%  GET_SCOPED_NAME          DUP                      INC                      PUT_SCOPED_NAME
+   5.01%  GET_SCOPED_NAME          LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8
+   4.93%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+   4.93%  POP                      GOTO_8                   GET_SCOPED_NAME          LOAD_INT
+   4.93%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING
+   4.93%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   4.93%  GOTO_8                   GET_SCOPED_NAME          LOAD_INT                 COMPARE_LT_NUM
+   4.93%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.93%  LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   3.29%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING
+   3.29%  LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+   3.29%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP                      INC
+   3.29%  ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   1.64%  PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME          DUP                      INC
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_SCOPED_NAME          IN
+   1.64%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR
+   1.64%  GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR        GET_SCOPED_NAME          DUP
+   1.64%  GET_SCOPED_NAME          IN                       BRANCH_FALSE_8           LOAD_1
+   1.64%  IN                       BRANCH_FALSE_8           LOAD_1                   GOTO_8
+   1.64%  GET_OBJ_NAME_EXPR        GET_SCOPED_NAME          IN                       BRANCH_FALSE_8
+   1.64%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        PUT_OBJ_NAME_EXPR
+   1.64%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_SCOPED_NAME
+   1.64%  BRANCH_FALSE_8           LOAD_1                   GOTO_8                   ADD_NUM
+   1.64%  LOAD_1                   GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME
+   1.64%  GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   1.64%  GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR        ADD_NUM                  PUT_SCOPED_NAME
+   1.64%  GET_OBJ_NAME_EXPR        ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   1.64%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        GET_OBJ_NAME_EXPR        ADD_NUM
+   0.08%  OPEN_BLOCK               LOAD_0                   PUT_SCOPED_NAME          GET_SCOPED_NAME
+   0.08%  LOAD_0                   PUT_SCOPED_NAME          GET_SCOPED_NAME          LOAD_INT
+   0.08%  COMPARE_LT_NUM           BRANCH_FALSE_8           CLOSE_BLOCK              GET_SCOPED_NAME
+   0.08%  LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8           CLOSE_BLOCK
+   0.08%  BRANCH_FALSE_8           OPEN_BLOCK               LOAD_0                   PUT_SCOPED_NAME
+   0.08%  CLOSE_BLOCK              GET_SCOPED_NAME          DUP                      INC
+   0.08%  BRANCH_FALSE_8           CLOSE_BLOCK              GET_SCOPED_NAME          DUP
+   0.08%  POP                      GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+== string.es
+Opcode frequency (594,838 instructions)
+  27.19%  GET_SCOPED_NAME
+  10.90%  PUT_SCOPED_NAME
+   5.72%  PUSH_RESULT
+   5.72%  CALL_OBJ_NAME
+   5.71%  ADD_NUM
+   5.45%  BRANCH_FALSE_8
+   5.45%  GOTO_8
+   5.11%  DUP
+   5.11%  POP
+   5.11%  INC
+   5.09%  COMPARE_LT_NUM
+   3.71%  GET_OBJ_NAME
+   3.47%  LOAD_INT
+   3.36%  MUL_NUM
+   2.18%  LOAD_STRING
+   0.34%  LOAD_1
+   0.14%  ADD
+   0.07%  ADD_CHAIN
+   0.02%  ADD_NAMESPACE
+   0.02%  COMPARE_LT
+   0.02%  PUT_OBJ_NAME
+   0.02%  GET_GLOBAL_SLOT
+   0.01%  DEFINE_CLASS
+   0.01%  CLOSE_BLOCK
+   0.01%  OPEN_BLOCK
+   0.01%  NEW_ARRAY
+   0.01%  LOAD_REGEXP
+   0.01%  CALL_SCOPED_NAME
+   0.01%  GET_LOCAL_SLOT_0
+   0.00%  DEFINE_FUNCTION
+   0.00%  RETURN
+   0.00%  LOAD_0
+   0.00%  NEW
+   0.00%  NEW_OBJECT
+   0.00%  RETURN_VALUE
+   0.00%  ADD_NAMESPACE_REF
+   0.00%  CALL_CONSTRUCTOR
+   0.00%  DIV
+   0.00%  GET_LOCAL_SLOT_3
+   0.00%  REM
+Opcode sequence frequency (2)
+  11.10%  GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.79%  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   5.72%  CALL_OBJ_NAME            PUSH_RESULT
+   5.71%  ADD_NUM                  PUT_SCOPED_NAME
+   5.11%  BRANCH_FALSE_8           GET_SCOPED_NAME
+   5.11%  GOTO_8                   GET_SCOPED_NAME
+   5.11%  GET_SCOPED_NAME          DUP
+   5.11%  PUT_SCOPED_NAME          POP
+   5.11%  INC                      PUT_SCOPED_NAME
+   5.11%  POP                      GOTO_8
+   5.11%  DUP                      INC
+   5.09%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   3.70%  PUSH_RESULT              GET_OBJ_NAME
+   3.70%  GET_SCOPED_NAME          CALL_OBJ_NAME
+   3.70%  GET_OBJ_NAME             ADD_NUM
+   3.43%  GET_SCOPED_NAME          LOAD_INT
+   3.36%  MUL_NUM                  COMPARE_LT_NUM
+   3.36%  LOAD_INT                 MUL_NUM
+   2.09%  GET_SCOPED_NAME          LOAD_STRING
+   2.02%  LOAD_STRING              CALL_OBJ_NAME
+   1.68%  GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.68%  PUSH_RESULT              ADD_NUM
+   0.34%  BRANCH_FALSE_8           LOAD_1
+   0.34%  PUSH_RESULT              BRANCH_FALSE_8
+   0.34%  LOAD_1                   GOTO_8
+   0.34%  GOTO_8                   ADD_NUM
+   0.07%  LOAD_STRING              GET_SCOPED_NAME
+   0.07%  ADD                      PUT_SCOPED_NAME
+   0.07%  GET_SCOPED_NAME          ADD_CHAIN
+   0.07%  LOAD_STRING              ADD
+   0.07%  ADD_CHAIN                LOAD_STRING
+   0.07%  ADD                      ADD
+   0.05%  LOAD_INT                 COMPARE_LT_NUM
+   0.02%  COMPARE_LT               BRANCH_FALSE_8
+   0.02%  LOAD_INT                 COMPARE_LT
+   0.01%  GET_GLOBAL_SLOT          PUT_OBJ_NAME
+   0.01%  LOAD_INT                 LOAD_STRING
+   0.01%  OPEN_BLOCK               ADD_NAMESPACE
+   0.01%  ADD_NAMESPACE            ADD_NAMESPACE
+   0.01%  CLOSE_BLOCK              OPEN_BLOCK
+Opcode sequence frequency (3)
+   5.71%  ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   5.11%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   5.11%  INC                      PUT_SCOPED_NAME          POP
+   5.11%  DUP                      INC                      PUT_SCOPED_NAME
+   5.11%  PUT_SCOPED_NAME          POP                      GOTO_8
+   5.11%  GET_SCOPED_NAME          DUP                      INC
+   5.11%  POP                      GOTO_8                   GET_SCOPED_NAME
+   5.09%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   5.04%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.04%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   3.70%  GET_SCOPED_NAME          CALL_OBJ_NAME            PUSH_RESULT
+   3.70%  GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_OBJ_NAME
+   3.70%  CALL_OBJ_NAME            PUSH_RESULT              GET_OBJ_NAME
+   3.70%  GET_OBJ_NAME             ADD_NUM                  PUT_SCOPED_NAME
+   3.70%  PUSH_RESULT              GET_OBJ_NAME             ADD_NUM
+   3.36%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_INT
+   3.36%  LOAD_INT                 MUL_NUM                  COMPARE_LT_NUM
+   3.36%  MUL_NUM                  COMPARE_LT_NUM           BRANCH_FALSE_8
+   3.36%  GET_SCOPED_NAME          LOAD_INT                 MUL_NUM
+   2.02%  LOAD_STRING              CALL_OBJ_NAME            PUSH_RESULT
+   2.02%  GET_SCOPED_NAME          LOAD_STRING              CALL_OBJ_NAME
+   2.02%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING
+   1.68%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.68%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.68%  PUSH_RESULT              ADD_NUM                  PUT_SCOPED_NAME
+   1.68%  CALL_OBJ_NAME            PUSH_RESULT              ADD_NUM
+   0.67%  PUT_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.34%  BRANCH_FALSE_8           LOAD_1                   GOTO_8
+   0.34%  PUSH_RESULT              BRANCH_FALSE_8           LOAD_1
+   0.34%  GET_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.34%  CALL_OBJ_NAME            PUSH_RESULT              BRANCH_FALSE_8
+   0.34%  LOAD_1                   GOTO_8                   ADD_NUM
+   0.34%  GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME
+   0.07%  ADD                      PUT_SCOPED_NAME          GET_SCOPED_NAME
+   0.07%  ADD_CHAIN                LOAD_STRING              ADD
+   0.07%  BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_STRING
+   0.07%  GET_SCOPED_NAME          ADD_CHAIN                LOAD_STRING
+   0.07%  LOAD_STRING              GET_SCOPED_NAME          ADD_CHAIN
+   0.07%  GOTO_8                   GET_SCOPED_NAME          LOAD_INT
+   0.07%  ADD                      ADD                      PUT_SCOPED_NAME
+Opcode sequence frequency (4)
+   5.11%  DUP                      INC                      PUT_SCOPED_NAME          POP
+   5.11%  INC                      PUT_SCOPED_NAME          POP                      GOTO_8
+   5.11%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP                      INC
+   5.11%  PUT_SCOPED_NAME          POP                      GOTO_8                   GET_SCOPED_NAME
+   5.11%  GET_SCOPED_NAME          DUP                      INC                      PUT_SCOPED_NAME
+   5.04%  POP                      GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.04%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   5.04%  ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   3.70%  GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_OBJ_NAME            PUSH_RESULT
+   3.70%  GET_OBJ_NAME             ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   3.70%  PUSH_RESULT              GET_OBJ_NAME             ADD_NUM                  PUT_SCOPED_NAME
+   3.70%  CALL_OBJ_NAME            PUSH_RESULT              GET_OBJ_NAME             ADD_NUM
+   3.36%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_INT
+   3.36%  GET_SCOPED_NAME          LOAD_INT                 MUL_NUM                  COMPARE_LT_NUM
+   3.36%  GET_SCOPED_NAME          CALL_OBJ_NAME            PUSH_RESULT              GET_OBJ_NAME
+   3.36%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_OBJ_NAME
+   3.36%  LOAD_INT                 MUL_NUM                  COMPARE_LT_NUM           BRANCH_FALSE_8
+   3.36%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_INT                 MUL_NUM
+   3.36%  MUL_NUM                  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   2.02%  GET_SCOPED_NAME          LOAD_STRING              CALL_OBJ_NAME            PUSH_RESULT
+   2.02%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING              CALL_OBJ_NAME
+   1.68%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.68%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.68%  CALL_OBJ_NAME            PUSH_RESULT              ADD_NUM                  PUT_SCOPED_NAME
+   1.68%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   1.68%  PUSH_RESULT              ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   1.34%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING
+   1.34%  LOAD_STRING              CALL_OBJ_NAME            PUSH_RESULT              ADD_NUM
+   0.67%  PUT_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_STRING
+   0.67%  ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.34%  GET_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME          CALL_OBJ_NAME
+   0.34%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.34%  LOAD_STRING              CALL_OBJ_NAME            PUSH_RESULT              GET_OBJ_NAME
+   0.34%  CALL_OBJ_NAME            PUSH_RESULT              BRANCH_FALSE_8           LOAD_1
+   0.34%  PUSH_RESULT              BRANCH_FALSE_8           LOAD_1                   GOTO_8
+   0.34%  LOAD_STRING              CALL_OBJ_NAME            PUSH_RESULT              BRANCH_FALSE_8
+   0.34%  GET_SCOPED_NAME          CALL_OBJ_NAME            PUSH_RESULT              ADD_NUM
+   0.34%  BRANCH_FALSE_8           LOAD_1                   GOTO_8                   ADD_NUM
+   0.34%  LOAD_1                   GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME
+   0.34%  GOTO_8                   ADD_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+== concat.es
+Opcode frequency (2,646,461 instructions)
+  20.60%  GET_SCOPED_NAME
+  19.65%  ADD_CHAIN
+  19.09%  LOAD_STRING
+   6.61%  PUT_SCOPED_NAME
+   4.16%  ADD
+   3.40%  BRANCH_FALSE_8
+   3.40%  COMPARE_LT_NUM
+   3.21%  DUP
+   3.21%  GOTO_8
+   3.21%  POP
+   3.21%  INC
+   2.27%  GET_OBJ_NAME_EXPR
+   2.09%  LOAD_INT
+   1.89%  LOAD_7
+   1.89%  MUL_NUM
+   1.32%  GET_OBJ_NAME
+   0.19%  CLOSE_BLOCK
+   0.19%  OPEN_BLOCK
+   0.19%  LOAD_0
+   0.19%  DIV_NUM
+   0.00%  ADD_NAMESPACE
+   0.00%  COMPARE_LT
+   0.00%  MUL
+   0.00%  PUT_OBJ_NAME
+   0.00%  GET_GLOBAL_SLOT
+   0.00%  DEFINE_CLASS
+   0.00%  NEW_ARRAY
+   0.00%  LOAD_REGEXP
+   0.00%  DEFINE_FUNCTION
+   0.00%  CALL_SCOPED_NAME
+   0.00%  GET_LOCAL_SLOT_0
+   0.00%  RETURN
+   0.00%  PUSH_RESULT
+   0.00%  NEW_OBJECT
+   0.00%  ADD_NAMESPACE_REF
+   0.00%  NEW
+   0.00%  RETURN_VALUE
+   0.00%  CALL_CONSTRUCTOR
+   0.00%  LOAD_DOUBLE
+   0.00%  DIV
+Opcode sequence frequency (2)
+  11.71%  ADD_CHAIN                LOAD_STRING
+  10.58%  LOAD_STRING              ADD_CHAIN
+   6.05%  ADD_CHAIN                GET_SCOPED_NAME
+   3.40%  LOAD_STRING              GET_SCOPED_NAME
+   3.40%  GET_SCOPED_NAME          GET_SCOPED_NAME
+   3.40%  GET_SCOPED_NAME          LOAD_STRING
+   3.40%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   3.21%  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   3.21%  GOTO_8                   GET_SCOPED_NAME
+   3.21%  GET_SCOPED_NAME          DUP
+   3.21%  PUT_SCOPED_NAME          POP
+   3.21%  INC                      PUT_SCOPED_NAME
+   3.21%  POP                      GOTO_8
+   3.21%  DUP                      INC
+   3.02%  GET_SCOPED_NAME          ADD_CHAIN
+   3.02%  ADD                      PUT_SCOPED_NAME
+   3.02%  LOAD_STRING              ADD
+   2.27%  GET_OBJ_NAME_EXPR        ADD_CHAIN
+   2.27%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   2.08%  BRANCH_FALSE_8           LOAD_STRING
+   1.89%  LOAD_STRING              LOAD_STRING
+   1.89%  ADD_CHAIN                LOAD_INT
+   1.89%  LOAD_INT                 ADD_CHAIN
+   1.89%  GET_SCOPED_NAME          LOAD_7
+   1.89%  GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.89%  MUL_NUM                  ADD_CHAIN
+   1.89%  LOAD_7                   MUL_NUM
+   1.32%  GET_SCOPED_NAME          GET_OBJ_NAME
+   1.32%  GET_OBJ_NAME             COMPARE_LT_NUM
+   1.13%  BRANCH_FALSE_8           GET_SCOPED_NAME
+   1.13%  ADD                      ADD
+   0.19%  BRANCH_FALSE_8           CLOSE_BLOCK
+   0.19%  LOAD_STRING              PUT_SCOPED_NAME
+   0.19%  LOAD_0                   PUT_SCOPED_NAME
+   0.19%  GET_SCOPED_NAME          LOAD_INT
+   0.19%  OPEN_BLOCK               LOAD_0
+   0.19%  PUT_SCOPED_NAME          OPEN_BLOCK
+   0.19%  LOAD_INT                 DIV_NUM
+   0.19%  DIV_NUM                  COMPARE_LT_NUM
+   0.19%  CLOSE_BLOCK              GET_SCOPED_NAME
+Opcode sequence frequency (3)
+   8.69%  ADD_CHAIN                LOAD_STRING              ADD_CHAIN
+   4.91%  LOAD_STRING              ADD_CHAIN                GET_SCOPED_NAME
+   3.78%  LOAD_STRING              ADD_CHAIN                LOAD_STRING
+   3.40%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+   3.21%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   3.21%  INC                      PUT_SCOPED_NAME          POP
+   3.21%  DUP                      INC                      PUT_SCOPED_NAME
+   3.21%  PUT_SCOPED_NAME          POP                      GOTO_8
+   3.21%  GET_SCOPED_NAME          DUP                      INC
+   3.21%  POP                      GOTO_8                   GET_SCOPED_NAME
+   3.02%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   3.02%  ADD_CHAIN                LOAD_STRING              ADD
+   3.02%  ADD                      PUT_SCOPED_NAME          GET_SCOPED_NAME
+   3.02%  ADD_CHAIN                GET_SCOPED_NAME          ADD_CHAIN
+   3.02%  GET_SCOPED_NAME          ADD_CHAIN                LOAD_STRING
+   2.27%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   2.27%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        ADD_CHAIN
+   2.07%  COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_STRING
+   1.89%  BRANCH_FALSE_8           LOAD_STRING              LOAD_STRING
+   1.89%  LOAD_STRING              ADD                      PUT_SCOPED_NAME
+   1.89%  ADD_CHAIN                LOAD_INT                 ADD_CHAIN
+   1.89%  LOAD_STRING              ADD_CHAIN                LOAD_INT
+   1.89%  LOAD_INT                 ADD_CHAIN                LOAD_STRING
+   1.89%  ADD_CHAIN                GET_SCOPED_NAME          LOAD_7
+   1.89%  LOAD_STRING              LOAD_STRING              ADD_CHAIN
+   1.89%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.89%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.89%  GET_SCOPED_NAME          LOAD_7                   MUL_NUM
+   1.89%  LOAD_7                   MUL_NUM                  ADD_CHAIN
+   1.89%  MUL_NUM                  ADD_CHAIN                LOAD_STRING
+   1.32%  GET_SCOPED_NAME          GET_SCOPED_NAME          GET_OBJ_NAME
+   1.32%  GET_SCOPED_NAME          GET_OBJ_NAME             COMPARE_LT_NUM
+   1.32%  GET_OBJ_NAME             COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.13%  LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING
+   1.13%  BRANCH_FALSE_8           GET_SCOPED_NAME          LOAD_STRING
+   1.13%  GET_OBJ_NAME_EXPR        ADD_CHAIN                GET_SCOPED_NAME
+   1.13%  GET_OBJ_NAME_EXPR        ADD_CHAIN                LOAD_STRING
+   1.13%  ADD                      ADD                      PUT_SCOPED_NAME
+   1.13%  LOAD_STRING              ADD                      ADD
+   1.13%  ADD_CHAIN                GET_SCOPED_NAME          LOAD_STRING
+Opcode sequence frequency (4)
+   4.91%  ADD_CHAIN                LOAD_STRING              ADD_CHAIN                GET_SCOPED_NAME
+   3.78%  LOAD_STRING              ADD_CHAIN                LOAD_STRING              ADD_CHAIN
+   3.21%  DUP                      INC                      PUT_SCOPED_NAME          POP
+   3.21%  INC                      PUT_SCOPED_NAME          POP                      GOTO_8
+   3.21%  PUT_SCOPED_NAME          POP                      GOTO_8                   GET_SCOPED_NAME
+   3.21%  GET_SCOPED_NAME          DUP                      INC                      PUT_SCOPED_NAME
+   3.21%  POP                      GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   3.02%  ADD                      PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   3.02%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP                      INC
+   3.02%  ADD_CHAIN                GET_SCOPED_NAME          ADD_CHAIN                LOAD_STRING
+   2.27%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR
+   2.27%  LOAD_STRING              GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        ADD_CHAIN
+   1.89%  LOAD_STRING              LOAD_STRING              ADD_CHAIN                LOAD_STRING
+   1.89%  ADD_CHAIN                LOAD_STRING              ADD                      PUT_SCOPED_NAME
+   1.89%  LOAD_STRING              ADD                      PUT_SCOPED_NAME          GET_SCOPED_NAME
+   1.89%  ADD_CHAIN                LOAD_INT                 ADD_CHAIN                LOAD_STRING
+   1.89%  LOAD_STRING              ADD_CHAIN                LOAD_INT                 ADD_CHAIN
+   1.89%  ADD_CHAIN                LOAD_STRING              ADD_CHAIN                LOAD_INT
+   1.89%  LOAD_STRING              ADD_CHAIN                GET_SCOPED_NAME          ADD_CHAIN
+   1.89%  LOAD_STRING              ADD_CHAIN                GET_SCOPED_NAME          LOAD_7
+   1.89%  LOAD_INT                 ADD_CHAIN                LOAD_STRING              ADD_CHAIN
+   1.89%  BRANCH_FALSE_8           LOAD_STRING              LOAD_STRING              ADD_CHAIN
+   1.89%  GET_SCOPED_NAME          ADD_CHAIN                LOAD_STRING              ADD_CHAIN
+   1.89%  ADD_CHAIN                LOAD_STRING              ADD_CHAIN                LOAD_STRING
+   1.89%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   1.89%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.89%  GET_SCOPED_NAME          LOAD_7                   MUL_NUM                  ADD_CHAIN
+   1.89%  COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_STRING              LOAD_STRING
+   1.89%  LOAD_7                   MUL_NUM                  ADD_CHAIN                LOAD_STRING
+   1.89%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8           LOAD_STRING
+   1.89%  MUL_NUM                  ADD_CHAIN                LOAD_STRING              ADD
+   1.89%  ADD_CHAIN                GET_SCOPED_NAME          LOAD_7                   MUL_NUM
+   1.32%  GET_SCOPED_NAME          GET_SCOPED_NAME          GET_OBJ_NAME             COMPARE_LT_NUM
+   1.32%  GET_SCOPED_NAME          GET_OBJ_NAME             COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.13%  ADD_CHAIN                GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+   1.13%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        ADD_CHAIN                LOAD_STRING
+   1.13%  ADD_CHAIN                LOAD_STRING              ADD                      ADD
+   1.13%  GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING
+   1.13%  GET_SCOPED_NAME          GET_OBJ_NAME_EXPR        ADD_CHAIN                GET_SCOPED_NAME
+   1.13%  LOAD_STRING              GET_SCOPED_NAME          LOAD_STRING              GET_SCOPED_NAME
+== quicken.es
+Opcode frequency (50,037,756 instructions)
+  27.54%  GET_SCOPED_NAME
+  10.07%  PUT_SCOPED_NAME
+   6.99%  MUL_NUM
+   5.71%  ADD_NUM
+   5.52%  BRANCH_FALSE_8
+   5.25%  LOAD_2
+   5.02%  DUP
+   5.01%  POP
+   5.01%  COMPARE_LT_NUM
+   5.01%  SUB_NUM
+   4.74%  GOTO_8
+   4.51%  INC
+   4.26%  LOAD_1
+   1.21%  GET_LOCAL_SLOT_0
+   0.53%  LOAD_INT
+   0.50%  LOAD_4
+   0.50%  COMPARE_LE_NUM
+   0.49%  CLOSE_BLOCK
+   0.49%  OPEN_BLOCK
+   0.49%  CALL_SCOPED_NAME
+   0.49%  PUSH_RESULT
+   0.49%  RETURN_VALUE
+   0.06%  LOAD_0
+   0.04%  DIV_NUM
+   0.02%  BRANCH_FALSE
+   0.02%  GOTO
+   0.02%  LOAD_DOUBLE
+   0.02%  COMPARE_EQ_NUM
+   0.00%  MUL
+   0.00%  ADD
+   0.00%  COMPARE_LT
+   0.00%  SUB
+   0.00%  LOAD_STRING
+   0.00%  ADD_NAMESPACE
+   0.00%  COMPARE_LE
+   0.00%  PUT_OBJ_NAME
+   0.00%  GET_GLOBAL_SLOT
+   0.00%  DEFINE_CLASS
+   0.00%  DIV
+   0.00%  NEW_ARRAY
+Opcode sequence frequency (2)
+   9.99%  GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.99%  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   4.51%  GET_SCOPED_NAME          DUP
+   4.51%  PUT_SCOPED_NAME          POP
+   4.51%  INC                      PUT_SCOPED_NAME
+   4.51%  DUP                      INC
+   4.50%  MUL_NUM                  ADD_NUM
+   4.49%  GOTO_8                   GET_SCOPED_NAME
+   4.48%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   4.26%  LOAD_1                   SUB_NUM
+   4.04%  BRANCH_FALSE_8           GET_SCOPED_NAME
+   4.04%  SUB_NUM                  PUT_SCOPED_NAME
+   4.02%  GET_SCOPED_NAME          COMPARE_LT_NUM
+   4.00%  POP                      GOTO_8
+   4.00%  GET_SCOPED_NAME          LOAD_2
+   4.00%  ADD_NUM                  LOAD_1
+   4.00%  LOAD_2                   MUL_NUM
+   2.99%  GET_SCOPED_NAME          MUL_NUM
+   2.00%  MUL_NUM                  GET_SCOPED_NAME
+   0.98%  GET_SCOPED_NAME          ADD_NUM
+   0.98%  ADD_NUM                  PUT_SCOPED_NAME
+   0.73%  GET_LOCAL_SLOT_0         LOAD_2
+   0.53%  LOAD_2                   GET_SCOPED_NAME
+   0.53%  GET_SCOPED_NAME          LOAD_INT
+   0.51%  PUT_SCOPED_NAME          LOAD_2
+   0.51%  DUP                      BRANCH_FALSE_8
+   0.51%  LOAD_INT                 COMPARE_LT_NUM
+   0.51%  COMPARE_LT_NUM           DUP
+   0.50%  POP                      GET_SCOPED_NAME
+   0.50%  BRANCH_FALSE_8           POP
+   0.50%  ADD_NUM                  LOAD_4
+   0.50%  COMPARE_LE_NUM           BRANCH_FALSE_8
+   0.50%  LOAD_4                   COMPARE_LE_NUM
+   0.49%  GET_SCOPED_NAME          PUT_SCOPED_NAME
+   0.49%  OPEN_BLOCK               GET_SCOPED_NAME
+   0.49%  BRANCH_FALSE_8           OPEN_BLOCK
+   0.49%  CLOSE_BLOCK              GOTO_8
+   0.49%  POP                      CLOSE_BLOCK
+   0.49%  SUB_NUM                  GET_SCOPED_NAME
+   0.49%  MUL_NUM                  SUB_NUM
+Opcode sequence frequency (3)
+   4.51%  INC                      PUT_SCOPED_NAME          POP
+   4.51%  DUP                      INC                      PUT_SCOPED_NAME
+   4.51%  GET_SCOPED_NAME          DUP                      INC
+   4.48%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   4.02%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   4.02%  LOAD_1                   SUB_NUM                  PUT_SCOPED_NAME
+   4.00%  PUT_SCOPED_NAME          POP                      GOTO_8
+   4.00%  POP                      GOTO_8                   GET_SCOPED_NAME
+   4.00%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.00%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.00%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_2
+   4.00%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   4.00%  LOAD_2                   MUL_NUM                  ADD_NUM
+   4.00%  ADD_NUM                  LOAD_1                   SUB_NUM
+   4.00%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   4.00%  MUL_NUM                  ADD_NUM                  LOAD_1
+   4.00%  GET_SCOPED_NAME          LOAD_2                   MUL_NUM
+   4.00%  SUB_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   2.00%  GET_SCOPED_NAME          MUL_NUM                  GET_SCOPED_NAME
+   1.97%  GET_SCOPED_NAME          GET_SCOPED_NAME          MUL_NUM
+   0.99%  MUL_NUM                  GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.98%  GET_SCOPED_NAME          ADD_NUM                  PUT_SCOPED_NAME
+   0.53%  LOAD_2                   GET_SCOPED_NAME          MUL_NUM
+   0.51%  PUT_SCOPED_NAME          LOAD_2                   GET_SCOPED_NAME
+   0.51%  LOAD_INT                 COMPARE_LT_NUM           DUP
+   0.51%  COMPARE_LT_NUM           DUP                      BRANCH_FALSE_8
+   0.51%  GET_SCOPED_NAME          LOAD_INT                 COMPARE_LT_NUM
+   0.50%  POP                      GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.50%  BRANCH_FALSE_8           POP                      GET_SCOPED_NAME
+   0.50%  DUP                      BRANCH_FALSE_8           POP
+   0.50%  ADD_NUM                  LOAD_4                   COMPARE_LE_NUM
+   0.50%  LOAD_4                   COMPARE_LE_NUM           BRANCH_FALSE_8
+   0.50%  MUL_NUM                  ADD_NUM                  LOAD_4
+   0.50%  GET_SCOPED_NAME          MUL_NUM                  ADD_NUM
+   0.49%  BRANCH_FALSE_8           OPEN_BLOCK               GET_SCOPED_NAME
+   0.49%  POP                      CLOSE_BLOCK              GOTO_8
+   0.49%  PUT_SCOPED_NAME          GET_SCOPED_NAME          PUT_SCOPED_NAME
+   0.49%  GET_SCOPED_NAME          PUT_SCOPED_NAME          GET_SCOPED_NAME
+   0.49%  OPEN_BLOCK               GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.49%  GOTO_8                   GET_SCOPED_NAME          LOAD_INT
+Opcode sequence frequency (4)
+   4.51%  DUP                      INC                      PUT_SCOPED_NAME          POP
+   4.51%  GET_SCOPED_NAME          DUP                      INC                      PUT_SCOPED_NAME
+   4.48%  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP                      INC
+   4.00%  INC                      PUT_SCOPED_NAME          POP                      GOTO_8
+   4.00%  PUT_SCOPED_NAME          POP                      GOTO_8                   GET_SCOPED_NAME
+   4.00%  BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_2
+   4.00%  POP                      GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.00%  GOTO_8                   GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM
+   4.00%  GET_SCOPED_NAME          GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8
+   4.00%  LOAD_1                   SUB_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME
+   4.00%  ADD_NUM                  LOAD_1                   SUB_NUM                  PUT_SCOPED_NAME
+   4.00%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME          GET_SCOPED_NAME
+   4.00%  SUB_NUM                  PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+   4.00%  GET_SCOPED_NAME          COMPARE_LT_NUM           BRANCH_FALSE_8           GET_SCOPED_NAME
+   4.00%  GET_SCOPED_NAME          GET_SCOPED_NAME          LOAD_2                   MUL_NUM
+   4.00%  MUL_NUM                  ADD_NUM                  LOAD_1                   SUB_NUM
+   4.00%  LOAD_2                   MUL_NUM                  ADD_NUM                  LOAD_1
+   4.00%  GET_SCOPED_NAME          LOAD_2                   MUL_NUM                  ADD_NUM
+   0.99%  GET_SCOPED_NAME          MUL_NUM                  GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.99%  GET_SCOPED_NAME          GET_SCOPED_NAME          MUL_NUM                  GET_SCOPED_NAME
+   0.99%  MUL_NUM                  GET_SCOPED_NAME          GET_SCOPED_NAME          MUL_NUM
+   0.53%  LOAD_2                   GET_SCOPED_NAME          MUL_NUM                  GET_SCOPED_NAME
+   0.51%  GET_SCOPED_NAME          LOAD_INT                 COMPARE_LT_NUM           DUP
+   0.51%  LOAD_INT                 COMPARE_LT_NUM           DUP                      BRANCH_FALSE_8
+   0.51%  PUT_SCOPED_NAME          LOAD_2                   GET_SCOPED_NAME          MUL_NUM
+   0.50%  DUP                      BRANCH_FALSE_8           POP                      GET_SCOPED_NAME
+   0.50%  BRANCH_FALSE_8           POP                      GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.50%  MUL_NUM                  ADD_NUM                  LOAD_4                   COMPARE_LE_NUM
+   0.50%  GET_SCOPED_NAME          GET_SCOPED_NAME          MUL_NUM                  ADD_NUM
+   0.50%  POP                      GET_SCOPED_NAME          GET_SCOPED_NAME          MUL_NUM
+   0.50%  GET_SCOPED_NAME          MUL_NUM                  ADD_NUM                  LOAD_4
+   0.50%  ADD_NUM                  LOAD_4                   COMPARE_LE_NUM           BRANCH_FALSE_8
+   0.50%  COMPARE_LT_NUM           DUP                      BRANCH_FALSE_8           POP
+   0.49%  PUT_SCOPED_NAME          POP                      CLOSE_BLOCK              GOTO_8
+   0.49%  INC                      PUT_SCOPED_NAME          POP                      CLOSE_BLOCK
+   0.49%  POP                      CLOSE_BLOCK              GOTO_8                   GET_SCOPED_NAME
+   0.49%  PUT_SCOPED_NAME          GET_SCOPED_NAME          PUT_SCOPED_NAME          GET_SCOPED_NAME
+   0.49%  CLOSE_BLOCK              GOTO_8                   GET_SCOPED_NAME          LOAD_INT
+   0.49%  BRANCH_FALSE_8           OPEN_BLOCK               GET_SCOPED_NAME          GET_SCOPED_NAME
+   0.49%  GET_SCOPED_NAME          PUT_SCOPED_NAME          GET_SCOPED_NAME          DUP
+== locals.es
+Opcode frequency (27,180,913 instructions)
+   7.95%  BRANCH_FALSE_8
+   7.39%  GET_LOCAL_SLOT_2
+   7.34%  GOTO_8
+   6.92%  GET_LOCAL_SLOT_0
+   5.54%  GET_LOCAL_SLOT_3
+   5.54%  DUP
+   5.54%  POP
+   5.54%  INC
+   5.48%  GET_LOCAL_SLOT_1
+   5.48%  PUT_LOCAL_SLOT_1
+   4.27%  COMPARE_LT_NUM
+   3.92%  LOAD_1
+   3.92%  ADD_NUM
+   3.70%  LOAD_INT
+   3.68%  COMPARE_GT_NUM
+   2.39%  SUB_NUM
+   1.86%  LOAD_0
+   1.86%  PUT_LOCAL_SLOT_3
+   1.86%  PUT_LOCAL_SLOT_2
+   1.84%  PUT_LOCAL_SLOT_0
+   1.84%  GET_LOCAL_SLOT_4
+   1.84%  PUT_LOCAL_SLOT_4
+   1.84%  MUL_NUM
+   0.83%  LOAD_2
+   0.55%  CALL_SCOPED_NAME
+   0.55%  PUSH_RESULT
+   0.55%  RETURN_VALUE
+   0.00%  COMPARE_LT
+   0.00%  SUB
+   0.00%  COMPARE_GT
+   0.00%  ADD
+   0.00%  LOAD_STRING
+   0.00%  ADD_NAMESPACE
+   0.00%  GET_SCOPED_NAME
+   0.00%  MUL
+   0.00%  PUT_OBJ_NAME
+   0.00%  GET_GLOBAL_SLOT
+   0.00%  DEFINE_CLASS
+   0.00%  CLOSE_BLOCK
+   0.00%  OPEN_BLOCK
+Opcode sequence frequency (2)
+   5.54%  POP                      GOTO_8
+   5.54%  DUP                      INC
+   4.27%  COMPARE_LT_NUM           BRANCH_FALSE_8
+   3.68%  COMPARE_GT_NUM           BRANCH_FALSE_8
+   3.64%  BRANCH_FALSE_8           GET_LOCAL_SLOT_1
+   3.64%  GOTO_8                   GET_LOCAL_SLOT_3
+   3.64%  ADD_NUM                  PUT_LOCAL_SLOT_1
+   2.39%  BRANCH_FALSE_8           GET_LOCAL_SLOT_0
+   2.12%  GET_LOCAL_SLOT_0         LOAD_1
+   2.11%  LOAD_1                   SUB_NUM
+   1.86%  GET_LOCAL_SLOT_3         LOAD_INT
+   1.86%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0
+   1.86%  GET_LOCAL_SLOT_2         DUP
+   1.86%  GOTO_8                   GET_LOCAL_SLOT_2
+   1.86%  INC                      PUT_LOCAL_SLOT_2
+   1.86%  PUT_LOCAL_SLOT_2         POP
+   1.86%  BRANCH_FALSE_8           GET_LOCAL_SLOT_2
+   1.86%  GET_LOCAL_SLOT_0         COMPARE_LT_NUM
+   1.86%  LOAD_INT                 COMPARE_LT_NUM
+   1.84%  GET_LOCAL_SLOT_0         LOAD_0
+   1.84%  GOTO_8                   GET_LOCAL_SLOT_0
+   1.84%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_3
+   1.84%  GET_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  INC                      PUT_LOCAL_SLOT_3
+   1.84%  GET_LOCAL_SLOT_3         DUP
+   1.84%  PUT_LOCAL_SLOT_1         POP
+   1.84%  GET_LOCAL_SLOT_4         LOAD_INT
+   1.84%  PUT_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  INC                      PUT_LOCAL_SLOT_1
+   1.84%  PUT_LOCAL_SLOT_0         GET_LOCAL_SLOT_1
+   1.84%  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4
+   1.84%  PUT_LOCAL_SLOT_3         POP
+   1.84%  GET_LOCAL_SLOT_1         DUP
+   1.84%  LOAD_0                   COMPARE_GT_NUM
+   1.84%  LOAD_INT                 COMPARE_GT_NUM
+   1.84%  GET_LOCAL_SLOT_2         ADD_NUM
+   1.84%  SUB_NUM                  PUT_LOCAL_SLOT_0
+   1.84%  MUL_NUM                  PUT_LOCAL_SLOT_4
+   1.84%  GET_LOCAL_SLOT_3         MUL_NUM
+   1.80%  GET_LOCAL_SLOT_1         LOAD_1
+Opcode sequence frequency (3)
+   2.12%  BRANCH_FALSE_8           GET_LOCAL_SLOT_0         LOAD_1
+   2.11%  GET_LOCAL_SLOT_0         LOAD_1                   SUB_NUM
+   1.86%  INC                      PUT_LOCAL_SLOT_2         POP
+   1.86%  DUP                      INC                      PUT_LOCAL_SLOT_2
+   1.86%  GOTO_8                   GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0
+   1.86%  POP                      GOTO_8                   GET_LOCAL_SLOT_2
+   1.86%  GET_LOCAL_SLOT_2         DUP                      INC
+   1.86%  PUT_LOCAL_SLOT_2         POP                      GOTO_8
+   1.86%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_2
+   1.86%  LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.86%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0         COMPARE_LT_NUM
+   1.86%  GET_LOCAL_SLOT_0         COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.86%  GET_LOCAL_SLOT_3         LOAD_INT                 COMPARE_LT_NUM
+   1.84%  POP                      GOTO_8                   GET_LOCAL_SLOT_0
+   1.84%  BRANCH_FALSE_8           GET_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  BRANCH_FALSE_8           GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_3
+   1.84%  PUT_LOCAL_SLOT_3         POP                      GOTO_8
+   1.84%  DUP                      INC                      PUT_LOCAL_SLOT_1
+   1.84%  INC                      PUT_LOCAL_SLOT_3         POP
+   1.84%  PUT_LOCAL_SLOT_1         GET_LOCAL_SLOT_2         DUP
+   1.84%  PUT_LOCAL_SLOT_0         GET_LOCAL_SLOT_1         DUP
+   1.84%  GET_LOCAL_SLOT_1         DUP                      INC
+   1.84%  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4         LOAD_INT
+   1.84%  PUT_LOCAL_SLOT_1         POP                      GOTO_8
+   1.84%  INC                      PUT_LOCAL_SLOT_1         POP
+   1.84%  GOTO_8                   GET_LOCAL_SLOT_3         LOAD_INT
+   1.84%  DUP                      INC                      PUT_LOCAL_SLOT_3
+   1.84%  GOTO_8                   GET_LOCAL_SLOT_0         LOAD_0
+   1.84%  GET_LOCAL_SLOT_3         DUP                      INC
+   1.84%  POP                      GOTO_8                   GET_LOCAL_SLOT_3
+   1.84%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_1
+   1.84%  LOAD_0                   COMPARE_GT_NUM           BRANCH_FALSE_8
+   1.84%  GET_LOCAL_SLOT_0         LOAD_0                   COMPARE_GT_NUM
+   1.84%  ADD_NUM                  PUT_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  MUL_NUM                  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4
+   1.84%  SUB_NUM                  PUT_LOCAL_SLOT_0         GET_LOCAL_SLOT_1
+   1.84%  GET_LOCAL_SLOT_3         MUL_NUM                  PUT_LOCAL_SLOT_4
+   1.84%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_3         MUL_NUM
+   1.84%  LOAD_1                   SUB_NUM                  PUT_LOCAL_SLOT_0
+   1.84%  GET_LOCAL_SLOT_2         ADD_NUM                  PUT_LOCAL_SLOT_1
+Opcode sequence frequency (4)
+   2.11%  BRANCH_FALSE_8           GET_LOCAL_SLOT_0         LOAD_1                   SUB_NUM
+   1.86%  GET_LOCAL_SLOT_2         DUP                      INC                      PUT_LOCAL_SLOT_2
+   1.86%  POP                      GOTO_8                   GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0
+   1.86%  DUP                      INC                      PUT_LOCAL_SLOT_2         POP
+   1.86%  INC                      PUT_LOCAL_SLOT_2         POP                      GOTO_8
+   1.86%  PUT_LOCAL_SLOT_2         POP                      GOTO_8                   GET_LOCAL_SLOT_2
+   1.86%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0         COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.86%  GOTO_8                   GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_0         COMPARE_LT_NUM
+   1.86%  LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_2
+   1.86%  GET_LOCAL_SLOT_3         LOAD_INT                 COMPARE_LT_NUM           BRANCH_FALSE_8
+   1.84%  GET_LOCAL_SLOT_1         DUP                      INC                      PUT_LOCAL_SLOT_1
+   1.84%  PUT_LOCAL_SLOT_3         POP                      GOTO_8                   GET_LOCAL_SLOT_3
+   1.84%  DUP                      INC                      PUT_LOCAL_SLOT_1         POP
+   1.84%  INC                      PUT_LOCAL_SLOT_3         POP                      GOTO_8
+   1.84%  PUT_LOCAL_SLOT_1         POP                      GOTO_8                   GET_LOCAL_SLOT_0
+   1.84%  PUT_LOCAL_SLOT_1         GET_LOCAL_SLOT_2         DUP                      INC
+   1.84%  PUT_LOCAL_SLOT_0         GET_LOCAL_SLOT_1         DUP                      INC
+   1.84%  GET_LOCAL_SLOT_3         DUP                      INC                      PUT_LOCAL_SLOT_3
+   1.84%  POP                      GOTO_8                   GET_LOCAL_SLOT_3         LOAD_INT
+   1.84%  POP                      GOTO_8                   GET_LOCAL_SLOT_0         LOAD_0
+   1.84%  INC                      PUT_LOCAL_SLOT_1         POP                      GOTO_8
+   1.84%  DUP                      INC                      PUT_LOCAL_SLOT_3         POP
+   1.84%  GET_LOCAL_SLOT_0         COMPARE_LT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_1
+   1.84%  GET_LOCAL_SLOT_0         LOAD_0                   COMPARE_GT_NUM           BRANCH_FALSE_8
+   1.84%  GOTO_8                   GET_LOCAL_SLOT_3         LOAD_INT                 COMPARE_LT_NUM
+   1.84%  GOTO_8                   GET_LOCAL_SLOT_0         LOAD_0                   COMPARE_GT_NUM
+   1.84%  MUL_NUM                  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4         LOAD_INT
+   1.84%  BRANCH_FALSE_8           GET_LOCAL_SLOT_1         GET_LOCAL_SLOT_2         ADD_NUM
+   1.84%  GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_3         MUL_NUM                  PUT_LOCAL_SLOT_4
+   1.84%  GET_LOCAL_SLOT_3         MUL_NUM                  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4
+   1.84%  LOAD_1                   SUB_NUM                  PUT_LOCAL_SLOT_0         GET_LOCAL_SLOT_1
+   1.84%  BRANCH_FALSE_8           GET_LOCAL_SLOT_2         GET_LOCAL_SLOT_3         MUL_NUM
+   1.84%  GET_LOCAL_SLOT_4         LOAD_INT                 COMPARE_GT_NUM           BRANCH_FALSE_8
+   1.84%  PUT_LOCAL_SLOT_4         GET_LOCAL_SLOT_4         LOAD_INT                 COMPARE_GT_NUM
+   1.84%  GET_LOCAL_SLOT_1         GET_LOCAL_SLOT_2         ADD_NUM                  PUT_LOCAL_SLOT_1
+   1.84%  COMPARE_LT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  COMPARE_GT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_0         LOAD_1
+   1.84%  GET_LOCAL_SLOT_2         ADD_NUM                  PUT_LOCAL_SLOT_1         GET_LOCAL_SLOT_2
+   1.84%  GET_LOCAL_SLOT_0         LOAD_1                   SUB_NUM                  PUT_LOCAL_SLOT_0
+   1.84%  LOAD_0                   COMPARE_GT_NUM           BRANCH_FALSE_8           GET_LOCAL_SLOT_0
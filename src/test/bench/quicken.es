@@ -0,0 +1,62 @@
+/*
+    quicken.es -- Benchmark runtime op code specialization of untyped code
+
+    Compare:
+        ejs quicken.es
+        ejs --noquicken quicken.es
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+function loop(n) {
+    let sum = 0
+    for (let i = 0; i < n; i++) {
+        sum = sum + i * 2 - 1
+    }
+    return sum
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2)
+}
+
+function mandel(size) {
+    let count = 0
+    for (let y = 0; y < size; y++) {
+        for (let x = 0; x < size; x++) {
+            let cr = 2 * x / size - 1.5, ci = 2 * y / size - 1
+            let zr = 0, zi = 0, i = 0
+            while (i < 50 && zr * zr + zi * zi <= 4) {
+                let t = zr * zr - zi * zi + cr
+                zi = 2 * zr * zi + ci
+                zr = t
+                i++
+            }
+            if (i == 50) {
+                count++
+            }
+        }
+    }
+    return count
+}
+
+let start = new Date
+let mark = new Date
+let count = 2000000
+loop(count)
+report("Untyped loop", count, mark)
+
+mark = new Date
+count = 25
+fib(count)
+report("Recursive fib", count, mark)
+
+mark = new Date
+count = 100
+mandel(count)
+report("Mandelbrot", count * count, mark)
+
+report("Total", 0, start)
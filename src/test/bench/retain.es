@@ -0,0 +1,20 @@
+/*
+    retain.es -- Benchmark allocation while the live heap grows. Each pass should take about the same time.
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+let start = new Date
+let keep = []
+let count = 20000
+for (let pass = 1; pass <= 5; pass++) {
+    let mark = new Date
+    for (let i = 0; i < count; i++) {
+        keep.push({ x: i, y: [i] })
+    }
+    report("Retained pass " + pass, keep.length, mark)
+}
+report("Total", 0, start)
@@ -0,0 +1,29 @@
+/*
+    startup.es -- Benchmark interpreter startup and exit for short-lived commands
+
+    Compare the VM cost of "ejs --cmd 1" against the process floor of "ejs --version":
+        ejs startup.es [count]
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+let ejs = App.exePath
+let count = (App.args[1] || 100) - 0
+
+function bench(msg, command) {
+    let mark = new Date
+    for (let i = 0; i < count; i++) {
+        Cmd.run(command)
+    }
+    report(msg, count, mark)
+}
+
+let start = new Date
+bench("Process only", [ejs, "--version"])
+bench("Startup and exit", [ejs, "--cmd", "1"])
+bench("Mapped modules", [ejs, "--map", "--cmd", "1"])
+bench("Lazy function bodies", [ejs, "--lazy", "--cmd", "1"])
+report("Total", 0, start)
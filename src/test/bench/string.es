@@ -0,0 +1,59 @@
+/*
+    string.es -- Benchmark String search, trimming and caseless comparison over long strings
+ */
+
+function report(msg, count, when) {
+    let t = when.elapsed / 10
+    print("%25s %5d.%02d (%,10d)" % [ msg, t / 100, t % 100, count])
+}
+
+let text = ""
+for (let i = 0; i < 400; i++) {
+    text += "The quick brown fox jumps over the lazy dog " + i + ". "
+}
+let upper = text.toUpperCase()
+let padded = "                                                                " + text + 
+             "                                                                "
+let count = 2000
+let sum = 0
+
+let start = new Date
+let mark = new Date
+for (let n = 0; n < count; n++) {
+    sum += text.indexOf("dog 399")
+    sum += text.indexOf("not present")
+}
+report("indexOf", count * 2, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    sum += text.lastIndexOf("The quick brown fox jumps over the lazy dog 0.")
+}
+report("lastIndexOf", count, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    sum += text.contains("fox jumps over the lazy dog 250") ? 1 : 0
+    sum += text.indexOf("#")
+}
+report("contains / char", count * 2, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    sum += text.split("399").length
+}
+report("split", count, mark)
+
+mark = new Date
+for (let n = 0; n < count; n++) {
+    sum += text.caselessCompare(upper)
+}
+report("caselessCompare", count, mark)
+
+mark = new Date
+for (let n = 0; n < count * 10; n++) {
+    sum += padded.trim().length
+}
+report("trim", count * 10, mark)
+
+report("Total", 0, start)
@@ -1,10 +1,16 @@
 /**
     genbyte.c - Program to generate various forms of the byte code definition files
-  
-    Generates: ejsByteCode.h, ejsGoto.h
-  
-    Interactive shell that interprets interactive sessions and command files.
-  
+
+    Generates: ejsByteCode.h, vm/ejsByteGoto.h and vm/ejsByteFused.h
+
+    The fused op codes are mined from an op code sequence profile recorded by building ejsInterp.c with
+    EJS_OP_PROFILE and running "ejs --stats" (see src/test/bench/opcodes.profile). Sequences of the op codes in
+    EJS_FUSIBLE_OPCODES are scored by the dispatches they save per 100 instructions, averaged over the profiled scripts.
+    The best sequence is fused and then discounted from the sequences that overlap it, as the compiler can only fuse one
+    of them at each site. This repeats while the best score is above the floor and op codes remain.
+
+    Usage: genbyte [--floor percent] [--profile opcodes.profile] [srcDir]
+
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
 
@@ -14,79 +20,522 @@
 
 #define EJS_DEFINE_OPTABLE 1
 
+/*
+    Read only the base op codes. The fused op codes are generated here.
+ */
+#define EJS_FUSED_OPTABLE
+
 #include    "ejsByteCodeTable.h"
 
+/*********************************** Locals ***********************************/
+
+#define GEN_FLOOR       0.5             /* Default minimum score to fuse a sequence */
+#define GEN_MAX_OPCODES 256             /* Op codes are encoded in a byte */
+#define GEN_MAX_SCRIPTS 32              /* Maximum scripts in a profile */
+
+/*
+    Fused op code candidate
+ */
+typedef struct Sequence {
+    int     ops[EJS_FUSED_MAX];         /* Op codes. The first is exact. The rest name their family. */
+    int     count;                      /* Number of op codes in the sequence */
+    double  freq[GEN_MAX_SCRIPTS];      /* Percentage of instructions starting the sequence in each script */
+    double  score;                      /* Dispatches saved per 100 instructions */
+    char    *name;                      /* Fused op code name */
+} Sequence;
+
+typedef struct Fusible {
+    cchar   *name;
+    int     kind;
+    int     opcode;
+} Fusible;
+
+static Fusible fusibles[] = {
+    #define FUSIBLE_OPCODE(name, kind) { #name, kind, -1 },
+    EJS_FUSIBLE_OPCODES(FUSIBLE_OPCODE)
+    #undef FUSIBLE_OPCODE
+    { 0, 0, -1 },
+};
+
+typedef struct NumberOpcode {
+    cchar   *generic;
+    cchar   *number;
+} NumberOpcode;
+
+static NumberOpcode numberOpcodes[] = {
+    #define NUMBER_OPCODE(generic, number) { #generic, #number },
+    EJS_NUMBER_OPCODES(NUMBER_OPCODE)
+    #undef NUMBER_OPCODE
+    { 0, 0 },
+};
+
+typedef struct OperandName {
+    int     operand;
+    cchar   *name;
+} OperandName;
+
+static OperandName operandNames[] = {
+    { EBC_BYTE,             "EBC_BYTE" },
+    { EBC_DOUBLE,           "EBC_DOUBLE" },
+    { EBC_NUM,              "EBC_NUM" },
+    { EBC_STRING,           "EBC_STRING" },
+    { EBC_GLOBAL,           "EBC_GLOBAL" },
+    { EBC_SLOT,             "EBC_SLOT" },
+    { EBC_JMP,              "EBC_JMP" },
+    { EBC_JMP8,             "EBC_JMP8" },
+    { EBC_INIT_DEFAULT,     "EBC_INIT_DEFAULT" },
+    { EBC_INIT_DEFAULT8,    "EBC_INIT_DEFAULT8" },
+    { EBC_ARGC,             "EBC_ARGC" },
+    { EBC_ARGC2,            "EBC_ARGC2" },
+    { EBC_ARGC3,            "EBC_ARGC3" },
+    { EBC_NEW_ARRAY,        "EBC_NEW_ARRAY" },
+    { EBC_NEW_OBJECT,       "EBC_NEW_OBJECT" },
+    { 0, 0 },
+};
+
+static MprList  *sequences;             /* Candidate sequences */
+static MprList  *fused;                 /* Selected sequences */
+static int      numScripts;             /* Number of scripts in the profile */
+static int      numBase;                /* Number of base op codes */
+
 /********************************** Forwards **********************************/
 
 static void footer(MprFile *file);
-static void genByteCodeHeader(Mpr *mpr, cchar *dir);
-static void genByteGotoHeader(Mpr *mpr, cchar *dir);
+static void genByteCodeHeader(cchar *dir);
+static void genByteFusedHeader(cchar *dir);
+static void genByteGotoHeader(cchar *dir);
 static void header(MprFile *file, cchar *name, cchar *desc);
+static int readProfile(cchar *path);
+static void selectSequences(double floor);
 
 /************************************ Code ************************************/
 
 int main(int argc, char **argv)
 {
-    Mpr     *mpr;
-    cchar   *dir;
+    Fusible     *fp;
+    cchar       *dir, *profile;
+    double      floor;
+    int         nextArg, i;
 
-    mpr = mprCreate(argc, argv, NULL);
-    if (mprStart(mpr) < 0) {
-        mprError(mpr, "Cannot start mpr services");
+    if (mprCreate(argc, argv, 0) == 0 || mprStart() < 0) {
+        mprError("Cannot start mpr services");
         return MPR_ERR;
     }
-    dir = (argc == 2) ? argv[1] : ".";
-    genByteCodeHeader(mpr, dir);
-    genByteGotoHeader(mpr, dir);
-    mprDestroy(mpr);
+    profile = 0;
+    floor = GEN_FLOOR;
+    for (nextArg = 1; nextArg < argc && argv[nextArg][0] == '-'; nextArg++) {
+        if (strcmp(argv[nextArg], "--floor") == 0 && (nextArg + 1) < argc) {
+            floor = atof(argv[++nextArg]);
+        } else if (strcmp(argv[nextArg], "--profile") == 0 && (nextArg + 1) < argc) {
+            profile = argv[++nextArg];
+        } else {
+            mprEprintf("usage: genbyte [--floor percent] [--profile opcodes.profile] [srcDir]\n");
+            return MPR_ERR;
+        }
+    }
+    dir = (nextArg < argc) ? argv[nextArg] : ".";
+
+    for (numBase = 0; ejsOptable[numBase].name; numBase++) ;
+    for (fp = fusibles; fp->name; fp++) {
+        for (i = 0; i < numBase; i++) {
+            if (strcmp(ejsOptable[i].name, fp->name) == 0) {
+                fp->opcode = i;
+            }
+        }
+        if (fp->opcode < 0) {
+            mprError("Unknown fusible op code %s", fp->name);
+            return MPR_ERR;
+        }
+    }
+    sequences = mprCreateList(0, 0);
+    fused = mprCreateList(0, 0);
+    if (profile) {
+        if (readProfile(profile) < 0) {
+            return MPR_ERR;
+        }
+        selectSequences(floor);
+    }
+    genByteCodeHeader(dir);
+    genByteGotoHeader(dir);
+    genByteFusedHeader(dir);
+    mprDestroy(MPR_EXIT_DEFAULT);
+    return 0;
+}
+
+
+static int findOpcode(cchar *name)
+{
+    int     i;
+
+    for (i = 0; i < numBase; i++) {
+        if (strcmp(ejsOptable[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/*
+    Map a Number variant onto its generic op code
+ */
+static int getGenericOpcode(int opcode)
+{
+    NumberOpcode    *np;
+
+    for (np = numberOpcodes; np->generic; np++) {
+        if (strcmp(ejsOptable[opcode].name, np->number) == 0) {
+            return findOpcode(np->generic);
+        }
+    }
+    return opcode;
+}
+
+
+/*
+    Return the fusible family of an op code, or null if it cannot be fused
+ */
+static Fusible *getFusible(int opcode)
+{
+    Fusible     *fp;
+
+    opcode = getGenericOpcode(opcode);
+    for (fp = fusibles; fp->name; fp++) {
+        if (opcode == fp->opcode || ((fp->kind & EJS_FUSE_SERIES) && opcode > fp->opcode && opcode <= fp->opcode + 9)) {
+            return fp;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Name an op code as a fused sequence component. Series after the first position are named OpN.
+ */
+static char *getComponentName(int opcode, int position)
+{
+    Fusible     *fp;
+    char        *name;
+
+    name = sclone(ejsOptable[opcode].name);
+    fp = getFusible(opcode);
+    if (position > 0 && (fp->kind & EJS_FUSE_SERIES)) {
+        name[slen(name) - 1] = 'N';
+    }
+    return name;
+}
+
+
+/*
+    Add a profiled sequence to the candidates. Sequences that differ only in Number variants or series members after
+    the first position are counted together.
+ */
+static void addSequence(char **names, int count, double percent)
+{
+    Sequence    seq, *sp;
+    Fusible     *fp;
+    int         i, next, opcode;
+
+    if (count < 2 || count > EJS_FUSED_MAX) {
+        return;
+    }
+    memset(&seq, 0, sizeof(seq));
+    for (i = 0; i < count; i++) {
+        if ((opcode = findOpcode(names[i])) < 0 || (fp = getFusible(opcode)) == 0) {
+            return;
+        }
+        if ((fp->kind & EJS_FUSE_LAST) && i < (count - 1)) {
+            return;
+        }
+        seq.ops[i] = (i == 0) ? getGenericOpcode(opcode) : fp->opcode;
+    }
+    seq.count = count;
+    for (next = 0; (sp = mprGetNextItem(sequences, &next)) != 0; ) {
+        if (sp->count == count && memcmp(sp->ops, seq.ops, sizeof(seq.ops)) == 0) {
+            sp->freq[numScripts - 1] += percent;
+            return;
+        }
+    }
+    sp = mprAlloc(sizeof(Sequence));
+    *sp = seq;
+    sp->freq[numScripts - 1] = percent;
+    mprAddItem(sequences, sp);
+}
+
+
+/*
+    Read the sequence frequencies of each script in the profile. Lines are: "== script" to start a script and
+    "percent% OP OP ..." for each sequence. Other lines are ignored.
+ */
+static int readProfile(cchar *path)
+{
+    char        *data, *line, *tok, *nextLine, *nextTok, *names[EJS_FUSED_MAX + 1];
+    double      percent;
+    int         count;
+
+    if ((data = mprReadPathContents(path, NULL)) == 0) {
+        mprError("Cannot read %s", path);
+        return MPR_ERR_CANT_READ;
+    }
+    for (line = stok(data, "\n", &nextLine); line; line = stok(NULL, "\n", &nextLine)) {
+        if (sstarts(line, "==")) {
+            if (++numScripts > GEN_MAX_SCRIPTS) {
+                mprError("Too many scripts in %s", path);
+                return MPR_ERR_WONT_FIT;
+            }
+            continue;
+        }
+        if (numScripts == 0 || (tok = stok(line, " \t", &nextTok)) == 0 || !isdigit((uchar) *tok) || !sends(tok, "%")) {
+            continue;
+        }
+        percent = atof(tok);
+        for (count = 0; (tok = stok(NULL, " \t", &nextTok)) != 0 && count <= EJS_FUSED_MAX; ) {
+            names[count++] = tok;
+        }
+        addSequence(names, count, percent);
+    }
+    if (numScripts == 0) {
+        mprError("No scripts in %s", path);
+        return MPR_ERR_BAD_FORMAT;
+    }
     return 0;
 }
 
 
-static void genByteCodeHeader(Mpr *mpr, cchar *dir)
+static void scoreSequence(Sequence *sp)
+{
+    int     i;
+
+    for (sp->score = 0, i = 0; i < numScripts; i++) {
+        sp->score += sp->freq[i] * (sp->count - 1) / numScripts;
+    }
+}
+
+
+static int getFamily(int opcode)
+{
+    return getFusible(opcode)->opcode;
+}
+
+
+/*
+    Test if a sequence shares two or more adjacent op codes with a selected sequence, so that the compiler can fuse only
+    one of them at a site. Sequences that contain the selected sequence are not overlapping as the compiler fuses the
+    longer sequence.
+ */
+static bool overlaps(Sequence *s1, Sequence *s2)
+{
+    int     shift, i, matched;
+
+    for (shift = 2 - s2->count; shift <= s1->count - 2; shift++) {
+        for (matched = 0, i = 0; i < s2->count; i++) {
+            if ((shift + i) < 0 || (shift + i) >= s1->count) {
+                continue;
+            }
+            if (getFamily(s1->ops[shift + i]) != getFamily(s2->ops[i])) {
+                matched = 0;
+                break;
+            }
+            matched++;
+        }
+        if (matched >= 2 && !(shift <= 0 && (shift + s2->count) >= s1->count && s2->count > s1->count)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Select the best scoring sequence while above the floor and op codes remain. Sequences that overlap a selected 
+    sequence keep only the part of their frequency in each script that exceeds it.
+ */
+static void selectSequences(double floor)
+{
+    Sequence    *sp, *best;
+    MprBuf      *buf;
+    int         next, i;
+
+    while ((numBase + mprGetListLength(fused)) < GEN_MAX_OPCODES) {
+        best = 0;
+        for (next = 0; (sp = mprGetNextItem(sequences, &next)) != 0; ) {
+            scoreSequence(sp);
+            if (best == 0 || sp->score > best->score) {
+                best = sp;
+            }
+        }
+        if (best == 0 || best->score < floor) {
+            break;
+        }
+        mprRemoveItem(sequences, best);
+        for (next = 0; (sp = mprGetNextItem(sequences, &next)) != 0; ) {
+            if (overlaps(best, sp)) {
+                for (i = 0; i < numScripts; i++) {
+                    sp->freq[i] = max(sp->freq[i] - best->freq[i], 0);
+                }
+            }
+        }
+        buf = mprCreateBuf(0, 0);
+        for (i = 0; i < best->count; i++) {
+            mprPutToBuf(buf, "%s%s", (i > 0) ? "_" : "", getComponentName(best->ops[i], i));
+        }
+        mprAddNullToBuf(buf);
+        best->name = sclone(mprGetBufStart(buf));
+        mprAddItem(fused, best);
+    }
+}
+
+
+static void genOptableRow(MprFile *file, cchar *name, EjsOptable *op)
+{
+    OperandName     *np;
+    MprBuf          *buf;
+    int             i;
+
+    buf = mprCreateBuf(0, 0);
+    for (i = 0; i < 8 && op->args[i]; i++) {
+        for (np = operandNames; np->name && np->operand != op->args[i]; np++) ;
+        mprPutToBuf(buf, "%s, ", np->name ? np->name : "EBC_NONE");
+    }
+    if (i == 0) {
+        mprPutStringToBuf(buf, "EBC_NONE, ");
+    }
+    mprAddNullToBuf(buf);
+    if (op->stackEffect == EBC_POPN) {
+        mprFprintf(file, "    {   \"%s\", EBC_POPN, { %s}, }, \\\n", name, mprGetBufStart(buf));
+    } else {
+        mprFprintf(file, "    {   \"%s\", %d, { %s}, }, \\\n", name, op->stackEffect, mprGetBufStart(buf));
+    }
+}
+
+
+static void genByteCodeHeader(cchar *dir)
 {
     MprFile     *file;
+    Sequence    *sp;
     EjsOptable  *op;
     char        *path;
+    int         next, i;
 
-    path = mprJoinPath(mpr, dir, "ejsByteCode.h");
-    file = mprOpenFile(mpr, path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    path = mprJoinPath(dir, "ejsByteCode.h");
+    file = mprOpenFile(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
     if (file == 0) {
-        mprError(mpr, "Cannot open %s", path);
+        mprError("Cannot open %s", path);
         return;
-    } 
+    }
     header(file, "ejsByteCode", "Ejscript VM Byte Code");
 
     mprFprintf(file, "typedef enum EjsOpCode {\n");
     for (op = ejsOptable; op->name; op++) {
         mprFprintf(file, "    EJS_OP_%s,\n", op->name);
     }
+    for (next = 0; (sp = mprGetNextItem(fused, &next)) != 0; ) {
+        mprFprintf(file, "    EJS_OP_%s,\n", sp->name);
+    }
     mprFprintf(file, "} EjsOpCode;\n");
+
+    mprFprintf(file, "\n\
+/*\n\
+    Fused op codes generated by genbyte from src/test/bench/opcodes.profile. A fused op code replaces the first op code\n\
+    of a sequence and runs the sequence in one dispatch. Expand with OP(opcode, count, first, second, third, fourth).\n\
+    The first op code is exact. The others name their family from EJS_FUSIBLE_OPCODES. Unused op codes are -1.\n\
+ */\n\
+#define EJS_FUSED_OPCODES(OP)");
+    for (next = 0; (sp = mprGetNextItem(fused, &next)) != 0; ) {
+        mprFprintf(file, " \\\n    OP(EJS_OP_%s, %d", sp->name, sp->count);
+        for (i = 0; i < EJS_FUSED_MAX; i++) {
+            if (i < sp->count) {
+                mprFprintf(file, ", EJS_OP_%s", ejsOptable[sp->ops[i]].name);
+            } else {
+                mprFprintf(file, ", -1");
+            }
+        }
+        mprFprintf(file, ")");
+    }
+    mprFprintf(file, "\n\n\
+/*\n\
+    Optable rows for the fused op codes. The other op codes of a sequence remain in the code, so a fused op code has\n\
+    the stack effect and operands of its first op code.\n\
+ */\n\
+#define EJS_FUSED_OPTABLE \\\n");
+    for (next = 0; (sp = mprGetNextItem(fused, &next)) != 0; ) {
+        genOptableRow(file, sp->name, &ejsOptable[sp->ops[0]]);
+    }
+    mprFprintf(file, "\n");
     footer(file);
     mprCloseFile(file);
 }
 
 
-static void genByteGotoHeader(Mpr *mpr, cchar *dir)
+static void genByteGotoHeader(cchar *dir)
 {
     MprFile     *file;
     EjsOptable  *op;
+    Sequence    *sp;
     char        *path;
+    int         next;
 
-    path = mprJoinPath(mpr, dir, "ejsByteGoto.h");
-    file = mprOpenFile(mpr, path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    path = mprJoinPath(dir, "vm/ejsByteGoto.h");
+    file = mprOpenFile(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
     if (file == 0) {
-        mprError(mpr, "Cannot open %s", path);
+        mprError("Cannot open %s", path);
         return;
-    } 
-    // header(file, "ejsByteGoto", "Ejscript Byte Code Jump Labels");
-
+    }
     mprFprintf(file, "static void *opcodeJump[] = {\n");
     for (op = ejsOptable; op->name; op++) {
         mprFprintf(file, "    &&EJS_OP_%s,\n", op->name);
     }
+    for (next = 0; (sp = mprGetNextItem(fused, &next)) != 0; ) {
+        mprFprintf(file, "    &&EJS_OP_%s,\n", sp->name);
+    }
     mprFprintf(file, "};\n");
-    // footer(file);
+    mprCloseFile(file);
+}
+
+
+/*
+    Generate the fused op code handlers. Each runs the DO_ fragments of its op codes. NEXT_OP stops the sequence if
+    an op code did not complete normally or the next op code is not the expected one.
+ */
+static void genByteFusedHeader(cchar *dir)
+{
+    MprFile     *file;
+    Fusible     *fp;
+    Sequence    *sp;
+    cchar       *test;
+    char        *path;
+    int         next, i;
+
+    path = mprJoinPath(dir, "vm/ejsByteFused.h");
+    file = mprOpenFile(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (file == 0) {
+        mprError("Cannot open %s", path);
+        return;
+    }
+    mprFprintf(file, "\
+/*\n\
+    ejsByteFused.h - Fused op code handlers generated by genbyte. Included by the VM in ejsInterp.c.\n\
+ */\n");
+    for (next = 0; (sp = mprGetNextItem(fused, &next)) != 0; ) {
+        mprFprintf(file, "\n        /*\n            Fused");
+        for (i = 0; i < sp->count; i++) {
+            mprFprintf(file, " %s", getComponentName(sp->ops[i], i));
+        }
+        mprFprintf(file, " (saves %.2f%%)\n         */\n", sp->score);
+        mprFprintf(file, "        CASE (EJS_OP_%s):\n", sp->name);
+        mprFprintf(file, "            FUSED_START(EJS_OP_%s);\n", ejsOptable[sp->ops[0]].name);
+        for (i = 0; i < sp->count; i++) {
+            fp = getFusible(sp->ops[i]);
+            if (i > 0) {
+                test = (fp->kind & EJS_FUSE_NUMBER) ? "IS_NUMBER_OP" : ((fp->kind & EJS_FUSE_SERIES) ? "IS_SERIES_OP" : "IS_OP");
+                mprFprintf(file, "            NEXT_OP(%s(EJS_OP_%s));\n", test, ejsOptable[sp->ops[i]].name);
+            }
+            mprFprintf(file, "            DO_%s();\n", getComponentName(fp->opcode, 1));
+        }
+        if (!(fp->kind & EJS_FUSE_LAST)) {
+            mprFprintf(file, "            BREAK;\n");
+        }
+    }
     mprCloseFile(file);
 }
 
@@ -95,9 +544,9 @@ static void header(MprFile *file, cchar *name, cchar *desc)
 {
     mprFprintf(file, "\
 /*\n\
- *  %s.h - %s\n\
- *\n\
- *  Copyright (c) All Rights Reserved. See details at the end of the file.\n\
+    %s.h - %s\n\
+  \n\
+    Copyright (c) All Rights Reserved. See details at the end of the file.\n\
  */\n\
 \n\
 #ifndef _h_EJS_%s\n\
@@ -114,14 +563,23 @@ static void footer(MprFile *file)
 #endif\n\
 \n\
 /*\n\
+    @copy   default\n\
+\n\
     Copyright (c) Embedthis Software LLC, 2003-2013. All Rights Reserved.\n\
-    Copyright (c) Michael O'Brien, 1993-2013. All Rights Reserved.\n\
-  \n\
+\n\
     This software is distributed under commercial and open source licenses.\n\
-    You may use the GPL open source license described below or you may acquire\n\
-    a commercial license from Embedthis Software. You agree to be fully bound\n\
+    You may use the Embedthis Open Source license or you may acquire a \n\
+    commercial license from Embedthis Software. You agree to be fully bound\n\
     by the terms of either license. Consult the LICENSE.md distributed with\n\
     this software for full details and other copyrights.\n\
+\n\
+    Local variables:\n\
+    tab-width: 4\n\
+    c-basic-offset: 4\n\
+    End:\n\
+    vim: sw=4 ts=4 expandtab\n\
+\n\
+    @end\n\
  */\n");
 }
 
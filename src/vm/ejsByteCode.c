@@ -18,6 +18,75 @@ PUBLIC EjsOptable *ejsGetOptable()
 }
 
 
+PUBLIC int ejsGetNumberOpcode(int opcode)
+{
+    switch (opcode) {
+    #define NUMBER_OPCODE(generic, number) case EJS_OP_##generic: return EJS_OP_##number;
+    EJS_NUMBER_OPCODES(NUMBER_OPCODE)
+    #undef NUMBER_OPCODE
+    }
+    return 0;
+}
+
+
+PUBLIC int ejsGetGenericOpcode(int opcode)
+{
+    switch (opcode) {
+    #define GENERIC_OPCODE(generic, number) case EJS_OP_##number: return EJS_OP_##generic;
+    EJS_NUMBER_OPCODES(GENERIC_OPCODE)
+    #undef GENERIC_OPCODE
+    }
+    return 0;
+}
+
+
+/*
+    Map an op code onto its fusible family: the generic op code or the first member of a series. Return -1 if the
+    op code cannot be fused.
+ */
+static int getFusedFamily(int opcode)
+{
+    int     generic;
+
+    if ((generic = ejsGetGenericOpcode(opcode)) != 0) {
+        opcode = generic;
+    }
+    #define FUSED_FAMILY(name, kind) \
+        if (opcode == EJS_OP_##name || ((kind) & EJS_FUSE_SERIES && opcode > EJS_OP_##name && \
+                opcode <= EJS_OP_##name + 9)) { \
+            return EJS_OP_##name; \
+        }
+    EJS_FUSIBLE_OPCODES(FUSED_FAMILY)
+    #undef FUSED_FAMILY
+    return -1;
+}
+
+
+PUBLIC int ejsGetFusedOpcode(int *opcodes, int count)
+{
+    static int fusedOpcodes[][EJS_FUSED_MAX + 2] = {
+        #define FUSED_OPCODE(fused, count, op1, op2, op3, op4) { fused, count, op1, op2, op3, op4 },
+        EJS_FUSED_OPCODES(FUSED_OPCODE)
+        #undef FUSED_OPCODE
+        { 0 }
+    };
+    int     *fp, first, i;
+
+    if ((first = ejsGetGenericOpcode(opcodes[0])) == 0) {
+        first = opcodes[0];
+    }
+    for (fp = fusedOpcodes[0]; fp[0]; fp += EJS_FUSED_MAX + 2) {
+        if (fp[1] != count || fp[2] != first) {
+            continue;
+        }
+        for (i = 1; i < count && getFusedFamily(opcodes[i]) == fp[i + 2]; i++) ;
+        if (i == count) {
+            return fp[0];
+        }
+    }
+    return 0;
+}
+
 /*
     @copy   default
 
@@ -0,0 +1,348 @@
+/*
+    ejsByteFused.h - Fused op code handlers generated by genbyte. Included by the VM in ejsInterp.c.
+ */
+
+        /*
+            Fused DUP INC PUT_SCOPED_NAME POP (saves 11.91%)
+         */
+        CASE (EJS_OP_DUP_INC_PUT_SCOPED_NAME_POP):
+            FUSED_START(EJS_OP_DUP);
+            DO_DUP();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_INC));
+            DO_INC();
+            NEXT_OP(IS_OP(EJS_OP_PUT_SCOPED_NAME));
+            DO_PUT_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_POP));
+            DO_POP();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME GET_SCOPED_NAME COMPARE_LT BRANCH_FALSE_8 (saves 6.77%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_COMPARE_LT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_LT));
+            DO_COMPARE_LT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused PUT_SCOPED_NAME GET_SCOPED_NAME DUP (saves 6.03%)
+         */
+        CASE (EJS_OP_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP):
+            FUSED_START(EJS_OP_PUT_SCOPED_NAME);
+            DO_PUT_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_DUP));
+            DO_DUP();
+            BREAK;
+
+        /*
+            Fused ADD PUT_SCOPED_NAME GET_SCOPED_NAME DUP (saves 5.67%)
+         */
+        CASE (EJS_OP_ADD_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP):
+            FUSED_START(EJS_OP_ADD);
+            DO_ADD();
+            NEXT_OP(IS_OP(EJS_OP_PUT_SCOPED_NAME));
+            DO_PUT_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_DUP));
+            DO_DUP();
+            BREAK;
+
+        /*
+            Fused POP GOTO_8 (saves 4.81%)
+         */
+        CASE (EJS_OP_POP_GOTO_8):
+            FUSED_START(EJS_OP_POP);
+            DO_POP();
+            NEXT_OP(IS_OP(EJS_OP_GOTO_8));
+            DO_GOTO_8();
+
+        /*
+            Fused GET_SCOPED_NAME LOAD_STRING GET_SCOPED_NAME (saves 3.87%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_STRING));
+            DO_LOAD_STRING();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME GET_SCOPED_NAME (saves 3.77%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            BREAK;
+
+        /*
+            Fused DUP INC PUT_LOCAL_SLOT_N POP (saves 2.77%)
+         */
+        CASE (EJS_OP_DUP_INC_PUT_LOCAL_SLOT_N_POP):
+            FUSED_START(EJS_OP_DUP);
+            DO_DUP();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_INC));
+            DO_INC();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_PUT_LOCAL_SLOT_0));
+            DO_PUT_LOCAL_SLOT_N();
+            NEXT_OP(IS_OP(EJS_OP_POP));
+            DO_POP();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME LOAD_INT COMPARE_LT BRANCH_FALSE_8 (saves 2.50%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_INT));
+            DO_LOAD_INT();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_LT));
+            DO_COMPARE_LT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_SCOPED_NAME GET_SCOPED_NAME LOAD_STRING GET_SCOPED_NAME (saves 2.46%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_STRING));
+            DO_LOAD_STRING();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            BREAK;
+
+        /*
+            Fused ADD LOAD_N SUB PUT_SCOPED_NAME (saves 2.00%)
+         */
+        CASE (EJS_OP_ADD_LOAD_N_SUB_PUT_SCOPED_NAME):
+            FUSED_START(EJS_OP_ADD);
+            DO_ADD();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_LOAD_0));
+            DO_LOAD_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_SUB));
+            DO_SUB();
+            NEXT_OP(IS_OP(EJS_OP_PUT_SCOPED_NAME));
+            DO_PUT_SCOPED_NAME();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME GET_SCOPED_NAME LOAD_N MUL (saves 2.00%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_N_MUL):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_LOAD_0));
+            DO_LOAD_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_MUL));
+            DO_MUL();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME LOAD_INT MUL COMPARE_LT (saves 1.68%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_LOAD_INT_MUL_COMPARE_LT):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_INT));
+            DO_LOAD_INT();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_MUL));
+            DO_MUL();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_LT));
+            DO_COMPARE_LT();
+            BREAK;
+
+        /*
+            Fused COMPARE_LT BRANCH_FALSE_8 (saves 1.63%)
+         */
+        CASE (EJS_OP_COMPARE_LT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_COMPARE_LT);
+            DO_COMPARE_LT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_LOCAL_SLOT_2 GET_LOCAL_SLOT_N COMPARE_LT BRANCH_FALSE_8 (saves 0.93%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_COMPARE_LT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_2);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_GET_LOCAL_SLOT_0));
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_LT));
+            DO_COMPARE_LT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_LOCAL_SLOT_3 LOAD_INT COMPARE_LT BRANCH_FALSE_8 (saves 0.93%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_3_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_3);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_INT));
+            DO_LOAD_INT();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_LT));
+            DO_COMPARE_LT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_LOCAL_SLOT_0 LOAD_N COMPARE_GT BRANCH_FALSE_8 (saves 0.92%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_0_LOAD_N_COMPARE_GT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_0);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_LOAD_0));
+            DO_LOAD_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_GT));
+            DO_COMPARE_GT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_LOCAL_SLOT_2 GET_LOCAL_SLOT_N MUL PUT_LOCAL_SLOT_N (saves 0.92%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_MUL_PUT_LOCAL_SLOT_N):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_2);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_GET_LOCAL_SLOT_0));
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_MUL));
+            DO_MUL();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_PUT_LOCAL_SLOT_0));
+            DO_PUT_LOCAL_SLOT_N();
+            BREAK;
+
+        /*
+            Fused LOAD_1 SUB PUT_LOCAL_SLOT_N GET_LOCAL_SLOT_N (saves 0.92%)
+         */
+        CASE (EJS_OP_LOAD_1_SUB_PUT_LOCAL_SLOT_N_GET_LOCAL_SLOT_N):
+            FUSED_START(EJS_OP_LOAD_1);
+            DO_LOAD_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_SUB));
+            DO_SUB();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_PUT_LOCAL_SLOT_0));
+            DO_PUT_LOCAL_SLOT_N();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_GET_LOCAL_SLOT_0));
+            DO_GET_LOCAL_SLOT_N();
+            BREAK;
+
+        /*
+            Fused GET_LOCAL_SLOT_4 LOAD_INT COMPARE_GT BRANCH_FALSE_8 (saves 0.92%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_4_LOAD_INT_COMPARE_GT_BRANCH_FALSE_8):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_4);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_INT));
+            DO_LOAD_INT();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_COMPARE_GT));
+            DO_COMPARE_GT();
+            NEXT_OP(IS_OP(EJS_OP_BRANCH_FALSE_8));
+            DO_BRANCH_FALSE_8();
+
+        /*
+            Fused GET_LOCAL_SLOT_1 GET_LOCAL_SLOT_N ADD PUT_LOCAL_SLOT_N (saves 0.92%)
+         */
+        CASE (EJS_OP_GET_LOCAL_SLOT_1_GET_LOCAL_SLOT_N_ADD_PUT_LOCAL_SLOT_N):
+            FUSED_START(EJS_OP_GET_LOCAL_SLOT_1);
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_GET_LOCAL_SLOT_0));
+            DO_GET_LOCAL_SLOT_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_ADD));
+            DO_ADD();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_PUT_LOCAL_SLOT_0));
+            DO_PUT_LOCAL_SLOT_N();
+            BREAK;
+
+        /*
+            Fused MUL ADD (saves 0.75%)
+         */
+        CASE (EJS_OP_MUL_ADD):
+            FUSED_START(EJS_OP_MUL);
+            DO_MUL();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_ADD));
+            DO_ADD();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME GET_SCOPED_NAME LOAD_STRING (saves 0.67%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_LOAD_STRING));
+            DO_LOAD_STRING();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME MUL GET_SCOPED_NAME (saves 0.67%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_MUL_GET_SCOPED_NAME):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_MUL));
+            DO_MUL();
+            NEXT_OP(IS_OP(EJS_OP_GET_SCOPED_NAME));
+            DO_GET_SCOPED_NAME();
+            BREAK;
+
+        /*
+            Fused PUT_SCOPED_NAME GOTO_8 (saves 0.65%)
+         */
+        CASE (EJS_OP_PUT_SCOPED_NAME_GOTO_8):
+            FUSED_START(EJS_OP_PUT_SCOPED_NAME);
+            DO_PUT_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_GOTO_8));
+            DO_GOTO_8();
+
+        /*
+            Fused GET_SCOPED_NAME DUP (saves 0.64%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_DUP):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_OP(EJS_OP_DUP));
+            DO_DUP();
+            BREAK;
+
+        /*
+            Fused GET_SCOPED_NAME LOAD_N MUL (saves 0.63%)
+         */
+        CASE (EJS_OP_GET_SCOPED_NAME_LOAD_N_MUL):
+            FUSED_START(EJS_OP_GET_SCOPED_NAME);
+            DO_GET_SCOPED_NAME();
+            NEXT_OP(IS_SERIES_OP(EJS_OP_LOAD_0));
+            DO_LOAD_N();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_MUL));
+            DO_MUL();
+            BREAK;
+
+        /*
+            Fused LOAD_STRING ADD (saves 0.52%)
+         */
+        CASE (EJS_OP_LOAD_STRING_ADD):
+            FUSED_START(EJS_OP_LOAD_STRING);
+            DO_LOAD_STRING();
+            NEXT_OP(IS_NUMBER_OP(EJS_OP_ADD));
+            DO_ADD();
+            BREAK;
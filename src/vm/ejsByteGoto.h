@@ -207,4 +207,44 @@ static void *opcodeJump[] = {
     &&EJS_OP_XOR,
     &&EJS_OP_CALL_FINALLY,
     &&EJS_OP_GOTO_FINALLY,
+    &&EJS_OP_ADD_NUM,
+    &&EJS_OP_SUB_NUM,
+    &&EJS_OP_MUL_NUM,
+    &&EJS_OP_DIV_NUM,
+    &&EJS_OP_COMPARE_EQ_NUM,
+    &&EJS_OP_COMPARE_NE_NUM,
+    &&EJS_OP_COMPARE_LT_NUM,
+    &&EJS_OP_COMPARE_LE_NUM,
+    &&EJS_OP_COMPARE_GT_NUM,
+    &&EJS_OP_COMPARE_GE_NUM,
+    &&EJS_OP_INC_NUM,
+    &&EJS_OP_ADD_CHAIN,
+    &&EJS_OP_DUP_INC_PUT_SCOPED_NAME_POP,
+    &&EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_COMPARE_LT_BRANCH_FALSE_8,
+    &&EJS_OP_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP,
+    &&EJS_OP_ADD_PUT_SCOPED_NAME_GET_SCOPED_NAME_DUP,
+    &&EJS_OP_POP_GOTO_8,
+    &&EJS_OP_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME,
+    &&EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME,
+    &&EJS_OP_DUP_INC_PUT_LOCAL_SLOT_N_POP,
+    &&EJS_OP_GET_SCOPED_NAME_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING_GET_SCOPED_NAME,
+    &&EJS_OP_ADD_LOAD_N_SUB_PUT_SCOPED_NAME,
+    &&EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_N_MUL,
+    &&EJS_OP_GET_SCOPED_NAME_LOAD_INT_MUL_COMPARE_LT,
+    &&EJS_OP_COMPARE_LT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_COMPARE_LT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_LOCAL_SLOT_3_LOAD_INT_COMPARE_LT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_LOCAL_SLOT_0_LOAD_N_COMPARE_GT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_LOCAL_SLOT_2_GET_LOCAL_SLOT_N_MUL_PUT_LOCAL_SLOT_N,
+    &&EJS_OP_LOAD_1_SUB_PUT_LOCAL_SLOT_N_GET_LOCAL_SLOT_N,
+    &&EJS_OP_GET_LOCAL_SLOT_4_LOAD_INT_COMPARE_GT_BRANCH_FALSE_8,
+    &&EJS_OP_GET_LOCAL_SLOT_1_GET_LOCAL_SLOT_N_ADD_PUT_LOCAL_SLOT_N,
+    &&EJS_OP_MUL_ADD,
+    &&EJS_OP_GET_SCOPED_NAME_GET_SCOPED_NAME_LOAD_STRING,
+    &&EJS_OP_GET_SCOPED_NAME_MUL_GET_SCOPED_NAME,
+    &&EJS_OP_PUT_SCOPED_NAME_GOTO_8,
+    &&EJS_OP_GET_SCOPED_NAME_DUP,
+    &&EJS_OP_GET_SCOPED_NAME_LOAD_N_MUL,
+    &&EJS_OP_LOAD_STRING_ADD,
 };
@@ -11,6 +11,9 @@
 /********************************** Includes **********************************/
 
 #include    "ejs.h"
+#if EJS_JIT
+    #include    <stddef.h>
+#endif
 
 /********************************** Inline Code *******************************/
 /*
@@ -103,6 +106,67 @@ static MPR_INLINE void checkGetter(Ejs *ejs, EjsAny *value, EjsAny *thisObj, Ejs
 }
 
 #define CHECK_VALUE(value, thisObj, obj, slotNum) checkGetter(ejs, value, thisObj, obj, slotNum)
+
+/*
+    Lookup the inline property cache for the by-name property access at the current PC. The name is only supplied for
+    sites with computed names. Otherwise the name is implied by the site. On a hit, the PC is advanced over the 
+    instruction operands and the matching cache entry is returned.
+ */
+static MPR_INLINE EjsCacheEntry *lookupCache(Ejs *ejs, EjsFrame *fp, EjsAny *vp, EjsName *qname)
+{
+    EjsCache        *cache;
+    EjsCacheEntry   *entry;
+    EjsPot          *pot;
+    EjsSlot         *sp;
+    int             offset, i;
+
+    if ((cache = fp->function.body.code->cache) != 0) {
+        offset = (int) (fp->pc - fp->function.body.code->byteCode);
+        for (i = 0; i < EJS_CACHE_WAYS; i++) {
+            entry = cache->lines[offset & (cache->size - 1)].entries[i];
+            if (entry == 0 || entry->offset != offset || entry->type != TYPE(vp)) {
+                continue;
+            }
+            if (entry->epoch != ejs->service->cacheEpoch) {
+                break;
+            }
+            if (qname && (entry->qname.name != qname->name || entry->qname.space != qname->space)) {
+                continue;
+            }
+            if (entry->holder) {
+                if (DYNAMIC(vp) || (TYPE(vp)->isPot && ((EjsPot*) vp)->shortScope)) {
+                    break;
+                }
+                pot = entry->holder;
+            } else {
+                pot = vp;
+                if (pot->shaped) {
+                    /* The shape determines the names and slots of all properties */
+                    if (entry->shape == 0 || ejsGetShape(pot) != entry->shape) {
+                        continue;
+                    }
+                    ejs->cacheHits++;
+                    fp->pc += entry->operands;
+                    return entry;
+                }
+                if (pot->dupNames) {
+                    break;
+                }
+            }
+            if (entry->slotNum < pot->numProp) {
+                sp = &pot->properties->slots[entry->slotNum];
+                if (sp->qname.name == entry->target.name && sp->qname.space == entry->target.space) {
+                    ejs->cacheHits++;
+                    fp->pc += entry->operands;
+                    return entry;
+                }
+            }
+            break;
+        }
+    }
+    ejs->cacheMisses++;
+    return 0;
+}
 #define CHECK_GC() if (MPR->heap->mustYield && !(ejs->state->paused)) { mprYield(0); } else 
 
 /*
@@ -120,6 +184,69 @@ static MPR_INLINE void checkGetter(Ejs *ejs, EjsAny *value, EjsAny *thisObj, Ejs
         (fp)->attentionPc = 0; \
     } else 
 
+/*
+    Test if the top two stack values are both Numbers for the Number specialized opcodes
+ */
+#define NUMBER(vp)          (((EjsNumber*) (vp))->value)
+#define NUMBER_OPERANDS()   (state->stack[0] && state->stack[-1] && TYPE(state->stack[0]) == EST(Number) && \
+                                TYPE(state->stack[-1]) == EST(Number))
+
+/*
+    Bodies of the Number specialized op codes. If either operand is not a Number, continue with the generic op code.
+    NUMBER_BINARY pushes an arithmetic result and NUMBER_COMPARE pushes a boolean.
+ */
+#define NUMBER_ARGS(generic, fallback) \
+    if (!NUMBER_OPERANDS()) { \
+        opcode = generic; \
+        goto fallback; \
+    } \
+    v2 = pop(ejs); \
+    v1 = pop(ejs)
+
+#define NUMBER_BINARY(generic, op) \
+    NUMBER_ARGS(generic, binaryExpression); \
+    ejs->result = ejsCreateNumber(ejs, NUMBER(v1) op NUMBER(v2)); \
+    push(ejs->result); \
+    BREAK
+
+#define NUMBER_COMPARE(generic, op) \
+    NUMBER_ARGS(generic, binaryExpression); \
+    ejs->result = (NUMBER(v1) op NUMBER(v2)) ? ESV(true) : ESV(false); \
+    push(ejs->result); \
+    BREAK
+
+/*
+    Count a function call or backward branch toward the quickening threshold
+ */
+#define HEAT(code) if ((code)->hotness < EJS_QUICKEN_THRESHOLD) { (code)->hotness++; } else
+
+/*
+    Quicken the instruction at "pc" once its function is hot. Generic op codes that see Number operands are rewritten
+    in place to their Number variants. Number variants that see other types are reverted to the generic op code. Both
+    forms have the same semantics and operands, so a site may be rewritten at any time, even when the code is shared by
+    cloned interpreters or by all the interpreters in the process via a mapped module. This race is benign without
+    locking: the rewrite is a single byte store, so other threads and the JIT read either the old or the new op code and
+    both run correctly. Concurrent writers only race between two correct values and a lost update is redone on the next
+    run of the site. Functions that keep reverting stop being specialized.
+ */
+static void quicken(Ejs *ejs, EjsCode *code, uchar *pc, EjsAny *v1, EjsAny *v2)
+{
+    int     opcode;
+
+    if (!ejs->service->quicken) {
+        return;
+    }
+    if (v1 && v2 && TYPE(v1) == EST(Number) && TYPE(v2) == EST(Number)) {
+        if (code->hotness >= EJS_QUICKEN_THRESHOLD && code->deopts < EJS_QUICKEN_MAX_DEOPT &&
+                (opcode = ejsGetNumberOpcode(*pc)) != 0) {
+            *(volatile uchar*) pc = (uchar) opcode;
+        }
+    } else if ((opcode = ejsGetGenericOpcode(*pc)) != 0) {
+        *(volatile uchar*) pc = (uchar) opcode;
+        code->deopts++;
+    }
+}
+
 #define GET_BYTE()      *(FRAME)->pc++
 #define GET_DOUBLE()    ejsDecodeDouble(ejs, &(FRAME)->pc)
 #define GET_INT()       ((int) GET_NUM())
@@ -135,13 +262,45 @@ static MPR_INLINE void checkGetter(Ejs *ejs, EjsAny *value, EjsAny *thisObj, Ejs
 #define FILL(mark)      while (mark < FRAME->pc) { *mark++ = EJS_OP_NOP; }
 
 // #define DEBUG_IDE 1
-#if DEBUG_IDE
+/*
+    Define EJS_OP_PROFILE to count executed op codes and op code sequences. Use "ejs --stats" to display the most 
+    frequent sequences. These are recorded in src/test/bench/opcodes.profile, from which genbyte generates the fused
+    op codes.
+ */
+#ifndef EJS_OP_PROFILE
+    #define EJS_OP_PROFILE 0
+#endif
+#define EJS_OP_PROFILE_TOP 40             /* Number of entries to display */
+#if EJS_OP_PROFILE
+    static EjsOpCode profileCode(Ejs *ejs, EjsOpCode opcode);
+    static void profileOp(Ejs *ejs, int opcode);
+    #define traceCode(ejs, opcode) profileCode(ejs, opcode)
+    static uint64 opcount[256];
+#elif DEBUG_IDE
     static EjsOpCode traceCode(Ejs *ejs, EjsOpCode opcode);
     static int opcount[256];
 #else
     #define traceCode(ejs, opcode) opcode
 #endif
 
+/*
+    Profiling and tracing observe each op code as it is dispatched, so they run everything in the interpreter
+ */
+#if EJS_OP_PROFILE || DEBUG_IDE
+    #undef EJS_JIT
+    #define EJS_JIT 0
+#endif
+#if EJS_JIT
+    static void jitEnter(Ejs *ejs, EjsFrame *fp);
+    /*
+        Continue the current frame in native code once its function is hot. Used after calls, returns and loop back
+        edges. Native code returns with the frame ready for the interpreter to dispatch the next instruction.
+     */
+    #define JIT_ENTER() if (ejs->service->jit) { jitEnter(ejs, FRAME); } else
+#else
+    #define JIT_ENTER()
+#endif
+
 #if BIT_UNIX_LIKE || (VXWORKS && !BIT_DIAB)
     #define CASE(opcode) opcode
     #define BREAK goto *opcodeJump[opcode = traceCode(ejs, GET_BYTE())]
@@ -153,6 +312,134 @@ static MPR_INLINE void checkGetter(Ejs *ejs, EjsAny *value, EjsAny *thisObj, Ejs
     #define CASE(opcode) case opcode
 #endif
 
+/*
+    Op code fragments. Each runs the body of one op code after its op code byte has been read. The standalone op codes
+    and the fused op code handlers in ejsByteFused.h share these. A fragment that transfers control ends with BREAK
+    or a goto, so it must be last in a fused sequence.
+ */
+#define DO_DUP() \
+    vp = state->stack[0]; \
+    push(vp)
+
+#define DO_POP() \
+    ejs->result = pop(ejs); \
+    assert(ejs->exception || ejs->result)
+
+#define DO_LOAD_INT() \
+    push(ejsCreateNumber(ejs, (MprNumber) GET_NUM()))
+
+#define DO_LOAD_N() \
+    push(ejsCreateNumber(ejs, opcode - EJS_OP_LOAD_0))
+
+#define DO_LOAD_STRING() \
+    push(GET_STRING())
+
+#define DO_GET_LOCAL_SLOT_N() \
+    GET_SLOT(NULL, FRAME, opcode - EJS_OP_GET_LOCAL_SLOT_0)
+
+#define DO_PUT_LOCAL_SLOT_N() \
+    SET_SLOT(NULL, FRAME, opcode - EJS_OP_PUT_LOCAL_SLOT_0, pop(ejs))
+
+#define DO_GET_SCOPED_NAME() \
+    qname = GET_NAME(); \
+    vp = ejsGetVarByName(ejs, NULL, qname, &lookup); \
+    if (unlikely(vp == 0)) { \
+        vp = ejsGetVarByName(ejs, NULL, qname, &lookup); \
+        ejsThrowReferenceError(ejs, "%@ is not defined", qname.name); \
+    } else { \
+        CHECK_VALUE(vp, NULL, lookup.obj, lookup.slotNum); \
+    }
+
+#define DO_PUT_SCOPED_NAME() \
+    qname = GET_NAME(); \
+    value = pop(ejs); \
+    storePropertyToScope(ejs, qname, value)
+
+#define DO_GOTO_8() \
+    offset = (schar) GET_BYTE(); \
+    if (offset < 0) { \
+        HEAT(FRAME->function.body.code); \
+    } \
+    SET_PC(FRAME, &FRAME->pc[offset]); \
+    CHECK_GC(); \
+    if (offset < 0) { \
+        JIT_ENTER(); \
+    } \
+    BREAK
+
+#define DO_BRANCH_FALSE_8() \
+    opcode = EJS_OP_BRANCH_FALSE; \
+    offset = (schar) GET_BYTE(); \
+    goto commonBoolBranchCode
+
+#define DO_BRANCH_TRUE_8() \
+    opcode = EJS_OP_BRANCH_TRUE; \
+    offset = (schar) GET_BYTE(); \
+    goto commonBoolBranchCode
+
+/*
+    Fused forms of the Number specialized op codes. These accept either the generic or the Number op code, so they
+    test the operands on every run and do not quicken.
+ */
+#define DO_NUMBER_BINARY(generic, op) \
+    v2 = pop(ejs); \
+    v1 = pop(ejs); \
+    if (v1 && v2 && TYPE(v1) == EST(Number) && TYPE(v2) == EST(Number)) { \
+        ejs->result = ejsCreateNumber(ejs, NUMBER(v1) op NUMBER(v2)); \
+    } else { \
+        ejs->result = evalBinaryExpr(ejs, v1, generic, v2); \
+    } \
+    push(ejs->result)
+
+#define DO_NUMBER_COMPARE(generic, op) \
+    v2 = pop(ejs); \
+    v1 = pop(ejs); \
+    if (v1 && v2 && TYPE(v1) == EST(Number) && TYPE(v2) == EST(Number)) { \
+        ejs->result = (NUMBER(v1) op NUMBER(v2)) ? ESV(true) : ESV(false); \
+    } else { \
+        ejs->result = evalBinaryExpr(ejs, v1, generic, v2); \
+    } \
+    push(ejs->result)
+
+#define DO_ADD()            DO_NUMBER_BINARY(EJS_OP_ADD, +)
+#define DO_SUB()            DO_NUMBER_BINARY(EJS_OP_SUB, -)
+#define DO_MUL()            DO_NUMBER_BINARY(EJS_OP_MUL, *)
+#define DO_DIV()            DO_NUMBER_BINARY(EJS_OP_DIV, /)
+#define DO_COMPARE_EQ()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_EQ, ==)
+#define DO_COMPARE_NE()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_NE, !=)
+#define DO_COMPARE_LT()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_LT, <)
+#define DO_COMPARE_LE()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_LE, <=)
+#define DO_COMPARE_GT()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_GT, >)
+#define DO_COMPARE_GE()     DO_NUMBER_COMPARE(EJS_OP_COMPARE_GE, >=)
+
+#define DO_INC() \
+    v1 = pop(ejs); \
+    count = (schar) GET_BYTE(); \
+    if (v1 && TYPE(v1) == EST(Number)) { \
+        result = (EjsObj*) ejsCreateNumber(ejs, NUMBER(v1) + count); \
+    } else { \
+        result = evalBinaryExpr(ejs, v1, EJS_OP_ADD, ejsCreateNumber(ejs, count)); \
+    } \
+    push(result)
+
+/*
+    Run the next op code of a fused sequence. The op code byte is still in the instruction stream, so if a fragment
+    threw, called a getter or the code does not match, end the sequence and dispatch the rest normally.
+ */
+#define FUSED_START(first) \
+    fusedFrame = FRAME; \
+    opcode = first
+
+#define NEXT_OP(test) \
+    if (FRAME != fusedFrame || ejs->exception || !(test)) { \
+        BREAK; \
+    } \
+    opcode = traceCode(ejs, GET_BYTE())
+
+#define IS_OP(op)           (*FRAME->pc == (op))
+#define IS_NUMBER_OP(op)    (*FRAME->pc == (op) || *FRAME->pc == op##_NUM)
+#define IS_SERIES_OP(op)    ((uint) (*FRAME->pc - (op)) <= 9)
+
 /******************************** Forward Declarations ************************/
 
 static void callInterfaceInitializers(Ejs *ejs, EjsType *type);
@@ -171,10 +458,14 @@ static EjsString *getStringArg(Ejs *ejs, EjsFrame *fp);
 static EjsObj *getGlobalArg(Ejs *ejs, EjsFrame *fp);
 static EjsBlock *popExceptionBlock(Ejs *ejs);
 static bool processException(Ejs *ejs);
-static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *obj, EjsName name, EjsObj *value);
+static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *obj, EjsName name, EjsObj *value, EjsLookup *resolved);
 static void storePropertyToSlot(Ejs *ejs, EjsObj *thisObj, EjsAny *obj, int slotNum, EjsObj *value);
 static void storePropertyToScope(Ejs *ejs, EjsName qname, EjsObj *value);
 static void throwNull(Ejs *ejs);
+static void manageCache(EjsCache *cache, int flags);
+static void manageCacheEntry(EjsCacheEntry *entry, int flags);
+static void updateCache(Ejs *ejs, EjsCode *code, uchar *site, uchar *pc, EjsAny *vp, EjsName *siteName, EjsName qname, 
+    EjsAny *holder, int slotNum);
 
 /************************************* Code ***********************************/
 /*
@@ -185,7 +476,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
     EjsName     qname;
     EjsObj      *result, *vp, *v1, *v2, *obj, *value;
     int         slotNum, nthBase;
-    EjsState    *state;
+    EjsState    vmState, *state;
     EjsBlock    *blk;
     EjsObj      *global;
     EjsObj      *vobj, *thisObj;
@@ -194,10 +485,13 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
     EjsType     *type;
     EjsLookup   lookup;
     EjsEx       *ex;
-    EjsFrame    *newFrame;
+    EjsFrame    *newFrame, *fusedFrame;
     EjsFunction *f1, *f2;
     EjsNamespace *nsp;
     EjsString   *str;
+    EjsCode     *code;
+    EjsCacheEntry *entry;
+    uchar       *site;
     int         i, offset, count, opcode, attributes, paused;
 
 #if BIT_UNIX_LIKE || (VXWORKS && !BIT_DIAB)
@@ -217,7 +511,10 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
     slotNum = -1;
     global = ejs->global;
 
-    state = mprAlloc(sizeof(EjsState));
+    /*
+        The VM state lives on the C stack. The GC marks its contents via the ejs->state chain.
+     */
+    state = &vmState;
     *state = *ejs->state;
     state->prev = ejs->state;
     state->paused = ejs->state->paused;
@@ -226,6 +523,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
     callFunction(ejs, fun, otherThis, argc, stackAdjust);
     assert(state->fp);
     FRAME->caller = 0;
+    JIT_ENTER();
 
 #if BIT_UNIX_LIKE || (VXWORKS && !BIT_DIAB)
     /*
@@ -301,8 +599,10 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             }
             state->bp = FRAME->function.block.prev;
             newFrame = FRAME->caller;
+            ejsFreeFrame(ejs, FRAME);
             FRAME = newFrame;
             CHECK_GC();
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -317,8 +617,10 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             state->stack = FRAME->stackReturn;
             state->bp = FRAME->function.block.prev;
             newFrame = FRAME->caller;
+            ejsFreeFrame(ejs, FRAME);
             FRAME = newFrame;
             CHECK_GC();
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -371,7 +673,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         [Number]
          */
         CASE (EJS_OP_LOAD_INT):
-            push(ejsCreateNumber(ejs, (MprNumber) GET_NUM()));
+            DO_LOAD_INT();
             BREAK;
 
         /*
@@ -390,7 +692,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
         CASE (EJS_OP_LOAD_7):
         CASE (EJS_OP_LOAD_8):
         CASE (EJS_OP_LOAD_9):
-            push(ejsCreateNumber(ejs, opcode - EJS_OP_LOAD_0));
+            DO_LOAD_N();
             BREAK;
 
         /*
@@ -410,7 +712,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         [String]
          */
         CASE (EJS_OP_LOAD_STRING):
-            push(GET_STRING());
+            DO_LOAD_STRING();
             BREAK;
 
         /*
@@ -479,9 +781,15 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
 
         CASE (EJS_OP_LOAD_THIS_LOOKUP):
             if (lookup.originalObj) {
+                if (ejsIsFrame(ejs, lookup.originalObj)) {
+                    ((EjsFrame*) lookup.originalObj)->captured = 1;
+                }
                 push(lookup.originalObj);
             } else {
                 obj = FRAME->function.moduleInitializer ? ejs->global : (EjsObj*) FRAME;
+                if (obj == (EjsObj*) FRAME) {
+                    FRAME->captured = 1;
+                }
                 push(obj);
             }
             BREAK;
@@ -563,7 +871,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
         CASE (EJS_OP_GET_LOCAL_SLOT_7):
         CASE (EJS_OP_GET_LOCAL_SLOT_8):
         CASE (EJS_OP_GET_LOCAL_SLOT_9):
-            GET_SLOT(NULL, FRAME, opcode - EJS_OP_GET_LOCAL_SLOT_0);
+            DO_GET_LOCAL_SLOT_N();
             BREAK;
 
         /*
@@ -674,14 +982,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         [value]
          */
         CASE (EJS_OP_GET_SCOPED_NAME):
-            qname = GET_NAME();
-            vp = ejsGetVarByName(ejs, NULL, qname, &lookup);
-            if (unlikely(vp == 0)) {
-                vp = ejsGetVarByName(ejs, NULL, qname, &lookup);
-                ejsThrowReferenceError(ejs, "%@ is not defined", qname.name);
-            } else {
-                CHECK_VALUE(vp, NULL, lookup.obj, lookup.slotNum);
-            }
+            DO_GET_SCOPED_NAME();
             BREAK;
                 
         /*
@@ -699,6 +1000,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 qname.space = ejsToString(ejs, v1);
             }
+            ejsInternName(&qname);
             vp = ejsGetVarByName(ejs, NULL, qname, &lookup);
             if (unlikely(vp == 0)) {
                 push(ESV(undefined));
@@ -743,13 +1045,21 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
 #if DYNAMIC_BINDING
             mark = FRAME->pc - 1;
 #endif
-            qname = GET_NAME();
             vp = pop(ejs);
+            if ((entry = lookupCache(ejs, FRAME, vp, NULL)) != 0) {
+                obj = entry->holder ? entry->holder : vp;
+                CHECK_VALUE(ejsGetProperty(ejs, obj, entry->slotNum), vp, obj, entry->slotNum);
+                BREAK;
+            }
+            site = FRAME->pc;
+            qname = GET_NAME();
             if (vp == ESV(null) || vp == ESV(undefined)) {
                 ejsThrowReferenceError(ejs, "Object reference is null");
                 BREAK;
             }
-            v1 = ejsGetVarByName(ejs, vp, qname, &lookup);
+            if ((v1 = ejsGetVarByName(ejs, vp, qname, &lookup)) != 0) {
+                updateCache(ejs, FRAME->function.body.code, site, FRAME->pc, vp, NULL, qname, lookup.obj, lookup.slotNum);
+            }
             CHECK_VALUE(v1, vp, lookup.obj, lookup.slotNum);
 #if DYNAMIC_BINDING
             if (lookup.slotNum < 0 || lookup.slotNum > 4096 || ejs->flags & EJS_FLAG_COMPILER) {
@@ -853,7 +1163,16 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 } else {
                     qname.space = ejsToString(ejs, v2);
                 }
-                v2 = ejsGetVarByName(ejs, vp, qname, &lookup);
+                ejsInternName(&qname);
+                if (qname.name && qname.space && (entry = lookupCache(ejs, FRAME, vp, &qname)) != 0) {
+                    obj = entry->holder ? entry->holder : vp;
+                    CHECK_VALUE(ejsGetProperty(ejs, obj, entry->slotNum), NULL, obj, entry->slotNum);
+                    BREAK;
+                }
+                if ((v2 = ejsGetVarByName(ejs, vp, qname, &lookup)) != 0) {
+                    updateCache(ejs, FRAME->function.body.code, FRAME->pc, FRAME->pc, vp, &qname, qname, lookup.obj, 
+                        lookup.slotNum);
+                }
                 CHECK_VALUE(v2, NULL, lookup.obj, lookup.slotNum);
                 BREAK;
             }
@@ -897,7 +1216,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
         CASE (EJS_OP_PUT_LOCAL_SLOT_7):
         CASE (EJS_OP_PUT_LOCAL_SLOT_8):
         CASE (EJS_OP_PUT_LOCAL_SLOT_9):
-            SET_SLOT(NULL, FRAME, opcode - EJS_OP_PUT_LOCAL_SLOT_0, pop(ejs));
+            DO_PUT_LOCAL_SLOT_N();
             BREAK;
 
         /*
@@ -1005,9 +1324,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         []
          */
         CASE (EJS_OP_PUT_SCOPED_NAME):
-            qname = GET_NAME();
-            value = pop(ejs);
-            storePropertyToScope(ejs, qname, value);
+            DO_PUT_SCOPED_NAME();
             BREAK;
 
         /*
@@ -1026,6 +1343,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 qname.space = ejsToString(ejs, v1);
             }
+            ejsInternName(&qname);
             value = pop(ejs);
             storePropertyToScope(ejs, qname, value);
             BREAK;
@@ -1038,10 +1356,20 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         []
          */
         CASE (EJS_OP_PUT_OBJ_NAME):
-            qname = GET_NAME();
             obj = pop(ejs);
             value = pop(ejs);
-            storeProperty(ejs, obj, obj, qname, value);
+            if ((entry = lookupCache(ejs, FRAME, obj, NULL)) != 0) {
+                SET_SLOT(obj, entry->holder ? entry->holder : obj, entry->slotNum, value);
+                BREAK;
+            }
+            code = FRAME->function.body.code;
+            site = FRAME->pc;
+            qname = GET_NAME();
+            offset = (int) (FRAME->pc - site);
+            storeProperty(ejs, obj, obj, qname, value, &lookup);
+            if (lookup.obj && !ejs->exception) {
+                updateCache(ejs, code, site, site + offset, obj, NULL, qname, lookup.obj, lookup.slotNum);
+            }
             BREAK;
 
         /*
@@ -1068,8 +1396,18 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 } else {
                     qname.space = ejsToString(ejs, v2);
                 }
+                ejsInternName(&qname);
                 if (qname.name && qname.space) {
-                    storeProperty(ejs, obj, obj, qname, value);
+                    if ((entry = lookupCache(ejs, FRAME, obj, &qname)) != 0) {
+                        SET_SLOT(obj, entry->holder ? entry->holder : obj, entry->slotNum, value);
+                        BREAK;
+                    }
+                    code = FRAME->function.body.code;
+                    site = FRAME->pc;
+                    storeProperty(ejs, obj, obj, qname, value, &lookup);
+                    if (lookup.obj && !ejs->exception) {
+                        updateCache(ejs, code, site, site, obj, &qname, qname, lookup.obj, lookup.slotNum);
+                    }
                 }
             }
             BREAK;
@@ -1120,6 +1458,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             ejs->spreadArgs = 0;
             vp = state->stack[-argc - 1];
             callFunction(ejs, (EjsFunction*) state->stack[-argc], vp, argc, 2);
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1134,6 +1473,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             argc += ejs->spreadArgs;
             ejs->spreadArgs = 0;
             callProperty(ejs, global, slotNum, NULL, argc, 0);
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1159,6 +1499,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 callProperty(ejs, TYPE(vp)->prototype, slotNum, vp, argc, 1);
             }
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1174,6 +1515,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             ejs->spreadArgs = 0;
             obj = (EjsObj*) TYPE(THIS)->prototype;
             callProperty(ejs, obj, slotNum, NULL, argc, 0);
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1189,6 +1531,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             argc += ejs->spreadArgs;
             ejs->spreadArgs = 0;
             callProperty(ejs, obj, slotNum, NULL, argc, 0);
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1209,6 +1552,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 callProperty(ejs, vp, slotNum, vp, argc, 1);
             }
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1231,6 +1575,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 type = (EjsType*) getNthBase(ejs, vp, nthBase);
                 callProperty(ejs, type, slotNum, type, argc, 1);
             }
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1252,6 +1597,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 BREAK;
             }
             callProperty(ejs, type, slotNum, type, argc, 0);
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1282,6 +1628,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 }
                 callProperty(ejs, lookup.obj, slotNum, vp, argc, 1);
             }
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1331,6 +1678,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 }
                 callProperty(ejs, lookup.obj, slotNum, vp, argc, 0);
             }
+            JIT_ENTER();
             BREAK;
 
         /*
@@ -1456,6 +1804,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 ejsThrowReferenceError(ejs, "Reference is not a class");
             } else {
                 type->constructor.block.scope = state->bp;
+                FRAME->captured = 1;
                 if (type && type->hasInitializer) {
                     fun = ejsGetProperty(ejs, type, 0);
                     MPR_VERIFY_MEM();
@@ -1493,6 +1842,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                         f2 = f1;
                     }
                     f2->block.scope = state->bp;
+                    FRAME->captured = 1;
                     if (FRAME->function.boundThis != ejs->global) {
                         f2->boundThis = FRAME->function.boundThis;
                     }
@@ -1603,8 +1953,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         []
          */
         CASE (EJS_OP_POP):
-            ejs->result = pop(ejs);
-            assert(ejs->exception || ejs->result);
+            DO_POP();
             BREAK;
 
         /*
@@ -1625,8 +1974,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                                     [value]
          */
         CASE (EJS_OP_DUP):
-            vp = state->stack[0];
-            push(vp);
+            DO_DUP();
             BREAK;
 
         /*
@@ -1735,8 +2083,14 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
          */
         CASE (EJS_OP_GOTO):
             offset = GET_WORD();
+            if (offset < 0) {
+                HEAT(FRAME->function.body.code);
+            }
             SET_PC(FRAME, &FRAME->pc[offset]);
             CHECK_GC();
+            if (offset < 0) {
+                JIT_ENTER();
+            }
             BREAK;
 
         /*
@@ -1744,10 +2098,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Goto.8              <offset.8>
          */
         CASE (EJS_OP_GOTO_8):
-            offset = (schar) GET_BYTE();
-            SET_PC(FRAME, &FRAME->pc[offset]);
-            CHECK_GC();
-            BREAK;
+            DO_GOTO_8();
 
         /*
             Branch to offset if false
@@ -1776,9 +2127,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         []
          */
         CASE (EJS_OP_BRANCH_FALSE_8):
-            opcode = (EjsOpCode) (opcode - EJS_OP_BRANCH_TRUE_8 + EJS_OP_BRANCH_TRUE);
-            offset = (schar) GET_BYTE();
-            goto commonBoolBranchCode;
+            DO_BRANCH_FALSE_8();
 
         /*
             Branch to offset if true (8 bit)
@@ -1787,9 +2136,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 Stack after         []
          */
         CASE (EJS_OP_BRANCH_TRUE_8):
-            /* We want sign extension here */
-            opcode = (EjsOpCode) (opcode - EJS_OP_BRANCH_TRUE_8 + EJS_OP_BRANCH_TRUE);
-            offset = (schar) GET_BYTE();
+            DO_BRANCH_TRUE_8();
 
         /*
             Common boolean branch code
@@ -2101,10 +2448,41 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             v2 = pop(ejs);
             v1 = pop(ejs);
             assert(v1);
+            quicken(ejs, FRAME->function.body.code, FRAME->pc - 1, v1, v2);
             ejs->result = evalBinaryExpr(ejs, v1, opcode, v2);
             push(ejs->result);
             BREAK;
 
+        /*
+            Add where the result is only used as the left operand of another add: (left + right) + more.
+            String results are returned as open string builders that the enclosing add appends to.
+                Stack before (top)  [right]
+                                    [left]
+                Stack after         [result]
+         */
+        CASE (EJS_OP_ADD_CHAIN):
+            if (NUMBER_OPERANDS()) {
+                v2 = pop(ejs);
+                v1 = pop(ejs);
+                push(ejsCreateNumber(ejs, NUMBER(v1) + NUMBER(v2)));
+
+            } else if (state->stack[-1] && TYPE(state->stack[-1]) == EST(String)) {
+                /* Convert while still on the stack so the operands are retained if toString runs script */
+                if ((v2 = (EjsObj*) ejsToString(ejs, state->stack[0])) == 0) {
+                    state->stack -= 2;
+                    BREAK;
+                }
+                state->stack--;
+                v1 = pop(ejs);
+                push(ejsAppendString(ejs, (EjsString*) v1, (EjsString*) v2));
+
+            } else {
+                v2 = pop(ejs);
+                v1 = pop(ejs);
+                push(evalBinaryExpr(ejs, v1, EJS_OP_ADD, v2));
+            }
+            BREAK;
+
 
         /* Unary operators */
 
@@ -2156,11 +2534,83 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
         CASE (EJS_OP_INC):
             v1 = pop(ejs);
             count = (schar) GET_BYTE();
+            quicken(ejs, FRAME->function.body.code, FRAME->pc - 2, v1, v1);
             result = evalBinaryExpr(ejs, v1, EJS_OP_ADD, ejsCreateNumber(ejs, count));
             push(result);
             BREAK;
 
 
+        /* Number operators */
+
+        /*
+            Number binary expressions. The compiler emits these when both operands are declared as Numbers. If either
+            operand is not a Number at runtime, revert to the generic opcode.
+                Stack before (top)  [right]
+                                    [left]
+                Stack after         [result]
+         */
+        CASE (EJS_OP_ADD_NUM):
+            NUMBER_BINARY(EJS_OP_ADD, +);
+
+        CASE (EJS_OP_SUB_NUM):
+            NUMBER_BINARY(EJS_OP_SUB, -);
+
+        CASE (EJS_OP_MUL_NUM):
+            NUMBER_BINARY(EJS_OP_MUL, *);
+
+        CASE (EJS_OP_DIV_NUM):
+            NUMBER_BINARY(EJS_OP_DIV, /);
+
+        /*
+            Number comparisons
+                Stack before (top)  [value1]
+                                    [value2]
+                Stack after         [boolean]
+         */
+        CASE (EJS_OP_COMPARE_EQ_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_EQ, ==);
+
+        CASE (EJS_OP_COMPARE_NE_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_NE, !=);
+
+        CASE (EJS_OP_COMPARE_LT_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_LT, <);
+
+        CASE (EJS_OP_COMPARE_LE_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_LE, <=);
+
+        CASE (EJS_OP_COMPARE_GT_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_GT, >);
+
+        CASE (EJS_OP_COMPARE_GE_NUM):
+            NUMBER_COMPARE(EJS_OP_COMPARE_GE, >=);
+
+        /*
+            Increment a Number stack variable
+                IncNum              <increment>
+                Stack before (top)  [value]
+                Stack after         [result]
+         */
+        CASE (EJS_OP_INC_NUM):
+            v1 = pop(ejs);
+            count = (schar) GET_BYTE();
+            if (v1 && TYPE(v1) == EST(Number)) {
+                result = (EjsObj*) ejsCreateNumber(ejs, NUMBER(v1) + count);
+            } else {
+                quicken(ejs, FRAME->function.body.code, FRAME->pc - 2, v1, v1);
+                result = evalBinaryExpr(ejs, v1, EJS_OP_ADD, ejsCreateNumber(ejs, count));
+            }
+            push(result);
+            BREAK;
+
+
+        /*
+            Fused op codes. The handlers are generated by genbyte from the op code sequence profile and run the DO_
+            fragments of each op code in turn. See FUSED_START and NEXT_OP.
+         */
+        #include    "ejsByteFused.h"
+
+
         /* Object creation */
 
         /*
@@ -2279,6 +2729,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 qname.space = ejsToString(ejs, v1);
             }
+            ejsInternName(&qname);
             vp = pop(ejs);
             slotNum = ejsLookupVar(ejs, vp, qname, &lookup);
             if (slotNum < 0) {
@@ -2308,6 +2759,7 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             } else {
                 qname.space = ejsToString(ejs, v1);
             }
+            ejsInternName(&qname);
             slotNum = ejsLookupScope(ejs, qname, &lookup);
             if (slotNum < 0) {
                 push(ESV(true));
@@ -2421,12 +2873,8 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
 #endif
     
 done:
-#if BIT_DEBUG && FUTURE
-    if (ejs->initialized) {
-        ejsShowOpFrequency(ejs);
-    }
-#endif
     assert(FRAME == 0 || FRAME->attentionPc == 0);
+    ejsFreeFrame(ejs, FRAME);
     ejs->state = ejs->state->prev;
     if (ejs->exception) {
         ejsAttention(ejs);
@@ -2499,8 +2947,10 @@ static void storePropertyToSlot(Ejs *ejs, EjsObj *thisObj, EjsAny *obj, int slot
 
 /*
     Store a property by name in the given object. Will create if the property does not already exist.
+    If resolved is supplied, it is set to the object and slot of the existing property (or setter) that received 
+    the store. Otherwise resolved->obj is set to null.
  */
-static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *vp, EjsName qname, EjsObj *value)
+static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *vp, EjsName qname, EjsObj *value, EjsLookup *resolved)
 {
     EjsLookup       lookup;
     EjsTrait        *trait;
@@ -2510,6 +2960,10 @@ static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *vp, EjsName qname,
     assert(qname.name);
     assert(vp);
 
+    if (resolved) {
+        resolved->obj = 0;
+    }
+
     //  ONLY XML requires this.  NOTE: this bypasses ES5 traits
     //  Alternatively push this whole function down into ejsObject and have all go via setPropertyByName
     
@@ -2524,6 +2978,9 @@ static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *vp, EjsName qname,
             trait = ejsGetPropertyTraits(ejs, lookup.obj, slotNum);
             if (trait->attributes & EJS_TRAIT_SETTER) {
                 vp = lookup.obj;
+                if (resolved) {
+                    *resolved = lookup;
+                }
                 
             } else if (ejsIsPrototype(ejs, lookup.obj) || trait->attributes & EJS_TRAIT_GETTER) {
                 if (TYPE(vp)->hasInstanceVars) {
@@ -2545,6 +3002,8 @@ static void storeProperty(Ejs *ejs, EjsObj *thisObj, EjsAny *vp, EjsName qname,
                  */
                 slotNum = -1;
             }
+        } else if (resolved) {
+            *resolved = lookup;
         }
     }
     if (slotNum < 0) {
@@ -2601,6 +3060,140 @@ static void storePropertyToScope(Ejs *ejs, EjsName qname, EjsObj *value)
 }
 
 
+/*
+    Record the result of a by-name property lookup in the inline cache for the site. Only cache results that can be 
+    revalidated cheaply: properties held by the receiver itself (validated by the receiver shape or the name at the slot)
+    and properties held by a prototype or base type of a sealed receiver (validated by the service cache epoch).
+ */
+static void updateCache(Ejs *ejs, EjsCode *code, uchar *site, uchar *pc, EjsAny *vp, EjsName *siteName, EjsName qname, 
+    EjsAny *holder, int slotNum)
+{
+    EjsCache        *cache;
+    EjsCacheLine    *line;
+    EjsCacheEntry   *entry, *ep;
+    EjsType         *type, *t;
+    EjsShape        *shape;
+    EjsPot          *pot, *prototype;
+    EjsName         target;
+    int             offset, size, i;
+
+    type = TYPE(vp);
+    if (slotNum < 0 || !ejsIsPot(ejs, holder) || type->helpers.getPropertyByName || type->virtualSlots ||
+            (type->helpers.lookupProperty != ejs->service->potHelpers.lookupProperty && 
+             type->helpers.lookupProperty != ejs->service->objHelpers.lookupProperty)) {
+        return;
+    }
+    pot = holder;
+    shape = 0;
+    if (holder == vp) {
+        if (pot->dupNames) {
+            return;
+        }
+        shape = ejsGetShape(pot);
+        holder = 0;
+    } else if (DYNAMIC(vp) || ejsIsType(ejs, vp) || (type->isPot && ((EjsPot*) vp)->shortScope) || 
+            !(pot->isPrototype || pot->isType)) {
+        return;
+    } else {
+        /* All prototypes searched before the holder must report shape changes */
+        for (t = type; t; t = t->baseType) {
+            if ((prototype = t->prototype) == 0 || prototype->shortScope || prototype == holder) {
+                break;
+            }
+            if (!prototype->isPrototype) {
+                return;
+            }
+        }
+    }
+    if (slotNum >= pot->numProp) {
+        return;
+    }
+    target = ejsGetPotPropertyName(ejs, pot, slotNum);
+    if (!qname.space->value[0]) {
+        /* Names resolved via the open namespaces must be unique in the holder */
+        qname.space = NULL;
+        if (ejsLookupProperty(ejs, pot, qname) != slotNum) {
+            return;
+        }
+    }
+    if ((cache = code->cache) == 0) {
+        for (size = EJS_CACHE_MIN; size < EJS_CACHE_MAX && size < code->codeLen / 16; size <<= 1) ;
+        if ((cache = mprAllocBlock(sizeof(EjsCache) + size * sizeof(EjsCacheLine), 
+                MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
+            return;
+        }
+        mprSetManager(cache, (MprManager) manageCache);
+        cache->size = size;
+        if (!mprAtomicCas((void**) &code->cache, NULL, cache)) {
+            cache = code->cache;
+        }
+    }
+    offset = (int) (site - code->byteCode);
+    line = &cache->lines[offset & (cache->size - 1)];
+
+    /* Prefer empty, stale or superseded entries. Otherwise evict round-robin until the line is megamorphic */
+    for (i = 0; i < EJS_CACHE_WAYS; i++) {
+        ep = line->entries[i];
+        if (ep == 0 || ep->epoch != ejs->service->cacheEpoch || 
+                (ep->offset == offset && ep->type == type && ep->shape == shape)) {
+            break;
+        }
+    }
+    if (i >= EJS_CACHE_WAYS) {
+        if (line->evictions >= EJS_CACHE_MAX_EVICT) {
+            return;
+        }
+        i = line->evictions++ % EJS_CACHE_WAYS;
+    }
+    if ((entry = mprAllocObj(EjsCacheEntry, manageCacheEntry)) == 0) {
+        return;
+    }
+    entry->type = type;
+    entry->holder = holder;
+    entry->shape = shape;
+    if (siteName) {
+        entry->qname = *siteName;
+    }
+    entry->target = target;
+    entry->offset = offset;
+    entry->operands = (int) (pc - site);
+    entry->slotNum = slotNum;
+    entry->epoch = ejs->service->cacheEpoch;
+    mprAtomicBarrier();
+    line->entries[i] = entry;
+}
+
+
+static void manageCache(EjsCache *cache, int flags)
+{
+    EjsCacheLine    *line;
+    int             i, j;
+
+    if (flags & MPR_MANAGE_MARK) {
+        for (i = 0; i < cache->size; i++) {
+            line = &cache->lines[i];
+            for (j = 0; j < EJS_CACHE_WAYS; j++) {
+                mprMark(line->entries[j]);
+            }
+        }
+    }
+}
+
+
+static void manageCacheEntry(EjsCacheEntry *entry, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(entry->type);
+        mprMark(entry->holder);
+        mprMark(entry->shape);
+        mprMark(entry->qname.name);
+        mprMark(entry->qname.space);
+        mprMark(entry->target.name);
+        mprMark(entry->target.space);
+    }
+}
+
+
 /*
     Run the module initializer
  */
@@ -2936,6 +3529,7 @@ static EjsBlock *popExceptionBlock(Ejs *ejs)
 static bool processException(Ejs *ejs)
 {
     EjsState        *state;
+    EjsFrame        *fp;
 
     state = ejs->state;
 
@@ -2947,9 +3541,11 @@ static bool processException(Ejs *ejs)
         if (ejs->exception == 0) {
             return 1;
         }
-        state->stack = state->fp->stackReturn;
-        state->bp = state->fp->function.block.prev;
-        state->fp = state->fp->caller;
+        fp = state->fp;
+        state->stack = fp->stackReturn;
+        state->bp = fp->function.block.prev;
+        state->fp = fp->caller;
+        ejsFreeFrame(ejs, fp);
         ejsClearAttention(ejs);
     }
     return 0;
@@ -3529,6 +4125,9 @@ static void callFunction(Ejs *ejs, EjsFunction *fun, EjsAny *thisObj, int argc,
         state->fp = fp;
         state->bp = (EjsBlock*) fp;
         ejsClearAttention(ejs);
+        if (fun->body.code) {
+            HEAT(fun->body.code);
+        }
     }
     assert(ejs->state->fp);
 }
@@ -3606,43 +4205,916 @@ static EjsAny *getNthBlock(Ejs *ejs, int nth)
 }
 
 
+#if EJS_JIT || EJS_OP_PROFILE
 /*
-    Enter a mesage into the log file
+    Map a fused op code to the first op code of its sequence. The fused op code replaces only the first op code byte,
+    so the instruction has the operands of the first op code.
  */
-void ejsLog(Ejs *ejs, cchar *fmt, ...)
+static int getFirstOpcode(int opcode)
 {
-    va_list     args;
-    char        buf[BIT_MAX_BUFFER];
-
-    va_start(args, fmt);
-    fmtv(buf, sizeof(buf) - 1, fmt, args);
-    va_end(args);
-    mprLog(0, "%s", buf);
+    switch (opcode) {
+    #define FUSED_FIRST(fused, count, op1, op2, op3, op4) case fused: return op1;
+    EJS_FUSED_OPCODES(FUSED_FIRST)
+    #undef FUSED_FIRST
+    default:
+        return opcode;
+    }
 }
+#endif
 
 
-#if FUTURE
-#if BIT_HAS_LIB_EDIT
-static History  *cmdHistory;
-static EditLine *eh; 
-static cchar    *prompt;
+#if EJS_JIT
+/*
+    Baseline template JIT for x86-64. A hot function is compiled to native code that calls an op code helper for each
+    instruction in turn, so there is no dispatch between instructions. Branches and gotos become native jumps. A
+    comparison followed by a conditional branch returns its result in a register rather than via the VM stack.
+
+    Instructions without a helper (calls, returns, exceptions and most property access) store their address in the
+    frame and return to the interpreter. So does any helper that throws, enters another function (a getter) or needs
+    attention. The interpreter enters the native code again at the next call, return or loop back edge. The native code
+    holds no interpreter state, so every interpreter sharing the byte code runs the same native code.
+ */
+typedef void (*EjsJitCode)(Ejs *ejs, EjsFrame *fp, uchar *entry);
+typedef int (*EjsJitHelper)(Ejs *ejs, EjsFrame *fp, uchar *pc, int opcode);
 
-static cchar *issuePrompt(EditLine *e) {
-    return prompt;
-}
+#define JIT_START       0x1             /* Start of an instruction */
+#define JIT_TARGET      0x2             /* Branch target or exception handler boundary */
+#define JIT_EPILOGUE    13              /* Native code offset of the epilogue */
 
-static EditLine *initEditLine()
+typedef struct JitFixup {
+    int         at;                     /* Native code offset of a jump displacement */
+    int         target;                 /* Byte code offset of the jump target */
+} JitFixup;
+
+/*
+    Op code helpers called from the native code. Each runs one instruction after its op code byte, so "pc" is the
+    address of the operands. Return non-zero if the native code must return to the interpreter.
+ */
+#define JIT_HELPER(name) static int name(Ejs *ejs, EjsFrame *fp, uchar *pc, int opcode)
+
+#define JIT_BEGIN() \
+    EjsState *state = ejs->state; \
+    assert(state->fp == fp && fp->attentionPc == 0); \
+    fp->pc = pc
+
+#define JIT_END() \
+    return ejs->exception || state->fp != fp || fp->attentionPc
+
+JIT_HELPER(jitDup)
 {
-    EditLine    *e;
-    HistEvent   ev; 
+    EjsObj  *vp;
 
-    cmdHistory = history_init(); 
-    history(cmdHistory, &ev, H_SETSIZE, 100); 
-    e = el_init("ejs", stdin, stdout, stderr); 
-    el_set(e, EL_EDITOR, "vi");
-    el_set(e, EL_HIST, history, cmdHistory);
-    el_source(e, NULL);
-    return e;
+    JIT_BEGIN();
+    DO_DUP();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPop)
+{
+    JIT_BEGIN();
+    DO_POP();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitSwap)
+{
+    JIT_BEGIN();
+    SWAP;
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPushResult)
+{
+    JIT_BEGIN();
+    push(ejs->result);
+    JIT_END();
+}
+
+
+JIT_HELPER(jitSaveResult)
+{
+    JIT_BEGIN();
+    ejs->result = pop(ejs);
+    JIT_END();
+}
+
+
+JIT_HELPER(jitLoadN)
+{
+    JIT_BEGIN();
+    DO_LOAD_N();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitLoadInt)
+{
+    JIT_BEGIN();
+    DO_LOAD_INT();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitLoadDouble)
+{
+    JIT_BEGIN();
+    push(ejsCreateNumber(ejs, GET_DOUBLE()));
+    JIT_END();
+}
+
+
+JIT_HELPER(jitLoadString)
+{
+    JIT_BEGIN();
+    DO_LOAD_STRING();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitLoadValue)
+{
+    EjsAny  *value;
+
+    JIT_BEGIN();
+    switch (opcode) {
+    case EJS_OP_LOAD_M1:
+        value = ejsCreateNumber(ejs, -1);
+        break;
+    case EJS_OP_LOAD_TRUE:
+        value = ESV(true);
+        break;
+    case EJS_OP_LOAD_FALSE:
+        value = ESV(false);
+        break;
+    case EJS_OP_LOAD_NULL:
+        value = ESV(null);
+        break;
+    case EJS_OP_LOAD_GLOBAL:
+        value = ejs->global;
+        break;
+    case EJS_OP_LOAD_THIS:
+        value = THIS;
+        break;
+    default:
+        value = ESV(undefined);
+        break;
+    }
+    push(value);
+    JIT_END();
+}
+
+
+JIT_HELPER(jitGetLocalSlot)
+{
+    JIT_BEGIN();
+    GET_SLOT(NULL, FRAME, GET_INT());
+    JIT_END();
+}
+
+
+JIT_HELPER(jitGetLocalSlotN)
+{
+    JIT_BEGIN();
+    DO_GET_LOCAL_SLOT_N();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPutLocalSlot)
+{
+    JIT_BEGIN();
+    SET_SLOT(NULL, FRAME, GET_INT(), pop(ejs));
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPutLocalSlotN)
+{
+    JIT_BEGIN();
+    DO_PUT_LOCAL_SLOT_N();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitGetGlobalSlot)
+{
+    JIT_BEGIN();
+    GET_SLOT(NULL, ejs->global, GET_INT());
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPutGlobalSlot)
+{
+    JIT_BEGIN();
+    SET_SLOT(NULL, ejs->global, GET_INT(), pop(ejs));
+    JIT_END();
+}
+
+
+JIT_HELPER(jitGetThisSlotN)
+{
+    JIT_BEGIN();
+    GET_SLOT(THIS, THIS, opcode - EJS_OP_GET_THIS_SLOT_0);
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPutThisSlotN)
+{
+    JIT_BEGIN();
+    SET_SLOT(THIS, THIS, opcode - EJS_OP_PUT_THIS_SLOT_0, pop(ejs));
+    JIT_END();
+}
+
+
+JIT_HELPER(jitGetScopedName)
+{
+    EjsName     qname;
+    EjsLookup   lookup;
+    EjsObj      *vp;
+
+    JIT_BEGIN();
+    DO_GET_SCOPED_NAME();
+    JIT_END();
+}
+
+
+JIT_HELPER(jitPutScopedName)
+{
+    EjsName     qname;
+    EjsObj      *value;
+
+    JIT_BEGIN();
+    DO_PUT_SCOPED_NAME();
+    JIT_END();
+}
+
+
+/*
+    Arithmetic and comparison with a Number fast path. These run both the generic and the Number op codes.
+ */
+#define JIT_NUMBER_HELPER(name, fragment) \
+    JIT_HELPER(name) \
+    { \
+        EjsObj  *v1, *v2; \
+        JIT_BEGIN(); \
+        fragment(); \
+        JIT_END(); \
+    }
+
+JIT_NUMBER_HELPER(jitAdd, DO_ADD)
+JIT_NUMBER_HELPER(jitSub, DO_SUB)
+JIT_NUMBER_HELPER(jitMul, DO_MUL)
+JIT_NUMBER_HELPER(jitDiv, DO_DIV)
+JIT_NUMBER_HELPER(jitCompareEq, DO_COMPARE_EQ)
+JIT_NUMBER_HELPER(jitCompareNe, DO_COMPARE_NE)
+JIT_NUMBER_HELPER(jitCompareLt, DO_COMPARE_LT)
+JIT_NUMBER_HELPER(jitCompareLe, DO_COMPARE_LE)
+JIT_NUMBER_HELPER(jitCompareGt, DO_COMPARE_GT)
+JIT_NUMBER_HELPER(jitCompareGe, DO_COMPARE_GE)
+
+
+JIT_HELPER(jitBinary)
+{
+    EjsObj  *v1, *v2;
+
+    JIT_BEGIN();
+    v2 = pop(ejs);
+    v1 = pop(ejs);
+    ejs->result = evalBinaryExpr(ejs, v1, opcode, v2);
+    push(ejs->result);
+    JIT_END();
+}
+
+
+JIT_HELPER(jitInc)
+{
+    EjsObj  *v1, *result;
+    int     count;
+
+    JIT_BEGIN();
+    DO_INC();
+    JIT_END();
+}
+
+
+/*
+    Test a branch condition. Return 1 if true, 0 if false and -1 if the cast to Boolean threw.
+ */
+static int jitTruth(Ejs *ejs, EjsAny *value)
+{
+    if (value == 0 || !ejsIs(ejs, value, Boolean)) {
+        value = ejsCast(ejs, value, Boolean);
+        if (ejs->exception) {
+            return -1;
+        }
+    }
+    if (!ejsIs(ejs, value, Boolean)) {
+        ejsThrowTypeError(ejs, "Result of a comparision must be boolean");
+        return -1;
+    }
+    return ((EjsBoolean*) value)->value ? 1 : 0;
+}
+
+
+/*
+    Conditional branch. The "pc" is the address of the next instruction.
+ */
+JIT_HELPER(jitTest)
+{
+    EjsObj  *v1;
+
+    JIT_BEGIN();
+    v1 = pop(ejs);
+    return jitTruth(ejs, v1);
+}
+
+
+/*
+    Comparison followed by a conditional branch. The result is returned rather than pushed on the VM stack.
+ */
+JIT_HELPER(jitCompareTest)
+{
+    EjsObj  *v1, *v2;
+    double  n1, n2;
+
+    JIT_BEGIN();
+    v2 = pop(ejs);
+    v1 = pop(ejs);
+    if (v1 && v2 && TYPE(v1) == EST(Number) && TYPE(v2) == EST(Number)) {
+        n1 = NUMBER(v1);
+        n2 = NUMBER(v2);
+        switch (opcode) {
+        case EJS_OP_COMPARE_EQ:
+            return n1 == n2;
+        case EJS_OP_COMPARE_NE:
+            return n1 != n2;
+        case EJS_OP_COMPARE_LT:
+            return n1 < n2;
+        case EJS_OP_COMPARE_LE:
+            return n1 <= n2;
+        case EJS_OP_COMPARE_GT:
+            return n1 > n2;
+        case EJS_OP_COMPARE_GE:
+            return n1 >= n2;
+        }
+    }
+    v1 = evalBinaryExpr(ejs, v1, opcode, v2);
+    if (ejs->exception) {
+        return -1;
+    }
+    return jitTruth(ejs, v1);
+}
+
+
+/*
+    Loop back edge to "pc". Yield to the garbage collector if required. Leave the native code if a debugger is attached
+    or the JIT is disabled.
+ */
+JIT_HELPER(jitLoop)
+{
+    JIT_BEGIN();
+    CHECK_GC();
+    if (mprGetDebugMode() || !ejs->service->jit) {
+        return 1;
+    }
+    JIT_END();
+}
+
+
+static EjsJitHelper getJitHelper(int opcode)
+{
+    switch (opcode) {
+    case EJS_OP_DUP:
+        return jitDup;
+    case EJS_OP_POP:
+        return jitPop;
+    case EJS_OP_SWAP:
+        return jitSwap;
+    case EJS_OP_PUSH_RESULT:
+        return jitPushResult;
+    case EJS_OP_SAVE_RESULT:
+        return jitSaveResult;
+    case EJS_OP_LOAD_0: case EJS_OP_LOAD_1: case EJS_OP_LOAD_2: case EJS_OP_LOAD_3: case EJS_OP_LOAD_4:
+    case EJS_OP_LOAD_5: case EJS_OP_LOAD_6: case EJS_OP_LOAD_7: case EJS_OP_LOAD_8: case EJS_OP_LOAD_9:
+        return jitLoadN;
+    case EJS_OP_LOAD_INT:
+        return jitLoadInt;
+    case EJS_OP_LOAD_DOUBLE:
+        return jitLoadDouble;
+    case EJS_OP_LOAD_STRING:
+        return jitLoadString;
+    case EJS_OP_LOAD_M1: case EJS_OP_LOAD_TRUE: case EJS_OP_LOAD_FALSE: case EJS_OP_LOAD_NULL:
+    case EJS_OP_LOAD_UNDEFINED: case EJS_OP_LOAD_GLOBAL: case EJS_OP_LOAD_THIS:
+        return jitLoadValue;
+    case EJS_OP_GET_LOCAL_SLOT:
+        return jitGetLocalSlot;
+    case EJS_OP_GET_LOCAL_SLOT_0: case EJS_OP_GET_LOCAL_SLOT_1: case EJS_OP_GET_LOCAL_SLOT_2:
+    case EJS_OP_GET_LOCAL_SLOT_3: case EJS_OP_GET_LOCAL_SLOT_4: case EJS_OP_GET_LOCAL_SLOT_5:
+    case EJS_OP_GET_LOCAL_SLOT_6: case EJS_OP_GET_LOCAL_SLOT_7: case EJS_OP_GET_LOCAL_SLOT_8:
+    case EJS_OP_GET_LOCAL_SLOT_9:
+        return jitGetLocalSlotN;
+    case EJS_OP_PUT_LOCAL_SLOT:
+        return jitPutLocalSlot;
+    case EJS_OP_PUT_LOCAL_SLOT_0: case EJS_OP_PUT_LOCAL_SLOT_1: case EJS_OP_PUT_LOCAL_SLOT_2:
+    case EJS_OP_PUT_LOCAL_SLOT_3: case EJS_OP_PUT_LOCAL_SLOT_4: case EJS_OP_PUT_LOCAL_SLOT_5:
+    case EJS_OP_PUT_LOCAL_SLOT_6: case EJS_OP_PUT_LOCAL_SLOT_7: case EJS_OP_PUT_LOCAL_SLOT_8:
+    case EJS_OP_PUT_LOCAL_SLOT_9:
+        return jitPutLocalSlotN;
+    case EJS_OP_GET_GLOBAL_SLOT:
+        return jitGetGlobalSlot;
+    case EJS_OP_PUT_GLOBAL_SLOT:
+        return jitPutGlobalSlot;
+    case EJS_OP_GET_THIS_SLOT_0: case EJS_OP_GET_THIS_SLOT_1: case EJS_OP_GET_THIS_SLOT_2:
+    case EJS_OP_GET_THIS_SLOT_3: case EJS_OP_GET_THIS_SLOT_4: case EJS_OP_GET_THIS_SLOT_5:
+    case EJS_OP_GET_THIS_SLOT_6: case EJS_OP_GET_THIS_SLOT_7: case EJS_OP_GET_THIS_SLOT_8:
+    case EJS_OP_GET_THIS_SLOT_9:
+        return jitGetThisSlotN;
+    case EJS_OP_PUT_THIS_SLOT_0: case EJS_OP_PUT_THIS_SLOT_1: case EJS_OP_PUT_THIS_SLOT_2:
+    case EJS_OP_PUT_THIS_SLOT_3: case EJS_OP_PUT_THIS_SLOT_4: case EJS_OP_PUT_THIS_SLOT_5:
+    case EJS_OP_PUT_THIS_SLOT_6: case EJS_OP_PUT_THIS_SLOT_7: case EJS_OP_PUT_THIS_SLOT_8:
+    case EJS_OP_PUT_THIS_SLOT_9:
+        return jitPutThisSlotN;
+    case EJS_OP_GET_SCOPED_NAME:
+        return jitGetScopedName;
+    case EJS_OP_PUT_SCOPED_NAME:
+        return jitPutScopedName;
+    case EJS_OP_ADD:
+        return jitAdd;
+    case EJS_OP_SUB:
+        return jitSub;
+    case EJS_OP_MUL:
+        return jitMul;
+    case EJS_OP_DIV:
+        return jitDiv;
+    case EJS_OP_COMPARE_EQ:
+        return jitCompareEq;
+    case EJS_OP_COMPARE_NE:
+        return jitCompareNe;
+    case EJS_OP_COMPARE_LT:
+        return jitCompareLt;
+    case EJS_OP_COMPARE_LE:
+        return jitCompareLe;
+    case EJS_OP_COMPARE_GT:
+        return jitCompareGt;
+    case EJS_OP_COMPARE_GE:
+        return jitCompareGe;
+    case EJS_OP_COMPARE_STRICTLY_EQ: case EJS_OP_COMPARE_STRICTLY_NE:
+    case EJS_OP_REM: case EJS_OP_SHL: case EJS_OP_SHR: case EJS_OP_USHR: case EJS_OP_AND: case EJS_OP_OR:
+    case EJS_OP_XOR:
+        return jitBinary;
+    case EJS_OP_INC:
+        return jitInc;
+    }
+    return 0;
+}
+
+
+/*
+    Decode the instruction at "pc" using the op code table. Set "target" to the branch target if it has one and mark
+    the targets in "flags" if supplied. Return the address of the next instruction or null if the instruction cannot
+    be decoded.
+ */
+static uchar *decodeInstruction(Ejs *ejs, EjsCode *code, uchar *pc, uchar **target, uchar *flags)
+{
+    EjsOptable  *opt;
+    uchar       *start, *end, *base, *to;
+    uint        offset;
+    int         *argp, count, t, i;
+
+    start = code->byteCode;
+    end = &start[code->codeLen];
+    opt = &ejsGetOptable()[*pc++];
+    *target = 0;
+    count = 0;
+
+    for (argp = opt->args; *argp && pc <= end; argp++) {
+        switch (*argp) {
+        case EBC_BYTE:
+            pc++;
+            break;
+
+        case EBC_DOUBLE:
+            ejsDecodeDouble(ejs, &pc);
+            break;
+
+        case EBC_NUM:
+        case EBC_STRING:
+        case EBC_SLOT:
+        case EBC_ARGC:
+        case EBC_ARGC2:
+        case EBC_ARGC3:
+        case EBC_NEW_ARRAY:
+            ejsDecodeNum(ejs, &pc);
+            break;
+
+        case EBC_NEW_OBJECT:
+            count = (int) ejsDecodeNum(ejs, &pc);
+            for (i = 0; i < count && pc < end; i++) {
+                ejsDecodeNum(ejs, &pc);
+            }
+            break;
+
+        case EBC_GLOBAL:
+            t = (int) ejsDecodeNum(ejs, &pc);
+            if (t >= 0 && (t & EJS_ENCODE_GLOBAL_MASK) == EJS_ENCODE_GLOBAL_NAME) {
+                ejsDecodeNum(ejs, &pc);
+            }
+            break;
+
+        case EBC_JMP8:
+            t = (schar) *pc++;
+            *target = &pc[t];
+            break;
+
+        case EBC_JMP:
+            t = ejsDecodeInt32(ejs, &pc);
+            *target = &pc[t];
+            break;
+
+        case EBC_INIT_DEFAULT8:
+        case EBC_INIT_DEFAULT:
+            /* Computed goto table relative to the end of the table size */
+            count = *pc++;
+            base = pc;
+            for (i = 0; i < count; i++) {
+                if (*argp == EBC_INIT_DEFAULT8) {
+                    offset = *pc++;
+                } else {
+                    memcpy(&offset, pc, sizeof(uint));
+                    pc += sizeof(uint);
+                }
+                to = &base[offset];
+                if (to > end) {
+                    return 0;
+                }
+                if (flags) {
+                    flags[to - start] |= JIT_TARGET;
+                }
+            }
+            break;
+
+        default:
+            return 0;
+        }
+    }
+    if (pc > end || (*target && (*target < start || *target > end))) {
+        return 0;
+    }
+    if (*target && flags) {
+        flags[*target - start] |= JIT_TARGET;
+    }
+    return pc;
+}
+
+
+static void emitInt32(MprBuf *buf, int value)
+{
+    mprPutBlockToBuf(buf, (cchar*) &value, sizeof(int));
+}
+
+
+static void emitInt64(MprBuf *buf, int64 value)
+{
+    mprPutBlockToBuf(buf, (cchar*) &value, sizeof(int64));
+}
+
+
+/*
+    Emit a jump (jmp or jcc) with a 32 bit displacement to a native code offset. Return the offset of the displacement.
+ */
+static int emitJump(MprBuf *buf, cchar *op, int to)
+{
+    int     at;
+
+    mprPutBlockToBuf(buf, op, slen(op));
+    at = (int) mprGetBufLength(buf);
+    emitInt32(buf, to - (at + 4));
+    return at;
+}
+
+
+static void patchJump(MprBuf *buf, int at, int to)
+{
+    int     disp;
+
+    disp = to - (at + 4);
+    memcpy(&mprGetBufStart(buf)[at], &disp, sizeof(int));
+}
+
+
+#define JMP             "\xe9"
+#define JE              "\x0f\x84"
+#define JNE             "\x0f\x85"
+#define JS              "\x0f\x88"
+
+/*
+    Call an op code helper: helper(ejs, fp, pc, opcode). Then test the result in eax.
+ */
+static void emitCall(MprBuf *buf, EjsJitHelper helper, uchar *pc, int opcode)
+{
+    /* mov rdi, rbx; mov rsi, r12; mov rdx, pc */
+    mprPutBlockToBuf(buf, "\x48\x89\xdf\x4c\x89\xe6\x48\xba", 8);
+    emitInt64(buf, (int64) (ssize) pc);
+    /* mov ecx, opcode */
+    mprPutBlockToBuf(buf, "\xb9", 1);
+    emitInt32(buf, opcode);
+    /* mov rax, helper; call rax; test eax, eax */
+    mprPutBlockToBuf(buf, "\x48\xb8", 2);
+    emitInt64(buf, (int64) (ssize) helper);
+    mprPutBlockToBuf(buf, "\xff\xd0\x85\xc0", 4);
+}
+
+
+/*
+    Return to the interpreter at "pc"
+ */
+static void emitExit(MprBuf *buf, uchar *pc)
+{
+    /* mov rax, pc; mov [r12 + offsetof(EjsFrame, pc)], rax */
+    mprPutBlockToBuf(buf, "\x48\xb8", 2);
+    emitInt64(buf, (int64) (ssize) pc);
+    mprPutBlockToBuf(buf, "\x49\x89\x84\x24", 4);
+    emitInt32(buf, (int) offsetof(EjsFrame, pc));
+    emitJump(buf, JMP, JIT_EPILOGUE);
+}
+
+
+/*
+    Emit a branch to "target" after a test helper has returned the condition in eax. Backward branches check in with
+    jitLoop when taken.
+ */
+static void emitBranch(MprBuf *buf, JitFixup *fixup, uchar *pc, uchar *target, uchar *start, int branchTrue)
+{
+    int     skip;
+
+    emitJump(buf, JS, JIT_EPILOGUE);
+    fixup->target = (int) (target - start);
+    if (target > pc) {
+        fixup->at = emitJump(buf, branchTrue ? JNE : JE, 0);
+    } else {
+        skip = emitJump(buf, branchTrue ? JE : JNE, 0);
+        emitCall(buf, jitLoop, target, 0);
+        emitJump(buf, JNE, JIT_EPILOGUE);
+        fixup->at = emitJump(buf, JMP, 0);
+        patchJump(buf, skip, (int) mprGetBufLength(buf));
+    }
+}
+
+
+static bool isBoolBranch(int opcode)
+{
+    return opcode == EJS_OP_BRANCH_TRUE || opcode == EJS_OP_BRANCH_FALSE || opcode == EJS_OP_BRANCH_TRUE_8 ||
+        opcode == EJS_OP_BRANCH_FALSE_8;
+}
+
+
+static bool isTrueBranch(int opcode)
+{
+    return opcode == EJS_OP_BRANCH_TRUE || opcode == EJS_OP_BRANCH_TRUE_8;
+}
+
+
+/*
+    Generate the native code for a function. The code starts with a prologue that saves the callee saved registers
+    used for "ejs" and "fp" and jumps to the entry point, followed by the shared epilogue.
+ */
+static bool generateJit(Ejs *ejs, EjsCode *code, EjsJit *jit)
+{
+    EjsEx           *ex;
+    EjsJitHelper    helper;
+    JitFixup        *fixups;
+    MprBuf          *buf;
+    uchar           *flags, *start, *end, *pc, *next, *target, *branch, *native;
+    ssize           size;
+    int             numFixups, opcode, generic, len, to, i;
+
+    start = code->byteCode;
+    len = code->codeLen;
+    end = &start[len];
+    if ((flags = mprAllocZeroed(len + 1)) == 0) {
+        return 0;
+    }
+    for (pc = start; pc < end; pc = next) {
+        flags[pc - start] |= JIT_START;
+        if ((next = decodeInstruction(ejs, code, pc, &target, flags)) == 0) {
+            return 0;
+        }
+    }
+    flags[len] |= JIT_START;
+    for (i = 0; i < code->numHandlers; i++) {
+        ex = code->handlers[i];
+        if (ex->tryStart > len || ex->tryEnd > len || ex->handlerStart > len || ex->handlerEnd > len) {
+            return 0;
+        }
+        flags[ex->tryStart] |= JIT_TARGET;
+        flags[ex->tryEnd] |= JIT_TARGET;
+        flags[ex->handlerStart] |= JIT_TARGET;
+        flags[ex->handlerEnd] |= JIT_TARGET;
+    }
+    for (i = 0; i <= len; i++) {
+        if ((flags[i] & JIT_TARGET) && !(flags[i] & JIT_START)) {
+            return 0;
+        }
+    }
+    if ((buf = mprCreateBuf(len * 48 + 64, -1)) == 0 || (fixups = mprAlloc((len + 1) * sizeof(JitFixup))) == 0) {
+        return 0;
+    }
+    numFixups = 0;
+
+    /* push rbx; push r12; push r13; mov rbx, rdi; mov r12, rsi; jmp rdx */
+    mprPutBlockToBuf(buf, "\x53\x41\x54\x41\x55\x48\x89\xfb\x49\x89\xf4\xff\xe2", 13);
+    assert(mprGetBufLength(buf) == JIT_EPILOGUE);
+    /* pop r13; pop r12; pop rbx; ret */
+    mprPutBlockToBuf(buf, "\x41\x5d\x41\x5c\x5b\xc3", 6);
+
+    for (pc = start; pc < end; pc = next) {
+        next = decodeInstruction(ejs, code, pc, &target, NULL);
+        jit->entries[pc - start] = (int) mprGetBufLength(buf);
+        opcode = getFirstOpcode(*pc);
+        if ((generic = ejsGetGenericOpcode(opcode)) != 0) {
+            opcode = generic;
+        }
+        switch (opcode) {
+        case EJS_OP_NOP:
+            break;
+
+        case EJS_OP_GOTO:
+        case EJS_OP_GOTO_8:
+            if (target <= pc) {
+                emitCall(buf, jitLoop, target, 0);
+                emitJump(buf, JNE, JIT_EPILOGUE);
+            }
+            fixups[numFixups].target = (int) (target - start);
+            fixups[numFixups++].at = emitJump(buf, JMP, 0);
+            break;
+
+        case EJS_OP_BRANCH_TRUE:
+        case EJS_OP_BRANCH_FALSE:
+        case EJS_OP_BRANCH_TRUE_8:
+        case EJS_OP_BRANCH_FALSE_8:
+            emitCall(buf, jitTest, next, 0);
+            emitBranch(buf, &fixups[numFixups++], pc, target, start, isTrueBranch(opcode));
+            break;
+
+        case EJS_OP_COMPARE_EQ:
+        case EJS_OP_COMPARE_NE:
+        case EJS_OP_COMPARE_LT:
+        case EJS_OP_COMPARE_LE:
+        case EJS_OP_COMPARE_GT:
+        case EJS_OP_COMPARE_GE:
+        case EJS_OP_COMPARE_STRICTLY_EQ:
+        case EJS_OP_COMPARE_STRICTLY_NE:
+            branch = next;
+            if (branch < end && isBoolBranch(*branch) && !(flags[branch - start] & JIT_TARGET)) {
+                /* The branch is not an entry point. Exceptions resume in the interpreter at the branch */
+                next = decodeInstruction(ejs, code, branch, &target, NULL);
+                emitCall(buf, jitCompareTest, pc + 1, opcode);
+                emitBranch(buf, &fixups[numFixups++], pc, target, start, isTrueBranch(*branch));
+                break;
+            }
+            /* Fall through */
+
+        default:
+            if ((helper = getJitHelper(opcode)) != 0) {
+                emitCall(buf, helper, pc + 1, opcode);
+                emitJump(buf, JNE, JIT_EPILOGUE);
+            } else {
+                /* Not an entry point. Entering here would only return to the interpreter */
+                jit->entries[pc - start] = -jit->entries[pc - start];
+                emitExit(buf, pc);
+            }
+            break;
+        }
+    }
+    jit->entries[len] = -(int) mprGetBufLength(buf);
+    emitExit(buf, end);
+
+    for (i = 0; i < numFixups; i++) {
+        if ((to = abs(jit->entries[fixups[i].target])) == 0) {
+            return 0;
+        }
+        patchJump(buf, fixups[i].at, to);
+    }
+    jit->entries[len] = 0;
+
+    size = mprGetBufLength(buf);
+    size = (size + mprGetPageSize() - 1) & ~(mprGetPageSize() - 1);
+    if ((native = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED) {
+        return 0;
+    }
+    memcpy(native, mprGetBufStart(buf), mprGetBufLength(buf));
+    if (mprotect(native, size, PROT_READ | PROT_EXEC) < 0) {
+        munmap(native, size);
+        return 0;
+    }
+    jit->native = native;
+    jit->size = size;
+    return 1;
+}
+
+
+static void manageJit(EjsJit *jit, int flags)
+{
+    if (flags & MPR_MANAGE_FREE) {
+        if (jit->native) {
+            munmap(jit->native, jit->size);
+            jit->native = 0;
+        }
+    }
+}
+
+
+/*
+    Compile a hot function. Functions that cannot be compiled get a jit without native code so they are not retried.
+    Interpreters may race to compile the same code. The first to install its jit wins.
+ */
+static EjsJit *compileJit(Ejs *ejs, EjsCode *code)
+{
+    EjsJit      *jit;
+
+    if ((jit = mprAllocBlock(sizeof(EjsJit) + (code->codeLen + 1) * sizeof(int),
+            MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
+        return 0;
+    }
+    mprSetManager(jit, (MprManager) manageJit);
+    if (!generateJit(ejs, code, jit)) {
+        mprTrace(6, "JIT cannot compile function of %d bytes", code->codeLen);
+    }
+    if (!mprAtomicCas((void**) &code->jit, NULL, jit)) {
+        jit = code->jit;
+    }
+    return jit;
+}
+
+
+/*
+    Run the current frame as native code from its current instruction, if the function is hot and has been compiled.
+    Returns when the native code exits with the frame ready for the interpreter.
+ */
+static void jitEnter(Ejs *ejs, EjsFrame *fp)
+{
+    EjsCode     *code;
+    EjsJit      *jit;
+    ssize       offset;
+
+    code = fp->function.body.code;
+    if (code == 0 || code->byteCode == 0 || code->hotness < EJS_QUICKEN_THRESHOLD || ejs->exception ||
+            fp->attentionPc || mprGetDebugMode()) {
+        return;
+    }
+    if ((jit = code->jit) == 0 && (jit = compileJit(ejs, code)) == 0) {
+        return;
+    }
+    offset = fp->pc - code->byteCode;
+    if (jit->native && 0 <= offset && offset < code->codeLen && jit->entries[offset] > 0) {
+        ((EjsJitCode) jit->native)(ejs, fp, &jit->native[jit->entries[offset]]);
+    }
+}
+#endif /* EJS_JIT */
+
+
+/*
+    Enter a mesage into the log file
+ */
+void ejsLog(Ejs *ejs, cchar *fmt, ...)
+{
+    va_list     args;
+    char        buf[BIT_MAX_BUFFER];
+
+    va_start(args, fmt);
+    fmtv(buf, sizeof(buf) - 1, fmt, args);
+    va_end(args);
+    mprLog(0, "%s", buf);
+}
+
+
+#if FUTURE
+#if BIT_HAS_LIB_EDIT
+static History  *cmdHistory;
+static EditLine *eh; 
+static cchar    *prompt;
+
+static cchar *issuePrompt(EditLine *e) {
+    return prompt;
+}
+
+static EditLine *initEditLine()
+{
+    EditLine    *e;
+    HistEvent   ev; 
+
+    cmdHistory = history_init(); 
+    history(cmdHistory, &ev, H_SETSIZE, 100); 
+    e = el_init("ejs", stdin, stdout, stderr); 
+    el_set(e, EL_EDITOR, "vi");
+    el_set(e, EL_HIST, history, cmdHistory);
+    el_source(e, NULL);
+    return e;
 }
 
 
@@ -3777,24 +5249,151 @@ static EjsOpCode traceCode(Ejs *ejs, EjsOpCode opcode)
 }
 
 
-#if FUTURE
-void ejsShowOpFrequency(Ejs *ejs)
+#endif /* BIT_DEBUG */
+
+
+#if EJS_OP_PROFILE
+/*
+    Op code sequences of 2 to EJS_OP_SEQ_MAX op codes are counted in a hash table. Each sequence is packed into a 64 bit
+    key with 16 bits per op code, first op code in the low bits. Sequences are not counted across calls and returns.
+ */
+#define EJS_OP_SEQ_MAX      4
+#define EJS_OP_SEQ_SIZE     (64 * 1024)
+
+typedef struct OpSeq {
+    uint64      key;
+    uint64      count;
+} OpSeq;
+
+static OpSeq    opseqs[EJS_OP_SEQ_SIZE];
+static int      lastOps[EJS_OP_SEQ_MAX - 1];
+static int      numLastOps;
+static void     *lastFrame;
+
+
+static void countSequence(uint64 key)
 {
-    EjsOptable      *optable;
-    int             i;
+    uint    i;
 
-    if (mprGetLogLevel(ejs) < 6) {
-        return;
+    i = (uint) ((key * 0x9E3779B97F4A7C15LL) >> 40) & (EJS_OP_SEQ_SIZE - 1);
+    while (opseqs[i].key && opseqs[i].key != key) {
+        i = (i + 1) & (EJS_OP_SEQ_SIZE - 1);
     }
+    opseqs[i].key = key;
+    opseqs[i].count++;
+}
+
+
+static int sequenceLength(uint64 key)
+{
+    int     len;
+
+    for (len = 0; key; key >>= 16) {
+        len++;
+    }
+    return len;
+}
+
+
+/*
+    Count an op code and the sequences it ends
+ */
+static void profileOp(Ejs *ejs, int opcode)
+{
+    uint64  key;
+    int     i;
+
+    opcount[opcode]++;
+    if (ejs->state->fp != lastFrame) {
+        lastFrame = ejs->state->fp;
+        numLastOps = 0;
+    }
+    key = opcode + 1;
+    for (i = numLastOps - 1; i >= 0; i--) {
+        key = (key << 16) | (lastOps[i] + 1);
+        countSequence(key);
+    }
+    if (numLastOps == EJS_OP_SEQ_MAX - 1) {
+        memmove(lastOps, &lastOps[1], (EJS_OP_SEQ_MAX - 2) * sizeof(int));
+        numLastOps--;
+    }
+    lastOps[numLastOps++] = opcode;
+}
+
+
+/*
+    Count a dispatched op code. Fused op codes count as their first op code. NEXT_OP counts the rest.
+ */
+static EjsOpCode profileCode(Ejs *ejs, EjsOpCode opcode)
+{
+    profileOp(ejs, getFirstOpcode(opcode));
+    return opcode;
+}
+
+
+typedef struct OpCount {
+    uint64      count;
+    uint64      key;
+} OpCount;
+
+
+static int compareOpCount(OpCount *c1, OpCount *c2)
+{
+    return (c1->count < c2->count) ? 1 : ((c1->count > c2->count) ? -1 : 0);
+}
+
+
+/*
+    Display the most frequent op codes and op code sequences as a percentage of all counted op codes
+ */
+PUBLIC void ejsShowOpFrequency(Ejs *ejs)
+{
+    EjsOptable  *optable;
+    OpCount     *counts;
+    MprBuf      *buf;
+    uint64      total, key;
+    int         i, n, size;
+
     optable = ejsGetOptable();
-    mprTrace(0, "Opcode Frequency");
-    for (i = 0; i < 256 && optable[i].name; i++) {
-        mprTrace(6, "%4d %24s %8d", (uchar) i, optable[i].name, opcount[i]);
+    counts = mprAlloc(sizeof(OpCount) * EJS_OP_SEQ_SIZE);
+    for (total = 0, n = 0, i = 0; i < 256 && optable[i].name; i++) {
+        total += opcount[i];
+        counts[n].count = opcount[i];
+        counts[n++].key = i + 1;
+    }
+    if (total == 0) {
+        return;
+    }
+    qsort(counts, n, sizeof(OpCount), (int (*)(cvoid*, cvoid*)) compareOpCount);
+    mprPrintf("Opcode frequency (%,Ld instructions)\n", total);
+    for (i = 0; i < EJS_OP_PROFILE_TOP && i < n && counts[i].count; i++) {
+        mprPrintf("  %5.2f%%  %s\n", counts[i].count * 100.0 / total, optable[counts[i].key - 1].name);
+    }
+    for (size = 2; size <= EJS_OP_SEQ_MAX; size++) {
+        for (n = 0, i = 0; i < EJS_OP_SEQ_SIZE; i++) {
+            if (sequenceLength(opseqs[i].key) == size) {
+                counts[n].count = opseqs[i].count;
+                counts[n++].key = opseqs[i].key;
+            }
+        }
+        qsort(counts, n, sizeof(OpCount), (int (*)(cvoid*, cvoid*)) compareOpCount);
+        mprPrintf("Opcode sequence frequency (%d)\n", size);
+        for (i = 0; i < EJS_OP_PROFILE_TOP && i < n; i++) {
+            buf = mprCreateBuf(0, 0);
+            for (key = counts[i].key; key; key >>= 16) {
+                mprPutToBuf(buf, " %-24s", optable[(key & 0xFFFF) - 1].name);
+            }
+            mprAddNullToBuf(buf);
+            mprPrintf("  %5.2f%% %s\n", counts[i].count * 100.0 / total, strim(mprGetBufStart(buf), " ", MPR_TRIM_END));
+        }
     }
 }
-#endif
+#else
 
-#endif /* BIT_DEBUG */
+PUBLIC void ejsShowOpFrequency(Ejs *ejs)
+{
+}
+#endif /* EJS_OP_PROFILE */
 
 
 /*
@@ -14,6 +14,7 @@ static int  addFixup(Ejs *ejs, EjsModule *mp, int kind, EjsObj *target, int slot
 static int  alreadyLoaded(Ejs *ejs, EjsString *name, int minVersion, int maxVersion);
 static EjsLoadState *createLoadState(Ejs *ejs, int flags);
 static EjsTypeFixup *createFixup(Ejs *ejs, EjsModule *mp, EjsName qname, int slotNum);
+static int  deferCode(Ejs *ejs, int flags);
 static int  fixupTypes(Ejs *ejs, MprList *list);
 static EjsObj *getCurrentBlock(EjsModule *mp);
 static int  getVersion(cchar *name);
@@ -29,14 +30,16 @@ static int  loadEndModuleSection(Ejs *ejs, EjsModule *mp);
 static int  loadDebugSection(Ejs *ejs, EjsModule *mp);
 static int  loadExceptionSection(Ejs *ejs, EjsModule *mp);
 static int  loadFunctionSection(Ejs *ejs, EjsModule *mp);
-static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleHdr *hdr, int *created, int flags);
+static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleMap *map, MprOff pos, EjsModuleHdr *hdr, 
+    int *created, int flags);
 static int  loadNativeLibrary(Ejs *ejs, EjsModule *mp, cchar *path);
-static int  loadSections(Ejs *ejs, MprFile *file, cchar *path, EjsModuleHdr *hdr, int flags);
+static int  loadSections(Ejs *ejs, MprFile *file, EjsModuleMap *map, cchar *path, EjsModuleHdr *hdr, int flags);
 static int  loadPropertySection(Ejs *ejs, EjsModule *mp, int sectionType);
 static int  loadScriptModule(Ejs *ejs, cchar *filename, int minVersion, int maxVersion, int flags);
 static char *makeModuleName(cchar *name);
 static void popScope(EjsModule *mp, int keepScope);
 static void pushScope(EjsModule *mp, EjsAny *block, EjsAny *obj);
+static int  readExceptions(Ejs *ejs, EjsModule *mp, EjsFunction *fun, int deferred);
 static char *search(Ejs *ejs, cchar *filename, int minVersion, int maxVersion);
 static int  trimModule(Ejs *ejs, char *name);
 static void setDoc(Ejs *ejs, EjsModule *mp, cchar *tag, void *vp, int slotNum);
@@ -158,16 +161,42 @@ static char *search(Ejs *ejs, cchar *filename, int minVersion, int maxVersion)
 /*
     Load the sections: modules, classes, properties and functions from a module file. May load muliple logical modules.
  */
-static int loadSections(Ejs *ejs, MprFile *file, cchar *path, EjsModuleHdr *hdr, int flags)
+/*
+    Read the next section type. Mapped files are read from the position of the current module. A file may hold 
+    several modules.
+ */
+static int getSectionType(MprFile *file, EjsModuleMap *map, EjsModule *mp, MprOff *pos)
+{
+    if (map) {
+        if (mp) {
+            *pos = mp->mapPos;
+        }
+        if (*pos >= map->size) {
+            return -1;
+        }
+        if (mp) {
+            mp->mapPos++;
+        }
+        return map->data[(*pos)++];
+    }
+    return mprGetFileChar(file);
+}
+
+
+static int loadSections(Ejs *ejs, MprFile *file, EjsModuleMap *map, cchar *path, EjsModuleHdr *hdr, int flags)
 {
     EjsModule   *mp;
+    MprMutex    *mutex;
+    MprOff      pos;
     int         next, rc, sectionType, created, firstModule, status;
 
     created = 0;
     mp = 0;
+    mutex = 0;
+    pos = sizeof(EjsModuleHdr);
     firstModule = mprGetListLength(ejs->modules);
 
-    while ((sectionType = (int) mprGetFileChar(file)) >= 0) {
+    while ((sectionType = getSectionType(file, map, mp, &pos)) >= 0) {
         if (sectionType < 0 || sectionType >= EJS_SECT_MAX) {
             mprError("Bad section type %d in %@", sectionType, mp->name);
             return MPR_ERR_CANT_LOAD;
@@ -216,10 +245,16 @@ static int loadSections(Ejs *ejs, MprFile *file, cchar *path, EjsModuleHdr *hdr,
             break;
 
         case EJS_SECT_MODULE:
-            if ((mp = loadModuleSection(ejs, file, hdr, &created, flags)) == 0) {
+            if ((mp = loadModuleSection(ejs, file, map, pos, hdr, &created, flags)) == 0) {
                 return MPR_ERR_CANT_LOAD;
             }
-            mp->mutex = mprCreateLock();
+            /*
+                Modules from the same file share a lock as they share the file for loading function bodies and debug
+             */
+            if (mutex == 0) {
+                mutex = mprCreateLock();
+            }
+            mp->mutex = mutex;
             lock(mp);
             ejsAddModule(ejs, mp);
             mp->path = sclone(path);
@@ -278,7 +313,8 @@ static int loadSections(Ejs *ejs, MprFile *file, cchar *path, EjsModuleHdr *hdr,
 /*
     Load a module section and constant pool.
  */
-static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleHdr *hdr, int *created, int flags)
+static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleMap *map, MprOff pos, EjsModuleHdr *hdr, 
+    int *created, int flags)
 {
     EjsModule       *mp, tmod;
     EjsString       *name;
@@ -296,6 +332,8 @@ static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleHdr *hdr,
     mp = &tmod;
     memset(&tmod, 0, sizeof(tmod));
     mp->file = file;
+    mp->map = map;
+    mp->mapPos = pos;
     nameToken = ejsModuleReadInt(ejs, mp);
     version   = ejsModuleReadInt(ejs, mp);
     checksum  = ejsModuleReadInt32(ejs, mp);
@@ -309,21 +347,31 @@ static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleHdr *hdr,
         assert(0);
         return 0;
     }
-    if ((pool = mprAlloc(poolSize)) == 0) {
-        return 0;
-    }
-    if (mprReadFile(file, pool, poolSize) != poolSize) {
-        return 0;
+    if (map) {
+        /* Use the constant pool in place */
+        if ((pool = (char*) ejsModuleReadMapped(ejs, mp, poolSize)) == 0 || pool[poolSize - 1] != '\0') {
+            return 0;
+        }
+    } else {
+        if ((pool = mprAlloc(poolSize)) == 0) {
+            return 0;
+        }
+        if (mprReadFile(file, pool, poolSize) != poolSize) {
+            return 0;
+        }
     }
     if (ejsCreateConstants(ejs, mp, poolCount, poolSize, pool) < 0) {
         return 0;
     }
+    mp->constants->mapped = (map != 0);
     name = ejsCreateStringFromConst(ejs, mp, nameToken);
 
     if ((mp = ejsCreateModule(ejs, name, version, mp->constants)) == NULL) {
         return 0;
     }
     mp->constants = tmod.constants;
+    mp->map = map;
+    mp->mapPos = tmod.mapPos;
     mp->current = mprCreateList(-1, 0);
     pushScope(mp, 0, ejs->global);
     mp->checksum = checksum;
@@ -331,6 +379,7 @@ static EjsModule *loadModuleSection(Ejs *ejs, MprFile *file, EjsModuleHdr *hdr,
 
     mp->file = file;
     mp->flags = flags;
+    mp->lazyCode = deferCode(ejs, flags);
     mp->loadState = createLoadState(ejs, flags);
 
     if (ejs->loaderCallback) {
@@ -350,7 +399,9 @@ static int loadEndModuleSection(Ejs *ejs, EjsModule *mp)
     }
     assert(mprGetListLength(mp->current) == 1);
     mp->current = 0;
-    mp->file = 0;
+    if (!mp->lazyCode) {
+        mp->file = 0;
+    }
     return 0;
 }
 
@@ -565,7 +616,7 @@ static int loadClassSection(Ejs *ejs, EjsModule *mp)
         (ejs->loaderCallback)(ejs, EJS_SECT_CLASS, mp, slotNum, qname, type, attributes);
     }
     if (type->endClass) {
-        mprSeekFile(mp->file, SEEK_SET, type->endClass);
+        ejsSeekModule(mp, type->endClass);
     }
     return 0;
 }
@@ -582,7 +633,7 @@ static int loadEndClassSection(Ejs *ejs, EjsModule *mp)
     }
     type = (EjsType*) mp->scope;
     if (type->endClass == 0) {
-        type->endClass = (int) mprGetFilePosition(mp->file) - 1;
+        type->endClass = (int) ejsGetModulePosition(mp) - 1;
         if (type->hasScriptFunctions) {
             type->hasScriptFunctions = 1;
         }
@@ -606,10 +657,11 @@ static int loadFunctionSection(Ejs *ejs, EjsModule *mp)
     EjsName         qname, returnTypeName;
     EjsPot          *block;
     uchar           *code;
-    int             slotNum, numProp, numArgs, numDefault, codeLen, numExceptions, attributes, strict, sn;
+    int             slotNum, numProp, numArgs, numDefault, codeLen, codeOffset, numExceptions, attributes, strict, sn;
 
     strict = 0;
     code = 0;
+    codeOffset = 0;
 
     qname = ejsModuleReadName(ejs, mp);
     attributes = ejsModuleReadInt(ejs, mp);
@@ -654,11 +706,25 @@ static int loadFunctionSection(Ejs *ejs, EjsModule *mp)
             Read the code
          */
         if (codeLen > 0) {
-            if ((code = mprAlloc(codeLen)) == 0) {
-                return MPR_ERR_MEMORY;
-            }
-            if (mprReadFile(mp->file, code, codeLen) != codeLen) {
-                return MPR_ERR_CANT_READ;
+            if (mp->lazyCode) {
+                /*
+                    Note the location of the code and skip over. Loaded by ejsLoadFunctionCode when first called.
+                 */
+                codeOffset = (int) ejsGetModulePosition(mp);
+                ejsSeekModule(mp, codeOffset + codeLen);
+
+            } else if (mp->map) {
+                /* The function code is used in place */
+                if ((code = ejsModuleReadMapped(ejs, mp, codeLen)) == 0) {
+                    return MPR_ERR_CANT_READ;
+                }
+            } else {
+                if ((code = mprAlloc(codeLen)) == 0) {
+                    return MPR_ERR_MEMORY;
+                }
+                if (mprReadFile(mp->file, code, codeLen) != codeLen) {
+                    return MPR_ERR_CANT_READ;
+                }
             }
             if (currentType) {
                 currentType->hasScriptFunctions = 1;
@@ -676,6 +742,10 @@ static int loadFunctionSection(Ejs *ejs, EjsModule *mp)
         if (fun == 0) {
             return MPR_ERR_MEMORY;
         }
+        if (codeOffset) {
+            fun->body.code->codeOffset = codeOffset;
+            mprAtomicAdd(&ejs->service->deferredCode, 1);
+        }
         assert(fun->block.pot.isBlock);
         assert(fun->block.pot.isFunction);
         if (numProp > 0) {
@@ -711,8 +781,8 @@ static int loadFunctionSection(Ejs *ejs, EjsModule *mp)
             return MPR_ERR_MEMORY;
         }
         assert(fun->endFunction);
-        assert(mprGetFilePosition(mp->file) <= fun->endFunction);
-        mprSeekFile(mp->file, SEEK_SET, fun->endFunction);
+        assert(ejsGetModulePosition(mp) <= fun->endFunction);
+        ejsSeekModule(mp, fun->endFunction);
     }
     assert(fun);
     mp->currentMethod = fun;
@@ -731,7 +801,7 @@ static int loadEndFunctionSection(Ejs *ejs, EjsModule *mp)
     mprTrace(9, "    End function section");
 
     fun = (EjsFunction*) mp->scope;
-    fun->endFunction = (int) mprGetFilePosition(mp->file) - 1;
+    fun->endFunction = (int) ejsGetModulePosition(mp) - 1;
     if (ejs->loaderCallback) {
         (ejs->loaderCallback)(ejs, EJS_SECT_FUNCTION_END, mp, fun);
     }
@@ -753,8 +823,8 @@ static int loadDebugSection(Ejs *ejs, EjsModule *mp)
      */
     assert(!fun->isNativeProc);
     size = ejsModuleReadInt32(ejs, mp);
-    fun->body.code->debugOffset = (int) mprGetFilePosition(mp->file);
-    mprSeekFile(mp->file, SEEK_CUR, size);
+    fun->body.code->debugOffset = (int) ejsGetModulePosition(mp);
+    ejsSeekModule(mp, fun->body.code->debugOffset + size);
     if (ejs->loaderCallback) {
         (ejs->loaderCallback)(ejs, EJS_SECT_DEBUG, mp, fun);
     }
@@ -765,14 +835,31 @@ static int loadDebugSection(Ejs *ejs, EjsModule *mp)
 static int loadExceptionSection(Ejs *ejs, EjsModule *mp)
 {
     EjsFunction     *fun;
+
+    fun = mp->currentMethod;
+    assert(fun);
+
+    if (readExceptions(ejs, mp, fun, fun->body.code->byteCode == 0) < 0) {
+        return MPR_ERR_CANT_READ;
+    }
+    if (ejs->loaderCallback) {
+        (ejs->loaderCallback)(ejs, EJS_SECT_EXCEPTION, mp, fun);
+    }
+    return 0;
+}
+
+
+/*
+    Read the exception handlers for a function. Handlers for deferred function bodies are skipped and read later by 
+    ejsLoadFunctionCode.
+ */
+static int readExceptions(Ejs *ejs, EjsModule *mp, EjsFunction *fun, int deferred)
+{
     EjsType         *catchType;
     EjsTypeFixup    *fixup;
     EjsCode         *code;
     EjsEx           *ex;
-    int             tryStart, tryEnd, handlerStart, handlerEnd, numBlocks, numStack, flags, i;
-
-    fun = mp->currentMethod;
-    assert(fun);
+    int             tryStart, tryEnd, handlerStart, handlerEnd, numBlocks, numStack, flags, i, t;
 
     flags = 0;
     code = fun->body.code;
@@ -785,6 +872,17 @@ static int loadExceptionSection(Ejs *ejs, EjsModule *mp)
         handlerEnd   = ejsModuleReadInt(ejs, mp);
         numBlocks    = ejsModuleReadInt(ejs, mp);
         numStack     = ejsModuleReadInt(ejs, mp);
+        if (deferred) {
+            /* Skip the catch type */
+            t = ejsModuleReadInt(ejs, mp);
+            if ((t & EJS_ENCODE_GLOBAL_MASK) == EJS_ENCODE_GLOBAL_NAME) {
+                ejsModuleReadInt(ejs, mp);
+            }
+            if (mp->hasError) {
+                return MPR_ERR_CANT_READ;
+            }
+            continue;
+        }
         ejsModuleReadType(ejs, mp, &catchType, &fixup, 0, 0);
         if (mp->hasError) {
             return MPR_ERR_CANT_READ;
@@ -793,19 +891,82 @@ static int loadExceptionSection(Ejs *ejs, EjsModule *mp)
             numStack, flags, i);
         if (fixup) {
             assert(catchType == 0);
+            if (mp->loadState == 0) {
+                /* Function bodies loaded on first call are read after all types are defined */
+                return MPR_ERR_CANT_FIND;
+            }
             if (addFixup(ejs, mp, EJS_FIXUP_EXCEPTION, (EjsObj*) ex, 0, fixup) < 0) {
                 assert(0);
                 return MPR_ERR_MEMORY;
             }
         }
     }
-    if (ejs->loaderCallback) {
-        (ejs->loaderCallback)(ejs, EJS_SECT_EXCEPTION, mp, fun);
-    }
     return 0;
 }
 
 
+/*
+    Load the byte code and exception handlers for a function deferred by loadFunctionSection
+ */
+int ejsLoadFunctionCode(Ejs *ejs, EjsFunction *fun)
+{
+    EjsModule   *mp;
+    EjsCode     *code;
+    uchar       *byteCode;
+    MprOff      prior;
+    int         rc;
+
+    code = fun->body.code;
+    if (code == 0 || code->byteCode || code->codeOffset == 0) {
+        return 0;
+    }
+    mp = code->module;
+    rc = 0;
+
+    /*
+        Synchronize with other threads calling the function and with loading debug information
+     */
+    lock(mp);
+    if (code->byteCode) {
+        unlock(mp);
+        return 0;
+    }
+    if (mp->map == 0 && mp->file == 0) {
+        unlock(mp);
+        ejsThrowIOError(ejs, "Cannot load code for function %@ from module %@", fun->name, mp->name);
+        return MPR_ERR_CANT_READ;
+    }
+    prior = ejsGetModulePosition(mp);
+    ejsSeekModule(mp, code->codeOffset);
+    if (mp->map) {
+        byteCode = ejsModuleReadMapped(ejs, mp, code->codeLen);
+    } else if ((byteCode = mprAlloc(code->codeLen)) != 0) {
+        if (mprReadFile(mp->file, byteCode, code->codeLen) != code->codeLen) {
+            byteCode = 0;
+        }
+    }
+    if (byteCode == 0) {
+        rc = MPR_ERR_CANT_READ;
+
+    } else if (code->numHandlers > 0) {
+        if (ejsModuleReadByte(ejs, mp) != EJS_SECT_EXCEPTION || readExceptions(ejs, mp, fun, 0) < 0) {
+            rc = MPR_ERR_CANT_READ;
+        }
+    }
+    ejsSeekModule(mp, prior);
+    if (rc == 0) {
+        mprAtomicBarrier();
+        code->byteCode = byteCode;
+        mprAtomicAdd(&ejs->service->loadedCode, 1);
+    }
+    unlock(mp);
+    if (rc < 0) {
+        ejsThrowIOError(ejs, "Cannot load code for function %@ from module %@", fun->name, mp->name);
+    }
+    return rc;
+}
+
+
 static int loadPropertySection(Ejs *ejs, EjsModule *mp, int sectionType)
 {
     EjsType         *type, *ctype;
@@ -959,8 +1120,10 @@ static int loadScriptModule(Ejs *ejs, cchar *filename, int minVersion, int maxVe
 {
     EjsModuleHdr    hdr;
     EjsModule       *mp;
+    EjsModuleMap    *map;
     MprFile         *file;
     char            *path;
+    ssize           len;
     int             next, status, firstModule;
 
     assert(filename && *filename);
@@ -969,19 +1132,29 @@ static int loadScriptModule(Ejs *ejs, cchar *filename, int minVersion, int maxVe
     if ((path = search(ejs, filename, minVersion, maxVersion)) == 0) {
         return MPR_ERR_CANT_ACCESS;
     }
-    if ((file = mprOpenFile(path, O_RDONLY | O_BINARY, 0666)) == NULL) {
-        ejsThrowIOError(ejs, "Cannot open module file %s", path);
-        return MPR_ERR_CANT_OPEN;
+    file = 0;
+    map = (ejs->service->mapModules) ? ejsMapModule(ejs, path) : 0;
+    if (map == 0) {
+        if ((file = mprOpenFile(path, O_RDONLY | O_BINARY, 0666)) == NULL) {
+            ejsThrowIOError(ejs, "Cannot open module file %s", path);
+            return MPR_ERR_CANT_OPEN;
+        }
+        mprEnableFileBuffering(file, 0, 0);
     }
     mprTrace(5, "Loading module %s", path);
-    mprEnableFileBuffering(file, 0, 0);
     firstModule = mprGetListLength(ejs->modules);
 
     /*
         Read module file header
      */
     status = 0;
-    if ((mprReadFile(file, &hdr, sizeof(hdr))) != sizeof(hdr)) {
+    if (map) {
+        len = min(map->size, (ssize) sizeof(hdr));
+        memcpy(&hdr, map->data, len);
+    } else {
+        len = mprReadFile(file, &hdr, sizeof(hdr));
+    }
+    if (len != sizeof(hdr)) {
         ejsThrowIOError(ejs, "Cannot read module file %s, corrupt header", path);
         status = MPR_ERR_CANT_LOAD;
 
@@ -997,7 +1170,7 @@ static int loadScriptModule(Ejs *ejs, cchar *filename, int minVersion, int maxVe
         if (ejs->loaderCallback) {
             (ejs->loaderCallback)(ejs, EJS_SECT_START, path, &hdr);
         }
-        if ((status = loadSections(ejs, file, path, &hdr, flags)) < 0) {
+        if ((status = loadSections(ejs, file, map, path, &hdr, flags)) < 0) {
             if (ejs->exception == 0) {
                 ejsThrowReferenceError(ejs, "Cannot load module file %s", path);
                 status = MPR_ERR_CANT_LOAD;
@@ -1009,7 +1182,10 @@ static int loadScriptModule(Ejs *ejs, cchar *filename, int minVersion, int maxVe
             ejsRemoveModule(ejs, mp);
         }
     }
-    mprCloseFile(file);
+    if (file && (status || !deferCode(ejs, flags))) {
+        /* Otherwise the modules keep the file to load function bodies when first called */
+        mprCloseFile(file);
+    }
     return status;
 }
 
@@ -1511,6 +1687,16 @@ int ejsModuleReadType(Ejs *ejs, EjsModule *mp, EjsType **typeRef, EjsTypeFixup *
 }
 
 
+/*
+    Function bodies are loaded when first called, except when modules are loaded to compile or list them
+ */
+static int deferCode(Ejs *ejs, int flags)
+{
+    return ejs->service->lazyCode && !(flags & EJS_LOADER_NO_INIT) && !(ejs->flags & EJS_FLAG_NO_INIT) &&
+        ejs->loaderCallback == 0;
+}
+
+
 static EjsTypeFixup *createFixup(Ejs *ejs, EjsModule *mp, EjsName qname, int slotNum)
 {
     EjsTypeFixup    *fixup;
@@ -13,6 +13,7 @@
 static void manageConstants(EjsConstants *constants, int flags);
 static void manageDebug(EjsDebug *debug, int flags);
 static void manageModule(EjsModule *module, int flags);
+static void manageModuleMap(EjsModuleMap *map, int flags);
 
 /************************************ Code ************************************/
 
@@ -50,6 +51,7 @@ static void manageModule(EjsModule *mp, int flags)
         mprMark(mp->loadState);
         mprMark(mp->dependencies);
         mprMark(mp->file);
+        mprMark(mp->map);
         mprMark(mp->current);
         mprMark(mp->currentMethod);
         mprMark(mp->scope);
@@ -59,7 +61,7 @@ static void manageModule(EjsModule *mp, int flags)
         mprMark(mp->globalProperties);
 
     } else if (flags & MPR_MANAGE_FREE) {
-        mprCloseFile(mp->file);
+        /* The file may be shared with other modules and is closed when it is collected */
         ejsRemoveModuleFromAll(mp);
     }
 }
@@ -165,6 +167,87 @@ void ejsRemoveModuleFromAll(EjsModule *mp)
 }
 
 
+/*
+    Map a module file. Mappings are cached by path and shared by all interpreters. A cached mapping is reused while the 
+    file is unchanged. The compiler deletes and recreates module files so the inode may be reused. The modification 
+    time is compared to the nanosecond so a recompile of the same size within one second is still detected.
+    Returns NULL if the file cannot be mapped so the caller can read the file instead.
+ */
+EjsModuleMap *ejsMapModule(Ejs *ejs, cchar *path)
+{
+#if BIT_UNIX_LIKE
+    EjsService      *sp;
+    EjsModuleMap    *map;
+    struct stat     info;
+    int64           modified;
+    void            *data;
+    int             fd;
+
+    sp = ejs->service;
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &info) < 0 || info.st_size <= 0 || info.st_size > MAXSSIZE) {
+        close(fd);
+        return NULL;
+    }
+#if MACOSX
+    modified = (int64) info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    modified = (int64) info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+    lock(sp);
+    map = mprLookupKey(sp->moduleMaps, path);
+    if (map && map->size == info.st_size && map->inode == info.st_ino && map->modified == modified) {
+        unlock(sp);
+        close(fd);
+        return map;
+    }
+    /*
+        Private writable mapping so the VM can rewrite byte code in place. Unmodified pages stay shared.
+     */
+    if ((data = mmap(0, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)) == MAP_FAILED) {
+        unlock(sp);
+        close(fd);
+        return NULL;
+    }
+    close(fd);
+    if ((map = mprAllocObj(EjsModuleMap, manageModuleMap)) == 0) {
+        munmap(data, info.st_size);
+        unlock(sp);
+        return NULL;
+    }
+    map->data = data;
+    map->size = info.st_size;
+    map->inode = info.st_ino;
+    map->modified = modified;
+    map->path = sclone(path);
+    mprAddKey(sp->moduleMaps, map->path, map);
+    unlock(sp);
+    mprTrace(5, "Mapped module file %s, %d bytes", path, (int) map->size);
+    return map;
+#else
+    return NULL;
+#endif
+}
+
+
+static void manageModuleMap(EjsModuleMap *map, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(map->path);
+
+    } else if (flags & MPR_MANAGE_FREE) {
+#if BIT_UNIX_LIKE
+        if (map->data) {
+            munmap(map->data, map->size);
+            map->data = 0;
+        }
+#endif
+    }
+}
+
+
 /************************************************* Constants ***************************************************/
 
 static void manageConstants(EjsConstants *cp, int flags)
@@ -172,7 +255,9 @@ static void manageConstants(EjsConstants *cp, int flags)
     int     i;
     
     if (flags & MPR_MANAGE_MARK) {
-        mprMark(cp->pool);
+        if (!cp->mapped) {
+            mprMark(cp->pool);
+        }
         mprMark(cp->table);
         mprMark(cp->index);
         /*
@@ -240,10 +325,20 @@ int ejsCreateConstants(Ejs *ejs, EjsModule *mp, int count, ssize size, char *poo
 int ejsGrowConstants(Ejs *ejs, EjsModule *mp, ssize len)
 {
     EjsConstants    *cp;
+    char            *pool;
     int             indexSize;
 
     lock(mp);
     cp = mp->constants;
+    if (cp->mapped) {
+        if ((pool = mprAlloc(cp->poolSize)) == 0) {
+            unlock(mp);
+            return MPR_ERR_MEMORY;
+        }
+        memcpy(pool, cp->pool, cp->poolLength);
+        cp->pool = pool;
+        cp->mapped = 0;
+    }
     if ((cp->poolLength + len) >= cp->poolSize) {
         cp->poolSize = ((cp->poolSize + len) + EC_BUFSIZE - 1) / EC_BUFSIZE * EC_BUFSIZE;
         if ((cp->pool = mprRealloc(cp->pool, cp->poolSize)) == 0) {
@@ -413,20 +508,26 @@ static EjsDebug *loadDebug(Ejs *ejs, EjsFunction *fun)
         Synchronize with ejsLoadModule. May be multiple threads using immutable types
      */
     lock(mp);
-    if (mp->file == 0) {
-        if ((mp->file = mprOpenFile(mp->path, O_RDONLY | O_BINARY, 0666)) == NULL) {
-            mprTrace(5, "Cannot open module file %s", mp->path);
+    if (mp->map) {
+        /* Mapped modules read debug information from the mapping without reopening the file */
+        prior = mp->mapPos;
+        mp->mapPos = code->debugOffset;
+    } else {
+        if (mp->file == 0) {
+            if ((mp->file = mprOpenFile(mp->path, O_RDONLY | O_BINARY, 0666)) == NULL) {
+                mprTrace(5, "Cannot open module file %s", mp->path);
+                unlock(mp);
+                return NULL;
+            }
+            mprEnableFileBuffering(mp->file, 0, 0);
+        } else {
+            prior = mprGetFilePosition(mp->file);
+        }
+        if (mprSeekFile(mp->file, SEEK_SET, code->debugOffset) != code->debugOffset) {
+            mprSeekFile(mp->file, SEEK_SET, prior);
             unlock(mp);
-            return NULL;
+            return 0;
         }
-        mprEnableFileBuffering(mp->file, 0, 0);
-    } else {
-        prior = mprGetFilePosition(mp->file);
-    }
-    if (mprSeekFile(mp->file, SEEK_SET, code->debugOffset) != code->debugOffset) {
-        mprSeekFile(mp->file, SEEK_SET, prior);
-        unlock(mp);
-        return 0;
     }
     length = ejsModuleReadInt(ejs, mp);
     if (!mp->hasError) {
@@ -439,7 +540,9 @@ static EjsDebug *loadDebug(Ejs *ejs, EjsFunction *fun)
             }
         }
     }
-    if (prior) {
+    if (mp->map) {
+        mp->mapPos = prior;
+    } else if (prior) {
         mprSeekFile(mp->file, SEEK_SET, prior);
     } else {
         mprCloseFile(mp->file);
@@ -684,11 +787,70 @@ int ejsEncodeInt32AtPos(Ejs *ejs, uchar *pos, int value)
 
 
 
+/*
+    Read a character from the module file or mapping. Returns -1 at the end of the file.
+ */
+static int getModuleChar(EjsModule *mp)
+{
+    if (mp->map) {
+        return (mp->mapPos < mp->map->size) ? mp->map->data[mp->mapPos++] : -1;
+    }
+    return mprGetFileChar(mp->file);
+}
+
+
+static ssize readModule(EjsModule *mp, void *buf, ssize len)
+{
+    if (mp->map) {
+        len = min(len, (ssize) (mp->map->size - mp->mapPos));
+        memcpy(buf, &mp->map->data[mp->mapPos], len);
+        mp->mapPos += len;
+        return len;
+    }
+    return mprReadFile(mp->file, buf, len);
+}
+
+
+MprOff ejsGetModulePosition(EjsModule *mp)
+{
+    return (mp->map) ? mp->mapPos : mprGetFilePosition(mp->file);
+}
+
+
+void ejsSeekModule(EjsModule *mp, MprOff pos)
+{
+    if (mp->map) {
+        mp->mapPos = min(pos, mp->map->size);
+    } else {
+        mprSeekFile(mp->file, SEEK_SET, pos);
+    }
+}
+
+
+/*
+    Return a reference to the next "len" bytes of a mapped module file and skip over them
+ */
+uchar *ejsModuleReadMapped(Ejs *ejs, EjsModule *mp, ssize len)
+{
+    uchar   *data;
+
+    assert(mp && mp->map);
+
+    if (len < 0 || len > (mp->map->size - mp->mapPos)) {
+        mp->hasError = 1;
+        return NULL;
+    }
+    data = &mp->map->data[mp->mapPos];
+    mp->mapPos += len;
+    return data;
+}
+
+
 void ejsModuleReadBlock(Ejs *ejs, EjsModule *mp, char *buf, int len)
 {
     assert(mp);
 
-    if (mprReadFile(mp->file, buf, len) != len) {
+    if (readModule(mp, buf, len) != len) {
         mp->hasError = 1;
     }
 }
@@ -700,7 +862,7 @@ int ejsModuleReadByte(Ejs *ejs, EjsModule *mp)
 
     assert(mp);
 
-    if ((c = mprGetFileChar(mp->file)) < 0) {
+    if ((c = getModuleChar(mp)) < 0) {
         mp->hasError = 1;
         return 0;
     }
@@ -730,7 +892,7 @@ int ejsModuleReadInt32(Ejs *ejs, EjsModule *mp)
 
     assert(mp);
 
-    if (mprReadFile(mp->file, buf, 4) != 4) {
+    if (readModule(mp, buf, 4) != 4) {
         mp->hasError = 1;
         return 0;
     }
@@ -755,7 +917,7 @@ char *ejsModuleReadMulti(Ejs *ejs, EjsModule *mp)
     if (mp->hasError || (buf = mprAlloc(len)) == 0) {
         return NULL;
     }
-    if (mprReadFile(mp->file, buf, len) != len) {
+    if (readModule(mp, buf, len) != len) {
         mp->hasError = 1;
         return NULL;
     }
@@ -792,9 +954,9 @@ int64 ejsModuleReadNum(Ejs *ejs, EjsModule *mp)
 
     assert(ejs);
     assert(mp);
-    assert(mp->file);
+    assert(mp->file || mp->map);
 
-    if ((c = mprGetFileChar(mp->file)) < 0) {
+    if ((c = getModuleChar(mp)) < 0) {
         mp->hasError = 1;
         return 0;
     }
@@ -804,7 +966,7 @@ int64 ejsModuleReadNum(Ejs *ejs, EjsModule *mp)
     shift = 6;
     
     while (c & 0x80) {
-        if ((c = mprGetFileChar(mp->file)) < 0) {
+        if ((c = getModuleChar(mp)) < 0) {
             mp->hasError = 1;
             return 0;
         }
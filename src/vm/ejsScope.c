@@ -30,6 +30,8 @@ int ejsLookupScope(Ejs *ejs, EjsName name, EjsLookup *lookup)
     assert(name.space);
     assert(lookup);
 
+    ejsInternName(&name);
+
     memset(lookup, 0, sizeof(*lookup));
 
     //  OPT -- remove nthBlock. Not needed if not binding
@@ -136,6 +138,8 @@ int ejsLookupVar(Ejs *ejs, EjsAny *obj, EjsName name, EjsLookup *lookup)
     assert(obj);
     assert(lookup);
 
+    ejsInternName(&name);
+
     memset(lookup, 0, sizeof(*lookup));
 
     /* Lookup simple object */
@@ -185,6 +189,8 @@ int ejsLookupVarWithNamespaces(Ejs *ejs, EjsAny *obj, EjsName name, EjsLookup *l
     assert(name.space);
     assert(lookup);
 
+    ejsInternName(&name);
+
     b = (EjsBlock*) ejs->global;
     globalSpaces = &b->namespaces;
 
@@ -278,6 +284,8 @@ EjsAny *ejsGetVarByName(Ejs *ejs, EjsAny *obj, EjsName name, EjsLookup *lookup)
 
     assert(ejs);
 
+    ejsInternName(&name);
+
     //  OPT - really nice to remove this
     //  OPT -- perhaps delegate the logic below down into a getPropertyByName?
     if (obj && TYPE(obj)->helpers.getPropertyByName) {
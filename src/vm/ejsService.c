@@ -50,6 +50,19 @@ static EjsService *createService()
     sp->intern = ejsCreateIntern(sp);
     sp->dtoaSpin[0] = mprCreateSpinLock();
     sp->dtoaSpin[1] = mprCreateSpinLock();
+    /*
+        Runtime op code specialization rewrites byte code and the JIT runs hot functions as native code. Keep the
+        compiled code intact and visible when debugging.
+     */
+    sp->quicken = !mprGetDebugMode();
+    sp->jit = !mprGetDebugMode();
+    sp->moduleMaps = mprCreateHash(-1, 0);
+    sp->mapModules = scmp(getenv("EJS_MAP_MODULES"), "1") == 0;
+    /*
+        Deferred function bodies keep each module file open for the life of the module. Off unless requested.
+     */
+    sp->lazyCode = scmp(getenv("EJS_LAZY_CODE"), "1") == 0;
+    sp->partitions = scmp(getenv("EJS_PARTITIONS"), "1") == 0;
     ejsInitCompiler(sp);
     mprGlobalUnlock();
     return sp;
@@ -58,6 +71,8 @@ static EjsService *createService()
 
 static void manageEjsService(EjsService *sp, int flags)
 {
+    int     i;
+
     if (flags & MPR_MANAGE_MARK) {
         mprMark(sp->http);
         mprMark(sp->mutex);
@@ -66,10 +81,15 @@ static void manageEjsService(EjsService *sp, int flags)
         mprMark(sp->vmpool);
 #endif
         mprMark(sp->nativeModules);
+        mprMark(sp->moduleMaps);
         mprMark(sp->intern);
+        mprMark(sp->regexCache);
         mprMark(sp->immutable);
         mprMark(sp->dtoaSpin[0]);
         mprMark(sp->dtoaSpin[1]);
+        for (i = 0; i < (EJS_NUMBER_CACHE_MAX - EJS_NUMBER_CACHE_MIN); i++) {
+            mprMark(sp->numbers[i]);
+        }
 
     } else if (flags & MPR_MANAGE_FREE) {
         ejsDestroyIntern(sp->intern);
@@ -81,12 +101,30 @@ static void manageEjsService(EjsService *sp, int flags)
 
 Ejs *ejsCreateVM(int argc, cchar **argv, int flags)
 {
-    EjsService  *sp;
-    Ejs         *ejs;
+    EjsService      *sp;
+    MprPartition    *partition, *prior;
+    Ejs             *ejs;
 
+    /*
+        Interpreters after the first are created in their own heap partition if partitions are enabled. The first 
+        interpreter and the shared types are in the shared heap.
+     */
+    partition = 0;
+    if ((sp = MPR->ejsService) != 0 && sp->partitions) {
+        partition = mprCreatePartition();
+    }
+    prior = mprSetThreadPartition(partition);
     if ((ejs = mprAllocObj(Ejs, manageEjs)) == NULL) {
+        mprSetThreadPartition(prior);
+        mprDestroyPartition(partition);
         return 0;
     }
+    ejs->partition = partition;
+    /*
+        The VM marks its evaluation stack and call states which are not in the heap. Minor collections must run
+        the manager as writes to them are not tracked.
+     */
+    mprRemember(ejs);
     sp = ejs->service = MPR->ejsService;
     if (sp == 0) {
         sp = ejs->service = createService();
@@ -97,7 +135,9 @@ Ejs *ejsCreateVM(int argc, cchar **argv, int flags)
     ejs->argc = argc;
     ejs->argv = argv;
     ejs->name = sfmt("ejs-%d", sp->seqno++);
-    ejs->dispatcher = mprCreateDispatcher(ejs->name, MPR_DISPATCHER_ENABLED);
+    if ((ejs->dispatcher = mprCreateDispatcher(ejs->name, MPR_DISPATCHER_ENABLED)) != 0) {
+        ejs->dispatcher->partition = partition;
+    }
     ejs->mutex = mprCreateLock(ejs);
     ejs->dontExit = sp->dontExit;
     ejs->flags |= (flags & (EJS_FLAG_NO_INIT | EJS_FLAG_DOC | EJS_FLAG_HOSTED));
@@ -120,9 +160,11 @@ Ejs *ejsCreateVM(int argc, cchar **argv, int flags)
 
     if (ejs->hasError || mprHasMemError(ejs)) {
         ejsDestroyVM(ejs);
+        mprSetThreadPartition(prior);
         mprError("Cannot create VM");
         return 0;
     }
+    mprSetThreadPartition(prior);
     mprTrace(5, "ejs: create VM");
     return ejs;
 }
@@ -130,15 +172,17 @@ Ejs *ejsCreateVM(int argc, cchar **argv, int flags)
 
 Ejs *ejsCloneVM(Ejs *master)
 {
-    EjsModule   *mp;
-    Ejs         *ejs;
-    int         next;
+    EjsModule       *mp;
+    MprPartition    *prior;
+    Ejs             *ejs;
+    int             next;
 
     if (master) {
         assert(!master->empty);
         if ((ejs = ejsCreateVM(master->argc, master->argv, master ? master->flags : 0)) == 0) {
             return 0;
         }
+        prior = mprSetThreadPartition(ejs->partition);
         cloneProperties(ejs, master);
         ejsFixTraits(ejs, ejs->global);
         ejs->sqlite = master->sqlite;
@@ -148,6 +192,7 @@ Ejs *ejsCloneVM(Ejs *master)
         for (next = 0; (mp = mprGetNextItem(master->modules, &next)) != 0;) {
             ejsAddModule(ejs, mp);
         }
+        mprSetThreadPartition(prior);
         return ejs;
     }
     return ejsCreateVM(0, 0, 0);
@@ -161,11 +206,13 @@ Ejs *ejsCloneVM(Ejs *master)
 int ejsLoadModules(Ejs *ejs, cchar *search, MprList *require)
 {
     EjsService      *sp;
+    MprPartition    *prior;
 
     sp = ejs->service;
     assert(mprGetListLength(ejs->modules) == 0);
 
     ejs->empty = !(require == 0 || mprGetListLength(require));
+    prior = mprSetThreadPartition(ejs->partition);
     if (search) {
         initSearchPath(ejs, search);
     }
@@ -176,9 +223,11 @@ int ejsLoadModules(Ejs *ejs, cchar *search, MprList *require)
         }
         ejsDestroyVM(ejs);
         unlock(sp);
+        mprSetThreadPartition(prior);
         return MPR_ERR_CANT_READ;
     }
     unlock(sp);
+    mprSetThreadPartition(prior);
     if (mprHasMemError(ejs)) {
         mprError("Memory allocation error during initialization");
         ejsDestroyVM(ejs);
@@ -210,11 +259,19 @@ void ejsDestroyVM(Ejs *ejs)
             ejs->state = 0;
         }
         mprRemoveItem(sp->vmlist, ejs);
+        mprForget(ejs);
+        if (sp->profiler == ejs) {
+            sp->profiler = 0;
+        }
         ejs->service = 0;
         ejs->result = 0;
         if (ejs->dispatcher) {
             mprDisableDispatcher(ejs->dispatcher);
+            ejs->dispatcher->partition = 0;
         }
+        /* The partition is merged into the shared heap by the next full collection */
+        mprDestroyPartition(ejs->partition);
+        ejs->partition = 0;
     }
     mprTrace(6, "ejs: destroy VM");
 }
@@ -232,12 +289,14 @@ static void manageEjs(Ejs *ejs, int flags)
         mprMark(ejs->exception);
         mprMark(ejs->result);
         /*
-            Mark active call stack
+            Mark active call stack. Only the base state is allocated. VM states live on the C stack.
          */
         start = ejs->state;
         if (start) {
             for (state = start; state; state = state->prev) {
-                mprMark(state);
+                if (state->prev == 0) {
+                    mprMark(state);
+                }
                 mprMark(state->fp);
                 mprMark(state->bp);
                 mprMark(state->internal);
@@ -273,8 +332,12 @@ static void manageEjs(Ejs *ejs, int flags)
         mprMark(ejs->modules);
         mprMark(ejs->httpServers);
         mprMark(ejs->doc);
+        mprMark(ejs->allocProfile);
         mprMark(ejs->http);
         mprMark(ejs->mutex);
+        for (next = 0; next < EJS_FRAME_CLASSES; next++) {
+            mprMark(ejs->frames[next]);
+        }
 
     } else if (flags & MPR_MANAGE_FREE) {
         ejsDestroyVM(ejs);
@@ -377,6 +440,7 @@ Ejs *ejsAllocPoolVM(EjsPool *pool, int flags)
             mprError("Cannot alloc ejs VM");
             return 0;
         }
+        mprSetThreadPartition(ejs->partition);
         if (pool->hostedDocuments) {
             ejs->hostedDocuments = pool->hostedDocuments;
         }
@@ -388,6 +452,7 @@ Ejs *ejsAllocPoolVM(EjsPool *pool, int flags)
             if (ejsLoadScriptFile(ejs, pool->startScriptPath, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
                 mprError("Cannot load \"%s\"\n%s", pool->startScriptPath, ejsGetErrorMsg(ejs, 1));
                 mprRemoveRoot(ejs);
+                mprSetThreadPartition(0);
                 return 0;
             }
         } else if (pool->startScript) {
@@ -395,12 +460,14 @@ Ejs *ejsAllocPoolVM(EjsPool *pool, int flags)
             if (ejsLoadScriptLiteral(ejs, script, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
                 mprError("Cannot load \"%@\"\n%s", script, ejsGetErrorMsg(ejs, 1));
                 mprRemoveRoot(ejs);
+                mprSetThreadPartition(0);
                 return 0;
             }
         }
         mprRemoveRoot(ejs);
         pool->count++;
     }
+    mprSetThreadPartition(ejs->partition);
     pool->lastActivity = mprGetTime();
     mprTrace(5, "ejs: Alloc VM active %d, allocated %d, max %d", pool->count - mprGetListLength(pool->list), 
         pool->count, pool->max);
@@ -425,6 +492,9 @@ void ejsFreePoolVM(EjsPool *pool, Ejs *ejs)
     assert(!ejs->exception);
 
     ejs->exception = 0;
+    if (ejs->partition && mprGetThreadPartition() == ejs->partition) {
+        mprSetThreadPartition(0);
+    }
     pool->lastActivity = mprGetTime();
     mprPushItem(pool->list, ejs);
     mprTrace(5, "ejs: Free VM, active %d, allocated %d, max %d", pool->count - mprGetListLength(pool->list), pool->count,